@@ -194,6 +194,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/math/log2.cpp",
     "src/mbgl/platform/settings.cpp",
     "src/mbgl/renderer/backend_scope.cpp",
+    "src/mbgl/renderer/bucket.cpp",
     "src/mbgl/renderer/bucket.hpp",
     "src/mbgl/renderer/bucket_parameters.cpp",
     "src/mbgl/renderer/bucket_parameters.hpp",
@@ -218,11 +219,16 @@ MLN_CORE_SOURCE = [
     "src/mbgl/renderer/cross_faded_property_evaluator.cpp",
     "src/mbgl/renderer/cross_faded_property_evaluator.hpp",
     "src/mbgl/renderer/data_driven_property_evaluator.hpp",
+    "src/mbgl/renderer/feature_state_texture.cpp",
+    "src/mbgl/renderer/feature_state_texture.hpp",
+    "src/mbgl/renderer/feature_vertex_index.cpp",
+    "src/mbgl/renderer/feature_vertex_index.hpp",
     "src/mbgl/renderer/group_by_layout.cpp",
     "src/mbgl/renderer/group_by_layout.hpp",
     "src/mbgl/renderer/image_manager.cpp",
     "src/mbgl/renderer/image_manager.hpp",
     "src/mbgl/renderer/image_manager_observer.hpp",
+    "src/mbgl/renderer/layer_drawable_data.hpp",
     "src/mbgl/renderer/layers/render_background_layer.cpp",
     "src/mbgl/renderer/layers/render_background_layer.hpp",
     "src/mbgl/renderer/layers/render_circle_layer.cpp",
@@ -317,6 +323,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/storage/main_resource_loader.hpp",
     "src/mbgl/storage/network_status.cpp",
     "src/mbgl/storage/pmtiles_file_source.hpp",
+    "src/mbgl/storage/request_concurrency_controller.cpp",
+    "src/mbgl/storage/request_concurrency_controller.hpp",
     "src/mbgl/storage/resource.cpp",
     "src/mbgl/storage/resource_options.cpp",
     "src/mbgl/storage/resource_transform.cpp",
@@ -349,6 +357,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/style/expression/assertion.cpp",
     "src/mbgl/style/expression/at.cpp",
     "src/mbgl/style/expression/boolean_operator.cpp",
+    "src/mbgl/style/expression/bytecode.cpp",
     "src/mbgl/style/expression/case.cpp",
     "src/mbgl/style/expression/check_subtype.cpp",
     "src/mbgl/style/expression/coalesce.cpp",
@@ -497,6 +506,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/tile/raster_dem_tile.hpp",
     "src/mbgl/tile/raster_dem_tile_worker.cpp",
     "src/mbgl/tile/raster_dem_tile_worker.hpp",
+    "src/mbgl/tile/raster_image_cache.cpp",
+    "src/mbgl/tile/raster_image_cache.hpp",
     "src/mbgl/tile/raster_tile.cpp",
     "src/mbgl/tile/raster_tile.hpp",
     "src/mbgl/tile/raster_tile_worker.cpp",
@@ -536,6 +547,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/event.cpp",
     "src/mbgl/util/filesystem.hpp",
     "src/mbgl/util/font_stack.cpp",
+    "src/mbgl/util/frame_arena.cpp",
+    "src/mbgl/util/frame_arena.hpp",
     "src/mbgl/util/geo.cpp",
     "src/mbgl/util/geojson_impl.cpp",
     "src/mbgl/util/geometry_util.cpp",
@@ -711,6 +724,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/style/expression/assertion.hpp",
     "include/mbgl/style/expression/at.hpp",
     "include/mbgl/style/expression/boolean_operator.hpp",
+    "include/mbgl/style/expression/bytecode.hpp",
     "include/mbgl/style/expression/case.hpp",
     "include/mbgl/style/expression/check_subtype.hpp",
     "include/mbgl/style/expression/coalesce.hpp",
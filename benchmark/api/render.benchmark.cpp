@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 
+#include <mbgl/benchmark/allocation_counter.hpp>
 #include <mbgl/gfx/headless_frontend.hpp>
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/map_observer.hpp>
@@ -14,9 +15,14 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 #include <optional>
+#include <thread>
+#include <vector>
 
 using namespace mbgl;
 
@@ -49,6 +55,58 @@ void prepare_map2(Map& map, std::optional<std::string> json = std::nullopt) {
     map.getStyle().addImage(std::make_unique<style::Image>("test-icon", std::move(image), 1.0f));
 }
 
+// A 100x100 grid of squares covering the viewport, numbered by feature ID and
+// filled depending on their "hover" feature state.
+std::string featureStateGridStyle() {
+    constexpr int gridSize = 100;
+    std::ostringstream features;
+    for (int row = 0; row < gridSize; ++row) {
+        for (int column = 0; column < gridSize; ++column) {
+            const double west = -74.0130 + column * 0.0004;
+            const double south = 40.7120 + row * 0.0003;
+            const double east = west + 0.00035;
+            const double north = south + 0.00025;
+            features << (row || column ? "," : "") << R"({"type":"Feature","id":)" << row * gridSize + column
+                     << R"(,"properties":{},"geometry":{"type":"Polygon","coordinates":[[)" << "[" << west << ","
+                     << south << "],[" << east << "," << south << "],[" << east << "," << north << "],[" << west
+                     << "," << north << "],[" << west << "," << south << "]]]}}";
+        }
+    }
+
+    return R"({"version":8,"sources":{"grid":{"type":"geojson","data":{"type":"FeatureCollection","features":[)" +
+           features.str() +
+           R"(]}}},"layers":[{"id":"grid","type":"fill","source":"grid","paint":{"fill-color":)"
+           R"(["case",["boolean",["feature-state","hover"],false],"#ff0000","#0000ff"]}}]})";
+}
+
+// Counts the partially rendered frames between the end of a camera
+// transition and the first fully loaded frame at its destination.
+class TransitionObserver : public MapObserver {
+public:
+    void onDidFinishRenderingFrame(const RenderFrameStatus& status) override {
+        if (!arrived || loaded) {
+            return;
+        }
+        if (status.mode == RenderMode::Full) {
+            loaded = true;
+        } else {
+            partialFrames++;
+        }
+    }
+
+    bool arrived = false;
+    bool loaded = false;
+    std::size_t partialFrames = 0;
+};
+
+// Counts rendered frames.
+class FrameObserver : public MapObserver {
+public:
+    void onDidFinishRenderingFrame(const RenderFrameStatus&) override { frames++; }
+
+    std::size_t frames = 0;
+};
+
 } // end namespace
 
 static void API_renderStill_reuse_map(::benchmark::State& state) {
@@ -154,9 +212,219 @@ static void API_renderStill_multiple_sources(::benchmark::State& state) {
     }
 }
 
+static void API_renderContinuous_flyTo(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    TransitionObserver observer;
+    Map map{frontend,
+            observer,
+            MapOptions().withMapMode(MapMode::Continuous).withSize(size).withPixelRatio(pixelRatio),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    map.setPrefetchZoomDelta(static_cast<uint8_t>(state.range(0)));
+    prepare(map);
+    while (!map.isFullyLoaded()) {
+        frontend.renderOnce(map);
+    }
+
+    const LatLng destinations[] = {LatLng{41.379800, 2.176810}, LatLng{40.726989, -73.992857}};
+    std::size_t partialFrames = 0;
+    std::size_t flights = 0;
+
+    for (auto _ : state) {
+        observer.arrived = false;
+        observer.loaded = false;
+        observer.partialFrames = 0;
+
+        AnimationOptions animation(Milliseconds(1000));
+        animation.transitionFinishFn = [&] { observer.arrived = true; };
+        map.flyTo(CameraOptions().withCenter(destinations[flights++ % 2]).withZoom(15.0), animation);
+
+        while (!observer.loaded) {
+            frontend.renderOnce(map);
+        }
+        partialFrames += observer.partialFrames;
+    }
+
+    state.counters["partial_frames_after_arrival"] = ::benchmark::Counter(
+        static_cast<double>(partialFrames) / static_cast<double>(flights));
+}
+
+// Heap allocations of a continuous-mode frame after the map has settled,
+// while panning back and forth over loaded tiles.
+static void API_renderContinuous_frame_allocations(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    FrameObserver observer;
+    Map map{frontend,
+            observer,
+            MapOptions().withMapMode(MapMode::Continuous).withSize(size).withPixelRatio(pixelRatio),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    prepare(map);
+    while (!map.isFullyLoaded()) {
+        frontend.renderOnce(map);
+    }
+
+    std::size_t allocations = 0;
+    std::size_t frames = 0;
+    double offset = 1.0;
+
+    for (auto _ : state) {
+        const std::size_t renderedFrames = observer.frames;
+        const std::size_t allocationsBefore = AllocationCounter::getAllocationsCount();
+
+        map.moveBy({offset, 0.0});
+        offset = -offset;
+        while (observer.frames == renderedFrames) {
+            frontend.renderOnce(map);
+        }
+
+        allocations += AllocationCounter::getAllocationsCount() - allocationsBefore;
+        frames += observer.frames - renderedFrames;
+    }
+
+    state.counters["allocations_per_frame"] = ::benchmark::Counter(static_cast<double>(allocations) /
+                                                                   static_cast<double>(frames));
+}
+
+// Hover highlighting: toggles the feature state of the first `state.range(0)`
+// of 10k features, then renders a frame.
+static void API_renderStill_feature_state(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    map.getStyle().loadJSON(featureStateGridStyle());
+    map.jumpTo(CameraOptions().withCenter(LatLng{40.727, -73.993}).withZoom(15.0));
+    frontend.render(map);
+
+    const auto count = state.range(0);
+    bool hover = false;
+    for (auto _ : state) {
+        hover = !hover;
+        for (int64_t i = 0; i < count; ++i) {
+            frontend.getRenderer()->setFeatureState("grid", {}, util::toString(i), FeatureState{{"hover", hover}});
+        }
+        frontend.render(map);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Eight GeoJSON sources of 2000 icons each. Without cross-source collisions,
+// every source is a collision group of its own.
+std::string collisionGroupsStyle() {
+    constexpr int sourceCount = 8;
+    constexpr int gridSize = 45;
+    std::ostringstream sources;
+    std::ostringstream layers;
+    for (int source = 0; source < sourceCount; ++source) {
+        std::ostringstream features;
+        for (int i = 0; i < gridSize * gridSize; ++i) {
+            const double lng = -74.0130 + (i % gridSize) * 0.0009 + source * 0.0001;
+            const double lat = 40.7120 + (i / gridSize) * 0.0007;
+            features << (i ? "," : "") << R"({"type":"Feature","properties":{},"geometry":{"type":"Point","coordinates":[)"
+                     << lng << "," << lat << "]}}";
+        }
+        sources << (source ? "," : "") << R"("points)" << source
+                << R"(":{"type":"geojson","data":{"type":"FeatureCollection","features":[)" << features.str() << "]}}";
+        layers << (source ? "," : "") << R"({"id":"icons)" << source << R"(","type":"symbol","source":"points)"
+               << source << R"(","layout":{"icon-image":"test-icon"}})";
+    }
+    return R"({"version":8,"sources":{)" + sources.str() + R"(},"layers":[)" + layers.str() + "]}";
+}
+
+// Rotates the map by a degree per frame, so that every frame places all the
+// symbols again without laying them out. The argument enables parallel
+// placement.
+static void API_renderStill_placement_collision_groups(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions()
+                .withMapMode(MapMode::Static)
+                .withSize(size)
+                .withPixelRatio(pixelRatio)
+                .withCrossSourceCollisions(false)
+                .withParallelPlacement(state.range(0) != 0),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    map.getStyle().loadJSON(collisionGroupsStyle());
+    auto image = decodeImage(util::read_file("benchmark/fixtures/api/default_marker.png"));
+    map.getStyle().addImage(std::make_unique<style::Image>("test-icon", std::move(image), 1.0f));
+    map.jumpTo(CameraOptions().withCenter(LatLng{40.727, -73.993}).withZoom(15.0));
+    frontend.render(map);
+
+    double bearing = 0.0;
+    for (auto _ : state) {
+        bearing += 1.0;
+        map.jumpTo(CameraOptions().withBearing(bearing));
+        frontend.render(map);
+    }
+
+    state.counters["hardware_threads"] = static_cast<double>(std::thread::hardware_concurrency());
+}
+
+// Frame times of a continuous map rotating by a degree per frame, paced at
+// 60 fps. Placement of the 16k icons is due every few frames. The argument
+// enables asynchronous placement, which moves it out of the frames.
+static void API_renderContinuous_placement_frame_times(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    FrameObserver observer;
+    Map map{frontend,
+            observer,
+            MapOptions()
+                .withMapMode(MapMode::Continuous)
+                .withSize(size)
+                .withPixelRatio(pixelRatio)
+                .withAsyncPlacement(state.range(0) != 0),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    map.getStyle().loadJSON(collisionGroupsStyle());
+    auto image = decodeImage(util::read_file("benchmark/fixtures/api/default_marker.png"));
+    map.getStyle().addImage(std::make_unique<style::Image>("test-icon", std::move(image), 1.0f));
+    map.jumpTo(CameraOptions().withCenter(LatLng{40.727, -73.993}).withZoom(15.0));
+    while (!map.isFullyLoaded()) {
+        frontend.renderOnce(map);
+    }
+
+    std::vector<double> frameTimes;
+    double bearing = 0.0;
+    for (auto _ : state) {
+        const auto frameDeadline = std::chrono::steady_clock::now() + std::chrono::microseconds(16667);
+        const std::size_t renderedFrames = observer.frames;
+
+        bearing += 1.0;
+        map.jumpTo(CameraOptions().withBearing(bearing));
+        while (observer.frames == renderedFrames) {
+            frontend.renderOnce(map);
+        }
+        frameTimes.push_back(frontend.getFrameTime() * 1000.0);
+
+        state.PauseTiming();
+        std::this_thread::sleep_until(frameDeadline);
+        state.ResumeTiming();
+    }
+
+    std::sort(frameTimes.begin(), frameTimes.end());
+    const auto percentile = [&](double p) {
+        return frameTimes[static_cast<std::size_t>(p * static_cast<double>(frameTimes.size() - 1))];
+    };
+    state.counters["frame_ms_p50"] = percentile(0.5);
+    state.counters["frame_ms_p90"] = percentile(0.9);
+    state.counters["frame_ms_p99"] = percentile(0.99);
+    state.counters["frame_ms_max"] = frameTimes.back();
+}
+
 BENCHMARK(API_renderStill_reuse_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_formatted_labels)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_switch_styles)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map_2)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_multiple_sources)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(API_renderStill_placement_collision_groups)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1)->Iterations(50);
+BENCHMARK(API_renderStill_feature_state)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1)->Arg(10000)->Iterations(50);
+BENCHMARK(API_renderContinuous_flyTo)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(4)->Iterations(10);
+BENCHMARK(API_renderContinuous_frame_allocations)->Unit(benchmark::kMillisecond)->Iterations(100);
+BENCHMARK(API_renderContinuous_placement_frame_times)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1)->Iterations(300);
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/style/expression/bytecode.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::style::expression;
+using namespace std::string_literals;
+
+namespace {
+
+// Typical data driven paint and layout expressions
+const std::vector<const char*> expressions{
+    R"(["interpolate", ["linear"], ["number", ["get", "rank"], 0], 0, 1, 10, 4, 20, 12])",
+    R"(["match", ["get", "class"], "motorway", "#e892a2", ["trunk", "primary"], "#fcd6a4", "secondary", "#f7fabf", "#ffffff"])",
+    R"(["case", ["==", ["get", "class"], "motorway"], ["*", ["number", ["get", "rank"], 1], 2], ["has", "name"], 1.5, 1])",
+    R"(["step", ["number", ["get", "rank"], 0], "small", 5, "medium", 10, "large"])",
+};
+
+std::vector<StubGeometryTileFeature> makeFeatures() {
+    const std::vector<std::string> classes{"motorway", "trunk", "primary", "secondary", "residential"};
+    std::vector<StubGeometryTileFeature> features;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        PropertyMap properties{{"class", classes[i % classes.size()]}, {"rank", static_cast<int64_t>(i % 20)}};
+        if (i % 3 == 0) {
+            properties.emplace("name", "Street "s + std::to_string(i));
+        }
+        features.emplace_back(std::move(properties));
+    }
+    return features;
+}
+
+void ExpressionBytecode_Tree(benchmark::State& state) {
+    const auto expression = dsl::createExpression(expressions[static_cast<std::size_t>(state.range(0))]);
+    const auto features = makeFeatures();
+
+    for (auto _ : state) {
+        for (const auto& feature : features) {
+            benchmark::DoNotOptimize(expression->evaluate(EvaluationContext(14.0f, &feature)));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(features.size()));
+}
+
+void ExpressionBytecode_Compiled(benchmark::State& state) {
+    const auto expression = dsl::createExpression(expressions[static_cast<std::size_t>(state.range(0))]);
+    const auto bytecode = Bytecode::compile(*expression);
+    if (!bytecode) {
+        state.SkipWithError("Expression isn't compiled");
+        return;
+    }
+    const auto features = makeFeatures();
+
+    for (auto _ : state) {
+        for (const auto& feature : features) {
+            benchmark::DoNotOptimize(bytecode->evaluate(EvaluationContext(14.0f, &feature)));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(features.size()));
+}
+
+} // namespace
+
+BENCHMARK(ExpressionBytecode_Tree)->DenseRange(0, 3);
+BENCHMARK(ExpressionBytecode_Compiled)->DenseRange(0, 3);
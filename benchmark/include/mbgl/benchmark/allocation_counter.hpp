@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mbgl {
+
+/**
+ * @brief Heap statistics of the benchmark runner.
+ *
+ * The runner's `main()` replaces the global `operator new` and `operator
+ * delete`, including the aligned and `nothrow` forms, with versions that
+ * report here (see `allocate()` and
+ * `deallocate()`), and enables the counter. Take the difference of two
+ * readings to get the allocations made by a section of code. Runners
+ * without the hook, and sanitizer builds, leave the counter disabled and
+ * all readings at zero.
+ */
+class AllocationCounter {
+public:
+    AllocationCounter() = delete;
+
+    static void setEnabled(bool);
+    static bool isEnabled();
+
+    /**
+     * @brief Same as `malloc()`, recording the allocation.
+     */
+    static void* allocate(std::size_t);
+    /**
+     * @brief Same as `allocate()`, with a power of two alignment.
+     */
+    static void* allocate(std::size_t, std::size_t alignment);
+    /**
+     * @brief Same as `free()` for memory returned by `allocate()`.
+     */
+    static void deallocate(void*) noexcept;
+    /**
+     * @brief Frees memory returned by `allocate()` with the same alignment.
+     */
+    static void deallocate(void*, std::size_t alignment) noexcept;
+
+    static std::size_t getAllocationsCount();
+    static std::size_t getAllocatedBytes();
+    static std::size_t getLiveBytes();
+
+    /**
+     * @brief Returns the highest `getLiveBytes()` since the last
+     * `resetPeak()`.
+     */
+    static std::size_t getPeakLiveBytes();
+    static void resetPeak();
+};
+
+} // namespace mbgl
@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/allocation_counter.hpp>
+#include <mbgl/layout/symbol_instance.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+SymbolInstance makeSymbolInstance(float x, float y, std::u16string key) {
+    GeometryCoordinates line;
+    ImageMap imageMap;
+    const ShapedTextOrientations shaping{};
+    style::SymbolLayoutProperties::Evaluated layout;
+    IndexedSubfeature subfeature(0, {}, {}, 0);
+    Anchor anchor(x, y, 0, 0);
+    std::array<float, 2> textOffset{{0.0f, 0.0f}};
+    std::array<float, 2> iconOffset{{0.0f, 0.0f}};
+    std::array<float, 2> variableTextOffset{{0.0f, 0.0f}};
+    std::vector<AnchorOffsetPair> anchorOffsets = {{style::SymbolAnchorType::Left, variableTextOffset}};
+    VariableAnchorOffsetCollection variableAnchorOffsetCollection(std::move(anchorOffsets));
+    style::SymbolPlacementType placementType = style::SymbolPlacementType::Point;
+
+    auto sharedData = std::make_shared<SymbolInstanceSharedData>(std::move(line),
+                                                                 shaping,
+                                                                 std::nullopt,
+                                                                 std::nullopt,
+                                                                 layout,
+                                                                 placementType,
+                                                                 textOffset,
+                                                                 imageMap,
+                                                                 0.0f,
+                                                                 SymbolContent::IconSDF,
+                                                                 false,
+                                                                 false);
+    return SymbolInstance(anchor,
+                          std::move(sharedData),
+                          shaping,
+                          std::nullopt,
+                          std::nullopt,
+                          0,
+                          0,
+                          placementType,
+                          textOffset,
+                          0,
+                          0,
+                          iconOffset,
+                          subfeature,
+                          0,
+                          0,
+                          std::move(key),
+                          0.0f,
+                          0.0f,
+                          0.0f,
+                          variableAnchorOffsetCollection,
+                          false);
+}
+
+std::vector<SymbolInstance> makeSymbolInstances(std::size_t count) {
+    std::vector<SymbolInstance> instances;
+    instances.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto position = static_cast<float>(i % 4096);
+        instances.push_back(makeSymbolInstance(position, position, u"Label " + std::u16string(i % 16, u'x')));
+        instances.back().releaseSharedData();
+    }
+    return instances;
+}
+
+// Memory retained per symbol once layout has released the shared data, the
+// way buckets keep them for placement.
+void SymbolInstance_memory(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::size_t retained = 0;
+
+    for (auto _ : state) {
+        const std::size_t liveBytes = AllocationCounter::getLiveBytes();
+        auto instances = makeSymbolInstances(count);
+        retained = AllocationCounter::getLiveBytes() - liveBytes;
+        benchmark::DoNotOptimize(instances.data());
+    }
+
+    state.counters["sizeof"] = static_cast<double>(sizeof(SymbolInstance));
+    if (AllocationCounter::isEnabled()) {
+        state.counters["bytes_per_symbol"] = static_cast<double>(retained) / static_cast<double>(count);
+    }
+}
+
+// The fields that placement reads for every symbol of a bucket.
+void SymbolInstance_placementScan(benchmark::State& state) {
+    auto instances = makeSymbolInstances(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        instances[i].setCrossTileID(static_cast<uint32_t>(i + 1));
+        instances[i].setPlacedCenterTextIndex(i);
+    }
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (const auto& instance : instances) {
+            if (instance.getCrossTileID() == SymbolInstance::invalidCrossTileID) continue;
+            if (instance.hasText() || instance.hasIcon()) {
+                sum += instance.getAnchor().point.x * instance.getTextBoxScale();
+            }
+            if (const auto index = instance.getDefaultHorizontalPlacedTextIndex()) {
+                sum += static_cast<float>(*index);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(SymbolInstance_memory)->Arg(10000);
+BENCHMARK(SymbolInstance_placementScan)->Arg(10000)->Arg(100000);
@@ -5,8 +5,13 @@
 #include <mbgl/style/conversion/filter.hpp>
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/vector_mvt_tile_data.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
 
+#include <memory>
+#include <vector>
+
 using namespace mbgl;
 
 style::Filter parse(const char* expression) {
@@ -30,5 +35,91 @@ static void Parse_EvaluateFilter(benchmark::State& state) {
     }
 }
 
+namespace {
+
+// Filters of a typical street style, in the legacy and the expression syntax,
+// with the source layer they apply to.
+const std::vector<std::pair<const char*, const char*>> tileFilters{
+    {"landcover", R"FILTER(["==", "class", "wood"])FILTER"},
+    {"hillshade", R"FILTER(["all", ["==", "class", "shadow"], ["in", "level", 89, 94]])FILTER"},
+    {"landuse", R"FILTER(["in", "class", "park", "cemetery", "hospital", "school", "pitch"])FILTER"},
+    {"landuse_overlay", R"FILTER(["==", "class", "wetland"])FILTER"},
+    {"contour", R"FILTER(["all", ["==", "index", 5], [">", "ele", 0]])FILTER"},
+    {"road",
+     R"FILTER(["all", ["==", "$type", "LineString"], ["!in", "structure", "bridge", "tunnel"],
+                       ["in", "class", "motorway", "trunk", "primary"], ["!=", "oneway", 1]])FILTER"},
+    {"road",
+     R"FILTER(["all", ["==", ["geometry-type"], "LineString"],
+                       ["match", ["get", "class"], ["street", "street_limited", "service"], true, false],
+                       ["!=", ["get", "structure"], "tunnel"]])FILTER"},
+    {"admin", R"FILTER(["all", [">=", "admin_level", 3], ["==", "maritime", 0], ["!has", "disputed"]])FILTER"},
+    {"place_label",
+     R"FILTER(["all", ["in", "type", "town", "village", "hamlet"], ["<=", "localrank", 3], ["has", "name_en"]])FILTER"},
+    {"place_label", R"FILTER(["all", ["==", ["get", "type"], "city"], ["<=", ["get", "scalerank"], 3]])FILTER"},
+    {"poi_label", R"FILTER(["all", ["==", "$type", "Point"], ["<=", "localrank", 2], ["has", "name"]])FILTER"},
+    {"road_label", R"FILTER(["all", ["!=", "class", "ferry"], ["<=", "reflen", 6]])FILTER"},
+};
+
+struct FilteredLayer {
+    style::Filter filter;
+    std::unique_ptr<GeometryTileLayer> layer;
+    std::vector<std::unique_ptr<GeometryTileFeature>> features;
+};
+
+std::vector<FilteredLayer> loadFilteredLayers(const GeometryTileData& tile) {
+    std::vector<FilteredLayer> layers;
+    for (const auto& [sourceLayer, filter] : tileFilters) {
+        FilteredLayer filtered{parse(filter), tile.getLayer(sourceLayer), {}};
+        if (!filtered.layer) continue;
+        for (std::size_t i = 0; i < filtered.layer->featureCount(); ++i) {
+            filtered.features.push_back(filtered.layer->getFeature(i));
+        }
+        layers.push_back(std::move(filtered));
+    }
+    return layers;
+}
+
+template <typename Evaluate>
+void evaluateTileFilters(benchmark::State& state, Evaluate&& evaluate) {
+    const VectorMVTTileData tile(
+        std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    const auto layers = loadFilteredLayers(tile);
+
+    std::size_t features = 0;
+    for (auto _ : state) {
+        std::size_t matched = 0;
+        features = 0;
+        for (const auto& layer : layers) {
+            for (const auto& feature : layer.features) {
+                const auto context = style::expression::EvaluationContext(10.0f, feature.get());
+                matched += evaluate(layer.filter, context) ? 1 : 0;
+            }
+            features += layer.features.size();
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(features));
+}
+
+} // namespace
+
+// The way tile workers and feature queries filter features
+static void Parse_EvaluateTileFilters(benchmark::State& state) {
+    evaluateTileFilters(state, [](const style::Filter& filter, const style::expression::EvaluationContext& context) {
+        return filter(context);
+    });
+}
+
+// The same filters evaluated by walking the expression tree
+static void Parse_EvaluateTileFiltersTree(benchmark::State& state) {
+    evaluateTileFilters(state, [](const style::Filter& filter, const style::expression::EvaluationContext& context) {
+        const auto result = (*filter.expression)->evaluate(context);
+        return result && result->is<bool>() && result->get<bool>();
+    });
+}
+
 BENCHMARK(Parse_Filter);
 BENCHMARK(Parse_EvaluateFilter);
+BENCHMARK(Parse_EvaluateTileFilters);
+BENCHMARK(Parse_EvaluateTileFiltersTree);
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/tile/raster_image_cache.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+// The tiles of four zoom levels past the maximum zoom of a raster source all
+// load the data of the same tile.
+constexpr int overscaledTiles = 4;
+
+void RasterTile_decode(benchmark::State& state) {
+    const auto data = std::make_shared<const std::string>(util::read_file("test/fixtures/image/tile.png"));
+
+    for (auto _ : state) {
+        for (int i = 0; i < overscaledTiles; ++i) {
+            benchmark::DoNotOptimize(decodeImage(*data));
+        }
+    }
+}
+
+void RasterTile_decodeCached(benchmark::State& state) {
+    const auto data = std::make_shared<const std::string>(util::read_file("test/fixtures/image/tile.png"));
+
+    for (auto _ : state) {
+        RasterImageCache cache(util::DEFAULT_RASTER_IMAGE_CACHE_SIZE);
+        for (int i = 0; i < overscaledTiles; ++i) {
+            // Each response has its own copy of the data
+            benchmark::DoNotOptimize(cache.decode(std::make_shared<const std::string>(*data)));
+        }
+    }
+}
+
+} // namespace
+
+BENCHMARK(RasterTile_decode);
+BENCHMARK(RasterTile_decodeCached);
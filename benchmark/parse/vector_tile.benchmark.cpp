@@ -1,30 +1,54 @@
 #include <benchmark/benchmark.h>
 
 #include <mbgl/tile/vector_mvt_tile_data.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/io.hpp>
 
 using namespace mbgl;
 
+namespace {
+
+std::size_t readAllFeatures(const VectorMVTTileData& tile) {
+    std::size_t length = 0;
+    for (const auto& name : tile.layerNames()) {
+        if (auto layer = tile.getLayer(name)) {
+            const std::size_t count = layer->featureCount();
+            for (std::size_t i = 0; i < count; i++) {
+                if (auto feature = layer->getFeature(i)) {
+                    length += feature->getGeometries().size();
+                    length += feature->getProperties().size();
+                }
+            }
+        }
+    }
+    return length;
+}
+
+} // namespace
+
 static void Parse_VectorTile(benchmark::State& state) {
     auto data = std::make_shared<std::string>(
         util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
 
     while (state.KeepRunning()) {
-        std::size_t length = 0;
         VectorMVTTileData tile(data);
-        for (const auto& name : tile.layerNames()) {
-            if (auto layer = tile.getLayer(name)) {
-                const std::size_t count = layer->featureCount();
-                for (std::size_t i = 0; i < count; i++) {
-                    if (auto feature = layer->getFeature(i)) {
-                        length += feature->getGeometries().size();
-                        length += feature->getProperties().size();
-                    }
-                }
-            }
-        }
-        (void)length;
+        benchmark::DoNotOptimize(readAllFeatures(tile));
+    }
+}
+
+// A gzipped tile as stored in MBTiles and PMTiles archives, from the
+// compressed bytes to the features.
+static void Parse_CompressedVectorTile(benchmark::State& state) {
+    const std::string compressed = util::compress(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"), util::GZIP);
+
+    while (state.KeepRunning()) {
+        VectorMVTTileData tile(std::make_shared<std::string>(util::decompress(compressed)));
+        benchmark::DoNotOptimize(readAllFeatures(tile));
     }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(compressed.size()));
 }
 
 BENCHMARK(Parse_VectorTile);
+BENCHMARK(Parse_CompressedVectorTile);
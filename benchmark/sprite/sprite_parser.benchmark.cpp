@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/allocation_counter.hpp>
+#include <mbgl/sprite/sprite_parser.hpp>
+#include <mbgl/style/image_impl.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mbgl;
+using namespace std::literals::string_literals;
+
+namespace {
+
+struct SpriteFixture {
+    std::string id;
+    std::string image;
+    std::string json;
+};
+
+// A style with several sprites, of different sizes and pixel ratios
+std::vector<SpriteFixture> loadSprites() {
+    std::vector<SpriteFixture> sprites;
+    for (const auto& [id, path] : std::initializer_list<std::pair<const char*, const char*>>{
+             {"default", "test/fixtures/resources/sprite"},
+             {"versatiles", "test/fixtures/resources/versatiles-sprite/sprite"},
+             {"versatiles@2x", "test/fixtures/resources/versatiles-sprite/sprite@2x"},
+             {"emerald", "test/fixtures/annotations/emerald@2x"}}) {
+        sprites.push_back({id, util::read_file(path + ".png"s), util::read_file(path + ".json"s)});
+    }
+    return sprites;
+}
+
+// Parsing the sprites of a style, then using every `range(0)`th image.
+void SpriteParser_load(benchmark::State& state) {
+    const auto sprites = loadSprites();
+    const auto stride = static_cast<std::size_t>(state.range(0));
+    std::size_t peakBytes = 0;
+
+    const std::size_t allocatedBytes = AllocationCounter::getAllocatedBytes();
+    for (auto _ : state) {
+        const std::size_t liveBytes = AllocationCounter::getLiveBytes();
+        AllocationCounter::resetPeak();
+        {
+            std::vector<std::vector<Immutable<style::Image::Impl>>> styleImages;
+            for (const auto& sprite : sprites) {
+                auto& images = styleImages.emplace_back(parseSprite(sprite.id, sprite.image, sprite.json));
+                for (std::size_t i = 0; i < images.size(); i += stride) {
+                    benchmark::DoNotOptimize(images[i]->getImage().data.get());
+                }
+            }
+        }
+        peakBytes = std::max(peakBytes, AllocationCounter::getPeakLiveBytes() - liveBytes);
+    }
+
+    // Heap used while the images of all the sprites are held, and allocated
+    // for each load of the style
+    if (AllocationCounter::isEnabled()) {
+        state.counters["peak_bytes"] = static_cast<double>(peakBytes);
+        state.counters["allocated_bytes"] = static_cast<double>(AllocationCounter::getAllocatedBytes() -
+                                                                allocatedBytes) /
+                                            static_cast<double>(state.iterations());
+    }
+}
+
+} // namespace
+
+BENCHMARK(SpriteParser_load)->Arg(1)->Arg(10);
@@ -0,0 +1,119 @@
+#include <mbgl/benchmark/allocation_counter.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace mbgl {
+
+namespace {
+
+std::atomic_bool enabled{false};
+std::atomic_size_t allocationsCount{0};
+std::atomic_size_t allocatedBytes{0};
+std::atomic_size_t liveBytes{0};
+std::atomic_size_t peakLiveBytes{0};
+
+// Every block is prefixed with its size so that `deallocate()` can account
+// for it without a lookup. The prefix keeps the alignment of `malloc()`.
+constexpr std::size_t headerSize = alignof(std::max_align_t);
+
+// Blocks with a stricter alignment are over-allocated, the size and the start
+// of the block are stored right before the aligned address.
+constexpr std::size_t alignedHeaderSize = sizeof(std::size_t) + sizeof(void*);
+
+void updatePeak(std::size_t live) {
+    std::size_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void record(std::size_t size) {
+    allocationsCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    updatePeak(liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+}
+
+} // namespace
+
+// static
+void AllocationCounter::setEnabled(bool enabled_) {
+    enabled = enabled_;
+}
+
+// static
+bool AllocationCounter::isEnabled() {
+    return enabled;
+}
+
+// static
+void* AllocationCounter::allocate(std::size_t size) {
+    auto* block = static_cast<std::byte*>(std::malloc(headerSize + size));
+    if (!block) return nullptr;
+
+    *reinterpret_cast<std::size_t*>(block) = size;
+    record(size);
+    return block + headerSize;
+}
+
+// static
+void* AllocationCounter::allocate(std::size_t size, std::size_t alignment) {
+    if (alignment <= headerSize) return allocate(size);
+
+    auto* block = static_cast<std::byte*>(std::malloc(alignedHeaderSize + alignment + size));
+    if (!block) return nullptr;
+
+    const auto start = reinterpret_cast<std::uintptr_t>(block);
+    auto* aligned = block + (((start + alignedHeaderSize + alignment - 1) & ~(alignment - 1)) - start);
+    reinterpret_cast<std::size_t*>(aligned)[-1] = size;
+    reinterpret_cast<std::byte**>(aligned - sizeof(std::size_t))[-1] = block;
+    record(size);
+    return aligned;
+}
+
+// static
+void AllocationCounter::deallocate(void* ptr) noexcept {
+    if (!ptr) return;
+
+    auto* block = static_cast<std::byte*>(ptr) - headerSize;
+    liveBytes.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+// static
+void AllocationCounter::deallocate(void* ptr, std::size_t alignment) noexcept {
+    if (alignment <= headerSize) return deallocate(ptr);
+    if (!ptr) return;
+
+    auto* aligned = static_cast<std::byte*>(ptr);
+    liveBytes.fetch_sub(reinterpret_cast<std::size_t*>(aligned)[-1], std::memory_order_relaxed);
+    std::free(reinterpret_cast<std::byte**>(aligned - sizeof(std::size_t))[-1]);
+}
+
+// static
+std::size_t AllocationCounter::getAllocationsCount() {
+    return allocationsCount.load(std::memory_order_relaxed);
+}
+
+// static
+std::size_t AllocationCounter::getAllocatedBytes() {
+    return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+// static
+std::size_t AllocationCounter::getLiveBytes() {
+    return liveBytes.load(std::memory_order_relaxed);
+}
+
+// static
+std::size_t AllocationCounter::getPeakLiveBytes() {
+    return peakLiveBytes.load(std::memory_order_relaxed);
+}
+
+// static
+void AllocationCounter::resetPeak() {
+    peakLiveBytes = liveBytes.load(std::memory_order_relaxed);
+}
+
+} // namespace mbgl
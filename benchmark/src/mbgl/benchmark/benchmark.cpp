@@ -1,12 +1,55 @@
 #include <mbgl/benchmark.hpp>
+#include <mbgl/benchmark/allocation_counter.hpp>
 
 #include <benchmark/benchmark.h>
 
 namespace mbgl {
 
+namespace {
+
+// Reports heap usage for every benchmark: the runner repeats each benchmark
+// for a few iterations between Start() and Stop(), and publishes the result
+// as allocs_per_iter, max_bytes_used, total_allocated_bytes and
+// net_heap_growth.
+class AllocationMemoryManager : public ::benchmark::MemoryManager {
+public:
+    // The library only calls the reference overload of Stop(), the pointer
+    // one is kept visible so that it isn't hidden.
+    using ::benchmark::MemoryManager::Stop;
+
+    void Start() override {
+        allocations = AllocationCounter::getAllocationsCount();
+        allocatedBytes = AllocationCounter::getAllocatedBytes();
+        liveBytes = AllocationCounter::getLiveBytes();
+        AllocationCounter::resetPeak();
+    }
+
+    void Stop(Result& result) override {
+        result.num_allocs = static_cast<int64_t>(AllocationCounter::getAllocationsCount() - allocations);
+        result.total_allocated_bytes = static_cast<int64_t>(AllocationCounter::getAllocatedBytes() - allocatedBytes);
+        result.net_heap_growth = static_cast<int64_t>(AllocationCounter::getLiveBytes()) -
+                                 static_cast<int64_t>(liveBytes);
+        result.max_bytes_used = static_cast<int64_t>(AllocationCounter::getPeakLiveBytes() - liveBytes);
+    }
+
+private:
+    std::size_t allocations = 0;
+    std::size_t allocatedBytes = 0;
+    std::size_t liveBytes = 0;
+};
+
+} // namespace
+
 int runBenchmark(int argc, char* argv[]) {
     ::benchmark::Initialize(&argc, argv);
+
+    AllocationMemoryManager memoryManager;
+    if (AllocationCounter::isEnabled()) {
+        ::benchmark::RegisterMemoryManager(&memoryManager);
+    }
+
     ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::RegisterMemoryManager(nullptr);
     return 0;
 }
 
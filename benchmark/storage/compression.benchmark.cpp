@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/compression.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Codec {
+    Zlib,
+    Zstd,
+};
+
+// Uncompressed contents of every tile and resource in the cache fixture, i.e.
+// a realistic mix of vector tiles, styles, sprites and glyphs.
+const std::vector<std::string>& cachedData() {
+    static const std::vector<std::string> data = [] {
+        std::vector<std::string> result;
+        auto db = mapbox::sqlite::Database::open("benchmark/fixtures/api/cache.db", mapbox::sqlite::ReadOnly);
+        mapbox::sqlite::Statement statement{
+            db,
+            "SELECT data, compressed FROM tiles WHERE data IS NOT NULL "
+            "UNION ALL "
+            "SELECT data, compressed FROM resources WHERE data IS NOT NULL"};
+        mapbox::sqlite::Query query{statement};
+        while (query.run()) {
+            auto blob = query.get<std::string>(0);
+            result.push_back(query.get<bool>(1) ? mbgl::util::decompress(blob) : std::move(blob));
+        }
+        return result;
+    }();
+    return data;
+}
+
+std::string compress(Codec codec, const std::string& raw) {
+    return codec == Codec::Zstd ? mbgl::util::compress_zstd(raw) : mbgl::util::compress(raw);
+}
+
+std::string decompress(Codec codec, const std::string& compressed) {
+    return codec == Codec::Zstd ? mbgl::util::decompress_zstd(compressed) : mbgl::util::decompress(compressed);
+}
+
+// Decodes the whole fixture once per iteration, as the offline database does
+// when the entries are read back, and reports the compression ratio.
+void Compression_Decode(benchmark::State& state, Codec codec) {
+    if (codec == Codec::Zstd && !mbgl::util::zstd_supported()) {
+        state.SkipWithError("built without zstd support");
+        return;
+    }
+
+    std::vector<std::string> compressed;
+    size_t rawSize = 0;
+    size_t compressedSize = 0;
+    for (const auto& raw : cachedData()) {
+        compressed.push_back(compress(codec, raw));
+        rawSize += raw.size();
+        compressedSize += compressed.back().size();
+    }
+
+    for (auto _ : state) {
+        for (const auto& entry : compressed) {
+            benchmark::DoNotOptimize(decompress(codec, entry));
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * rawSize));
+    state.counters["ratio"] = static_cast<double>(rawSize) / static_cast<double>(compressedSize);
+    state.counters["compressed_bytes"] = static_cast<double>(compressedSize);
+}
+
+void Compression_Encode(benchmark::State& state, Codec codec) {
+    if (codec == Codec::Zstd && !mbgl::util::zstd_supported()) {
+        state.SkipWithError("built without zstd support");
+        return;
+    }
+
+    size_t rawSize = 0;
+    for (const auto& raw : cachedData()) {
+        rawSize += raw.size();
+    }
+
+    for (auto _ : state) {
+        for (const auto& raw : cachedData()) {
+            benchmark::DoNotOptimize(compress(codec, raw));
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * rawSize));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(Compression_Decode, Zlib, Codec::Zlib)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(Compression_Decode, Zstd, Codec::Zstd)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(Compression_Encode, Zlib, Codec::Zlib)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(Compression_Encode, Zstd, Codec::Zstd)->Unit(benchmark::kMicrosecond);
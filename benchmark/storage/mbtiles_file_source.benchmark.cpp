@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr uint8_t zoom = 14;
+// Tiles along each side of the generated file
+constexpr int32_t span = 64;
+
+// The file to read, `MLN_BENCHMARK_MBTILES` can point to a large z14 extract.
+// Otherwise a file with span^2 tiles of 16 KiB is generated.
+std::string benchmarkFile() {
+    if (const char* path = std::getenv("MLN_BENCHMARK_MBTILES")) {
+        return path;
+    }
+
+    static const std::string path = [] {
+        const auto file = (std::filesystem::temp_directory_path() / "mbgl-benchmark.mbtiles").string();
+        std::filesystem::remove(file);
+        auto db = mapbox::sqlite::Database::open(file, mapbox::sqlite::ReadWriteCreate);
+        db.exec(
+            "CREATE TABLE metadata (name TEXT, value TEXT);"
+            "CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB);"
+            "CREATE UNIQUE INDEX tile_index ON tiles (zoom_level, tile_column, tile_row);");
+
+        std::mt19937 gen(0);
+        std::string data(16 * 1024, '\0');
+        mapbox::sqlite::Transaction transaction(db);
+        mapbox::sqlite::Statement insert(db, "INSERT INTO tiles VALUES (?1, ?2, ?3, ?4)");
+        for (int32_t x = 0; x < span; ++x) {
+            for (int32_t y = 0; y < span; ++y) {
+                for (auto& byte : data) {
+                    byte = static_cast<char>(gen());
+                }
+                mapbox::sqlite::Query query{insert};
+                query.bind(1, zoom);
+                query.bind(2, x);
+                query.bind(3, y);
+                query.bindBlob(4, data.data(), data.size());
+                query.run();
+            }
+        }
+        transaction.commit();
+        return file;
+    }();
+    return path;
+}
+
+// Reads random tiles with `range(0)` requests in flight.
+void MBTilesFileSource_RandomTiles(benchmark::State& state) {
+    util::RunLoop loop;
+    MBTilesFileSource fileSource(ResourceOptions::Default(), ClientOptions());
+    const std::string url = "mbtiles://" + benchmarkFile() + "?file={z}/{x}/{y}.pbf";
+    const auto inFlight = static_cast<std::size_t>(state.range(0));
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int32_t> dis(0, span - 1);
+    int64_t bytes = 0;
+
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<AsyncRequest>> requests;
+        std::size_t pending = inFlight;
+        for (std::size_t i = 0; i < inFlight; ++i) {
+            requests.push_back(fileSource.request(
+                Resource::tile(url, 1.0, dis(gen), dis(gen), zoom, Tileset::Scheme::XYZ), [&](const Response& res) {
+                    bytes += res.data ? static_cast<int64_t>(res.data->size()) : 0;
+                    if (--pending == 0) {
+                        loop.stop();
+                    }
+                }));
+        }
+        loop.run();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(bytes);
+}
+
+} // namespace
+
+BENCHMARK(MBTilesFileSource_RandomTiles)->Arg(1)->Arg(64)->UseRealTime();
@@ -1,12 +1,17 @@
 #include <benchmark/benchmark.h>
 
+#include <mbgl/benchmark/allocation_counter.hpp>
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <list>
 #include <random>
 
 class OfflineDatabase : public benchmark::Fixture {
@@ -128,11 +133,47 @@ BENCHMARK_F(OfflineDatabase, GetTile)(benchmark::State& state) {
     std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(0, tileCount - 1);
 
+    const std::size_t allocatedBytes = AllocationCounter::getAllocatedBytes();
     while (state.KeepRunning()) {
         auto res = db.get(
             Resource::tile("mapbox://tile_ambient" + util::toString(dis(gen)), 1, 0, 0, 0, Tileset::Scheme::XYZ));
         assert(res != std::nullopt);
     }
+
+    // Bytes allocated for each tile, relative to its size
+    if (AllocationCounter::isEnabled()) {
+        state.counters["allocated_per_tile_byte"] = static_cast<double>(AllocationCounter::getAllocatedBytes() -
+                                                                        allocatedBytes) /
+                                                    static_cast<double>(state.iterations() * response.data->size());
+    }
+}
+
+// A tile that is stored without compression
+BENCHMARK_F(OfflineDatabase, GetIncompressibleTile)(benchmark::State& state) {
+    using namespace mbgl;
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<> dis(0, 255);
+    Response incompressible = response;
+    auto data = std::make_shared<std::string>(50 * 1024, 0);
+    for (auto& byte : *data) {
+        byte = static_cast<char>(dis(gen));
+    }
+    incompressible.data = data;
+    const Resource resource = Resource::tile("mapbox://tile_incompressible", 1, 0, 0, 0, Tileset::Scheme::XYZ);
+    db.put(resource, incompressible);
+
+    const std::size_t allocatedBytes = AllocationCounter::getAllocatedBytes();
+    while (state.KeepRunning()) {
+        auto res = db.get(resource);
+        assert(res && res->data && res->data->size() == data->size());
+    }
+
+    if (AllocationCounter::isEnabled()) {
+        state.counters["allocated_per_tile_byte"] = static_cast<double>(AllocationCounter::getAllocatedBytes() -
+                                                                        allocatedBytes) /
+                                                    static_cast<double>(state.iterations() * data->size());
+    }
 }
 
 BENCHMARK_F(OfflineDatabase, AddTilesToFullDatabase)(benchmark::State& state) {
@@ -200,3 +241,179 @@ BENCHMARK_F(OfflineDatabase, ResizeDatabase)(benchmark::State& state) {
         }
     }
 }
+
+// Opens a database holding `state.range(0)` offline region tiles and writes
+// one ambient tile, which is when the ambient cache size gets looked up. The
+// time should not depend on the amount of offline data.
+static void OfflineDatabase_FirstAmbientWrite(benchmark::State& state) {
+    using namespace mbgl;
+
+    const std::string path = "benchmark/fixtures/offline_database_init.db";
+    util::deleteFile(path);
+
+    Response response;
+    response.data = std::make_shared<std::string>(1024, 0);
+
+    {
+        mbgl::OfflineDatabase db(path, TileServerOptions::DefaultConfiguration());
+        db.setOfflineMapboxTileCountLimit(std::numeric_limits<uint64_t>::max());
+
+        OfflineTilePyramidRegionDefinition definition{
+            "mapbox://style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0, true};
+        auto region = db.createRegion(definition, OfflineRegionMetadata());
+
+        std::list<std::tuple<Resource, Response>> resources;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            resources.emplace_back(
+                Resource::tile("mapbox://tile_offline_region" + util::toString(i), 1, 0, 0, 0, Tileset::Scheme::XYZ),
+                response);
+        }
+        OfflineRegionStatus status;
+        db.putRegionResources(region->getID(), resources, status);
+    }
+
+    while (state.KeepRunning()) {
+        mbgl::OfflineDatabase db(path, TileServerOptions::DefaultConfiguration());
+        db.put(Resource::tile("mapbox://tile_ambient" + util::toString(state.iterations()),
+                              1,
+                              0,
+                              0,
+                              0,
+                              Tileset::Scheme::XYZ),
+               response);
+    }
+
+    util::deleteFile(path);
+}
+
+BENCHMARK(OfflineDatabase_FirstAmbientWrite)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+namespace {
+
+// Writes a database with one region of `count` tiles, a quarter of them
+// identical, and exports the region as an archive.
+void writeRegionFiles(int64_t count, const std::string& databasePath, const std::string& archivePath) {
+    using namespace mbgl;
+
+    util::deleteFile(databasePath);
+    util::deleteFile(archivePath);
+
+    mbgl::OfflineDatabase db(databasePath, TileServerOptions::DefaultConfiguration());
+    OfflineTilePyramidRegionDefinition definition{
+        "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0, true};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+
+    std::mt19937 random;
+    std::string tile(4 * 1024, 0);
+    std::list<std::tuple<Resource, Response>> resources;
+    for (int64_t i = 0; i < count; ++i) {
+        Response response;
+        if (i % 4) {
+            std::generate(tile.begin(), tile.end(), [&] { return static_cast<char>(random()); });
+        }
+        response.data = std::make_shared<std::string>(i % 4 ? tile : std::string(tile.size(), 'x'));
+        resources.emplace_back(
+            Resource::tile("http://example.com/", 1, static_cast<int32_t>(i), 0, 14, Tileset::Scheme::XYZ),
+            std::move(response));
+    }
+    OfflineRegionStatus status;
+    db.putRegionResources(region->getID(), resources, status);
+    db.exportRegion(region->getID(), archivePath);
+}
+
+} // namespace
+
+// The two ways of adding a region of `state.range(0)` tiles that was
+// downloaded elsewhere: merging its database, and importing its archive.
+static void OfflineDatabase_MergeDatabase(benchmark::State& state) {
+    using namespace mbgl;
+
+    const std::string path = "benchmark/fixtures/offline_database_side.db";
+    writeRegionFiles(state.range(0), path, "benchmark/fixtures/offline_database_side.archive");
+
+    for (auto _ : state) {
+        mbgl::OfflineDatabase db(":memory:", TileServerOptions::DefaultConfiguration());
+        if (!db.mergeDatabase(path)) {
+            state.SkipWithError("Merge failed");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    util::deleteFile(path);
+    util::deleteFile("benchmark/fixtures/offline_database_side.archive");
+}
+
+static void OfflineDatabase_ImportRegion(benchmark::State& state) {
+    using namespace mbgl;
+
+    const std::string path = "benchmark/fixtures/offline_database_side.archive";
+    writeRegionFiles(state.range(0), "benchmark/fixtures/offline_database_side.db", path);
+
+    for (auto _ : state) {
+        mbgl::OfflineDatabase db(":memory:", TileServerOptions::DefaultConfiguration());
+        if (!db.importRegion(path)) {
+            state.SkipWithError("Import failed");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    util::deleteFile(path);
+    util::deleteFile("benchmark/fixtures/offline_database_side.db");
+}
+
+BENCHMARK(OfflineDatabase_MergeDatabase)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(OfflineDatabase_ImportRegion)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// Stores a region of 2000 tiles, `state.range(0)` percent of which are
+// identical like ocean tiles, and reports the size of the database.
+static void OfflineDatabase_StoreRegion(benchmark::State& state) {
+    using namespace mbgl;
+
+    const std::string path = "benchmark/fixtures/offline_database_store.db";
+    const int64_t count = 2000;
+    int64_t databaseSize = 0;
+
+    std::mt19937 random;
+    std::list<std::tuple<Resource, Response>> resources;
+    for (int64_t i = 0; i < count; ++i) {
+        std::string tile(4 * 1024, 'x');
+        if (i * 100 >= count * state.range(0)) {
+            std::generate(tile.begin(), tile.end(), [&] { return static_cast<char>(random()); });
+        }
+        Response response;
+        response.data = std::make_shared<std::string>(std::move(tile));
+        resources.emplace_back(
+            Resource::tile("http://example.com/", 1, static_cast<int32_t>(i), 0, 14, Tileset::Scheme::XYZ),
+            std::move(response));
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        util::deleteFile(path);
+        mbgl::OfflineDatabase db(path, TileServerOptions::DefaultConfiguration());
+        OfflineTilePyramidRegionDefinition definition{
+            "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0, true};
+        auto region = db.createRegion(definition, OfflineRegionMetadata());
+        state.ResumeTiming();
+
+        OfflineRegionStatus status;
+        db.putRegionResources(region->getID(), resources, status);
+    }
+
+    {
+        auto db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
+        mapbox::sqlite::Statement statement{
+            db, "SELECT page_count * page_size FROM pragma_page_count(), pragma_page_size()"};
+        mapbox::sqlite::Query query{statement};
+        query.run();
+        databaseSize = query.get<int64_t>(0);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["database_bytes"] = static_cast<double>(databaseSize);
+    util::deleteFile(path);
+}
+
+BENCHMARK(OfflineDatabase_StoreRegion)->Arg(0)->Arg(50)->Arg(90)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/http_file_source.hpp>
+#include <mbgl/storage/offline.hpp>
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/offline_download.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/util/client_options.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <httplib.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace mbgl;
+
+namespace {
+
+// Serves a style with a single vector source and the same tile for every
+// coordinate, as a local stand-in for a tile server.
+class TileServer {
+public:
+    TileServer()
+        : tile(16 * 1024, 'x') {
+        server.Get("/style.json", [this](const httplib::Request&, httplib::Response& res) {
+            res.set_content(R"({"version": 8, "sources": {"tiles": {"type": "vector", "tiles": [")" + url() +
+                                R"(/{z}/{x}/{y}.pbf"]}}, "layers": []})",
+                            "application/json");
+        });
+        server.Get(R"(/(\d+)/(\d+)/(\d+)\.pbf)", [this](const httplib::Request&, httplib::Response& res) {
+            res.set_content(tile, "application/x-protobuf");
+        });
+
+        port = server.bind_to_any_port("127.0.0.1");
+        thread = std::thread([this] { server.listen_after_bind(); });
+    }
+
+    ~TileServer() {
+        server.stop();
+        thread.join();
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + util::toString(port); }
+
+private:
+    const std::string tile;
+    httplib::Server server;
+    int port = 0;
+    std::thread thread;
+};
+
+class Observer : public OfflineRegionObserver {
+public:
+    explicit Observer(util::RunLoop& loop_)
+        : loop(loop_) {}
+
+    void statusChanged(OfflineRegionStatus status) override {
+        if (status.downloadState == OfflineRegionDownloadState::Inactive) {
+            complete = status.complete();
+            loop.stop();
+        }
+    }
+
+    util::RunLoop& loop;
+    bool complete = false;
+};
+
+// Downloads a world region from zoom 0 up to the given zoom level.
+bool download(util::RunLoop& loop,
+              OfflineDatabase& db,
+              FileSource& fileSource,
+              const TileServer& server,
+              int64_t regionID,
+              double maxZoom) {
+    OfflineDownload download(
+        regionID,
+        OfflineTilePyramidRegionDefinition(server.url() + "/style.json", LatLngBounds::world(), 0, maxZoom, 1.0, false),
+        db,
+        fileSource);
+
+    auto observer = std::make_unique<Observer>(loop);
+    auto& result = *observer;
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+    loop.run();
+    return result.complete;
+}
+
+void OfflineDownload_Download(benchmark::State& state) {
+    util::RunLoop loop;
+    TileServer server;
+    HTTPFileSource fileSource(ResourceOptions::Default(), ClientOptions());
+    const auto maxZoom = static_cast<double>(state.range(0));
+    int64_t tiles = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        OfflineDatabase db(":memory:", TileServerOptions::DefaultConfiguration());
+        const auto region = db.createRegion(
+            OfflineTilePyramidRegionDefinition("", LatLngBounds::world(), 0, maxZoom, 1.0, false), {});
+        state.ResumeTiming();
+
+        if (!download(loop, db, fileSource, server, region->getID(), maxZoom)) {
+            state.SkipWithError("Download didn't complete");
+            return;
+        }
+        tiles += static_cast<int64_t>(db.getRegionCompletedStatus(region->getID())->completedTileCount);
+    }
+
+    state.SetItemsProcessed(tiles);
+}
+
+// Downloading a region again only checks that its tiles are stored.
+void OfflineDownload_StoredRegion(benchmark::State& state) {
+    util::RunLoop loop;
+    TileServer server;
+    HTTPFileSource fileSource(ResourceOptions::Default(), ClientOptions());
+    const auto maxZoom = static_cast<double>(state.range(0));
+
+    OfflineDatabase db(":memory:", TileServerOptions::DefaultConfiguration());
+    const auto region = db.createRegion(
+        OfflineTilePyramidRegionDefinition("", LatLngBounds::world(), 0, maxZoom, 1.0, false), {});
+    if (!download(loop, db, fileSource, server, region->getID(), maxZoom)) {
+        state.SkipWithError("Download didn't complete");
+        return;
+    }
+    const auto tiles = static_cast<int64_t>(db.getRegionCompletedStatus(region->getID())->completedTileCount);
+
+    for (auto _ : state) {
+        download(loop, db, fileSource, server, region->getID(), maxZoom);
+    }
+
+    state.SetItemsProcessed(state.iterations() * tiles);
+}
+
+} // namespace
+
+BENCHMARK(OfflineDownload_Download)->Arg(4)->Arg(6)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(OfflineDownload_StoredRegion)->Arg(6)->Arg(7)->Unit(benchmark::kMillisecond)->UseRealTime();
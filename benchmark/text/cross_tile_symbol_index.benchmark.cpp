@@ -0,0 +1,182 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/layout/symbol_instance.hpp>
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/style/variable_anchor_offset_collection.hpp>
+#include <mbgl/text/cross_tile_symbol_index.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+SymbolInstance makeSymbolInstance(float x, float y, std::u16string key) {
+    GeometryCoordinates line;
+    ImageMap imageMap;
+    const ShapedTextOrientations shaping{};
+    style::SymbolLayoutProperties::Evaluated layout;
+    IndexedSubfeature subfeature(0, {}, {}, 0);
+    Anchor anchor(x, y, 0, 0);
+    std::array<float, 2> textOffset{{0.0f, 0.0f}};
+    std::array<float, 2> iconOffset{{0.0f, 0.0f}};
+    std::vector<AnchorOffsetPair> anchorOffsets = {{style::SymbolAnchorType::Center, textOffset}};
+    VariableAnchorOffsetCollection variableAnchorOffsetCollection(std::move(anchorOffsets));
+    style::SymbolPlacementType placementType = style::SymbolPlacementType::Point;
+
+    auto sharedData = std::make_shared<SymbolInstanceSharedData>(std::move(line),
+                                                                 shaping,
+                                                                 std::nullopt,
+                                                                 std::nullopt,
+                                                                 layout,
+                                                                 placementType,
+                                                                 textOffset,
+                                                                 imageMap,
+                                                                 0.0f,
+                                                                 SymbolContent::IconSDF,
+                                                                 false,
+                                                                 false);
+    return SymbolInstance(anchor,
+                          std::move(sharedData),
+                          shaping,
+                          std::nullopt,
+                          std::nullopt,
+                          0,
+                          0,
+                          placementType,
+                          textOffset,
+                          0,
+                          0,
+                          iconOffset,
+                          subfeature,
+                          0,
+                          0,
+                          std::move(key),
+                          0.0f,
+                          0.0f,
+                          0.0f,
+                          variableAnchorOffsetCollection,
+                          false);
+}
+
+std::u16string makeKey(std::u16string prefix, std::size_t number) {
+    for (const char digit : std::to_string(number)) {
+        prefix.push_back(static_cast<char16_t>(digit));
+    }
+    return prefix;
+}
+
+struct Label {
+    // Position in the 2x2 block of tiles at `baseZoom`, in [0, 1)
+    double x;
+    double y;
+    std::u16string key;
+};
+
+struct Step {
+    OverscaledTileID tileID;
+    std::unique_ptr<SymbolBucket> bucket;
+};
+
+constexpr uint8_t baseZoom = 12;
+constexpr uint32_t baseX = 1200;
+constexpr uint32_t baseY = 1500;
+
+// A zoom from `baseZoom` to `baseZoom + 4` through a dense label layer, in the
+// order tiles arrive: every zoom level adds the tiles of a 4x4 viewport around
+// the center, with the labels that fall into them. Town names are mostly
+// unique, street names repeat along their streets.
+std::vector<std::vector<Step>> makeZoomSequence() {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> position(0.0, 1.0);
+    std::vector<Label> labels;
+    for (std::size_t i = 0; i < 8000; ++i) {
+        labels.push_back({position(random), position(random), makeKey(u"Town ", i % 6000)});
+    }
+    for (std::size_t street = 0; street < 200; ++street) {
+        const double y = position(random);
+        const std::u16string key = makeKey(u"Street ", street);
+        for (double x = position(random) * 0.01; x < 1.0; x += 0.005) {
+            labels.push_back({x, y, key});
+        }
+    }
+
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    uint32_t bucketInstanceId = 0;
+
+    std::vector<std::vector<Step>> sequence;
+    for (uint8_t z = baseZoom; z <= baseZoom + 4; ++z) {
+        const uint32_t dimension = 2u << (z - baseZoom);
+        const uint32_t first = dimension > 4 ? dimension / 2 - 2 : 0;
+        const uint32_t last = std::min(dimension, first + 4);
+
+        auto& steps = sequence.emplace_back();
+        for (uint32_t x = first; x < last; ++x) {
+            for (uint32_t y = first; y < last; ++y) {
+                std::vector<SymbolInstance> instances;
+                for (const auto& label : labels) {
+                    const double tileX = label.x * dimension - x;
+                    const double tileY = label.y * dimension - y;
+                    if (tileX >= 0 && tileX < 1 && tileY >= 0 && tileY < 1) {
+                        instances.push_back(makeSymbolInstance(static_cast<float>(tileX * util::EXTENT),
+                                                               static_cast<float>(tileY * util::EXTENT),
+                                                               label.key));
+                    }
+                }
+                auto bucket = std::make_unique<SymbolBucket>(layout,
+                                                             std::map<std::string, Immutable<style::LayerProperties>>{},
+                                                             16.0f,
+                                                             1.0f,
+                                                             0.0f,
+                                                             false,
+                                                             false,
+                                                             "labels",
+                                                             std::move(instances),
+                                                             std::vector<SortKeyRange>{},
+                                                             1.0f,
+                                                             false,
+                                                             std::vector<style::TextWritingModeType>{},
+                                                             false);
+                bucket->bucketInstanceId = ++bucketInstanceId;
+                const uint32_t scale = 1u << (z - baseZoom);
+                steps.push_back({OverscaledTileID(z, 0, z, baseX * scale + x, baseY * scale + y), std::move(bucket)});
+            }
+        }
+    }
+    return sequence;
+}
+
+void CrossTileSymbolIndex_zoomSequence(benchmark::State& state) {
+    const auto sequence = makeZoomSequence();
+
+    for (auto _ : state) {
+        uint32_t maxCrossTileID = 0;
+        CrossTileSymbolLayerIndex index(maxCrossTileID);
+        std::unordered_set<uint32_t> previousIDs;
+        for (const auto& steps : sequence) {
+            // Tiles of the previous zoom are kept while the new ones fade in
+            std::unordered_set<uint32_t> currentIDs;
+            for (const auto& step : steps) {
+                index.addBucket(step.tileID, mat4{}, *step.bucket);
+                currentIDs.insert(step.bucket->bucketInstanceId);
+            }
+            std::unordered_set<uint32_t> retainedIDs = currentIDs;
+            retainedIDs.insert(previousIDs.begin(), previousIDs.end());
+            index.removeStaleBuckets(retainedIDs);
+            previousIDs = std::move(currentIDs);
+        }
+        benchmark::DoNotOptimize(maxCrossTileID);
+    }
+}
+
+} // namespace
+
+BENCHMARK(CrossTileSymbolIndex_zoomSequence)->Unit(benchmark::kMillisecond);
@@ -5,6 +5,8 @@
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/map/transform.hpp>
 
+#include <array>
+
 using namespace mbgl;
 
 static const LatLngBounds sanFrancisco = LatLngBounds::hull({37.6609, -122.5744}, {37.8271, -122.3204});
@@ -32,6 +34,52 @@ static void TileCoverPitchedViewport(benchmark::State& state) {
     benchmark::DoNotOptimize(length);
 }
 
+// A frame of a style with several vector and raster sources. Every source
+// computes its cover; range(0) selects whether the camera pans between frames.
+static const std::array<std::pair<style::SourceType, uint16_t>, 8> frameSources = {{{style::SourceType::Vector, 512},
+                                                                                     {style::SourceType::Vector, 512},
+                                                                                     {style::SourceType::Vector, 512},
+                                                                                     {style::SourceType::Raster, 256},
+                                                                                     {style::SourceType::Raster, 256},
+                                                                                     {style::SourceType::RasterDEM, 512},
+                                                                                     {style::SourceType::Vector, 512},
+                                                                                     {style::SourceType::Raster, 512}}};
+
+template <typename CoverFn>
+static void runFrames(benchmark::State& state, CoverFn&& cover) {
+    Transform transform;
+    transform.resize({1024, 768});
+    transform.jumpTo(CameraOptions().withCenter(LatLng{37.7749, -122.4194}).withZoom(14.3).withPitch(50.0));
+
+    const bool panning = state.range(0);
+    std::size_t length = 0;
+    std::size_t frame = 0;
+    while (state.KeepRunning()) {
+        if (panning) {
+            transform.moveBy({(frame++ % 2) ? 1.0 : -1.0, 0.0});
+        }
+        const util::TileCoverParameters parameters = {transform.getState()};
+        for (const auto& [type, tileSize] : frameSources) {
+            const auto z = static_cast<uint8_t>(util::coveringZoomLevel(transform.getZoom(), type, tileSize));
+            length += cover(parameters, z);
+        }
+    }
+    benchmark::DoNotOptimize(length);
+}
+
+static void TileCoverFrameMultipleSources(benchmark::State& state) {
+    runFrames(state, [](const util::TileCoverParameters& parameters, uint8_t z) {
+        return util::tileCover(parameters, z).size();
+    });
+}
+
+static void TileCoverFrameMultipleSourcesCached(benchmark::State& state) {
+    util::TileCoverCache cache;
+    runFrames(state, [&](const util::TileCoverParameters& parameters, uint8_t z) {
+        return cache.get(parameters, z).size();
+    });
+}
+
 static void TileCoverBounds(benchmark::State& state) {
     std::size_t length = 0;
     while (state.KeepRunning()) {
@@ -78,5 +126,7 @@ static void TileCountPolygon(benchmark::State& state) {
 BENCHMARK(TileCountBounds);
 BENCHMARK(TileCountPolygon);
 BENCHMARK(TileCoverPitchedViewport);
+BENCHMARK(TileCoverFrameMultipleSources)->Arg(0)->Arg(1);
+BENCHMARK(TileCoverFrameMultipleSourcesCached)->Arg(0)->Arg(1);
 BENCHMARK(TileCoverBounds);
 BENCHMARK(TileCoverPolygon);
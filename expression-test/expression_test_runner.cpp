@@ -3,6 +3,8 @@
 #include "expression_test_parser.hpp"
 #include "test_runner_common.hpp"
 
+#include <mbgl/style/expression/bytecode.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/util/io.hpp>
 
 #include <rapidjson/writer.h>
@@ -95,6 +97,62 @@ void writeTestData(const JSDocument& document, const std::string& rootPath, cons
     }
 }
 
+// The compiled expressions read features through the tile interface, none of
+// them needs the geometry.
+class InputFeature : public GeometryTileFeature {
+public:
+    explicit InputFeature(const Feature& feature_)
+        : feature(feature_) {}
+
+    FeatureType getType() const override { return apply_visitor(ToFeatureType(), feature.geometry); }
+    const PropertyMap& getProperties() const override { return feature.properties; }
+    FeatureIdentifier getID() const override { return feature.id; }
+    std::optional<mbgl::Value> getValue(const std::string& key) const override {
+        auto it = feature.properties.find(key);
+        if (it != feature.properties.end()) {
+            return std::optional<mbgl::Value>(it->second);
+        }
+        return std::nullopt;
+    }
+
+private:
+    const Feature& feature;
+};
+
+// Evaluates the compiled form of the expression, if there's one, and compares
+// it with the results of the tree for the inputs it doesn't give up on.
+// Returns the differences, empty when they agree.
+std::string bytecodeDifference(const style::expression::Expression& expression, const TestData& data) {
+    const auto bytecode = style::expression::Bytecode::compile(expression);
+    if (!bytecode) {
+        return {};
+    }
+
+    std::vector<Value> treeOutputs;
+    std::vector<Value> bytecodeOutputs;
+    for (const auto& input : data.inputs) {
+        const InputFeature feature(input.feature);
+        style::expression::EvaluationContext context(input.zoom, &feature, input.heatmapDensity);
+        context.withAvailableImages(&input.availableImages);
+        if (input.canonical) {
+            context.withCanonicalTileID(&*input.canonical);
+        }
+
+        const auto compiled = bytecode->evaluate(context);
+        if (!compiled) {
+            continue;
+        }
+        const auto tree = expression.evaluate(context);
+        treeOutputs.emplace_back(tree ? toValue(*tree).value_or(Value{}) : Value{tree.error().message});
+        bytecodeOutputs.emplace_back(toValue(*compiled).value_or(Value{}));
+    }
+
+    if (deepEqual(Value{treeOutputs}, Value{bytecodeOutputs})) {
+        return {};
+    }
+    return simpleDiff(Value{std::move(bytecodeOutputs)}, Value{std::move(treeOutputs)});
+}
+
 } // namespace
 
 TestRunOutput runExpressionTest(TestData& data, const std::string& rootPath, const std::string& id) {
@@ -131,8 +189,10 @@ TestRunOutput runExpressionTest(TestData& data, const std::string& rootPath, con
     output.expression = toJSON(data.result.expression.value_or(Value{}), 2, true);
 
     // Evaluate expression
+    std::string bytecodeDiff;
     if (parsedExpression) {
         evaluateExpression(parsedExpression, data.result);
+        bytecodeDiff = bytecodeDifference(*parsedExpression, data);
         output.serialized = toJSON(data.result.serialized.value_or(Value{}), 2, true);
 
         // round trip
@@ -163,7 +223,7 @@ TestRunOutput runExpressionTest(TestData& data, const std::string& rootPath, con
         roundTripOk = recompileOk && deepEqual(data.recompiled.outputs, data.expected.outputs);
     }
 
-    output.passed = compileOk && evalOk && recompileOk && roundTripOk && serializationOk;
+    output.passed = compileOk && evalOk && recompileOk && roundTripOk && serializationOk && bytecodeDiff.empty();
 
     if (!compileOk) {
         auto resultValue = toValue(data.result.compiled);
@@ -192,5 +252,9 @@ TestRunOutput runExpressionTest(TestData& data, const std::string& rootPath, con
         output.text += "Roundtripped through serialize expression outputs difference:\n"s + diff + "\n"s;
     }
 
+    if (!bytecodeDiff.empty()) {
+        output.text += "Bytecode outputs difference:\n"s + bytecodeDiff + "\n"s;
+    }
+
     return output;
 }
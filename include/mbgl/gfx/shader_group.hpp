@@ -10,6 +10,9 @@
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -161,6 +164,20 @@ public:
         return {};
     }
 
+    /// Prefix of the names in `propertiesAsUniforms` of data driven properties which are read
+    /// from a feature state texture instead of from vertex attributes.
+    static constexpr std::string_view featureStatePrefix = "feature_state_";
+
+    /// @brief Get the shader defines for the properties which are read from a feature state texture.
+    /// @details Defines `HAS_FEATURE_STATE_TEXTURE` and `FEATURE_STATE_STRIDE`, the number of texels per
+    /// feature, if there are any, and `HAS_FEATURE_STATE_u_<name>` and `FEATURE_STATE_SLOT_u_<name>` for
+    /// each of them that isn't also a uniform. Slots are numbered in the order of the property names, matching
+    /// `PaintPropertyBinders`.
+    /// @param propertiesAsUniforms Set of data driven properties as uniforms.
+    /// @return Pairs of define names and values
+    static std::vector<std::pair<std::string, std::string>> featureStateDefines(
+        const StringIDSetsPair& propertiesAsUniforms);
+
 protected:
     using PropertyHashType = std::uint64_t;
 
@@ -172,7 +189,17 @@ protected:
     PropertyHashType propertyHash(const StringIDSetsPair& propertiesAsUniforms) {
         const auto beg = propertiesAsUniforms.second.cbegin();
         const auto end = propertiesAsUniforms.second.cend();
-        return util::order_independent_hash<decltype(beg), PropertyHashType>(beg, end);
+        const auto hash = util::order_independent_hash<decltype(beg), PropertyHashType>(beg, end);
+
+        // Properties read from a feature state texture share their IDs with the
+        // uniform variant, only the names tell them apart.
+        PropertyHashType featureStateHash = 0;
+        for (const auto name : propertiesAsUniforms.first) {
+            if (name.starts_with(featureStatePrefix)) {
+                featureStateHash ^= std::hash<std::string_view>()(name);
+            }
+        }
+        return hash ^ (featureStateHash * util::factor<PropertyHashType>());
     }
 
 private:
@@ -327,6 +327,11 @@ public:
     /// Clear the collection
     void clear();
 
+    /// Replace the attributes with ones referring to the same shared data as those in another
+    /// array, which may be of another type, e.g., one populated away from the render thread.
+    /// Attributes holding their own items are skipped.
+    void setSharedAttributes(const VertexAttributeArray& other);
+
     /// Do something with each attribute
     template <typename Func /* void(VertexAttribute&) */>
     void visitAttributes(Func f) const {
@@ -428,7 +433,17 @@ protected:
             const auto& attributeName = DataDrivenPaintProperty::AttributeNames[attrIndex];
 
             // Apply the property, or add it to the uniforms collection if it's constant.
-            if (!isConstant && binder->getVertexCount() > 0) {
+            // Properties in the feature state texture are identified by name, and keep their
+            // slot even when they're constant, so that the other slots don't shift.
+            if (binder->featureStateSlot) {
+                if (propertiesAsUniforms) {
+                    propertiesAsUniforms->first.emplace(DataDrivenPaintProperty::Attribute::featureStateName());
+                    if (isConstant) {
+                        propertiesAsUniforms->first.emplace(attributeName);
+                    }
+                    propertiesAsUniforms->second.emplace(dataDrivenAttrId);
+                }
+            } else if (!isConstant && binder->getVertexCount() > 0) {
                 using Attribute = typename DataDrivenPaintProperty::Attribute;
                 if (const auto& attr = set(dataDrivenAttrId)) {
                     applyPaintProperty<Attribute>(attrIndex, attr, binder);
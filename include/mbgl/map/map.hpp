@@ -137,7 +137,8 @@ public:
     /// than 0, the map will first request a tile for `zoom - delta` in a
     /// attempt to display a full map at lower resolution as quick as possible.
     /// It will get clamped at the tile source minimum zoom. The default `delta`
-    /// is 4.
+    /// is 4. When set, tiles along the path of animated camera transitions are
+    /// also requested ahead of time with low priority.
     void setPrefetchZoomDelta(uint8_t delta);
     uint8_t getPrefetchZoomDelta() const;
 
@@ -87,6 +87,43 @@ public:
      */
     bool crossSourceCollisions() const;
 
+    /**
+     * @brief Specify whether symbols of different collision groups are placed
+     * concurrently on the background thread pool. This only has an effect
+     * when cross-source collisions are disabled, and gives the same result as
+     * serial placement. By default, it is set to false.
+     *
+     * @param enable true to enable, false to disable
+     * @return MapOptions for chaining options together.
+     */
+    MapOptions& withParallelPlacement(bool enable);
+
+    /**
+     * @brief Gets the previously set (or default) parallelPlacement value.
+     *
+     * @return true if parallel placement is enabled, false otherwise.
+     */
+    bool parallelPlacement() const;
+
+    /**
+     * @brief Specify whether symbol placement runs on a background thread in
+     * continuous mode. A frame that needs a new placement draws with the
+     * current one, the new placement runs after that frame is rendered and
+     * is shown, with the usual fade, by the next frame. By default, it is
+     * set to false.
+     *
+     * @param enable true to enable, false to disable
+     * @return MapOptions for chaining options together.
+     */
+    MapOptions& withAsyncPlacement(bool enable);
+
+    /**
+     * @brief Gets the previously set (or default) asyncPlacement value.
+     *
+     * @return true if asynchronous placement is enabled, false otherwise.
+     */
+    bool asyncPlacement() const;
+
     /**
      * @brief Sets the orientation of the Map. By default, it is set to
      * Upwards.
@@ -39,25 +39,36 @@ layout (std140) uniform FillEvaluatedPropsUBO {
 };
 
 layout (location = 0) in vec2 a_pos;
+#ifdef HAS_FEATURE_STATE_TEXTURE
+layout (location = 1) in highp float a_feature_ordinal;
+#endif
 
 out vec2 v_pos;
 
 #ifndef HAS_UNIFORM_u_outline_color
-layout (location = 1) in highp vec4 a_outline_color;
+#ifndef HAS_FEATURE_STATE_u_outline_color
+layout (location = 2) in highp vec4 a_outline_color;
+#endif
 out highp vec4 outline_color;
 #endif
 #ifndef HAS_UNIFORM_u_opacity
-layout (location = 2) in lowp vec2 a_opacity;
+#ifndef HAS_FEATURE_STATE_u_opacity
+layout (location = 3) in lowp vec2 a_opacity;
+#endif
 out lowp float opacity;
 #endif
 
 void main() {
-    #ifndef HAS_UNIFORM_u_outline_color
+    #if defined(HAS_FEATURE_STATE_u_outline_color)
+outline_color = unpack_mix_color(feature_state_texel(a_feature_ordinal, FEATURE_STATE_SLOT_u_outline_color), u_outline_color_t);
+#elif !defined(HAS_UNIFORM_u_outline_color)
 outline_color = unpack_mix_color(a_outline_color, u_outline_color_t);
 #else
 highp vec4 outline_color = u_outline_color;
 #endif
-    #ifndef HAS_UNIFORM_u_opacity
+    #if defined(HAS_FEATURE_STATE_u_opacity)
+opacity = unpack_mix_vec2(feature_state_texel(a_feature_ordinal, FEATURE_STATE_SLOT_u_opacity).xy, u_opacity_t);
+#elif !defined(HAS_UNIFORM_u_opacity)
 opacity = unpack_mix_vec2(a_opacity, u_opacity_t);
 #else
 lowp float opacity = u_opacity;
@@ -40,6 +40,9 @@ public:
         std::string additionalDefines;
         additionalDefines.reserve(propertiesAsUniforms.first.size() * 48);
         for (const auto propertyName : propertiesAsUniforms.first) {
+            if (propertyName.starts_with(featureStatePrefix)) {
+                continue;
+            }
             // We expect the names to be prefixed by "a_", but we need just the base here.
             const auto* prefix = propertyName.data();
             if (prefix[0] == 'a' && prefix[1] == '_') {
@@ -50,6 +53,9 @@ public:
             additionalDefines += prefix;
             additionalDefines += "\n";
         }
+        for (const auto& [define, value] : featureStateDefines(propertiesAsUniforms)) {
+            additionalDefines += "#define " + define + " " + value + "\n";
+        }
 
         auto& glContext = static_cast<gl::Context&>(context);
         shader = ShaderProgramGL::create(glContext,
@@ -277,6 +277,7 @@ enum {
 
 enum {
     idFillImageTexture,
+    idFillFeatureStateTexture,
     fillTextureCount
 };
 
@@ -396,6 +397,9 @@ enum {
     idFillPatternFromVertexAttribute,
     idFillPatternToVertexAttribute,
 
+    // Only with a feature state texture
+    idFillFeatureOrdinalVertexAttribute,
+
     fillVertexAttributeCount
 };
 
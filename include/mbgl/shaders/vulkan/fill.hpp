@@ -18,23 +18,34 @@ template <>
 struct ShaderSource<BuiltIn::FillShader, gfx::Backend::Type::Vulkan> {
     static constexpr const char* name = "FillShader";
 
-    static const std::array<AttributeInfo, 3> attributes;
+    static const std::array<AttributeInfo, 4> attributes;
     static constexpr std::array<AttributeInfo, 0> instanceAttributes{};
-    static const std::array<TextureInfo, 0> textures;
+    static const std::array<TextureInfo, 1> textures;
 
     static constexpr auto prelude = fillShaderPrelude;
     static constexpr auto vertex = R"(
 
 layout(location = 0) in ivec2 in_position;
 
-#if !defined(HAS_UNIFORM_u_color)
+#if !defined(HAS_UNIFORM_u_color) && !defined(HAS_FEATURE_STATE_u_color)
 layout(location = 1) in vec4 in_color;
 #endif
 
-#if !defined(HAS_UNIFORM_u_opacity)
+#if !defined(HAS_UNIFORM_u_opacity) && !defined(HAS_FEATURE_STATE_u_opacity)
 layout(location = 2) in vec2 in_opacity;
 #endif
 
+#if defined(HAS_FEATURE_STATE_TEXTURE)
+layout(location = 3) in float in_feature_ordinal;
+layout(set = DRAWABLE_IMAGE_SET_INDEX, binding = 1) uniform sampler2D feature_state_sampler;
+
+vec4 feature_state_texel(const int slot) {
+    const int index = int(in_feature_ordinal) * FEATURE_STATE_STRIDE + slot;
+    const int width = textureSize(feature_state_sampler, 0).x;
+    return texelFetch(feature_state_sampler, ivec2(index % width, index / width), 0);
+}
+#endif
+
 layout(push_constant) uniform Constants {
     int ubo_index;
 } constant;
@@ -64,11 +75,15 @@ layout(location = 1) out lowp float frag_opacity;
 void main() {
     const FillDrawableUBO drawable = drawableVector.drawable_ubo[constant.ubo_index];
 
-#if !defined(HAS_UNIFORM_u_color)
+#if defined(HAS_FEATURE_STATE_u_color)
+    frag_color = vec4(unpack_mix_color(feature_state_texel(FEATURE_STATE_SLOT_u_color), drawable.color_t));
+#elif !defined(HAS_UNIFORM_u_color)
     frag_color = vec4(unpack_mix_color(in_color, drawable.color_t));
 #endif
 
-#if !defined(HAS_UNIFORM_u_opacity)
+#if defined(HAS_FEATURE_STATE_u_opacity)
+    frag_opacity = unpack_mix_float(feature_state_texel(FEATURE_STATE_SLOT_u_opacity).xy, drawable.opacity_t);
+#elif !defined(HAS_UNIFORM_u_opacity)
     frag_opacity = unpack_mix_float(in_opacity, drawable.opacity_t);
 #endif
 
@@ -121,23 +136,34 @@ template <>
 struct ShaderSource<BuiltIn::FillOutlineShader, gfx::Backend::Type::Vulkan> {
     static constexpr const char* name = "FillOutlineShader";
 
-    static const std::array<AttributeInfo, 3> attributes;
+    static const std::array<AttributeInfo, 4> attributes;
     static constexpr std::array<AttributeInfo, 0> instanceAttributes{};
-    static const std::array<TextureInfo, 0> textures;
+    static const std::array<TextureInfo, 1> textures;
 
     static constexpr auto prelude = fillShaderPrelude;
     static constexpr auto vertex = R"(
 
 layout(location = 0) in ivec2 in_position;
 
-#if !defined(HAS_UNIFORM_u_outline_color)
+#if !defined(HAS_UNIFORM_u_outline_color) && !defined(HAS_FEATURE_STATE_u_outline_color)
 layout(location = 1) in vec4 in_color;
 #endif
 
-#if !defined(HAS_UNIFORM_u_opacity)
+#if !defined(HAS_UNIFORM_u_opacity) && !defined(HAS_FEATURE_STATE_u_opacity)
 layout(location = 2) in vec2 in_opacity;
 #endif
 
+#if defined(HAS_FEATURE_STATE_TEXTURE)
+layout(location = 3) in float in_feature_ordinal;
+layout(set = DRAWABLE_IMAGE_SET_INDEX, binding = 1) uniform sampler2D feature_state_sampler;
+
+vec4 feature_state_texel(const int slot) {
+    const int index = int(in_feature_ordinal) * FEATURE_STATE_STRIDE + slot;
+    const int width = textureSize(feature_state_sampler, 0).x;
+    return texelFetch(feature_state_sampler, ivec2(index % width, index / width), 0);
+}
+#endif
+
 layout(push_constant) uniform Constants {
     int ubo_index;
 } constant;
@@ -169,11 +195,15 @@ layout(location = 2) out vec2 frag_position;
 void main() {
     const FillOutlineDrawableUBO drawable = drawableVector.drawable_ubo[constant.ubo_index];
 
-#if !defined(HAS_UNIFORM_u_outline_color)
+#if defined(HAS_FEATURE_STATE_u_outline_color)
+    frag_color = vec4(unpack_mix_color(feature_state_texel(FEATURE_STATE_SLOT_u_outline_color), drawable.outline_color_t));
+#elif !defined(HAS_UNIFORM_u_outline_color)
     frag_color = vec4(unpack_mix_color(in_color, drawable.outline_color_t));
 #endif
 
-#if !defined(HAS_UNIFORM_u_opacity)
+#if defined(HAS_FEATURE_STATE_u_opacity)
+    frag_opacity = unpack_mix_float(feature_state_texel(FEATURE_STATE_SLOT_u_opacity).xy, drawable.opacity_t);
+#elif !defined(HAS_UNIFORM_u_opacity)
     frag_opacity = unpack_mix_float(in_opacity, drawable.opacity_t);
 #endif
 
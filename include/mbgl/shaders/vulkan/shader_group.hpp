@@ -23,10 +23,16 @@ protected:
     void addAdditionalDefines(const StringIDSetsPair& propertiesAsUniforms, DefinesMap& additionalDefines) {
         additionalDefines.reserve(propertiesAsUniforms.first.size());
         for (const auto name : propertiesAsUniforms.first) {
+            if (name.starts_with(featureStatePrefix)) {
+                continue;
+            }
             // We expect the names to be prefixed by "a_", but we need just the base here.
             const auto* base = (name[0] == 'a' && name[1] == '_') ? &name[2] : name.data();
             additionalDefines.insert(std::make_pair(std::string(uniformPrefix) + base, std::string()));
         }
+        for (auto& define : featureStateDefines(propertiesAsUniforms)) {
+            additionalDefines.insert(std::move(define));
+        }
     }
 
     ProgramParameters programParameters;
@@ -211,6 +211,39 @@ public:
     virtual void mergeOfflineRegions(const std::string& sideDatabasePath,
                                      std::function<void(expected<OfflineRegions, std::exception_ptr>)>);
 
+    /**
+     * Write an offline region, with the resources and tiles stored for it, to
+     * a single archive file that can be imported into another database.
+     *
+     * The archive is written sequentially, with a checksum, and stores data
+     * that is shared by several tiles only once.
+     *
+     * When the export is completed, the provided callback will be executed on
+     * the database thread; it is the responsibility of the SDK bindings to
+     * re-execute a user-provided callback on the main thread.
+     */
+    virtual void exportOfflineRegion(const OfflineRegion&,
+                                     const std::string& archivePath,
+                                     std::function<void(std::exception_ptr)>);
+
+    /**
+     * Add the offline region of an archive written by `exportOfflineRegion` to
+     * the offline database.
+     *
+     * Nothing is added if the archive is incomplete or corrupt. An identical
+     * region that already exists in the database is reused, and resources or
+     * tiles that are newer in the database than in the archive are kept.
+     *
+     * Invokes the callback with a `MapboxOfflineTileCountExceededException` error if
+     * the import would result in the offline tile count limit being exceeded.
+     *
+     * When the import is completed, the provided callback will be executed on
+     * the database thread; it is the responsibility of the SDK bindings to
+     * re-execute a user-provided callback on the main thread.
+     */
+    virtual void importOfflineRegion(const std::string& archivePath,
+                                     std::function<void(expected<OfflineRegion, std::exception_ptr>)>);
+
     /**
      * Remove an offline region from the database and perform any resources
      * evictions necessary as a result.
@@ -112,10 +112,21 @@ constexpr const char* API_BASE_URL_KEY = "api-base-url";
 /// type: unsigned
 constexpr const char* MAX_CONCURRENT_REQUESTS_KEY = "max-concurrent-requests";
 
+/// Property name to enable / disable adaptive per-host request concurrency.
+/// When enabled, the number of concurrent requests to each host is tuned from
+/// observed latency, capped by `max-concurrent-requests`.
+/// type: bool
+constexpr const char* ADAPTIVE_CONCURRENT_REQUESTS_KEY = "adaptive-concurrent-requests";
+
 // Properties that may be supported by database file sources:
 
 /// Property to set database mode. When set, database opens in read-only mode;
 /// database opens in read-write-create mode otherwise. type: bool
 constexpr const char* READ_ONLY_MODE_KEY = "read-only-mode";
 
+/// Property to store new database entries with zstd instead of zlib, when the
+/// library is built with zstd support. Builds without it can't read these
+/// entries, e.g. from a sideloaded database. type: bool
+constexpr const char* ZSTD_DATA_CODEC_KEY = "zstd-data-codec";
+
 } // namespace mbgl
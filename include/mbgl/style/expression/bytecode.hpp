@@ -0,0 +1,144 @@
+#pragma once
+
+#include <mbgl/style/expression/expression.hpp>
+#include <mbgl/style/expression/interpolator.hpp>
+#include <mbgl/util/color.hpp>
+#include <mbgl/util/containers.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+namespace expression {
+
+/**
+    A style expression compiled to a flat list of instructions over a small
+    register file.
+
+    Registers hold unboxed numbers, booleans, colors and pointers to strings,
+    tagged with their runtime type, so evaluating a program doesn't build
+    `Value`s or allocate for intermediate results. Constant subexpressions are
+    folded at compile time, and conditionals (`case`, `match`, `step`, ...)
+    become forward jumps.
+
+    Each property key gets one slot per program, however many times the
+    expression reads it, so a feature is asked for a key at most once per
+    evaluation. The legacy `filter-*` operators compile to instructions that
+    compare a slot against pre-converted constants and value sets.
+
+    Only a subset of the expressions is supported, `compile` returns null for
+    any other. A program gives up on anything that would produce an
+    evaluation error, the tree-walking `Expression::evaluate` is then used for
+    the result and the error message.
+*/
+class Bytecode {
+public:
+    /// Types that a program evaluates to directly
+    template <typename T>
+    static constexpr bool isEvaluatedType = std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                                            std::is_same_v<T, bool> || std::is_same_v<T, Color> ||
+                                            std::is_same_v<T, std::string>;
+
+    /// @return The compiled program, or null if the expression uses anything unsupported.
+    static std::shared_ptr<const Bytecode> compile(const Expression&);
+
+    /// @return The result, or nothing if it's an error or of another type.
+    /// Instantiated for the `isEvaluatedType` types.
+    template <typename T>
+    std::optional<T> evaluate(const EvaluationContext&) const;
+
+    /// @return The result as a `Value`, or nothing if it's an error.
+    std::optional<Value> evaluate(const EvaluationContext&) const;
+
+    std::size_t getInstructionCount() const { return code.size(); }
+
+    // Limits of a single program, more complex expressions aren't compiled.
+    static constexpr std::size_t maxRegisters = 64;
+    static constexpr std::size_t maxPropertySlots = 16;
+
+    enum class RegisterType : uint8_t {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Color,
+        // Arrays and objects read from features
+        Other,
+    };
+
+    struct Register {
+        RegisterType type;
+        union {
+            bool boolean;
+            double number;
+            const std::string* string;
+            float color[4];
+        };
+    };
+    static_assert(std::is_trivially_default_constructible_v<Register>);
+
+    enum class OpCode : uint8_t;
+
+    struct Instruction {
+        OpCode op;
+        uint8_t dst;
+        uint8_t a;
+        uint8_t b;
+        uint32_t operand;
+    };
+    static_assert(sizeof(Instruction) == 8);
+
+    class Frame;
+
+private:
+    friend class BytecodeCompiler;
+
+    const Register* run(const EvaluationContext&, Frame&) const;
+
+    struct MatchTable {
+        mbgl::unordered_map<std::string, uint32_t> strings;
+        mbgl::unordered_map<int64_t, uint32_t> numbers;
+        uint32_t otherwise;
+    };
+
+    /// The values of a legacy `in` filter
+    struct ValueSet {
+        mbgl::unordered_set<std::string> strings;
+        mbgl::unordered_set<double> numbers;
+        bool null = false;
+        bool trueValue = false;
+        bool falseValue = false;
+    };
+
+    struct StepTable {
+        std::vector<double> inputs;
+        std::vector<uint32_t> targets;
+    };
+
+    struct InterpolateTable {
+        Interpolator interpolator;
+        std::vector<double> inputs;
+        std::vector<Register> outputs;
+    };
+
+    std::vector<Instruction> code;
+    std::vector<Register> constants;
+    // Property names and string constants, stable in memory
+    std::deque<std::string> strings;
+    // Key of each property slot, null for the feature id
+    std::vector<const std::string*> propertyKeys;
+    std::vector<MatchTable> matchTables;
+    std::vector<ValueSet> valueSets;
+    std::vector<StepTable> stepTables;
+    std::vector<InterpolateTable> interpolateTables;
+};
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
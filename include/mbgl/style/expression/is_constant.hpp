@@ -30,6 +30,9 @@ bool isGlobalPropertyConstant(const Expression& expression, const T& properties)
 bool isFeatureConstant(const Expression& expression);
 bool isZoomConstant(const Expression& e);
 
+/// Returns true if expression does not read the state set with `setFeatureState`.
+bool isFeatureStateConstant(const Expression& e);
+
 /// Returns true if expression does not depend on information provided by the runtime.
 bool isRuntimeConstant(const Expression& e);
 
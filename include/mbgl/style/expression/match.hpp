@@ -5,13 +5,29 @@
 #include <mbgl/style/conversion.hpp>
 
 #include <memory>
+#include <string>
+#include <type_traits>
 
 namespace mbgl {
 namespace style {
 namespace expression {
 
+/// Tells the `Match` specializations apart, they share the same `Kind`.
+class MatchBase : public Expression {
+public:
+    bool hasStringLabels() const noexcept { return stringLabels; }
+
+protected:
+    MatchBase(type::Type type_, Dependency dependencies_, bool stringLabels_)
+        : Expression(Kind::Match, std::move(type_), dependencies_),
+          stringLabels(stringLabels_) {}
+
+private:
+    const bool stringLabels;
+};
+
 template <typename T>
-class Match : public Expression {
+class Match : public MatchBase {
 public:
     using Branches = std::unordered_map<T, std::shared_ptr<Expression>>;
 
@@ -19,8 +35,9 @@ public:
           std::unique_ptr<Expression> input_,
           Branches branches_,
           std::unique_ptr<Expression> otherwise_)
-        : Expression(
-              Kind::Match, std::move(type_), depsOf(input_) | depsOf(otherwise_) | collectDependencies(branches_)),
+        : MatchBase(std::move(type_),
+                    depsOf(input_) | depsOf(otherwise_) | collectDependencies(branches_),
+                    std::is_same_v<T, std::string>),
           input(std::move(input_)),
           branches(std::move(branches_)),
           otherwise(std::move(otherwise_)) {}
@@ -36,6 +53,10 @@ public:
     mbgl::Value serialize() const override;
     std::string getOperator() const override { return "match"; }
 
+    const std::unique_ptr<Expression>& getInput() const noexcept { return input; }
+    const Branches& getBranches() const noexcept { return branches; }
+    const std::unique_ptr<Expression>& getOtherwise() const noexcept { return otherwise; }
+
 private:
     std::unique_ptr<Expression> input;
     Branches branches;
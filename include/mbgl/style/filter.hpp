@@ -3,6 +3,7 @@
 #include <mbgl/util/variant.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/geometry.hpp>
+#include <mbgl/style/expression/bytecode.hpp>
 #include <mbgl/style/expression/expression.hpp>
 
 #include <string>
@@ -19,6 +20,8 @@ public:
 
 private:
     std::optional<mbgl::Value> legacyFilter;
+    // Compiled once and shared by the copies of the filter, null if the expression isn't supported
+    std::shared_ptr<const expression::Bytecode> bytecode;
 
 public:
     Filter() = default;
@@ -27,6 +30,9 @@ public:
         : expression(std::move(*_expression)),
           legacyFilter(std::move(_filter)) {
         assert(!expression || *expression != nullptr);
+        if (expression) {
+            bytecode = expression::Bytecode::compile(**expression);
+        }
     }
 
     bool operator()(const expression::EvaluationContext& context) const;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/style/expression/bytecode.hpp>
 #include <mbgl/style/expression/expression.hpp>
 #include <mbgl/style/expression/is_constant.hpp>
 #include <mbgl/style/expression/interpolate.hpp>
@@ -35,6 +36,9 @@ public:
 
     bool isZoomConstant() const noexcept { return isZoomConstant_; }
     bool isFeatureConstant() const noexcept { return isFeatureConstant_; }
+    /// Whether the result is unaffected by `feature-state`, so changing the
+    /// state of a feature doesn't require evaluating the expression again.
+    bool isFeatureStateConstant() const noexcept { return isFeatureStateConstant_; }
     bool isRuntimeConstant() const noexcept { return isRuntimeConstant_; }
     float interpolationFactor(const Range<float>&, float) const noexcept;
     Range<float> getCoveringStops(float, float) const noexcept;
@@ -52,18 +56,23 @@ public:
     /// Build a cached GPU representation of the expression, with the same lifetime as this object.
     gfx::UniqueGPUExpression getGPUExpression(bool intZoom) const;
 
+    /// The compiled form of data driven expressions, or null if they can't be compiled.
+    const std::shared_ptr<const expression::Bytecode>& getBytecode() const noexcept { return bytecode; }
+
     Dependency getDependencies() const noexcept { return expression ? expression->dependencies : Dependency::None; }
 
     const ZoomCurvePtr& getZoomCurve() const { return zoomCurve; }
 
 protected:
     std::shared_ptr<const Expression> expression;
+    std::shared_ptr<const expression::Bytecode> bytecode;
 
     ZoomCurvePtr zoomCurve;
 
     bool useIntegerZoom_ = false;
     bool isZoomConstant_;
     bool isFeatureConstant_;
+    bool isFeatureStateConstant_;
     bool isRuntimeConstant_;
 
     // If the expression depends on zoom and nothing else, and produces
@@ -82,6 +91,14 @@ public:
           defaultValue(std::move(defaultValue_)) {}
 
     T evaluate(const expression::EvaluationContext& context, T finalDefaultValue = T()) const {
+        if constexpr (expression::Bytecode::isEvaluatedType<T>) {
+            // Errors fall back to the tree, so that the default value applies the same way
+            if (bytecode) {
+                if (std::optional<T> compiled = bytecode->template evaluate<T>(context)) {
+                    return std::move(*compiled);
+                }
+            }
+        }
         const expression::EvaluationResult result = expression->evaluate(context);
         if (result) {
             const std::optional<T> typed = expression::fromExpressionValue<T>(*result);
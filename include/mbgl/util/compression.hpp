@@ -17,6 +17,14 @@ bool is_compressed(const std::string&);
 std::string compress(const std::string& raw, int windowBits = CompressionFormat::ZLIB);
 std::string decompress(const std::string& raw, int windowBits = CompressionFormat::DETECT);
 
+// Zstandard frames. Only available when built with MLN_WITH_ZSTD; otherwise
+// zstd_supported() returns false and the other two functions throw.
+// decompress_zstd() only accepts frames that record their content size, as
+// the ones written by compress_zstd() do.
+bool zstd_supported() noexcept;
+std::string compress_zstd(const std::string& raw, int level = 3);
+std::string decompress_zstd(const std::string& raw);
+
 std::uint32_t crc32(const void* raw, size_t size) noexcept;
 
 } // namespace util
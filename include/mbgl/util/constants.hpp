@@ -44,12 +44,20 @@ constexpr float ONE_EM = 24.0f;
 
 constexpr uint8_t DEFAULT_PREFETCH_ZOOM_DELTA = 4;
 
+// Number of camera states sampled along an animated transition to prefetch
+// the tiles it will pass through.
+constexpr std::size_t TRANSITION_PATH_PREFETCH_SAMPLES = 8;
+
 constexpr uint64_t DEFAULT_MAX_CACHE_SIZE = 50 * 1024 * 1024;
 
 // Default ImageManager's cache size for images added via onStyleImageMissing API.
 // Average sprite size with 1.0 pixel ratio is ~2kB, 8kB for pixel ratio of 2.0.
 constexpr std::size_t DEFAULT_ON_DEMAND_IMAGES_CACHE_SIZE = 100 * 8192;
 
+// Size of the raster tile images kept for reuse by a renderer, with their encoded data,
+// about 30 tiles of 512x512 pixels.
+constexpr std::size_t DEFAULT_RASTER_IMAGE_CACHE_SIZE = 32 * 1024 * 1024;
+
 constexpr Duration DEFAULT_TRANSITION_DURATION = Milliseconds(300);
 constexpr Seconds CLOCK_SKEW_RETRY_TIMEOUT{30};
 
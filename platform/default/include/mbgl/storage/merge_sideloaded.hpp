@@ -18,13 +18,14 @@ static constexpr const char* mergeSideloadedDatabaseSQL =
     "    FROM side.regions sr\n"
     "    JOIN regions r ON sr.definition = r.definition  AND sr.description IS "
     "r.description;\n"
-    "REPLACE INTO tiles\n"
+    "REPLACE INTO tiles (id, url_template, pixel_ratio, z, x, y, expires, "
+    "modified, etag, data, compressed, accessed, must_revalidate)\n"
     "    SELECT t.id,\n"
     "        st.url_template, st.pixel_ratio, st.z, st.x, st.y,\n"
     "        st.expires, st.modified, st.etag, st.data, st.compressed, "
     "st.accessed, st.must_revalidate\n"
     "    FROM (SELECT DISTINCT sti.* FROM side.region_tiles srt JOIN "
-    "side.tiles sti ON srt.tile_id = sti.id)\n"
+    "side_tiles sti ON srt.tile_id = sti.id)\n"
     "    AS st\n"
     "    LEFT JOIN tiles t ON st.url_template = t.url_template AND "
     "st.pixel_ratio = t.pixel_ratio AND st.z = t.z AND "
@@ -40,11 +41,12 @@ static constexpr const char* mergeSideloadedDatabaseSQL =
     "st.pixel_ratio = t.pixel_ratio AND st.z = t.z "
     "AND st.x = t.x AND st.y = t.y\n"
     "    ) AS sti ON srt.tile_id = sti.side_tile_id;\n"
-    "REPLACE INTO resources\n"
+    "REPLACE INTO resources (id, url, kind, expires, modified, etag, data, "
+    "compressed, accessed, must_revalidate)\n"
     "    SELECT r.id, \n"
     "        sr.url, sr.kind, sr.expires, sr.modified, sr.etag,\n"
     "        sr.data, sr.compressed, sr.accessed, sr.must_revalidate\n"
-    "    FROM side.region_resources srr JOIN side.resources sr ON "
+    "    FROM side.region_resources srr JOIN side_resources sr ON "
     "srr.resource_id = sr.id\n"
     "    LEFT JOIN resources r ON sr.url = r.url\n"
     "        WHERE r.id IS NULL\n"
@@ -56,6 +58,15 @@ static constexpr const char* mergeSideloadedDatabaseSQL =
     "  JOIN (SELECT r.id, sr.id AS side_resource_id FROM side.resources sr\n"
     "          JOIN resources r ON sr.url = r.url) AS sri  ON srr.resource_id "
     "= sri.side_resource_id;\n"
+    "DELETE FROM ambient_tiles\n"
+    "  WHERE EXISTS (SELECT 1 FROM tiles t\n"
+    "    WHERE t.url_template = ambient_tiles.url_template AND t.pixel_ratio = "
+    "ambient_tiles.pixel_ratio\n"
+    "      AND t.z = ambient_tiles.z AND t.x = ambient_tiles.x AND t.y = "
+    "ambient_tiles.y);\n"
+    "DELETE FROM ambient_resources\n"
+    "  WHERE EXISTS (SELECT 1 FROM resources r WHERE r.url = "
+    "ambient_resources.url);\n"
     " \n"
     "DROP TABLE region_mapping;\n";
 
@@ -10,12 +10,13 @@ CREATE TEMPORARY TABLE region_mapping AS
     FROM side.regions sr
     JOIN regions r ON sr.definition = r.definition  AND sr.description IS r.description;
 
---Insert /Update tiles
-REPLACE INTO tiles
+--Insert /Update tiles. side_tiles and side_resources hold the data inline whatever the
+--side database version, see OfflineDatabase::mergeDatabase(). It is moved to blobs afterwards.
+REPLACE INTO tiles (id, url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed, must_revalidate)
     SELECT t.id, -- use the old ID in case we run a REPLACE. If it doesn't exist yet, it'll be NULL which will auto-assign a new ID.
         st.url_template, st.pixel_ratio, st.z, st.x, st.y,
         st.expires, st.modified, st.etag, st.data, st.compressed, st.accessed, st.must_revalidate
-    FROM (SELECT DISTINCT sti.* FROM side.region_tiles srt JOIN side.tiles sti ON srt.tile_id = sti.id)   -- ensure that we're only considering region tiles, and not ambient tiles.
+    FROM (SELECT DISTINCT sti.* FROM side.region_tiles srt JOIN side_tiles sti ON srt.tile_id = sti.id)   -- ensure that we're only considering region tiles, and not ambient tiles.
     AS st
     LEFT JOIN tiles t ON st.url_template = t.url_template AND st.pixel_ratio = t.pixel_ratio AND st.z = t.z AND st.x = t.x AND st.y = t.y
         WHERE t.id IS NULL -- only consider tiles that don't exist yet in the original database.
@@ -31,11 +32,11 @@ INSERT OR IGNORE INTO region_tiles
     ) AS sti ON srt.tile_id = sti.side_tile_id;
 
 -- copy over resources
-REPLACE INTO resources
+REPLACE INTO resources (id, url, kind, expires, modified, etag, data, compressed, accessed, must_revalidate)
     SELECT r.id,
         sr.url, sr.kind, sr.expires, sr.modified, sr.etag,
         sr.data, sr.compressed, sr.accessed, sr.must_revalidate
-    FROM side.region_resources srr JOIN side.resources sr ON srr.resource_id = sr.id   --only consider region resources, and not ambient resources.
+    FROM side.region_resources srr JOIN side_resources sr ON srr.resource_id = sr.id   --only consider region resources, and not ambient resources.
     LEFT JOIN resources r ON sr.url = r.url
         WHERE r.id IS NULL -- only consider resources that don't exist yet in the main database
         OR sr.modified > r.modified; -- ...or resources that are newer in the side loaded DB.
@@ -48,4 +49,13 @@ INSERT OR IGNORE INTO region_resources
   JOIN (SELECT r.id, sr.id AS side_resource_id FROM side.resources sr
           JOIN resources r ON sr.url = r.url) AS sri  ON srr.resource_id = sri.side_resource_id;
 
+-- Drop ambient cache copies of what is now part of a region
+DELETE FROM ambient_tiles
+  WHERE EXISTS (SELECT 1 FROM tiles t
+    WHERE t.url_template = ambient_tiles.url_template AND t.pixel_ratio = ambient_tiles.pixel_ratio
+      AND t.z = ambient_tiles.z AND t.x = ambient_tiles.x AND t.y = ambient_tiles.y);
+
+DELETE FROM ambient_resources
+  WHERE EXISTS (SELECT 1 FROM resources r WHERE r.url = ambient_resources.url);
+
 DROP TABLE region_mapping;
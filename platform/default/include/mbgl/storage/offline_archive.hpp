@@ -0,0 +1,94 @@
+#pragma once
+
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+/*
+   An offline archive is a self-contained copy of one offline region, written
+   and read sequentially. It is a header (a magic string and the format
+   version) followed by records, each a type byte, the 32-bit length of its
+   payload and the payload. Integers are little endian.
+
+   - Region: the definition JSON and the metadata of the region, always first.
+   - Resource, Tile: an entry of the region with its cache headers. The data
+     is stored as it is in the database, with its codec, unless an earlier
+     entry has the same bytes. The entry then refers to that copy by its
+     index, copies being numbered in the order they appear, so that identical
+     tiles are stored once.
+   - End: the CRC-32 of everything before it.
+
+   Readers skip record types that they don't know.
+*/
+struct OfflineArchiveEntry {
+    bool isTile = false;
+    // The URL, or the URL template of a tile
+    std::string url;
+    Resource::Kind kind = Resource::Kind::Unknown;
+    uint8_t pixelRatio = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    uint8_t z = 0;
+
+    std::optional<std::string> etag;
+    std::optional<Timestamp> expires;
+    std::optional<Timestamp> modified;
+    bool mustRevalidate = false;
+
+    // Data as stored in the database, nothing for entries without content.
+    std::optional<std::string> data;
+    int64_t codec = 0;
+    // Index of the earlier copy of the data, instead of `data`.
+    std::optional<uint32_t> blob;
+};
+
+class OfflineArchiveWriter {
+public:
+    explicit OfflineArchiveWriter(const std::string& path);
+
+    void writeRegion(const std::string& definition, const std::vector<uint8_t>& metadata);
+
+    // @return Index of the copy of the data, if the entry has data.
+    std::optional<uint32_t> writeEntry(const OfflineArchiveEntry&);
+
+    // Writes the checksum, the archive is incomplete without it.
+    void finish();
+
+private:
+    void writeRecord(uint8_t type);
+    void write(const void*, std::size_t);
+
+    std::ofstream file;
+    std::string record;
+    uint32_t checksum;
+    uint32_t blobCount = 0;
+};
+
+class OfflineArchiveReader {
+public:
+    explicit OfflineArchiveReader(const std::string& path);
+
+    // The definition and metadata of the region.
+    std::pair<std::string, std::vector<uint8_t>> readRegion();
+
+    // @return The next entry, or nothing once the checksum has been verified.
+    std::optional<OfflineArchiveEntry> next();
+
+private:
+    bool readRecord();
+    void read(void*, std::size_t);
+
+    std::ifstream file;
+    uint8_t type = 0;
+    std::string record;
+    uint32_t checksum;
+};
+
+} // namespace mbgl
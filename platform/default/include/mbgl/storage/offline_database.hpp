@@ -13,6 +13,7 @@
 #include <memory>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace mapbox {
 namespace sqlite {
@@ -27,6 +28,7 @@ namespace mbgl {
 
 class Response;
 class TileID;
+struct OfflineArchiveEntry;
 
 namespace util {
 struct IOException;
@@ -37,6 +39,15 @@ struct MapboxTileLimitExceededException : util::Exception {
         : util::Exception("Mapbox tile limit exceeded") {}
 };
 
+// Codec of an entry's data, stored in the `compressed` column of the tile and
+// resource tables. Databases written before Zstd was added only contain the
+// values 0 and 1, which keep their meaning, so no migration is needed.
+enum class OfflineDataCodec : uint8_t {
+    None = 0,
+    Zlib = 1,
+    Zstd = 2,
+};
+
 class OfflineDatabase {
 public:
     OfflineDatabase(std::string path, const TileServerOptions& options);
@@ -71,6 +82,15 @@ public:
 
     expected<OfflineRegions, std::exception_ptr> mergeDatabase(const std::string& sideDatabasePath);
 
+    // Writes a region with its resources and tiles to an offline archive, see
+    // offline_archive.hpp.
+    std::exception_ptr exportRegion(int64_t regionID, const std::string& archivePath);
+
+    // Adds the region of an offline archive. An identical region that already
+    // exists is used instead, and entries that are newer in the database are
+    // kept.
+    expected<OfflineRegion, std::exception_ptr> importRegion(const std::string& archivePath);
+
     expected<OfflineRegionMetadata, std::exception_ptr> updateMetadata(int64_t regionID, const OfflineRegionMetadata&);
 
     std::exception_ptr deleteRegion(OfflineRegion&&);
@@ -79,6 +99,9 @@ public:
     // Return value is (response, stored size)
     std::optional<std::pair<Response, uint64_t>> getRegionResource(const Resource&);
     std::optional<int64_t> hasRegionResource(const Resource&);
+    // Looks up a batch of resources in one read transaction. Return value has
+    // the stored size of each resource, in order, or nothing if it isn't stored.
+    std::vector<std::optional<int64_t>> hasRegionResources(const std::vector<Resource>&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
     void putRegionResources(int64_t regionID, const std::list<std::tuple<Resource, Response>>&, OfflineRegionStatus&);
 
@@ -95,11 +118,15 @@ public:
     std::exception_ptr pack();
     void runPackDatabaseAutomatically(bool autopack_) { autopack = autopack_; }
 
+    // Selects the codec used for new entries. Existing entries keep the codec
+    // they were written with. The default is Zlib, which every build can read.
+    // Zstd falls back to Zlib when the library was built without zstd support.
+    void setDataCodec(OfflineDataCodec);
+    OfflineDataCodec getDataCodec() const { return dataCodec; }
+
     void reopenDatabaseReadOnly(bool readOnly);
 
 private:
-    class DatabaseSizeChangeStats;
-
     void initialize();
     void handleError(const mapbox::sqlite::Exception&, const char* action);
     void handleError(const util::IOException&, const char* action);
@@ -112,6 +139,9 @@ private:
     void migrateToVersion5();
     void migrateToVersion3();
     void migrateToVersion6();
+    void migrateToVersion7();
+    void migrateToVersion8();
+    void addBlobColumns();
     void cleanup();
     bool disabled();
     void vacuum();
@@ -121,17 +151,30 @@ private:
 
     std::optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
     std::optional<int64_t> hasTile(const Resource::TileData&);
-    bool putTile(const Resource::TileData&, const Response&, const std::string&, bool compressed);
+    bool putTile(const Resource::TileData&, const Response&, const std::string&, OfflineDataCodec, bool ambient);
 
     std::optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     std::optional<int64_t> hasResource(const Resource&);
-    bool putResource(const Resource&, const Response&, const std::string&, bool compressed);
+    bool putResource(const Resource&, const Response&, const std::string&, OfflineDataCodec, bool ambient);
 
     uint64_t putRegionResourceInternal(int64_t regionID, const Resource&, const Response&);
 
+    // Return value is (blob, inserted), the blob is nothing if the stored entry was kept.
+    std::pair<std::optional<int64_t>, bool> importEntry(int64_t regionID,
+                                                        const OfflineArchiveEntry&,
+                                                        std::optional<int64_t> blobID);
+
     std::optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
     std::optional<int64_t> hasInternal(const Resource&);
-    std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool evict);
+    std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool ambient);
+
+    // Moves an ambient cache entry into the region tables, so that it can be
+    // referenced by a region.
+    void moveFromAmbientCache(const Resource&);
+
+    int64_t putBlob(const std::string& data);
+    void moveDataToBlobs();
+    void moveDataToBlob(bool tile, int64_t row);
 
     // Return value is true iff the resource was previously unused by any other regions.
     bool markUsed(int64_t regionID, const Resource&);
@@ -151,39 +194,15 @@ private:
 
     std::optional<uint64_t> offlineMapboxTileCount;
 
-    bool evict(uint64_t neededFreeSize, DatabaseSizeChangeStats& stats);
+    bool evict(uint64_t neededFreeSize);
 
     TileServerOptions tileServerOptions;
 
-    class DatabaseSizeChangeStats {
-    public:
-        explicit DatabaseSizeChangeStats(OfflineDatabase*);
-
-        // Returns difference between current database size and
-        // database size at the time of creation of this object.
-        int64_t diff() const;
-
-        // Returns how many bytes were released comparing to a database
-        // size at the time of creation of this object.
-        uint64_t bytesReleased() const;
-
-        // Returns page size for the database.
-        uint64_t pageSize() const;
-
-    private:
-        uint64_t pageSize_ = 0u;
-        uint64_t pageCount_ = 0u;
-        uint64_t initialSize_ = 0u;
-        OfflineDatabase* db = nullptr;
-    };
-
-    friend class DatabaseSizeChangeStats;
-
-    // Lazily initializes currentAmbientCacheSize.
-    std::exception_ptr initAmbientCacheSize();
-    std::optional<uint64_t> currentAmbientCacheSize;
-    void updateAmbientCacheSize(DatabaseSizeChangeStats&);
+    // Reads the persisted size of the ambient cache, see ambient_cache_size in
+    // offline_schema.sql.
+    uint64_t getAmbientCacheSize();
 
+    OfflineDataCodec dataCodec;
     bool autopack = true;
     bool readOnly = false;
 };
@@ -41,6 +41,7 @@ private:
     void continueDownload();
     void deactivateDownload();
     bool flushResourcesBuffer();
+    bool hasRemainingResources() const;
 
     /*
      * Ensure that the resource is stored in the database, requesting it if necessary.
@@ -49,6 +50,9 @@ private:
      */
     void ensureResource(Resource&&, std::function<void(Response)> = {});
 
+    // Requests a resource that isn't in the database and queues the response for storage.
+    void requestResource(Resource, std::function<void(Response)> = {});
+
     void onMapboxTileCountLimitExceeded();
 
     int64_t id;
@@ -61,11 +65,20 @@ private:
     std::list<std::unique_ptr<AsyncRequest>> requests;
     std::set<std::string> requiredSourceURLs;
     std::deque<Resource> resourcesRemaining;
+
+    // Tiles are enumerated from the tile cover of each source as the download
+    // progresses, rather than listed up front, and checked against the
+    // database in batches. `tilesRemaining` holds the ones still to request.
+    class TilePlan;
+    std::deque<std::unique_ptr<TilePlan>> tilePlans;
+    std::deque<Resource> tilesRemaining;
+
     std::list<Resource> resourcesToBeMarkedAsUsed;
     std::list<std::tuple<Resource, Response>> buffer;
 
     void queueResource(Resource&&);
     void queueTiles(style::SourceType, uint16_t tileSize, const Tileset&);
+    void planTiles();
     void markPendingUsedResources();
 };
 
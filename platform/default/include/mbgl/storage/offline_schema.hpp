@@ -6,7 +6,7 @@
 namespace mbgl {
 
 static constexpr const char* offlineDatabaseSchema =
-    "CREATE TABLE resources (\n"
+    "CREATE TABLE IF NOT EXISTS resources (\n"
     "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,\n"
     "  url TEXT NOT NULL,\n"
     "  kind INTEGER NOT NULL,\n"
@@ -17,9 +17,10 @@ static constexpr const char* offlineDatabaseSchema =
     "  compressed INTEGER NOT NULL DEFAULT 0,\n"
     "  accessed INTEGER NOT NULL,\n"
     "  must_revalidate INTEGER NOT NULL DEFAULT 0,\n"
+    "  blob_id INTEGER,\n"
     "  UNIQUE (url)\n"
     ");\n"
-    "CREATE TABLE tiles (\n"
+    "CREATE TABLE IF NOT EXISTS tiles (\n"
     "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,\n"
     "  url_template TEXT NOT NULL,\n"
     "  pixel_ratio INTEGER NOT NULL,\n"
@@ -33,30 +34,148 @@ static constexpr const char* offlineDatabaseSchema =
     "  compressed INTEGER NOT NULL DEFAULT 0,\n"
     "  accessed INTEGER NOT NULL,\n"
     "  must_revalidate INTEGER NOT NULL DEFAULT 0,\n"
+    "  blob_id INTEGER,\n"
     "  UNIQUE (url_template, pixel_ratio, z, x, y)\n"
     ");\n"
-    "CREATE TABLE regions (\n"
+    "CREATE TABLE IF NOT EXISTS blobs (\n"
+    "  id INTEGER NOT NULL PRIMARY KEY,\n"
+    "  hash INTEGER NOT NULL,\n"
+    "  data BLOB NOT NULL,\n"
+    "  refs INTEGER NOT NULL DEFAULT 0\n"
+    ");\n"
+    "CREATE TABLE IF NOT EXISTS regions (\n"
     "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,\n"
     "  definition TEXT NOT NULL,\n"
     "  description BLOB\n"
     ");\n"
-    "CREATE TABLE region_resources (\n"
+    "CREATE TABLE IF NOT EXISTS region_resources (\n"
     "  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,\n"
     "  resource_id INTEGER NOT NULL REFERENCES resources(id),\n"
     "  UNIQUE (region_id, resource_id)\n"
     ");\n"
-    "CREATE TABLE region_tiles (\n"
+    "CREATE TABLE IF NOT EXISTS region_tiles (\n"
     "  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,\n"
     "  tile_id INTEGER NOT NULL REFERENCES tiles(id),\n"
     "  UNIQUE (region_id, tile_id)\n"
     ");\n"
-    "CREATE INDEX resources_accessed\n"
+    "CREATE TABLE IF NOT EXISTS ambient_resources (\n"
+    "  id INTEGER NOT NULL PRIMARY KEY,\n"
+    "  url TEXT NOT NULL,\n"
+    "  kind INTEGER NOT NULL,\n"
+    "  expires INTEGER,\n"
+    "  modified INTEGER,\n"
+    "  etag TEXT,\n"
+    "  data BLOB,\n"
+    "  compressed INTEGER NOT NULL DEFAULT 0,\n"
+    "  accessed INTEGER NOT NULL,\n"
+    "  must_revalidate INTEGER NOT NULL DEFAULT 0,\n"
+    "  UNIQUE (url)\n"
+    ");\n"
+    "CREATE TABLE IF NOT EXISTS ambient_tiles (\n"
+    "  id INTEGER NOT NULL PRIMARY KEY,\n"
+    "  url_template TEXT NOT NULL,\n"
+    "  pixel_ratio INTEGER NOT NULL,\n"
+    "  z INTEGER NOT NULL,\n"
+    "  x INTEGER NOT NULL,\n"
+    "  y INTEGER NOT NULL,\n"
+    "  expires INTEGER,\n"
+    "  modified INTEGER,\n"
+    "  etag TEXT,\n"
+    "  data BLOB,\n"
+    "  compressed INTEGER NOT NULL DEFAULT 0,\n"
+    "  accessed INTEGER NOT NULL,\n"
+    "  must_revalidate INTEGER NOT NULL DEFAULT 0,\n"
+    "  UNIQUE (url_template, pixel_ratio, z, x, y)\n"
+    ");\n"
+    "CREATE TABLE IF NOT EXISTS ambient_cache_size (\n"
+    "  size INTEGER NOT NULL\n"
+    ");\n"
+    "INSERT INTO ambient_cache_size (size) SELECT 0 WHERE NOT EXISTS (SELECT 1 FROM ambient_cache_size);\n"
+    "CREATE TRIGGER IF NOT EXISTS ambient_resources_insert AFTER INSERT ON ambient_resources\n"
+    "BEGIN\n"
+    "  UPDATE ambient_cache_size SET size = size\n"
+    "    + IFNULL(LENGTH(NEW.data), 0) + LENGTH(NEW.url) + IFNULL(LENGTH(NEW.etag), 0);\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS ambient_resources_update AFTER UPDATE OF data, etag ON ambient_resources\n"
+    "BEGIN\n"
+    "  UPDATE ambient_cache_size SET size = size\n"
+    "    + IFNULL(LENGTH(NEW.data), 0) + LENGTH(NEW.url) + IFNULL(LENGTH(NEW.etag), 0)\n"
+    "    - IFNULL(LENGTH(OLD.data), 0) - LENGTH(OLD.url) - IFNULL(LENGTH(OLD.etag), 0);\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS ambient_resources_delete AFTER DELETE ON ambient_resources\n"
+    "BEGIN\n"
+    "  UPDATE ambient_cache_size SET size = size\n"
+    "    - IFNULL(LENGTH(OLD.data), 0) - LENGTH(OLD.url) - IFNULL(LENGTH(OLD.etag), 0);\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS ambient_tiles_insert AFTER INSERT ON ambient_tiles\n"
+    "BEGIN\n"
+    "  UPDATE ambient_cache_size SET size = size\n"
+    "    + IFNULL(LENGTH(NEW.data), 0) + LENGTH(NEW.url_template) + IFNULL(LENGTH(NEW.etag), 0);\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS ambient_tiles_update AFTER UPDATE OF data, etag ON ambient_tiles\n"
+    "BEGIN\n"
+    "  UPDATE ambient_cache_size SET size = size\n"
+    "    + IFNULL(LENGTH(NEW.data), 0) + LENGTH(NEW.url_template) + IFNULL(LENGTH(NEW.etag), 0)\n"
+    "    - IFNULL(LENGTH(OLD.data), 0) - LENGTH(OLD.url_template) - IFNULL(LENGTH(OLD.etag), 0);\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS ambient_tiles_delete AFTER DELETE ON ambient_tiles\n"
+    "BEGIN\n"
+    "  UPDATE ambient_cache_size SET size = size\n"
+    "    - IFNULL(LENGTH(OLD.data), 0) - LENGTH(OLD.url_template) - IFNULL(LENGTH(OLD.etag), 0);\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS resources_blob_insert AFTER INSERT ON resources\n"
+    "WHEN NEW.blob_id IS NOT NULL\n"
+    "BEGIN\n"
+    "  UPDATE blobs SET refs = refs + 1 WHERE id = NEW.blob_id;\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS resources_blob_update AFTER UPDATE OF blob_id ON resources\n"
+    "WHEN OLD.blob_id IS NOT NEW.blob_id\n"
+    "BEGIN\n"
+    "  UPDATE blobs SET refs = refs + 1 WHERE id = NEW.blob_id;\n"
+    "  UPDATE blobs SET refs = refs - 1 WHERE id = OLD.blob_id;\n"
+    "  DELETE FROM blobs WHERE id = OLD.blob_id AND refs = 0;\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS resources_blob_delete AFTER DELETE ON resources\n"
+    "WHEN OLD.blob_id IS NOT NULL\n"
+    "BEGIN\n"
+    "  UPDATE blobs SET refs = refs - 1 WHERE id = OLD.blob_id;\n"
+    "  DELETE FROM blobs WHERE id = OLD.blob_id AND refs = 0;\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS tiles_blob_insert AFTER INSERT ON tiles\n"
+    "WHEN NEW.blob_id IS NOT NULL\n"
+    "BEGIN\n"
+    "  UPDATE blobs SET refs = refs + 1 WHERE id = NEW.blob_id;\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS tiles_blob_update AFTER UPDATE OF blob_id ON tiles\n"
+    "WHEN OLD.blob_id IS NOT NEW.blob_id\n"
+    "BEGIN\n"
+    "  UPDATE blobs SET refs = refs + 1 WHERE id = NEW.blob_id;\n"
+    "  UPDATE blobs SET refs = refs - 1 WHERE id = OLD.blob_id;\n"
+    "  DELETE FROM blobs WHERE id = OLD.blob_id AND refs = 0;\n"
+    "END;\n"
+    "CREATE TRIGGER IF NOT EXISTS tiles_blob_delete AFTER DELETE ON tiles\n"
+    "WHEN OLD.blob_id IS NOT NULL\n"
+    "BEGIN\n"
+    "  UPDATE blobs SET refs = refs - 1 WHERE id = OLD.blob_id;\n"
+    "  DELETE FROM blobs WHERE id = OLD.blob_id AND refs = 0;\n"
+    "END;\n"
+    "CREATE INDEX IF NOT EXISTS resources_accessed\n"
     "ON resources (accessed);\n"
-    "CREATE INDEX tiles_accessed\n"
+    "CREATE INDEX IF NOT EXISTS tiles_accessed\n"
     "ON tiles (accessed);\n"
-    "CREATE INDEX region_resources_resource_id\n"
+    "CREATE INDEX IF NOT EXISTS region_resources_resource_id\n"
     "ON region_resources (resource_id);\n"
-    "CREATE INDEX region_tiles_tile_id\n"
-    "ON region_tiles (tile_id);\n";
+    "CREATE INDEX IF NOT EXISTS region_tiles_tile_id\n"
+    "ON region_tiles (tile_id);\n"
+    "CREATE INDEX IF NOT EXISTS ambient_resources_accessed\n"
+    "ON ambient_resources (accessed);\n"
+    "CREATE INDEX IF NOT EXISTS ambient_tiles_accessed\n"
+    "ON ambient_tiles (accessed);\n"
+    "CREATE INDEX IF NOT EXISTS blobs_hash\n"
+    "ON blobs (hash);\n"
+    "CREATE INDEX IF NOT EXISTS resources_inline_data\n"
+    "ON resources (id) WHERE data IS NOT NULL;\n"
+    "CREATE INDEX IF NOT EXISTS tiles_inline_data\n"
+    "ON tiles (id) WHERE data IS NOT NULL;\n";
 
 } // namespace mbgl
@@ -1,8 +1,13 @@
+--
+-- Every statement can be applied to an existing database: migrations run the
+-- schema again to create the tables and indexes that an older version lacks.
+--
+
 --
 -- Table containing the style, source, sprite, and glyph
 -- resources. Essentially everything that is not a tile.
 --
-CREATE TABLE resources (
+CREATE TABLE IF NOT EXISTS resources (
   id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,   -- Primary key.
 
   url TEXT NOT NULL,                               -- The URL of the resource without the access token.Must be
@@ -27,25 +32,29 @@ CREATE TABLE resources (
                                                    -- not get re-downloaded. See:
                                                    -- https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/ETag
 
-  data BLOB,                                       -- Contents of the resource.
+  data BLOB,                                       -- Not used since schema version 8, the contents are in `blobs`.
 
-  compressed INTEGER NOT NULL DEFAULT 0,           -- If the resource is compressed with Deflate or not. Compression is
-                                                   -- optional and should be used when the compression ratio is
-                                                   -- significant. Using compression will make decoding time slower
-                                                   -- because it will add an extra decompression step.
+  compressed INTEGER NOT NULL DEFAULT 0,           -- Codec of the resource data: 0 for none, 1 for Deflate (zlib) and
+                                                   -- 2 for Zstandard. Compression is optional and should be used
+                                                   -- when the compression ratio is significant. Using compression
+                                                   -- will make decoding time slower because it will add an extra
+                                                   -- decompression step.
 
   accessed INTEGER NOT NULL,                       -- Last time the resource was used by GL Native. Useful for when
                                                    -- evicting the least used resources from the cache.
 
   must_revalidate INTEGER NOT NULL DEFAULT 0,      -- When set to true, the resource will not be used unless it gets
                                                    -- first revalidated by the server.
+
+  blob_id INTEGER,                                 -- The blob holding the contents of the resource, NULL for a
+                                                   -- resource without content.
   UNIQUE (url)
 );
 
 --
 -- Table containing all tiles, both vector and raster.
 --
-CREATE TABLE tiles (
+CREATE TABLE IF NOT EXISTS tiles (
   id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,   -- Primary key.
 
   url_template TEXT NOT NULL,                      -- The URL of the resource without the access token and without
@@ -72,21 +81,40 @@ CREATE TABLE tiles (
                                                    -- get re-downloaded. See:
                                                    -- https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/ETag
 
-  data BLOB,                                       -- Contents of the tile.
+  data BLOB,                                       -- Not used since schema version 8, the contents are in `blobs`.
 
-  compressed INTEGER NOT NULL DEFAULT 0,           -- If the tile is compressed with Deflate or not. Compression is
-                                                   -- optional and should be used when the compression ratio is
-                                                   -- significant. Using compression will make decoding time slower
-                                                   -- because it will add an extra decompression step.
+  compressed INTEGER NOT NULL DEFAULT 0,           -- Codec of the tile data: 0 for none, 1 for Deflate (zlib) and
+                                                   -- 2 for Zstandard. Compression is optional and should be used
+                                                   -- when the compression ratio is significant. Using compression
+                                                   -- will make decoding time slower because it will add an extra
+                                                   -- decompression step.
 
   accessed INTEGER NOT NULL,                       -- Last time the tile was used by GL Native. Useful for when
                                                    -- evicting the least used tiles from the cache.
 
   must_revalidate INTEGER NOT NULL DEFAULT 0,      -- When set to true, the tile will not be used unless it gets
                                                    -- first revalidated by the server.
+
+  blob_id INTEGER,                                 -- The blob holding the contents of the tile, NULL for a tile
+                                                   -- without content.
   UNIQUE (url_template, pixel_ratio, z, x, y)
 );
 
+--
+-- Contents of the tiles and resources of regions, stored once for all the
+-- entries with the same bytes: ocean or empty land tiles are identical across
+-- many coordinates. The codec stays with each entry. `refs` counts the rows
+-- of `tiles` and `resources` that use a blob and is kept up to date by the
+-- triggers below, which delete a blob along with its last entry.
+--
+CREATE TABLE IF NOT EXISTS blobs (
+  id INTEGER NOT NULL PRIMARY KEY,
+  hash INTEGER NOT NULL,                           -- Length and CRC-32 of the data. Blobs with the same hash are
+                                                   -- compared byte for byte.
+  data BLOB NOT NULL,
+  refs INTEGER NOT NULL DEFAULT 0
+);
+
 --
 -- Regions define the offline regions, which could be a GeoJSON geometry,
 -- or a bounding box like this example:
@@ -116,7 +144,7 @@ CREATE TABLE tiles (
 -- by GL Native client side using local fonts. Downloading CJK
 -- will increase the size of the database considerably.
 --
-CREATE TABLE regions (
+CREATE TABLE IF NOT EXISTS regions (
   id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,    -- Primary key.
 
   definition TEXT NOT NULL,                         -- JSON formatted definition of a region, a bounding box
@@ -127,10 +155,9 @@ CREATE TABLE regions (
 
 --
 -- Table mapping resources to regions. A resource
--- might be part of many regions. Resources without
--- regions are part of the ambient cache.
+-- might be part of many regions.
 --
-CREATE TABLE region_resources (
+CREATE TABLE IF NOT EXISTS region_resources (
   region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,
   resource_id INTEGER NOT NULL REFERENCES resources(id),
   UNIQUE (region_id, resource_id)
@@ -139,27 +166,181 @@ CREATE TABLE region_resources (
 --
 -- Table mapping tiles to regions. A tile might
 -- be part of many regions, meaning that regions might
--- overlap efficiently. Tiles without regions are part
--- of the ambient cache.
+-- overlap efficiently.
 --
-CREATE TABLE region_tiles (
+CREATE TABLE IF NOT EXISTS region_tiles (
   region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,
   tile_id INTEGER NOT NULL REFERENCES tiles(id),
   UNIQUE (region_id, tile_id)
 );
 
+--
+-- Ambient cache resources, i.e. resources that were loaded while browsing the
+-- map and that are not part of any region. Same columns as `resources`, but
+-- the data is kept inline so that evicting an entry frees its bytes. A URL is
+-- stored either here or in `resources`, never in both: storing it for a
+-- region moves it out of the ambient cache.
+--
+CREATE TABLE IF NOT EXISTS ambient_resources (
+  id INTEGER NOT NULL PRIMARY KEY,
+  url TEXT NOT NULL,
+  kind INTEGER NOT NULL,
+  expires INTEGER,
+  modified INTEGER,
+  etag TEXT,
+  data BLOB,
+  compressed INTEGER NOT NULL DEFAULT 0,
+  accessed INTEGER NOT NULL,
+  must_revalidate INTEGER NOT NULL DEFAULT 0,
+  UNIQUE (url)
+);
+
+--
+-- Ambient cache tiles, the counterpart of `ambient_resources` for `tiles`.
+--
+CREATE TABLE IF NOT EXISTS ambient_tiles (
+  id INTEGER NOT NULL PRIMARY KEY,
+  url_template TEXT NOT NULL,
+  pixel_ratio INTEGER NOT NULL,
+  z INTEGER NOT NULL,
+  x INTEGER NOT NULL,
+  y INTEGER NOT NULL,
+  expires INTEGER,
+  modified INTEGER,
+  etag TEXT,
+  data BLOB,
+  compressed INTEGER NOT NULL DEFAULT 0,
+  accessed INTEGER NOT NULL,
+  must_revalidate INTEGER NOT NULL DEFAULT 0,
+  UNIQUE (url_template, pixel_ratio, z, x, y)
+);
+
+--
+-- Single row holding the size of the ambient cache in bytes, counted as the
+-- length of the data, URL and etag of every entry. Kept up to date by the
+-- triggers below, in the same transaction as the change itself, so that it
+-- never has to be recomputed. The update triggers only watch the counted
+-- columns that can change, so that refreshing `accessed` on every read
+-- doesn't rewrite this row.
+--
+CREATE TABLE IF NOT EXISTS ambient_cache_size (
+  size INTEGER NOT NULL
+);
+
+INSERT INTO ambient_cache_size (size) SELECT 0 WHERE NOT EXISTS (SELECT 1 FROM ambient_cache_size);
+
+CREATE TRIGGER IF NOT EXISTS ambient_resources_insert AFTER INSERT ON ambient_resources
+BEGIN
+  UPDATE ambient_cache_size SET size = size
+    + IFNULL(LENGTH(NEW.data), 0) + LENGTH(NEW.url) + IFNULL(LENGTH(NEW.etag), 0);
+END;
+
+CREATE TRIGGER IF NOT EXISTS ambient_resources_update AFTER UPDATE OF data, etag ON ambient_resources
+BEGIN
+  UPDATE ambient_cache_size SET size = size
+    + IFNULL(LENGTH(NEW.data), 0) + LENGTH(NEW.url) + IFNULL(LENGTH(NEW.etag), 0)
+    - IFNULL(LENGTH(OLD.data), 0) - LENGTH(OLD.url) - IFNULL(LENGTH(OLD.etag), 0);
+END;
+
+CREATE TRIGGER IF NOT EXISTS ambient_resources_delete AFTER DELETE ON ambient_resources
+BEGIN
+  UPDATE ambient_cache_size SET size = size
+    - IFNULL(LENGTH(OLD.data), 0) - LENGTH(OLD.url) - IFNULL(LENGTH(OLD.etag), 0);
+END;
+
+CREATE TRIGGER IF NOT EXISTS ambient_tiles_insert AFTER INSERT ON ambient_tiles
+BEGIN
+  UPDATE ambient_cache_size SET size = size
+    + IFNULL(LENGTH(NEW.data), 0) + LENGTH(NEW.url_template) + IFNULL(LENGTH(NEW.etag), 0);
+END;
+
+CREATE TRIGGER IF NOT EXISTS ambient_tiles_update AFTER UPDATE OF data, etag ON ambient_tiles
+BEGIN
+  UPDATE ambient_cache_size SET size = size
+    + IFNULL(LENGTH(NEW.data), 0) + LENGTH(NEW.url_template) + IFNULL(LENGTH(NEW.etag), 0)
+    - IFNULL(LENGTH(OLD.data), 0) - LENGTH(OLD.url_template) - IFNULL(LENGTH(OLD.etag), 0);
+END;
+
+CREATE TRIGGER IF NOT EXISTS ambient_tiles_delete AFTER DELETE ON ambient_tiles
+BEGIN
+  UPDATE ambient_cache_size SET size = size
+    - IFNULL(LENGTH(OLD.data), 0) - LENGTH(OLD.url_template) - IFNULL(LENGTH(OLD.etag), 0);
+END;
+
+CREATE TRIGGER IF NOT EXISTS resources_blob_insert AFTER INSERT ON resources
+WHEN NEW.blob_id IS NOT NULL
+BEGIN
+  UPDATE blobs SET refs = refs + 1 WHERE id = NEW.blob_id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS resources_blob_update AFTER UPDATE OF blob_id ON resources
+WHEN OLD.blob_id IS NOT NEW.blob_id
+BEGIN
+  UPDATE blobs SET refs = refs + 1 WHERE id = NEW.blob_id;
+  UPDATE blobs SET refs = refs - 1 WHERE id = OLD.blob_id;
+  DELETE FROM blobs WHERE id = OLD.blob_id AND refs = 0;
+END;
+
+CREATE TRIGGER IF NOT EXISTS resources_blob_delete AFTER DELETE ON resources
+WHEN OLD.blob_id IS NOT NULL
+BEGIN
+  UPDATE blobs SET refs = refs - 1 WHERE id = OLD.blob_id;
+  DELETE FROM blobs WHERE id = OLD.blob_id AND refs = 0;
+END;
+
+CREATE TRIGGER IF NOT EXISTS tiles_blob_insert AFTER INSERT ON tiles
+WHEN NEW.blob_id IS NOT NULL
+BEGIN
+  UPDATE blobs SET refs = refs + 1 WHERE id = NEW.blob_id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS tiles_blob_update AFTER UPDATE OF blob_id ON tiles
+WHEN OLD.blob_id IS NOT NEW.blob_id
+BEGIN
+  UPDATE blobs SET refs = refs + 1 WHERE id = NEW.blob_id;
+  UPDATE blobs SET refs = refs - 1 WHERE id = OLD.blob_id;
+  DELETE FROM blobs WHERE id = OLD.blob_id AND refs = 0;
+END;
+
+CREATE TRIGGER IF NOT EXISTS tiles_blob_delete AFTER DELETE ON tiles
+WHEN OLD.blob_id IS NOT NULL
+BEGIN
+  UPDATE blobs SET refs = refs - 1 WHERE id = OLD.blob_id;
+  DELETE FROM blobs WHERE id = OLD.blob_id AND refs = 0;
+END;
+
 --
 -- Indexes for efficient eviction queries.
 --
 
-CREATE INDEX resources_accessed
+CREATE INDEX IF NOT EXISTS resources_accessed
 ON resources (accessed);
 
-CREATE INDEX tiles_accessed
+CREATE INDEX IF NOT EXISTS tiles_accessed
 ON tiles (accessed);
 
-CREATE INDEX region_resources_resource_id
+CREATE INDEX IF NOT EXISTS region_resources_resource_id
 ON region_resources (resource_id);
 
-CREATE INDEX region_tiles_tile_id
+CREATE INDEX IF NOT EXISTS region_tiles_tile_id
 ON region_tiles (tile_id);
+
+CREATE INDEX IF NOT EXISTS ambient_resources_accessed
+ON ambient_resources (accessed);
+
+CREATE INDEX IF NOT EXISTS ambient_tiles_accessed
+ON ambient_tiles (accessed);
+
+--
+-- Indexes for finding blobs by content, and the few region entries that still
+-- hold their data inline, after a migration or a merge.
+--
+
+CREATE INDEX IF NOT EXISTS blobs_hash
+ON blobs (hash);
+
+CREATE INDEX IF NOT EXISTS resources_inline_data
+ON resources (id) WHERE data IS NOT NULL;
+
+CREATE INDEX IF NOT EXISTS tiles_inline_data
+ON tiles (id) WHERE data IS NOT NULL;
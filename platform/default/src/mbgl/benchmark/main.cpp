@@ -1,5 +1,52 @@
 #include <mbgl/benchmark.hpp>
+#include <mbgl/benchmark/allocation_counter.hpp>
+
+#include <new>
+
+#if !defined(SANITIZE)
+void* operator new(std::size_t sz) {
+    void* ptr = mbgl::AllocationCounter::allocate(sz ? sz : 1);
+    if (!ptr) throw std::bad_alloc{};
+
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    mbgl::AllocationCounter::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    mbgl::AllocationCounter::deallocate(ptr);
+}
+
+// Some standard libraries don't implement these on top of the plain forms.
+void* operator new(std::size_t sz, const std::nothrow_t&) noexcept {
+    return mbgl::AllocationCounter::allocate(sz ? sz : 1);
+}
+
+void* operator new(std::size_t sz, std::align_val_t al) {
+    void* ptr = mbgl::AllocationCounter::allocate(sz ? sz : 1, static_cast<std::size_t>(al));
+    if (!ptr) throw std::bad_alloc{};
+
+    return ptr;
+}
+
+void* operator new(std::size_t sz, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return mbgl::AllocationCounter::allocate(sz ? sz : 1, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* ptr, std::align_val_t al) noexcept {
+    mbgl::AllocationCounter::deallocate(ptr, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t al) noexcept {
+    mbgl::AllocationCounter::deallocate(ptr, static_cast<std::size_t>(al));
+}
+#endif
 
 int main(int argc, char* argv[]) {
+#if !defined(SANITIZE)
+    mbgl::AllocationCounter::setEnabled(true);
+#endif
     return mbgl::runBenchmark(argc, argv);
 }
@@ -92,6 +92,17 @@ public:
         callback(db->mergeDatabase(sideDatabasePath));
     }
 
+    void exportOfflineRegion(const int64_t regionID,
+                             const std::string& archivePath,
+                             const std::function<void(std::exception_ptr)>& callback) {
+        callback(db->exportRegion(regionID, archivePath));
+    }
+
+    void importOfflineRegion(const std::string& archivePath,
+                             const std::function<void(expected<OfflineRegion, std::exception_ptr>)>& callback) {
+        callback(db->importRegion(archivePath));
+    }
+
     void updateMetadata(const int64_t regionID,
                         const OfflineRegionMetadata& metadata,
                         const std::function<void(expected<OfflineRegionMetadata, std::exception_ptr>)>& callback) {
@@ -132,6 +143,8 @@ public:
 
     void reopenDatabaseReadOnly(bool readOnly) { db->reopenDatabaseReadOnly(readOnly); }
 
+    void setDataCodec(OfflineDataCodec codec) { db->setDataCodec(codec); }
+
 private:
     expected<OfflineDownload*, std::exception_ptr> getDownload(int64_t regionID) {
         if (!onlineFileSource) {
@@ -287,6 +300,18 @@ void DatabaseFileSource::mergeOfflineRegions(
     impl->actor().invoke(&DatabaseFileSourceThread::mergeOfflineRegions, sideDatabasePath, std::move(callback));
 }
 
+void DatabaseFileSource::exportOfflineRegion(const OfflineRegion& region,
+                                             const std::string& archivePath,
+                                             std::function<void(std::exception_ptr)> callback) {
+    impl->actor().invoke(
+        &DatabaseFileSourceThread::exportOfflineRegion, region.getID(), archivePath, std::move(callback));
+}
+
+void DatabaseFileSource::importOfflineRegion(
+    const std::string& archivePath, std::function<void(expected<OfflineRegion, std::exception_ptr>)> callback) {
+    impl->actor().invoke(&DatabaseFileSourceThread::importOfflineRegion, archivePath, std::move(callback));
+}
+
 void DatabaseFileSource::updateOfflineMetadata(
     const int64_t regionID,
     const OfflineRegionMetadata& metadata,
@@ -326,6 +351,9 @@ void DatabaseFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
 void DatabaseFileSource::setProperty(const std::string& key, const mapbox::base::Value& value) {
     if (key == READ_ONLY_MODE_KEY && value.getBool()) {
         impl->actor().invoke(&DatabaseFileSourceThread::reopenDatabaseReadOnly, *value.getBool());
+    } else if (key == ZSTD_DATA_CODEC_KEY && value.getBool()) {
+        impl->actor().invoke(&DatabaseFileSourceThread::setDataCodec,
+                             *value.getBool() ? OfflineDataCodec::Zstd : OfflineDataCodec::Zlib);
     } else {
         std::string message = "Resource provider does not support property " + key;
         Log::Error(Event::General, message.c_str());
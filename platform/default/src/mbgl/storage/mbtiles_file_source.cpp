@@ -1,5 +1,7 @@
-#include <sstream>
+#include <algorithm>
 #include <map>
+#include <sstream>
+#include <thread>
 
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/storage/mbtiles_file_source.hpp>
@@ -70,8 +72,6 @@ public:
         return std::string(buffer.GetString(), buffer.GetSize());
     }
 
-    std::string db_path(const std::string &path) { return path.substr(0, path.find('?')); }
-
     // Generate a tilejson resource from .mbtiles file
     void request_tilejson(const Resource &resource, ActorRef<FileSourceRequest> req) {
         const auto path = url_to_path(resource.url);
@@ -186,42 +186,6 @@ public:
         req.invoke(&FileSourceRequest::setResponse, response);
     }
 
-    // Load data for specific tile
-    void request_tile(const Resource &resource, ActorRef<FileSourceRequest> req) {
-        std::string base_path = url_to_path(resource.url);
-        std::string path = db_path(base_path);
-        auto &db = get_db(path);
-
-        int iy = resource.tileData->y;
-        int iz = resource.tileData->z;
-
-        auto x = std::to_string(resource.tileData->x);
-        auto y = std::to_string((int)(pow(2, iz) - 1) - iy);
-        auto z = std::to_string(iz);
-
-        std::string sql = "SELECT tile_data FROM tiles where zoom_level = " + z + " AND tile_column = " + x +
-                          " AND tile_row = " + y;
-        mapbox::sqlite::Statement stmt(db, sql.c_str());
-
-        Response response;
-        response.noContent = true;
-
-        for (mapbox::sqlite::Query q(stmt); q.run();) {
-            std::optional<std::string> data = q.get<std::optional<std::string>>(0);
-            if (data) {
-                response.data = std::make_shared<std::string>(*data);
-                response.noContent = false;
-                response.expires = Timestamp::max();
-                response.etag = resource.url;
-
-                if (util::is_compressed(*response.data)) {
-                    response.data = std::make_shared<std::string>(util::decompress(*response.data));
-                }
-            }
-        }
-        req.invoke(&FileSourceRequest::setResponse, response);
-    }
-
     void setResourceOptions(ResourceOptions options) {
         std::lock_guard<std::mutex> lock(resourceOptionsMutex);
         resourceOptions = options;
@@ -243,33 +207,89 @@ public:
     }
 
 private:
-    std::map<std::string, mapbox::sqlite::Database> db_cache;
+    mutable std::mutex resourceOptionsMutex;
+    mutable std::mutex clientOptionsMutex;
+    ResourceOptions resourceOptions;
+    ClientOptions clientOptions;
+};
 
-    void close_db(const std::string &path) {
-        auto ptr = db_cache.find(path);
-        if (ptr != db_cache.end()) {
-            db_cache.erase(path);
+// Reads the tiles of .mbtiles files, keeping a connection and its prepared
+// tile query open for every file.
+class MBTilesFileSource::TileReader {
+public:
+    explicit TileReader(const ActorRef<TileReader> &) {}
+
+    void request_tile(const Resource &resource, ActorRef<FileSourceRequest> req) {
+        Response response;
+        response.noContent = true;
+
+        try {
+            auto &connection = get_connection(db_path(url_to_path(resource.url)));
+
+            const int iz = resource.tileData->z;
+            mapbox::sqlite::Query query{*connection.tileStatement};
+            query.bind(1, iz);
+            query.bind(2, static_cast<int64_t>(resource.tileData->x));
+            query.bind(3, static_cast<int64_t>((int64_t(1) << iz) - 1 - resource.tileData->y));
+
+            if (query.run()) {
+                std::optional<std::string> data = query.get<std::optional<std::string>>(0);
+                if (data) {
+                    response.data = std::make_shared<std::string>(util::is_compressed(*data) ? util::decompress(*data)
+                                                                                             : std::move(*data));
+                    response.noContent = false;
+                    response.expires = Timestamp::max();
+                    response.etag = resource.url;
+                }
+            }
+        } catch (const std::exception &ex) {
+            response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other, ex.what());
         }
+
+        req.invoke(&FileSourceRequest::setResponse, response);
     }
 
-    void close_all() { db_cache.clear(); }
+private:
+    struct Connection {
+        explicit Connection(const std::string &path)
+            : db(mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)) {
+            // Map the file into memory rather than copying the pages into SQLite's cache
+            db.exec("PRAGMA mmap_size = " + std::to_string(mmapSize));
+
+            // Deduplicated files store the tiles in `images`, and `tiles` is a view joining it with `map`.
+            // Query the tables directly.
+            mapbox::sqlite::Statement schema(db,
+                                             "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name IN "
+                                             "('map', 'images')");
+            mapbox::sqlite::Query schemaQuery{schema};
+            const bool deduplicated = schemaQuery.run() && schemaQuery.get<int64_t>(0) == 2;
+
+            tileStatement = std::make_unique<mapbox::sqlite::Statement>(
+                db,
+                deduplicated ? "SELECT images.tile_data FROM map JOIN images ON images.tile_id = map.tile_id "
+                               "WHERE map.zoom_level = ?1 AND map.tile_column = ?2 AND map.tile_row = ?3"
+                             : "SELECT tile_data FROM tiles WHERE zoom_level = ?1 AND tile_column = ?2 AND "
+                               "tile_row = ?3");
+        }
+
+        mapbox::sqlite::Database db;
+        std::unique_ptr<mapbox::sqlite::Statement> tileStatement;
+    };
+
+    static constexpr uint64_t mmapSize = uint64_t(1) << 30;
+
+    static std::string db_path(const std::string &path) { return path.substr(0, path.find('?')); }
 
     // Multiple databases open simultaneously, to effectively support multiple .mbtiles maps
-    mapbox::sqlite::Database &get_db(const std::string &path) {
-        auto ptr = db_cache.find(path);
-        if (ptr != db_cache.end()) {
-            return ptr->second;
-        };
-
-        auto ptr2 = db_cache.insert(std::pair<std::string, mapbox::sqlite::Database>(
-            path, mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)));
-        return ptr2.first->second;
+    Connection &get_connection(const std::string &path) {
+        auto it = connections.find(path);
+        if (it == connections.end()) {
+            it = connections.emplace(path, std::make_unique<Connection>(path)).first;
+        }
+        return *it->second;
     }
 
-    mutable std::mutex resourceOptionsMutex;
-    mutable std::mutex clientOptionsMutex;
-    ResourceOptions resourceOptions;
-    ClientOptions clientOptions;
+    std::map<std::string, std::unique_ptr<Connection>> connections;
 };
 
 MBTilesFileSource::MBTilesFileSource(const ResourceOptions &resourceOptions, const ClientOptions &clientOptions)
@@ -277,14 +297,21 @@ MBTilesFileSource::MBTilesFileSource(const ResourceOptions &resourceOptions, con
           util::makeThreadPrioritySetter(platform::EXPERIMENTAL_THREAD_PRIORITY_FILE),
           "MBTilesFileSource",
           resourceOptions.clone(),
-          clientOptions.clone())) {}
+          clientOptions.clone())) {
+    const std::size_t readerCount = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+    for (std::size_t i = 0; i < readerCount; ++i) {
+        tileReaders.push_back(std::make_unique<util::Thread<TileReader>>(
+            util::makeThreadPrioritySetter(platform::EXPERIMENTAL_THREAD_PRIORITY_FILE), "MBTilesFileSource"));
+    }
+}
 
 std::unique_ptr<AsyncRequest> MBTilesFileSource::request(const Resource &resource, FileSource::Callback callback) {
     auto req = std::make_unique<FileSourceRequest>(std::move(callback));
 
     // assume if there is a tile request, that the mbtiles file has been validated
     if (resource.kind == Resource::Tile) {
-        thread->actor().invoke(&Impl::request_tile, resource, req->actor());
+        auto &reader = *tileReaders[nextTileReader++ % tileReaders.size()];
+        reader.actor().invoke(&TileReader::request_tile, resource, req->actor());
         return req;
     }
 
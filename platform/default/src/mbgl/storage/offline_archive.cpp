@@ -0,0 +1,305 @@
+#include <mbgl/storage/offline_archive.hpp>
+
+#include <zlib.h>
+
+#include <array>
+#include <cassert>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace mbgl {
+
+namespace {
+
+constexpr std::array<char, 8> magic{{'M', 'L', 'N', 'O', 'F', 'F', 'L', 'N'}};
+constexpr uint32_t version = 1;
+
+// Larger records are treated as corrupt rather than allocated.
+constexpr uint32_t maxRecordSize = 1 << 30;
+
+enum class RecordType : uint8_t {
+    End = 0,
+    Region = 1,
+    Resource = 2,
+    Tile = 3,
+};
+
+enum class DataType : uint8_t {
+    None = 0,
+    Inline = 1,
+    Copy = 2,
+};
+
+[[noreturn]] void corrupt() {
+    throw std::runtime_error("Offline archive is corrupt");
+}
+
+template <typename T>
+void put(std::string& out, T value) {
+    static_assert(std::is_integral_v<T>);
+    using Unsigned = std::make_unsigned_t<T>;
+    auto bits = static_cast<Unsigned>(value);
+    for (std::size_t i = 0; i < sizeof(T); i++) {
+        out.push_back(static_cast<char>(bits & 0xFF));
+        bits = static_cast<Unsigned>(bits >> 8);
+    }
+}
+
+void putString(std::string& out, const std::string& value) {
+    if (value.size() > maxRecordSize) {
+        throw std::runtime_error("Offline archive record is too large");
+    }
+    put(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+void putTimestamp(std::string& out, const std::optional<Timestamp>& value) {
+    put(out, static_cast<uint8_t>(bool(value)));
+    if (value) {
+        put(out, static_cast<int64_t>(value->time_since_epoch().count()));
+    }
+}
+
+// Reads the fields of a record payload in order.
+class Cursor {
+public:
+    explicit Cursor(const std::string& data_)
+        : data(data_) {}
+
+    template <typename T>
+    T get() {
+        static_assert(std::is_integral_v<T>);
+        using Unsigned = std::make_unsigned_t<T>;
+        const auto bytes = take(sizeof(T));
+        Unsigned bits = 0;
+        for (std::size_t i = sizeof(T); i-- > 0;) {
+            bits = static_cast<Unsigned>((bits << 8) | static_cast<uint8_t>(bytes[i]));
+        }
+        return static_cast<T>(bits);
+    }
+
+    std::string getString() { return std::string(take(get<uint32_t>())); }
+
+    std::optional<Timestamp> getTimestamp() {
+        if (!get<uint8_t>()) return std::nullopt;
+        return Timestamp(Seconds(get<int64_t>()));
+    }
+
+private:
+    std::string_view take(std::size_t size) {
+        if (size > data.size() - offset) corrupt();
+        std::string_view result(data.data() + offset, size);
+        offset += size;
+        return result;
+    }
+
+    const std::string& data;
+    std::size_t offset = 0;
+};
+
+uint32_t crc(uint32_t checksum, const void* data, std::size_t size) {
+    return static_cast<uint32_t>(::crc32(checksum, static_cast<const Bytef*>(data), static_cast<uInt>(size)));
+}
+
+} // namespace
+
+OfflineArchiveWriter::OfflineArchiveWriter(const std::string& path)
+    : file(path, std::ios::binary | std::ios::trunc),
+      checksum(crc(0, nullptr, 0)) {
+    if (!file.good()) {
+        throw std::runtime_error("Cannot create offline archive " + path);
+    }
+
+    write(magic.data(), magic.size());
+    std::string header;
+    put(header, version);
+    write(header.data(), header.size());
+}
+
+void OfflineArchiveWriter::writeRegion(const std::string& definition, const std::vector<uint8_t>& metadata) {
+    record.clear();
+    putString(record, definition);
+    putString(record, std::string(metadata.begin(), metadata.end()));
+    writeRecord(static_cast<uint8_t>(RecordType::Region));
+}
+
+std::optional<uint32_t> OfflineArchiveWriter::writeEntry(const OfflineArchiveEntry& entry) {
+    record.clear();
+    if (entry.isTile) {
+        putString(record, entry.url);
+        put(record, entry.pixelRatio);
+        put(record, entry.z);
+        put(record, entry.x);
+        put(record, entry.y);
+    } else {
+        put(record, static_cast<uint8_t>(entry.kind));
+        putString(record, entry.url);
+    }
+
+    put(record, static_cast<uint8_t>(bool(entry.etag)));
+    if (entry.etag) {
+        putString(record, *entry.etag);
+    }
+    putTimestamp(record, entry.expires);
+    putTimestamp(record, entry.modified);
+    put(record, static_cast<uint8_t>(entry.mustRevalidate));
+
+    std::optional<uint32_t> blob;
+    if (entry.blob) {
+        assert(*entry.blob < blobCount);
+        put(record, static_cast<uint8_t>(DataType::Copy));
+        put(record, *entry.blob);
+        blob = entry.blob;
+    } else if (entry.data) {
+        put(record, static_cast<uint8_t>(DataType::Inline));
+        put(record, static_cast<uint8_t>(entry.codec));
+        putString(record, *entry.data);
+        blob = blobCount++;
+    } else {
+        put(record, static_cast<uint8_t>(DataType::None));
+    }
+
+    writeRecord(static_cast<uint8_t>(entry.isTile ? RecordType::Tile : RecordType::Resource));
+    return blob;
+}
+
+void OfflineArchiveWriter::finish() {
+    std::string end;
+    put(end, static_cast<uint8_t>(RecordType::End));
+    put(end, static_cast<uint32_t>(sizeof(checksum)));
+    put(end, checksum);
+    write(end.data(), end.size());
+
+    file.flush();
+    if (!file.good()) {
+        throw std::runtime_error("Cannot write offline archive");
+    }
+}
+
+void OfflineArchiveWriter::writeRecord(uint8_t type) {
+    if (record.size() > maxRecordSize) {
+        throw std::runtime_error("Offline archive record is too large");
+    }
+
+    std::string header;
+    put(header, type);
+    put(header, static_cast<uint32_t>(record.size()));
+    write(header.data(), header.size());
+    write(record.data(), record.size());
+}
+
+void OfflineArchiveWriter::write(const void* data, std::size_t size) {
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!file.good()) {
+        throw std::runtime_error("Cannot write offline archive");
+    }
+    checksum = crc(checksum, data, size);
+}
+
+OfflineArchiveReader::OfflineArchiveReader(const std::string& path)
+    : file(path, std::ios::binary),
+      checksum(crc(0, nullptr, 0)) {
+    if (!file.good()) {
+        throw std::runtime_error("Cannot read offline archive " + path);
+    }
+
+    std::array<char, magic.size()> fileMagic;
+    read(fileMagic.data(), fileMagic.size());
+    if (fileMagic != magic) {
+        throw std::runtime_error("Not an offline archive");
+    }
+
+    std::string header(sizeof(uint32_t), '\0');
+    read(header.data(), header.size());
+    if (Cursor(header).get<uint32_t>() > version) {
+        throw std::runtime_error("Unsupported offline archive version");
+    }
+}
+
+std::pair<std::string, std::vector<uint8_t>> OfflineArchiveReader::readRegion() {
+    if (!readRecord() || type != static_cast<uint8_t>(RecordType::Region)) corrupt();
+
+    Cursor cursor(record);
+    auto definition = cursor.getString();
+    const auto metadata = cursor.getString();
+    return {std::move(definition), std::vector<uint8_t>(metadata.begin(), metadata.end())};
+}
+
+std::optional<OfflineArchiveEntry> OfflineArchiveReader::next() {
+    while (readRecord()) {
+        if (type != static_cast<uint8_t>(RecordType::Resource) && type != static_cast<uint8_t>(RecordType::Tile)) {
+            continue;
+        }
+
+        Cursor cursor(record);
+        OfflineArchiveEntry entry;
+        entry.isTile = type == static_cast<uint8_t>(RecordType::Tile);
+        if (entry.isTile) {
+            entry.kind = Resource::Kind::Tile;
+            entry.url = cursor.getString();
+            entry.pixelRatio = cursor.get<uint8_t>();
+            entry.z = cursor.get<uint8_t>();
+            entry.x = cursor.get<int32_t>();
+            entry.y = cursor.get<int32_t>();
+        } else {
+            entry.kind = static_cast<Resource::Kind>(cursor.get<uint8_t>());
+            entry.url = cursor.getString();
+        }
+
+        if (cursor.get<uint8_t>()) {
+            entry.etag = cursor.getString();
+        }
+        entry.expires = cursor.getTimestamp();
+        entry.modified = cursor.getTimestamp();
+        entry.mustRevalidate = cursor.get<uint8_t>() != 0;
+
+        switch (static_cast<DataType>(cursor.get<uint8_t>())) {
+            case DataType::None:
+                break;
+            case DataType::Inline:
+                entry.codec = cursor.get<uint8_t>();
+                entry.data = cursor.getString();
+                break;
+            case DataType::Copy:
+                entry.blob = cursor.get<uint32_t>();
+                break;
+            default:
+                corrupt();
+        }
+
+        return entry;
+    }
+    return std::nullopt;
+}
+
+bool OfflineArchiveReader::readRecord() {
+    const uint32_t checksumBefore = checksum;
+
+    std::string header(sizeof(uint8_t) + sizeof(uint32_t), '\0');
+    read(header.data(), header.size());
+    Cursor cursor(header);
+    type = cursor.get<uint8_t>();
+    const auto size = cursor.get<uint32_t>();
+    if (size > maxRecordSize) corrupt();
+
+    record.resize(size);
+    read(record.data(), record.size());
+
+    if (type == static_cast<uint8_t>(RecordType::End)) {
+        if (Cursor(record).get<uint32_t>() != checksumBefore) corrupt();
+        return false;
+    }
+    return true;
+}
+
+void OfflineArchiveReader::read(void* data, std::size_t size) {
+    file.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    if (static_cast<std::size_t>(file.gcount()) != size) {
+        throw std::runtime_error("Offline archive is truncated");
+    }
+    checksum = crc(checksum, data, size);
+}
+
+} // namespace mbgl
@@ -1,7 +1,9 @@
 #include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/offline_archive.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/sqlite3.hpp>
 #include <mbgl/util/compression.hpp>
+#include <mbgl/util/containers.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/chrono.hpp>
@@ -11,11 +13,60 @@
 #include <mbgl/storage/offline_schema.hpp>
 #include <mbgl/storage/merge_sideloaded.hpp>
 
+#include <zlib.h>
+
 namespace mbgl {
 
+namespace {
+
+std::string encodeData(const std::string& data, OfflineDataCodec codec) {
+    switch (codec) {
+        case OfflineDataCodec::Zlib:
+            return util::compress(data);
+        case OfflineDataCodec::Zstd:
+            return util::compress_zstd(data);
+        case OfflineDataCodec::None:
+            break;
+    }
+    return data;
+}
+
+// Throws for codecs this build can't decode, e.g. Zstd entries written by a
+// build with zstd support. The caller treats that like any other read error,
+// and the resource is fetched from the network again.
+std::string decodeData(std::string data, int64_t codec) {
+    switch (static_cast<OfflineDataCodec>(codec)) {
+        case OfflineDataCodec::None:
+            return data;
+        case OfflineDataCodec::Zlib:
+            return util::decompress(data);
+        case OfflineDataCodec::Zstd:
+            return util::decompress_zstd(data);
+    }
+    throw std::runtime_error("Unknown data codec " + std::to_string(codec));
+}
+
+// The highest codec this build can decode. Entries with another codec are
+// refused when they come from another database, they could never be read.
+OfflineDataCodec maxSupportedCodec() {
+    return util::zstd_supported() ? OfflineDataCodec::Zstd : OfflineDataCodec::Zlib;
+}
+
+// Key of a blob in the `blobs` table, its length and CRC-32. Blobs with the
+// same key are compared byte for byte, so it only has to tell most contents
+// apart, and it has to stay the same across builds and platforms.
+int64_t blobHash(const std::string& data) {
+    const auto crc = ::crc32(
+        ::crc32(0, nullptr, 0), reinterpret_cast<const Bytef*>(data.data()), static_cast<uInt>(data.size()));
+    return static_cast<int64_t>((static_cast<uint64_t>(data.size()) << 32) | (crc & 0xFFFFFFFF));
+}
+
+} // namespace
+
 OfflineDatabase::OfflineDatabase(std::string path_, const TileServerOptions& options)
     : path(std::move(path_)),
-      tileServerOptions(options) {
+      tileServerOptions(options),
+      dataCodec(OfflineDataCodec::Zlib) {
     try {
         initialize();
     } catch (...) {
@@ -45,6 +96,8 @@ void OfflineDatabase::initialize() {
         mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadWriteCreate));
     db->setBusyTimeout(Milliseconds::max());
     db->exec("PRAGMA foreign_keys = ON");
+    // Rows that REPLACE deletes release their blob through the delete triggers.
+    db->exec("PRAGMA recursive_triggers = ON");
 
     const auto userVersion = getPragma<int64_t>("PRAGMA user_version");
     switch (userVersion) {
@@ -67,6 +120,12 @@ void OfflineDatabase::initialize() {
             migrateToVersion6();
             // fall through
         case 6:
+            migrateToVersion7();
+            // fall through
+        case 7:
+            migrateToVersion8();
+            // fall through
+        case 8:
             // Happy path; we're done
             return;
         default:
@@ -173,7 +232,7 @@ void OfflineDatabase::createSchema() {
     db->exec("PRAGMA synchronous = FULL");
     mapbox::sqlite::Transaction transaction(*db);
     db->exec(offlineDatabaseSchema);
-    db->exec("PRAGMA user_version = 6");
+    db->exec("PRAGMA user_version = 8");
     transaction.commit();
 }
 
@@ -215,6 +274,125 @@ void OfflineDatabase::migrateToVersion6() {
     transaction.commit();
 }
 
+void OfflineDatabase::migrateToVersion7() {
+    assert(db);
+    checkFlags();
+
+    // The ambient cache moves to its own tables. This is the last time the
+    // entries that do not belong to a region have to be searched for.
+    mapbox::sqlite::Transaction transaction(*db);
+    addBlobColumns();
+    db->exec(offlineDatabaseSchema);
+    // clang-format off
+    db->exec(
+        "INSERT INTO ambient_tiles (url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed, must_revalidate) "
+        "SELECT                     url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed, must_revalidate "
+        "FROM tiles "
+        "WHERE id NOT IN (SELECT tile_id FROM region_tiles)");
+    db->exec("DELETE FROM tiles WHERE id NOT IN (SELECT tile_id FROM region_tiles)");
+    db->exec(
+        "INSERT INTO ambient_resources (url, kind, expires, modified, etag, data, compressed, accessed, must_revalidate) "
+        "SELECT                         url, kind, expires, modified, etag, data, compressed, accessed, must_revalidate "
+        "FROM resources "
+        "WHERE id NOT IN (SELECT resource_id FROM region_resources)");
+    db->exec("DELETE FROM resources WHERE id NOT IN (SELECT resource_id FROM region_resources)");
+    // clang-format on
+    db->exec("PRAGMA user_version = 7");
+    transaction.commit();
+
+    if (autopack) vacuum();
+}
+
+void OfflineDatabase::migrateToVersion8() {
+    assert(db);
+    checkFlags();
+
+    // The data of region entries moves to `blobs`, where identical contents
+    // are stored once.
+    mapbox::sqlite::Transaction transaction(*db);
+    addBlobColumns();
+    db->exec(offlineDatabaseSchema);
+    moveDataToBlobs();
+    db->exec("PRAGMA user_version = 8");
+    transaction.commit();
+
+    if (autopack) vacuum();
+}
+
+// The triggers of the schema use these columns, so every migration that
+// applies the schema adds them first.
+void OfflineDatabase::addBlobColumns() {
+    {
+        mapbox::sqlite::Query query{
+            getStatement("SELECT COUNT(*) FROM pragma_table_info('tiles') WHERE name = 'blob_id'")};
+        if (query.run() && query.get<int64_t>(0) != 0) {
+            return;
+        }
+    }
+
+    db->exec("ALTER TABLE tiles ADD COLUMN blob_id INTEGER");
+    db->exec("ALTER TABLE resources ADD COLUMN blob_id INTEGER");
+}
+
+// Moves the data that region entries hold inline, after a migration or a
+// merge, to `blobs`.
+void OfflineDatabase::moveDataToBlobs() {
+    for (const bool tile : {true, false}) {
+        std::vector<int64_t> rows;
+        {
+            mapbox::sqlite::Query query{getStatement(tile ? "SELECT id FROM tiles WHERE data IS NOT NULL"
+                                                          : "SELECT id FROM resources WHERE data IS NOT NULL")};
+            while (query.run()) {
+                rows.push_back(query.get<int64_t>(0));
+            }
+        }
+        for (const int64_t row : rows) {
+            moveDataToBlob(tile, row);
+        }
+    }
+}
+
+void OfflineDatabase::moveDataToBlob(bool tile, int64_t row) {
+    std::optional<std::string> data;
+    {
+        mapbox::sqlite::Query query{getStatement(tile ? "SELECT data FROM tiles WHERE id = ?1"
+                                                      : "SELECT data FROM resources WHERE id = ?1")};
+        query.bind(1, row);
+        if (query.run()) {
+            data = query.get<std::optional<std::string>>(0);
+        }
+    }
+    if (!data) {
+        return;
+    }
+
+    mapbox::sqlite::Query query{getStatement(tile ? "UPDATE tiles SET data = NULL, blob_id = ?1 WHERE id = ?2"
+                                                  : "UPDATE resources SET data = NULL, blob_id = ?1 WHERE id = ?2")};
+    query.bind(1, putBlob(*data));
+    query.bind(2, row);
+    query.run();
+}
+
+// Returns the blob holding `data`, which is added if there is none. A new
+// blob has no references until an entry uses it.
+int64_t OfflineDatabase::putBlob(const std::string& data) {
+    const int64_t hash = blobHash(data);
+    {
+        mapbox::sqlite::Query query{getStatement("SELECT id FROM blobs WHERE hash = ?1 AND data = ?2 LIMIT 1")};
+        query.bind(1, hash);
+        query.bindBlob(2, data.data(), data.size(), false);
+        if (query.run()) {
+            return query.get<int64_t>(0);
+        }
+    }
+
+    mapbox::sqlite::Query query{getStatement("INSERT INTO blobs (hash, data) VALUES (?1, ?2)")};
+    query.bind(1, hash);
+    query.bindBlob(2, data.data(), data.size(), false);
+    query.run();
+    return query.lastInsertRowId();
+}
+
 void OfflineDatabase::vacuum() {
     assert(db);
     checkFlags();
@@ -296,63 +474,55 @@ std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const R
 
 std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
                                                        const Response& response,
-                                                       bool evict_) {
+                                                       bool ambient) {
     checkFlags();
 
     if (response.error) {
         return {false, 0};
     }
 
-    std::string compressedData;
-    bool compressed = false;
+    std::string encodedData;
+    OfflineDataCodec codec = OfflineDataCodec::None;
     uint64_t size = 0;
 
     if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
+        if (dataCodec != OfflineDataCodec::None) {
+            encodedData = encodeData(*response.data, dataCodec);
+            if (encodedData.size() < response.data->size()) {
+                codec = dataCodec;
+            }
+        }
+        size = codec != OfflineDataCodec::None ? encodedData.size() : response.data->size();
     }
 
-    std::optional<DatabaseSizeChangeStats> stats;
-    if (evict_) {
-        stats = DatabaseSizeChangeStats(this);
-        if (!evict(size, *stats)) {
-            Log::Info(Event::Database, "Unable to make space for entry");
-            return {false, 0};
-        }
+    if (ambient && !evict(size)) {
+        Log::Info(Event::Database, "Unable to make space for entry");
+        return {false, 0};
     }
 
+    const std::string& data = codec != OfflineDataCodec::None ? encodedData
+                              : response.data                 ? *response.data
+                                                              : encodedData;
+
     bool inserted;
 
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        inserted = putTile(*resource.tileData,
-                           response,
-                           compressed      ? compressedData
-                           : response.data ? *response.data
-                                           : "",
-                           compressed);
+        inserted = putTile(*resource.tileData, response, data, codec, ambient);
     } else {
-        inserted = putResource(resource,
-                               response,
-                               compressed      ? compressedData
-                               : response.data ? *response.data
-                                               : "",
-                               compressed);
-    }
-
-    if (stats) {
-        updateAmbientCacheSize(*stats);
+        inserted = putResource(resource, response, data, codec, ambient);
     }
 
     return {inserted, size};
 }
 
 std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
-    // Update accessed timestamp used for LRU eviction.
+    // Update accessed timestamp used for LRU eviction. Only the ambient cache
+    // is evicted, so region resources don't need it.
     if (!readOnly) {
         try {
-            mapbox::sqlite::Query accessedQuery{getStatement("UPDATE resources SET accessed = ?1 WHERE url = ?2")};
+            mapbox::sqlite::Query accessedQuery{
+                getStatement("UPDATE ambient_resources SET accessed = ?1 WHERE url = ?2")};
             accessedQuery.bind(1, util::now());
             accessedQuery.bind(2, resource.url);
             accessedQuery.run();
@@ -369,10 +539,16 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const
 
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
-        //        0      1            2            3       4      5
+        //          0          1             2                3         4         5
+        "SELECT r.etag, r.expires, r.must_revalidate, r.modified, b.data, r.compressed "
+        "FROM resources r "
+        "LEFT JOIN blobs b ON b.id = r.blob_id "
+        "WHERE r.url = ?1 "
+        "UNION ALL "
         "SELECT etag, expires, must_revalidate, modified, data, compressed "
-        "FROM resources "
-        "WHERE url = ?") };
+        "FROM ambient_resources "
+        "WHERE url = ?1 "
+        "LIMIT 1") };
     // clang-format on
 
     query.bind(1, resource.url);
@@ -392,19 +568,22 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const
     auto data = query.get<std::optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(decodeData(std::move(*data), query.get<int64_t>(5)));
     }
 
     return std::make_pair(response, size);
 }
 
 std::optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
-    mapbox::sqlite::Query query{getStatement("SELECT length(data) FROM resources WHERE url = ?")};
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "SELECT length(b.data) FROM resources r LEFT JOIN blobs b ON b.id = r.blob_id WHERE r.url = ?1 "
+        "UNION ALL "
+        "SELECT length(data) FROM ambient_resources WHERE url = ?1 "
+        "LIMIT 1") };
+    // clang-format on
     query.bind(1, resource.url);
     if (!query.run()) {
         return std::nullopt;
@@ -416,31 +595,110 @@ std::optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
                                   const std::string& data,
-                                  bool compressed) {
+                                  OfflineDataCodec codec,
+                                  bool ambient) {
     checkFlags();
 
+    // A URL is stored either for a region or in the ambient cache. Ambient
+    // loads of a URL that belongs to a region refresh the region copy.
     if (response.notModified) {
+        auto notModified = [&](mapbox::sqlite::Statement& statement) {
+            mapbox::sqlite::Query notModifiedQuery{statement};
+            notModifiedQuery.bind(1, util::now());
+            notModifiedQuery.bind(2, response.expires);
+            notModifiedQuery.bind(3, response.mustRevalidate);
+            notModifiedQuery.bind(4, resource.url);
+            notModifiedQuery.run();
+            return notModifiedQuery.changes() != 0;
+        };
+
         // clang-format off
-        mapbox::sqlite::Query notModifiedQuery{ getStatement(
+        if (!notModified(getStatement(
             "UPDATE resources "
             "SET accessed         = ?1, "
             "    expires          = ?2, "
             "    must_revalidate  = ?3 "
-            "WHERE url    = ?4 ") };
+            "WHERE url    = ?4 ")) && ambient) {
+            notModified(getStatement(
+                "UPDATE ambient_resources "
+                "SET accessed         = ?1, "
+                "    expires          = ?2, "
+                "    must_revalidate  = ?3 "
+                "WHERE url    = ?4 "));
+        }
         // clang-format on
-
-        notModifiedQuery.bind(1, util::now());
-        notModifiedQuery.bind(2, response.expires);
-        notModifiedQuery.bind(3, response.mustRevalidate);
-        notModifiedQuery.bind(4, resource.url);
-        notModifiedQuery.run();
         return false;
     }
 
+    // Region copies keep their data in `blobs`, see putBlob(). The ambient
+    // cache keeps it inline.
+    std::optional<int64_t> row;
+    {
+        mapbox::sqlite::Query rowQuery{getStatement("SELECT id FROM resources WHERE url = ?1")};
+        rowQuery.bind(1, resource.url);
+        if (rowQuery.run()) {
+            row = rowQuery.get<int64_t>(0);
+        }
+    }
+
+    if (row || !ambient) {
+        auto bindData = [&](mapbox::sqlite::Query& query, int blobOffset, int codecOffset) {
+            if (response.noContent) {
+                query.bind(blobOffset, nullptr);
+                query.bind(codecOffset, false);
+            } else {
+                query.bind(blobOffset, putBlob(data));
+                query.bind(codecOffset, static_cast<int64_t>(codec));
+            }
+        };
+
+        if (row) {
+            // clang-format off
+            mapbox::sqlite::Query updateQuery{ getStatement(
+                "UPDATE resources "
+                "SET kind            = ?1, "
+                "    etag            = ?2, "
+                "    expires         = ?3, "
+                "    must_revalidate = ?4, "
+                "    modified        = ?5, "
+                "    accessed        = ?6, "
+                "    blob_id         = ?7, "
+                "    compressed      = ?8 "
+                "WHERE id            = ?9 ") };
+            // clang-format on
+            updateQuery.bind(1, int(resource.kind));
+            updateQuery.bind(2, response.etag);
+            updateQuery.bind(3, response.expires);
+            updateQuery.bind(4, response.mustRevalidate);
+            updateQuery.bind(5, response.modified);
+            updateQuery.bind(6, util::now());
+            bindData(updateQuery, 7, 8);
+            updateQuery.bind(9, *row);
+            updateQuery.run();
+            return false;
+        }
+
+        // clang-format off
+        mapbox::sqlite::Query insertQuery{ getStatement(
+            "INSERT INTO resources (url, kind, etag, expires, must_revalidate, modified, accessed, blob_id, compressed) "
+            "VALUES                (?1,  ?2,   ?3,   ?4,      ?5,              ?6,       ?7,       ?8,      ?9) ") };
+        // clang-format on
+        insertQuery.bind(1, resource.url);
+        insertQuery.bind(2, int(resource.kind));
+        insertQuery.bind(3, response.etag);
+        insertQuery.bind(4, response.expires);
+        insertQuery.bind(5, response.mustRevalidate);
+        insertQuery.bind(6, response.modified);
+        insertQuery.bind(7, util::now());
+        bindData(insertQuery, 8, 9);
+        insertQuery.run();
+        return true;
+    }
+
     // We can't use REPLACE because it would change the id value.
     // clang-format off
     mapbox::sqlite::Query updateQuery{ getStatement(
-        "UPDATE resources "
+        "UPDATE ambient_resources "
         "SET kind            = ?1, "
         "    etag            = ?2, "
         "    expires         = ?3, "
@@ -451,7 +709,6 @@ bool OfflineDatabase::putResource(const Resource& resource,
         "    compressed      = ?8 "
         "WHERE url           = ?9 ") };
     // clang-format on
-
     updateQuery.bind(1, int(resource.kind));
     updateQuery.bind(2, response.etag);
     updateQuery.bind(3, response.expires);
@@ -465,7 +722,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         updateQuery.bind(8, false);
     } else {
         updateQuery.bindBlob(7, data.data(), data.size(), false);
-        updateQuery.bind(8, compressed);
+        updateQuery.bind(8, static_cast<int64_t>(codec));
     }
 
     updateQuery.run();
@@ -475,8 +732,8 @@ bool OfflineDatabase::putResource(const Resource& resource,
 
     // clang-format off
     mapbox::sqlite::Query insertQuery{ getStatement(
-        "INSERT INTO resources (url, kind, etag, expires, must_revalidate, modified, accessed, data, compressed) "
-        "VALUES                (?1,  ?2,   ?3,   ?4,      ?5,              ?6,       ?7,       ?8,   ?9) ") };
+        "INSERT INTO ambient_resources (url, kind, etag, expires, must_revalidate, modified, accessed, data, compressed) "
+        "VALUES                        (?1,  ?2,   ?3,   ?4,      ?5,              ?6,       ?7,       ?8,   ?9) ") };
     // clang-format on
 
     insertQuery.bind(1, resource.url);
@@ -492,7 +749,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         insertQuery.bind(9, false);
     } else {
         insertQuery.bindBlob(8, data.data(), data.size(), false);
-        insertQuery.bind(9, compressed);
+        insertQuery.bind(9, static_cast<int64_t>(codec));
     }
 
     insertQuery.run();
@@ -501,12 +758,13 @@ bool OfflineDatabase::putResource(const Resource& resource,
 }
 
 std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile) {
-    // Update accessed timestamp used for LRU eviction.
+    // Update accessed timestamp used for LRU eviction. Only the ambient cache
+    // is evicted, so region tiles don't need it.
     if (!readOnly) {
         try {
             // clang-format off
             mapbox::sqlite::Query accessedQuery{ getStatement(
-                "UPDATE tiles "
+                "UPDATE ambient_tiles "
                 "SET accessed       = ?1 "
                 "WHERE url_template = ?2 "
                 "  AND pixel_ratio  = ?3 "
@@ -535,14 +793,24 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
 
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
-        //        0      1           2,            3,      4,      5
+        //          0          1             2,               3,        4,        5
+        "SELECT t.etag, t.expires, t.must_revalidate, t.modified, b.data, t.compressed "
+        "FROM tiles t "
+        "LEFT JOIN blobs b ON b.id = t.blob_id "
+        "WHERE t.url_template = ?1 "
+        "  AND t.pixel_ratio  = ?2 "
+        "  AND t.x            = ?3 "
+        "  AND t.y            = ?4 "
+        "  AND t.z            = ?5 "
+        "UNION ALL "
         "SELECT etag, expires, must_revalidate, modified, data, compressed "
-        "FROM tiles "
+        "FROM ambient_tiles "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
         "  AND x            = ?3 "
         "  AND y            = ?4 "
-        "  AND z            = ?5 ") };
+        "  AND z            = ?5 "
+        "LIMIT 1") };
     // clang-format on
 
     query.bind(1, tile.urlTemplate);
@@ -566,12 +834,9 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
     std::optional<std::string> data = query.get<std::optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(decodeData(std::move(*data), query.get<int64_t>(5)));
     }
 
     return std::make_pair(response, size);
@@ -580,13 +845,23 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
 std::optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
     // clang-format off
     mapbox::sqlite::Query size{ getStatement(
+        "SELECT length(b.data) "
+        "FROM tiles t "
+        "LEFT JOIN blobs b ON b.id = t.blob_id "
+        "WHERE t.url_template = ?1 "
+        "  AND t.pixel_ratio  = ?2 "
+        "  AND t.x            = ?3 "
+        "  AND t.y            = ?4 "
+        "  AND t.z            = ?5 "
+        "UNION ALL "
         "SELECT length(data) "
-        "FROM tiles "
+        "FROM ambient_tiles "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
         "  AND x            = ?3 "
         "  AND y            = ?4 "
-        "  AND z            = ?5 ") };
+        "  AND z            = ?5 "
+        "LIMIT 1") };
     // clang-format on
 
     size.bind(1, tile.urlTemplate);
@@ -605,12 +880,28 @@ std::optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile)
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
-                              bool compressed) {
+                              OfflineDataCodec codec,
+                              bool ambient) {
     checkFlags();
 
+    // See putResource(): ambient loads of a region tile refresh the region copy.
     if (response.notModified) {
+        auto notModified = [&](mapbox::sqlite::Statement& statement) {
+            mapbox::sqlite::Query notModifiedQuery{statement};
+            notModifiedQuery.bind(1, util::now());
+            notModifiedQuery.bind(2, response.expires);
+            notModifiedQuery.bind(3, response.mustRevalidate);
+            notModifiedQuery.bind(4, tile.urlTemplate);
+            notModifiedQuery.bind(5, tile.pixelRatio);
+            notModifiedQuery.bind(6, tile.x);
+            notModifiedQuery.bind(7, tile.y);
+            notModifiedQuery.bind(8, tile.z);
+            notModifiedQuery.run();
+            return notModifiedQuery.changes() != 0;
+        };
+
         // clang-format off
-        mapbox::sqlite::Query notModifiedQuery{ getStatement(
+        if (!notModified(getStatement(
             "UPDATE tiles "
             "SET accessed        = ?1, "
             "    expires         = ?2, "
@@ -619,26 +910,103 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
             "  AND pixel_ratio   = ?5 "
             "  AND x             = ?6 "
             "  AND y             = ?7 "
-            "  AND z             = ?8 ") };
+            "  AND z             = ?8 ")) && ambient) {
+            notModified(getStatement(
+                "UPDATE ambient_tiles "
+                "SET accessed        = ?1, "
+                "    expires         = ?2, "
+                "    must_revalidate = ?3 "
+                "WHERE url_template  = ?4 "
+                "  AND pixel_ratio   = ?5 "
+                "  AND x             = ?6 "
+                "  AND y             = ?7 "
+                "  AND z             = ?8 "));
+        }
         // clang-format on
-
-        notModifiedQuery.bind(1, util::now());
-        notModifiedQuery.bind(2, response.expires);
-        notModifiedQuery.bind(3, response.mustRevalidate);
-        notModifiedQuery.bind(4, tile.urlTemplate);
-        notModifiedQuery.bind(5, tile.pixelRatio);
-        notModifiedQuery.bind(6, tile.x);
-        notModifiedQuery.bind(7, tile.y);
-        notModifiedQuery.bind(8, tile.z);
-        notModifiedQuery.run();
         return false;
     }
 
-    // We can't use REPLACE because it would change the id value.
+    // See putResource(): region copies keep their data in `blobs`.
+    std::optional<int64_t> row;
+    {
+        // clang-format off
+        mapbox::sqlite::Query rowQuery{ getStatement(
+            "SELECT id FROM tiles "
+            "WHERE url_template = ?1 "
+            "  AND pixel_ratio  = ?2 "
+            "  AND x            = ?3 "
+            "  AND y            = ?4 "
+            "  AND z            = ?5 ") };
+        // clang-format on
+        rowQuery.bind(1, tile.urlTemplate);
+        rowQuery.bind(2, tile.pixelRatio);
+        rowQuery.bind(3, tile.x);
+        rowQuery.bind(4, tile.y);
+        rowQuery.bind(5, tile.z);
+        if (rowQuery.run()) {
+            row = rowQuery.get<int64_t>(0);
+        }
+    }
+
+    if (row || !ambient) {
+        auto bindData = [&](mapbox::sqlite::Query& query, int blobOffset, int codecOffset) {
+            if (response.noContent) {
+                query.bind(blobOffset, nullptr);
+                query.bind(codecOffset, false);
+            } else {
+                query.bind(blobOffset, putBlob(data));
+                query.bind(codecOffset, static_cast<int64_t>(codec));
+            }
+        };
+
+        if (row) {
+            // clang-format off
+            mapbox::sqlite::Query updateQuery{ getStatement(
+                "UPDATE tiles "
+                "SET modified        = ?1, "
+                "    etag            = ?2, "
+                "    expires         = ?3, "
+                "    must_revalidate = ?4, "
+                "    accessed        = ?5, "
+                "    blob_id         = ?6, "
+                "    compressed      = ?7 "
+                "WHERE id            = ?8 ") };
+            // clang-format on
+            updateQuery.bind(1, response.modified);
+            updateQuery.bind(2, response.etag);
+            updateQuery.bind(3, response.expires);
+            updateQuery.bind(4, response.mustRevalidate);
+            updateQuery.bind(5, util::now());
+            bindData(updateQuery, 6, 7);
+            updateQuery.bind(8, *row);
+            updateQuery.run();
+            return false;
+        }
 
+        // clang-format off
+        mapbox::sqlite::Query insertQuery{ getStatement(
+            "INSERT INTO tiles (url_template, pixel_ratio, x,  y,  z,  modified, must_revalidate, etag, expires, accessed,  blob_id, compressed) "
+            "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,       ?7,              ?8,   ?9,      ?10,       ?11,     ?12)") };
+        // clang-format on
+        insertQuery.bind(1, tile.urlTemplate);
+        insertQuery.bind(2, tile.pixelRatio);
+        insertQuery.bind(3, tile.x);
+        insertQuery.bind(4, tile.y);
+        insertQuery.bind(5, tile.z);
+        insertQuery.bind(6, response.modified);
+        insertQuery.bind(7, response.mustRevalidate);
+        insertQuery.bind(8, response.etag);
+        insertQuery.bind(9, response.expires);
+        insertQuery.bind(10, util::now());
+        bindData(insertQuery, 11, 12);
+        insertQuery.run();
+        return true;
+    }
+
+    // We can't use REPLACE because it would change the id value.
     // clang-format off
     mapbox::sqlite::Query updateQuery{ getStatement(
-        "UPDATE tiles "
+        "UPDATE ambient_tiles "
         "SET modified        = ?1, "
         "    etag            = ?2, "
         "    expires         = ?3, "
@@ -652,7 +1020,6 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         "  AND y             = ?11 "
         "  AND z             = ?12 ") };
     // clang-format on
-
     updateQuery.bind(1, response.modified);
     updateQuery.bind(2, response.etag);
     updateQuery.bind(3, response.expires);
@@ -669,7 +1036,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         updateQuery.bind(7, false);
     } else {
         updateQuery.bindBlob(6, data.data(), data.size(), false);
-        updateQuery.bind(7, compressed);
+        updateQuery.bind(7, static_cast<int64_t>(codec));
     }
 
     updateQuery.run();
@@ -679,8 +1046,8 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     // clang-format off
     mapbox::sqlite::Query insertQuery{ getStatement(
-        "INSERT INTO tiles (url_template, pixel_ratio, x,  y,  z,  modified, must_revalidate, etag, expires, accessed,  data, compressed) "
-        "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,       ?7,              ?8,   ?9,      ?10,       ?11,  ?12)") };
+        "INSERT INTO ambient_tiles (url_template, pixel_ratio, x,  y,  z,  modified, must_revalidate, etag, expires, accessed,  data, compressed) "
+        "VALUES                    (?1,           ?2,          ?3, ?4, ?5, ?6,       ?7,              ?8,   ?9,      ?10,       ?11,  ?12)") };
     // clang-format on
 
     insertQuery.bind(1, tile.urlTemplate);
@@ -699,7 +1066,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         insertQuery.bind(12, false);
     } else {
         insertQuery.bindBlob(11, data.data(), data.size(), false);
-        insertQuery.bind(12, compressed);
+        insertQuery.bind(12, static_cast<int64_t>(codec));
     }
 
     insertQuery.run();
@@ -707,31 +1074,79 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     return true;
 }
 
-std::exception_ptr OfflineDatabase::invalidateAmbientCache() try {
+void OfflineDatabase::moveFromAmbientCache(const Resource& resource) {
     checkFlags();
 
-    // clang-format off
-    mapbox::sqlite::Query tileQuery{ getStatement(
-        "UPDATE tiles "
-        "SET expires = 0, must_revalidate = 1 "
-        "WHERE id NOT IN ("
-        "    SELECT tile_id FROM region_tiles"
-        ")"
-    ) };
-    // clang-format on
+    if (resource.kind == Resource::Kind::Tile) {
+        const Resource::TileData& tile = *resource.tileData;
 
-    tileQuery.run();
+        // clang-format off
+        mapbox::sqlite::Query insertQuery{ getStatement(
+            "INSERT OR IGNORE INTO tiles (url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed, must_revalidate) "
+            "SELECT                      url_template, pixel_ratio, z, x, y, expires, modified, etag, data, compressed, accessed, must_revalidate "
+            "FROM ambient_tiles "
+            "WHERE url_template = ?1 "
+            "  AND pixel_ratio  = ?2 "
+            "  AND x            = ?3 "
+            "  AND y            = ?4 "
+            "  AND z            = ?5 ") };
+        // clang-format on
 
-    // clang-format off
-    mapbox::sqlite::Query resourceQuery{ getStatement(
-        "UPDATE resources "
-        "SET expires = 0, must_revalidate = 1 "
-        "WHERE id NOT IN ("
-        "    SELECT resource_id FROM region_resources"
-        ")"
-    ) };
-    // clang-format on
+        insertQuery.bind(1, tile.urlTemplate);
+        insertQuery.bind(2, tile.pixelRatio);
+        insertQuery.bind(3, tile.x);
+        insertQuery.bind(4, tile.y);
+        insertQuery.bind(5, tile.z);
+        insertQuery.run();
+        if (insertQuery.changes() != 0) {
+            moveDataToBlob(true, insertQuery.lastInsertRowId());
+        }
+
+        // clang-format off
+        mapbox::sqlite::Query deleteQuery{ getStatement(
+            "DELETE FROM ambient_tiles "
+            "WHERE url_template = ?1 "
+            "  AND pixel_ratio  = ?2 "
+            "  AND x            = ?3 "
+            "  AND y            = ?4 "
+            "  AND z            = ?5 ") };
+        // clang-format on
+
+        deleteQuery.bind(1, tile.urlTemplate);
+        deleteQuery.bind(2, tile.pixelRatio);
+        deleteQuery.bind(3, tile.x);
+        deleteQuery.bind(4, tile.y);
+        deleteQuery.bind(5, tile.z);
+        deleteQuery.run();
+    } else {
+        // clang-format off
+        mapbox::sqlite::Query insertQuery{ getStatement(
+            "INSERT OR IGNORE INTO resources (url, kind, expires, modified, etag, data, compressed, accessed, must_revalidate) "
+            "SELECT                          url, kind, expires, modified, etag, data, compressed, accessed, must_revalidate "
+            "FROM ambient_resources "
+            "WHERE url = ?1 ") };
+        // clang-format on
+
+        insertQuery.bind(1, resource.url);
+        insertQuery.run();
+        if (insertQuery.changes() != 0) {
+            moveDataToBlob(false, insertQuery.lastInsertRowId());
+        }
+
+        mapbox::sqlite::Query deleteQuery{getStatement("DELETE FROM ambient_resources WHERE url = ?1")};
+        deleteQuery.bind(1, resource.url);
+        deleteQuery.run();
+    }
+}
 
+std::exception_ptr OfflineDatabase::invalidateAmbientCache() try {
+    checkFlags();
+
+    mapbox::sqlite::Query tileQuery{getStatement("UPDATE ambient_tiles SET expires = 0, must_revalidate = 1")};
+    tileQuery.run();
+
+    mapbox::sqlite::Query resourceQuery{
+        getStatement("UPDATE ambient_resources SET expires = 0, must_revalidate = 1")};
     resourceQuery.run();
 
     return nullptr;
@@ -743,26 +1158,10 @@ std::exception_ptr OfflineDatabase::invalidateAmbientCache() try {
 std::exception_ptr OfflineDatabase::clearAmbientCache() try {
     checkFlags();
 
-    // clang-format off
-    mapbox::sqlite::Query tileQuery{ getStatement(
-        "DELETE FROM tiles "
-        "WHERE id NOT IN ("
-        "    SELECT tile_id FROM region_tiles"
-        ")"
-    ) };
-    // clang-format on
-
+    mapbox::sqlite::Query tileQuery{getStatement("DELETE FROM ambient_tiles")};
     tileQuery.run();
 
-    // clang-format off
-    mapbox::sqlite::Query resourceQuery{ getStatement(
-        "DELETE FROM resources "
-        "WHERE id NOT IN ("
-        "    SELECT resource_id FROM region_resources"
-        ")"
-    ) };
-    // clang-format on
-
+    mapbox::sqlite::Query resourceQuery{getStatement("DELETE FROM ambient_resources")};
     resourceQuery.run();
 
     if (autopack) vacuum();
@@ -892,12 +1291,14 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
         return unexpected<std::exception_ptr>(std::current_exception());
     }
     try {
-        // Support sideloaded databases at user_version = 6. Future schema
-        // version changes will need to implement migration paths for sideloaded
-        // databases at version 6.
+        // Support sideloaded databases at user_version = 6 to 8. Only the
+        // region tables are merged, and those are the same in these versions,
+        // except that version 8 keeps their data in blobs. Future schema
+        // version changes will need to implement migration paths for
+        // sideloaded databases at version 6.
         auto sideUserVersion = static_cast<int>(getPragma<int64_t>("PRAGMA side.user_version"));
         const auto mainUserVersion = getPragma<int64_t>("PRAGMA user_version");
-        if (sideUserVersion < 6 || sideUserVersion != mainUserVersion) {
+        if (sideUserVersion < 6 || sideUserVersion > mainUserVersion) {
             throw std::runtime_error("Merge database has incorrect user_version");
         }
 
@@ -924,8 +1325,57 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
         }
         queryTiles.reset();
 
+        // clang-format off
+        mapbox::sqlite::Query queryCodecs{ getStatement(
+            "SELECT EXISTS (SELECT 1 FROM side.tiles st "
+                           "JOIN side.region_tiles srt ON srt.tile_id = st.id "
+                           "WHERE st.compressed NOT BETWEEN 0 AND ?1) "
+            "OR EXISTS (SELECT 1 FROM side.resources sr "
+                       "JOIN side.region_resources srr ON srr.resource_id = sr.id "
+                       "WHERE sr.compressed NOT BETWEEN 0 AND ?1)") };
+        // clang-format on
+        queryCodecs.bind(1, static_cast<int64_t>(maxSupportedCodec()));
+        queryCodecs.run();
+        const bool hasUndecodableEntries = queryCodecs.get<bool>(0);
+        queryCodecs.reset();
+        if (hasUndecodableEntries) {
+            throw std::runtime_error("Merge database has entries in a data codec this build can't decode");
+        }
+
         mapbox::sqlite::Transaction transaction(*db);
+        // The merge reads the side region entries through these views, which
+        // hold the data inline whatever the version.
+        if (sideUserVersion >= 8) {
+            // clang-format off
+            db->exec(
+                "CREATE TEMPORARY VIEW side_tiles AS "
+                "SELECT t.id, t.url_template, t.pixel_ratio, t.z, t.x, t.y, t.expires, t.modified, t.etag, "
+                "       b.data, t.compressed, t.accessed, t.must_revalidate "
+                "FROM side.tiles t LEFT JOIN side.blobs b ON b.id = t.blob_id");
+            db->exec(
+                "CREATE TEMPORARY VIEW side_resources AS "
+                "SELECT r.id, r.url, r.kind, r.expires, r.modified, r.etag, "
+                "       b.data, r.compressed, r.accessed, r.must_revalidate "
+                "FROM side.resources r LEFT JOIN side.blobs b ON b.id = r.blob_id");
+            // clang-format on
+        } else {
+            // clang-format off
+            db->exec(
+                "CREATE TEMPORARY VIEW side_tiles AS "
+                "SELECT id, url_template, pixel_ratio, z, x, y, expires, modified, etag, "
+                "       data, compressed, accessed, must_revalidate "
+                "FROM side.tiles");
+            db->exec(
+                "CREATE TEMPORARY VIEW side_resources AS "
+                "SELECT id, url, kind, expires, modified, etag, "
+                "       data, compressed, accessed, must_revalidate "
+                "FROM side.resources");
+            // clang-format on
+        }
         db->exec(mergeSideloadedDatabaseSQL);
+        db->exec("DROP VIEW side_tiles");
+        db->exec("DROP VIEW side_resources");
+        moveDataToBlobs();
         transaction.commit();
 
         // clang-format off
@@ -955,6 +1405,320 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
     return {};
 }
 
+std::exception_ptr OfflineDatabase::exportRegion(int64_t regionID, const std::string& archivePath) try {
+    if (!db) {
+        initialize();
+    }
+
+    // Read in one transaction, for a consistent copy of the region.
+    mapbox::sqlite::Transaction transaction(*db);
+
+    std::optional<OfflineArchiveWriter> writer;
+    {
+        mapbox::sqlite::Query query{getStatement("SELECT definition, description FROM regions WHERE id = ?1")};
+        query.bind(1, regionID);
+        if (!query.run()) {
+            throw std::runtime_error("Offline region " + util::toString(regionID) + " doesn't exist");
+        }
+        writer.emplace(archivePath);
+        writer->writeRegion(query.get<std::string>(0), query.get<std::vector<uint8_t>>(1));
+    }
+
+    // The copy of each blob written so far and its codec. Entries with the
+    // same blob refer to that copy.
+    mbgl::unordered_map<int64_t, std::pair<uint32_t, int64_t>> copies;
+
+    // The data is only read for the first entry with a blob.
+    auto writeEntry = [&](OfflineArchiveEntry& entry, mapbox::sqlite::Query& query, int blobOffset) {
+        entry.codec = query.get<int64_t>(blobOffset + 1);
+        const auto blobID = query.get<std::optional<int64_t>>(blobOffset);
+        if (blobID) {
+            auto it = copies.find(*blobID);
+            if (it != copies.end() && it->second.second == entry.codec) {
+                entry.blob = it->second.first;
+            } else {
+                entry.data = query.get<std::optional<std::string>>(blobOffset + 2);
+            }
+        }
+
+        const auto copy = writer->writeEntry(entry);
+        if (blobID && !entry.blob && copy) {
+            copies.emplace(*blobID, std::make_pair(*copy, entry.codec));
+        }
+    };
+
+    // clang-format off
+    mapbox::sqlite::Query resourceQuery{ getStatement(
+        "SELECT r.url, r.kind, r.etag, r.expires, r.modified, r.must_revalidate, r.blob_id, r.compressed, b.data "
+        "FROM region_resources rr "
+        "JOIN resources r ON r.id = rr.resource_id "
+        "LEFT JOIN blobs b ON b.id = r.blob_id "
+        "WHERE rr.region_id = ?1") };
+    // clang-format on
+    resourceQuery.bind(1, regionID);
+    while (resourceQuery.run()) {
+        OfflineArchiveEntry entry;
+        entry.url = resourceQuery.get<std::string>(0);
+        entry.kind = static_cast<Resource::Kind>(resourceQuery.get<int>(1));
+        entry.etag = resourceQuery.get<std::optional<std::string>>(2);
+        entry.expires = resourceQuery.get<std::optional<Timestamp>>(3);
+        entry.modified = resourceQuery.get<std::optional<Timestamp>>(4);
+        entry.mustRevalidate = resourceQuery.get<bool>(5);
+        writeEntry(entry, resourceQuery, 6);
+    }
+
+    // clang-format off
+    mapbox::sqlite::Query tileQuery{ getStatement(
+        "SELECT t.url_template, t.pixel_ratio, t.z, t.x, t.y, t.etag, t.expires, t.modified, t.must_revalidate, "
+        "       t.blob_id, t.compressed, b.data "
+        "FROM region_tiles rt "
+        "JOIN tiles t ON t.id = rt.tile_id "
+        "LEFT JOIN blobs b ON b.id = t.blob_id "
+        "WHERE rt.region_id = ?1") };
+    // clang-format on
+    tileQuery.bind(1, regionID);
+    while (tileQuery.run()) {
+        OfflineArchiveEntry entry;
+        entry.isTile = true;
+        entry.kind = Resource::Kind::Tile;
+        entry.url = tileQuery.get<std::string>(0);
+        entry.pixelRatio = static_cast<uint8_t>(tileQuery.get<int>(1));
+        entry.z = static_cast<uint8_t>(tileQuery.get<int>(2));
+        entry.x = tileQuery.get<int>(3);
+        entry.y = tileQuery.get<int>(4);
+        entry.etag = tileQuery.get<std::optional<std::string>>(5);
+        entry.expires = tileQuery.get<std::optional<Timestamp>>(6);
+        entry.modified = tileQuery.get<std::optional<Timestamp>>(7);
+        entry.mustRevalidate = tileQuery.get<bool>(8);
+        writeEntry(entry, tileQuery, 9);
+    }
+
+    writer->finish();
+    transaction.commit();
+    return nullptr;
+} catch (...) {
+    handleError("export region");
+    return std::current_exception();
+}
+
+expected<OfflineRegion, std::exception_ptr> OfflineDatabase::importRegion(const std::string& archivePath) try {
+    checkFlags();
+
+    if (!db) {
+        initialize();
+    }
+
+    OfflineArchiveReader reader(archivePath);
+    const auto [definition, description] = reader.readRegion();
+
+    // Nothing is kept unless the whole archive is read and its checksum matches.
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+
+    // Identical regions are flattened into one, as for merged databases.
+    int64_t regionID = 0;
+    {
+        mapbox::sqlite::Query query{
+            getStatement("SELECT id FROM regions WHERE definition = ?1 AND description IS ?2 LIMIT 1")};
+        query.bind(1, definition);
+        query.bindBlob(2, description);
+        if (query.run()) {
+            regionID = query.get<int64_t>(0);
+        }
+    }
+    if (!regionID) {
+        mapbox::sqlite::Query query{getStatement("INSERT INTO regions (definition, description) VALUES (?1, ?2)")};
+        query.bind(1, definition);
+        query.bindBlob(2, description);
+        query.run();
+        regionID = query.lastInsertRowId();
+    }
+
+    const auto mapboxTileCount = getOfflineMapboxTileCount();
+    uint64_t importedMapboxTileCount = 0;
+
+    // The blob and codec of each copy of the data in the archive. Copies that
+    // weren't stored because the database kept a newer entry are held in
+    // memory instead.
+    std::vector<std::pair<std::optional<int64_t>, int64_t>> copies;
+    mbgl::unordered_map<uint32_t, std::string> unstoredCopies;
+
+    while (auto entry = reader.next()) {
+        std::optional<int64_t> blobID;
+        if (entry->blob) {
+            if (*entry->blob >= copies.size()) {
+                throw std::runtime_error("Offline archive is corrupt");
+            }
+
+            const auto& copy = copies[*entry->blob];
+            entry->codec = copy.second;
+            if (copy.first) {
+                blobID = copy.first;
+            } else {
+                entry->data = unstoredCopies.at(*entry->blob);
+            }
+        }
+
+        const bool isCopy = entry->data && !entry->blob;
+        // Entries this build can't decode would only ever be read errors.
+        // Archives are written as they are stored, so a zstd-enabled build
+        // may export them.
+        if (isCopy && (entry->codec < 0 || entry->codec > static_cast<int64_t>(maxSupportedCodec()))) {
+            throw std::runtime_error("Offline archive uses data codec " + util::toString(entry->codec) +
+                                     ", which this build can't decode");
+        }
+        const auto [stored, inserted] = importEntry(regionID, *entry, blobID);
+
+        if (isCopy) {
+            if (!stored) {
+                unstoredCopies.emplace(static_cast<uint32_t>(copies.size()), std::move(*entry->data));
+            }
+            copies.emplace_back(stored, entry->codec);
+        }
+
+        if (inserted && entry->isTile && util::mapbox::isCanonicalURL(tileServerOptions, entry->url) &&
+            mapboxTileCount + ++importedMapboxTileCount > offlineMapboxTileCountLimit) {
+            throw MapboxTileLimitExceededException();
+        }
+    }
+
+    // Drop ambient cache copies of what is now part of a region.
+    // clang-format off
+    db->exec(
+        "DELETE FROM ambient_tiles "
+        "WHERE EXISTS (SELECT 1 FROM tiles t "
+        "  WHERE t.url_template = ambient_tiles.url_template AND t.pixel_ratio = ambient_tiles.pixel_ratio "
+        "    AND t.z = ambient_tiles.z AND t.x = ambient_tiles.x AND t.y = ambient_tiles.y)");
+    db->exec(
+        "DELETE FROM ambient_resources "
+        "WHERE EXISTS (SELECT 1 FROM resources r WHERE r.url = ambient_resources.url)");
+    // clang-format on
+
+    transaction.commit();
+    offlineMapboxTileCount = std::nullopt;
+
+    // Construct, then move because this constructor is private.
+    OfflineRegion region(regionID, decodeOfflineRegionDefinition(definition), description);
+    return {std::move(region)};
+} catch (const MapboxTileLimitExceededException&) {
+    return unexpected<std::exception_ptr>(std::current_exception());
+} catch (...) {
+    handleError("import region");
+    return unexpected<std::exception_ptr>(std::current_exception());
+}
+
+std::pair<std::optional<int64_t>, bool> OfflineDatabase::importEntry(int64_t regionID,
+                                                                     const OfflineArchiveEntry& entry,
+                                                                     std::optional<int64_t> blobID) {
+    std::optional<int64_t> existing;
+    std::optional<Timestamp> existingModified;
+    if (entry.isTile) {
+        // clang-format off
+        mapbox::sqlite::Query query{ getStatement(
+            "SELECT id, modified FROM tiles "
+            "WHERE url_template = ?1 "
+            "  AND pixel_ratio  = ?2 "
+            "  AND z            = ?3 "
+            "  AND x            = ?4 "
+            "  AND y            = ?5 ") };
+        // clang-format on
+        query.bind(1, entry.url);
+        query.bind(2, entry.pixelRatio);
+        query.bind(3, entry.z);
+        query.bind(4, entry.x);
+        query.bind(5, entry.y);
+        if (query.run()) {
+            existing = query.get<int64_t>(0);
+            existingModified = query.get<std::optional<Timestamp>>(1);
+        }
+    } else {
+        mapbox::sqlite::Query query{getStatement("SELECT id, modified FROM resources WHERE url = ?1")};
+        query.bind(1, entry.url);
+        if (query.run()) {
+            existing = query.get<int64_t>(0);
+            existingModified = query.get<std::optional<Timestamp>>(1);
+        }
+    }
+
+    std::optional<int64_t> stored;
+    auto bindData = [&](mapbox::sqlite::Query& query, int blobOffset, int codecOffset) {
+        if (blobID || entry.data) {
+            stored = blobID ? *blobID : putBlob(*entry.data);
+            query.bind(blobOffset, *stored);
+            query.bind(codecOffset, entry.codec);
+        } else {
+            query.bind(blobOffset, nullptr);
+            query.bind(codecOffset, false);
+        }
+    };
+
+    std::optional<int64_t> row;
+    bool inserted = false;
+    if (!existing) {
+        if (entry.isTile) {
+            // clang-format off
+            mapbox::sqlite::Query query{ getStatement(
+                "INSERT INTO tiles (url_template, pixel_ratio, z,  x,  y,  expires, modified, etag, must_revalidate, accessed, blob_id, compressed) "
+                "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,      ?7,       ?8,   ?9,              ?10,      ?11,     ?12)") };
+            // clang-format on
+            query.bind(1, entry.url);
+            query.bind(2, entry.pixelRatio);
+            query.bind(3, entry.z);
+            query.bind(4, entry.x);
+            query.bind(5, entry.y);
+            query.bind(6, entry.expires);
+            query.bind(7, entry.modified);
+            query.bind(8, entry.etag);
+            query.bind(9, entry.mustRevalidate);
+            query.bind(10, util::now());
+            bindData(query, 11, 12);
+            query.run();
+            row = query.lastInsertRowId();
+        } else {
+            // clang-format off
+            mapbox::sqlite::Query query{ getStatement(
+                "INSERT INTO resources (url, kind, expires, modified, etag, must_revalidate, accessed, blob_id, compressed) "
+                "VALUES                (?1,  ?2,   ?3,      ?4,       ?5,   ?6,              ?7,       ?8,      ?9)") };
+            // clang-format on
+            query.bind(1, entry.url);
+            query.bind(2, int(entry.kind));
+            query.bind(3, entry.expires);
+            query.bind(4, entry.modified);
+            query.bind(5, entry.etag);
+            query.bind(6, entry.mustRevalidate);
+            query.bind(7, util::now());
+            bindData(query, 8, 9);
+            query.run();
+            row = query.lastInsertRowId();
+        }
+        inserted = true;
+    } else if (entry.modified && existingModified && *entry.modified > *existingModified) {
+        // clang-format off
+        mapbox::sqlite::Query query{ getStatement(entry.isTile ?
+            "UPDATE tiles SET expires = ?1, modified = ?2, etag = ?3, must_revalidate = ?4, blob_id = ?5, compressed = ?6 "
+            "WHERE id = ?7" :
+            "UPDATE resources SET expires = ?1, modified = ?2, etag = ?3, must_revalidate = ?4, blob_id = ?5, compressed = ?6 "
+            "WHERE id = ?7") };
+        // clang-format on
+        query.bind(1, entry.expires);
+        query.bind(2, entry.modified);
+        query.bind(3, entry.etag);
+        query.bind(4, entry.mustRevalidate);
+        bindData(query, 5, 6);
+        query.bind(7, *existing);
+        query.run();
+        row = existing;
+    }
+
+    mapbox::sqlite::Query query{getStatement(
+        entry.isTile ? "INSERT OR IGNORE INTO region_tiles (region_id, tile_id) VALUES (?1, ?2)"
+                     : "INSERT OR IGNORE INTO region_resources (region_id, resource_id) VALUES (?1, ?2)")};
+    query.bind(1, regionID);
+    query.bind(2, row ? *row : *existing);
+    query.run();
+
+    return {stored, inserted};
+}
+
 expected<OfflineRegionMetadata, std::exception_ptr> OfflineDatabase::updateMetadata(
     const int64_t regionID, const OfflineRegionMetadata& metadata) try {
     checkFlags();
@@ -977,17 +1741,51 @@ expected<OfflineRegionMetadata, std::exception_ptr> OfflineDatabase::updateMetad
 std::exception_ptr OfflineDatabase::deleteRegion(OfflineRegion&& region) try {
     checkFlags();
 
+    if (!db) {
+        initialize();
+    }
+
     {
-        mapbox::sqlite::Query query{getStatement("DELETE FROM regions WHERE id = ?")};
+        mapbox::sqlite::Transaction transaction(*db);
+
+        // Tiles and resources that no other region uses are deleted with the
+        // region. They reference the region_tiles and region_resources rows
+        // that only go away with the region itself, so foreign keys are
+        // checked at commit.
+        db->exec("PRAGMA defer_foreign_keys = ON");
+
+        // clang-format off
+        mapbox::sqlite::Query tileQuery{ getStatement(
+            "DELETE FROM tiles "
+            "WHERE id IN (SELECT tile_id FROM region_tiles WHERE region_id = ?1) "
+            "  AND NOT EXISTS ("
+            "    SELECT 1 FROM region_tiles "
+            "    WHERE tile_id = tiles.id AND region_id != ?1"
+            "  )") };
+        // clang-format on
+        tileQuery.bind(1, region.getID());
+        tileQuery.run();
+
+        // clang-format off
+        mapbox::sqlite::Query resourceQuery{ getStatement(
+            "DELETE FROM resources "
+            "WHERE id IN (SELECT resource_id FROM region_resources WHERE region_id = ?1) "
+            "  AND NOT EXISTS ("
+            "    SELECT 1 FROM region_resources "
+            "    WHERE resource_id = resources.id AND region_id != ?1"
+            "  )") };
+        // clang-format on
+        resourceQuery.bind(1, region.getID());
+        resourceQuery.run();
+
+        mapbox::sqlite::Query query{getStatement("DELETE FROM regions WHERE id = ?1")};
         query.bind(1, region.getID());
         query.run();
+        transaction.commit();
     }
 
-    DatabaseSizeChangeStats stats(this);
-    evict(0, stats);
     assert(db);
     if (autopack) vacuum();
-    updateAmbientCacheSize(stats);
 
     // Ensure that the cached offlineTileCount value is recalculated.
     offlineMapboxTileCount = std::nullopt;
@@ -1011,6 +1809,25 @@ std::optional<int64_t> OfflineDatabase::hasRegionResource(const Resource& resour
     return std::nullopt;
 }
 
+std::vector<std::optional<int64_t>> OfflineDatabase::hasRegionResources(const std::vector<Resource>& resources) try {
+    if (!db) {
+        initialize();
+    }
+    std::vector<std::optional<int64_t>> result;
+    result.reserve(resources.size());
+
+    // Holds the read lock for the whole batch instead of taking it per query.
+    mapbox::sqlite::Transaction transaction(*db);
+    for (const auto& resource : resources) {
+        result.push_back(hasInternal(resource));
+    }
+    transaction.commit();
+    return result;
+} catch (...) {
+    handleError("query region resources");
+    return std::vector<std::optional<int64_t>>(resources.size());
+}
+
 uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& resource, const Response& response) try {
     checkFlags();
 
@@ -1079,6 +1896,7 @@ uint64_t OfflineDatabase::putRegionResourceInternal(int64_t regionID,
                                                     const Response& response) {
     checkFlags();
 
+    moveFromAmbientCache(resource);
     uint64_t size = putInternal(resource, response, false).second;
     bool previouslyUnused = markUsed(regionID, resource);
 
@@ -1206,10 +2024,11 @@ expected<OfflineRegionStatus, std::exception_ptr> OfflineDatabase::getRegionComp
 std::pair<int64_t, int64_t> OfflineDatabase::getCompletedResourceCountAndSize(int64_t regionID) {
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
-        "SELECT COUNT(*), SUM(LENGTH(data)) "
-        "FROM region_resources, resources "
-        "WHERE region_id = ?1 "
-        "AND resource_id = resources.id ") };
+        "SELECT COUNT(*), SUM(LENGTH(blobs.data)) "
+        "FROM region_resources "
+        "JOIN resources ON resources.id = resource_id "
+        "LEFT JOIN blobs ON blobs.id = resources.blob_id "
+        "WHERE region_id = ?1 ") };
     // clang-format on
     query.bind(1, regionID);
     query.run();
@@ -1219,10 +2038,11 @@ std::pair<int64_t, int64_t> OfflineDatabase::getCompletedResourceCountAndSize(in
 std::pair<int64_t, int64_t> OfflineDatabase::getCompletedTileCountAndSize(int64_t regionID) {
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
-        "SELECT COUNT(*), SUM(LENGTH(data)) "
-        "FROM region_tiles, tiles "
-        "WHERE region_id = ?1 "
-        "AND tile_id = tiles.id ") };
+        "SELECT COUNT(*), SUM(LENGTH(blobs.data)) "
+        "FROM region_tiles "
+        "JOIN tiles ON tiles.id = tile_id "
+        "LEFT JOIN blobs ON blobs.id = tiles.blob_id "
+        "WHERE region_id = ?1 ") };
     // clang-format on
     query.bind(1, regionID);
     query.run();
@@ -1236,38 +2056,25 @@ T OfflineDatabase::getPragma(const char* sql) {
     return query.get<T>(0);
 }
 
-// Remove least-recently used resources and tiles until the used database size,
-// as calculated by multiplying the number of in-use pages by the page size, is
-// less than the maximum cache size. Returns false if this condition cannot be
-// satisfied.
+// Remove least-recently used ambient resources and tiles until the ambient
+// cache, plus the entry about to be written and one page of slack, fits in the
+// maximum cache size. Returns false if this condition cannot be satisfied.
 //
-// SQLite database never shrinks in size unless we call VACUUM. We here
-// are monitoring the soft limit (i.e. number of free pages in the file)
-// and as it approaches to the hard limit (i.e. the actual file size) we
-// delete an arbitrary number of old cache entries. The free pages approach
-// saves us from calling VACUUM or keeping a running total, which can be costly.
-bool OfflineDatabase::evict(uint64_t neededFreeSize, DatabaseSizeChangeStats& stats) {
+// The ambient cache has its own tables, so both the size lookup and the
+// oldest-first scan below use small indexed tables regardless of how much
+// offline region data the database holds.
+bool OfflineDatabase::evict(uint64_t neededFreeSize) {
     checkFlags();
-    uint64_t ambientCacheSize = (initAmbientCacheSize() == nullptr) ? *currentAmbientCacheSize
-                                                                    : maximumAmbientCacheSize;
-    uint64_t newAmbientCacheSize = ambientCacheSize + neededFreeSize + stats.pageSize();
+    const auto pageSize = static_cast<uint64_t>(getPragma<int64_t>("PRAGMA page_size"));
 
-    while (newAmbientCacheSize > maximumAmbientCacheSize) {
+    while (getAmbientCacheSize() + neededFreeSize + pageSize > maximumAmbientCacheSize) {
         // clang-format off
         mapbox::sqlite::Query accessedQuery{ getStatement(
             "SELECT max(accessed) "
             "FROM ( "
-            "    SELECT accessed "
-            "    FROM resources "
-            "    LEFT JOIN region_resources "
-            "    ON resource_id = resources.id "
-            "    WHERE resource_id IS NULL "
+            "    SELECT accessed FROM ambient_resources "
             "  UNION ALL "
-            "    SELECT accessed "
-            "    FROM tiles "
-            "    LEFT JOIN region_tiles "
-            "    ON tile_id = tiles.id "
-            "    WHERE tile_id IS NULL "
+            "    SELECT accessed FROM ambient_tiles "
             "  ORDER BY accessed ASC LIMIT ?1 "
             ") "
         ) };
@@ -1278,40 +2085,16 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize, DatabaseSizeChangeStats& st
         }
         Timestamp accessed = accessedQuery.get<Timestamp>(0);
 
-        // clang-format off
-        mapbox::sqlite::Query resourceQuery{ getStatement(
-            "DELETE FROM resources "
-            "WHERE id IN ( "
-            "  SELECT id FROM resources "
-            "  LEFT JOIN region_resources "
-            "  ON resource_id = resources.id "
-            "  WHERE resource_id IS NULL "
-            "  AND accessed <= ?1 "
-            ") ") };
-        // clang-format on
+        mapbox::sqlite::Query resourceQuery{getStatement("DELETE FROM ambient_resources WHERE accessed <= ?1")};
         resourceQuery.bind(1, accessed);
         resourceQuery.run();
         const uint64_t resourceChanges = resourceQuery.changes();
 
-        // clang-format off
-        mapbox::sqlite::Query tileQuery{ getStatement(
-            "DELETE FROM tiles "
-            "WHERE id IN ( "
-            "  SELECT id FROM tiles "
-            "  LEFT JOIN region_tiles "
-            "  ON tile_id = tiles.id "
-            "  WHERE tile_id IS NULL "
-            "  AND accessed <= ?1 "
-            ") ") };
-        // clang-format on
+        mapbox::sqlite::Query tileQuery{getStatement("DELETE FROM ambient_tiles WHERE accessed <= ?1")};
         tileQuery.bind(1, accessed);
         tileQuery.run();
         const uint64_t tileChanges = tileQuery.changes();
 
-        // Update current ambient cache size, based on how many bytes were released.
-        newAmbientCacheSize = std::max<int64_t>(
-            static_cast<int64_t>(newAmbientCacheSize) - static_cast<int64_t>(stats.bytesReleased()), 0u);
-
         // The cached value of offlineTileCount does not need to be updated
         // here because only non-offline tiles can be removed by eviction.
         if (resourceChanges == 0 && tileChanges == 0) {
@@ -1322,75 +2105,23 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize, DatabaseSizeChangeStats& st
     return true;
 }
 
-std::exception_ptr OfflineDatabase::initAmbientCacheSize() {
-    if (!currentAmbientCacheSize) {
-        try {
-            // clang-format off
-            mapbox::sqlite::Query query{ getStatement(
-            "SELECT SUM(data) "
-            "FROM ( "
-            "    SELECT SUM(IFNULL(LENGTH(data), 0) "
-            "               + IFNULL(LENGTH(id), 0) "
-            "               + IFNULL(LENGTH(url_template), 0) "
-            "               + IFNULL(LENGTH(pixel_ratio), 0) "
-            "               + IFNULL(LENGTH(x), 0) "
-            "               + IFNULL(LENGTH(y), 0) "
-            "               + IFNULL(LENGTH(z), 0) "
-            "               + IFNULL(LENGTH(expires), 0) "
-            "               + IFNULL(LENGTH(modified), 0) "
-            "               + IFNULL(LENGTH(etag), 0) "
-            "               + IFNULL(LENGTH(compressed), 0) "
-            "               + IFNULL(LENGTH(accessed), 0) "
-            "               + IFNULL(LENGTH(must_revalidate), 0) "
-            "               ) as data "
-            "    FROM tiles "
-            "    LEFT JOIN region_tiles "
-            "    ON tile_id = tiles.id "
-            "    WHERE tile_id IS NULL "
-            "  UNION ALL "
-            "    SELECT SUM(IFNULL(LENGTH(data), 0) "
-            "               + IFNULL(LENGTH(id), 0) "
-            "               + IFNULL(LENGTH(url), 0) "
-            "               + IFNULL(LENGTH(kind), 0) "
-            "               + IFNULL(LENGTH(expires), 0) "
-            "               + IFNULL(LENGTH(modified), 0) "
-            "               + IFNULL(LENGTH(etag), 0) "
-            "               + IFNULL(LENGTH(compressed), 0) "
-            "               + IFNULL(LENGTH(accessed), 0) "
-            "               + IFNULL(LENGTH(must_revalidate), 0) "
-            "               ) as data "
-            "    FROM resources "
-            "    LEFT JOIN region_resources "
-            "    ON resource_id = resources.id "
-            "    WHERE resource_id IS NULL "
-            ") ") };
-            // clang-format on
-            query.run();
-            currentAmbientCacheSize = query.get<int64_t>(0);
-        } catch (const mapbox::sqlite::Exception& ex) {
-            handleError(ex, "cannot get current ambient cache size");
-            return std::current_exception();
-        }
+uint64_t OfflineDatabase::getAmbientCacheSize() {
+    mapbox::sqlite::Query query{getStatement("SELECT size FROM ambient_cache_size")};
+    if (!query.run()) {
+        return 0;
     }
-
-    return nullptr;
+    return static_cast<uint64_t>(std::max<int64_t>(query.get<int64_t>(0), 0));
 }
 
 std::exception_ptr OfflineDatabase::setMaximumAmbientCacheSize(uint64_t size) {
     uint64_t previousMaximumAmbientCacheSize = maximumAmbientCacheSize;
 
-    if (auto exception = initAmbientCacheSize()) {
-        return exception;
-    }
-
     try {
         maximumAmbientCacheSize = size;
 
-        if (*currentAmbientCacheSize > maximumAmbientCacheSize) {
-            DatabaseSizeChangeStats stats(this);
-            evict(0, stats);
+        if (getAmbientCacheSize() > maximumAmbientCacheSize) {
+            evict(0);
             if (autopack) vacuum();
-            updateAmbientCacheSize(stats);
         }
 
         return nullptr;
@@ -1401,6 +2132,10 @@ std::exception_ptr OfflineDatabase::setMaximumAmbientCacheSize(uint64_t size) {
     }
 }
 
+void OfflineDatabase::setDataCodec(OfflineDataCodec codec) {
+    dataCodec = codec == OfflineDataCodec::Zstd && !util::zstd_supported() ? OfflineDataCodec::Zlib : codec;
+}
+
 void OfflineDatabase::setOfflineMapboxTileCountLimit(uint64_t limit) {
     offlineMapboxTileCountLimit = limit;
 }
@@ -1451,6 +2186,7 @@ void OfflineDatabase::markUsedResources(int64_t regionID, const std::list<Resour
     }
     mapbox::sqlite::Transaction transaction(*db);
     for (const auto& resource : resources) {
+        moveFromAmbientCache(resource);
         markUsed(regionID, resource);
     }
     transaction.commit();
@@ -1487,34 +2223,4 @@ void OfflineDatabase::reopenDatabaseReadOnly(bool readOnly_) {
     }
 }
 
-OfflineDatabase::DatabaseSizeChangeStats::DatabaseSizeChangeStats(OfflineDatabase* db_)
-    : db(db_) {
-    assert(db);
-    pageSize_ = db->getPragma<int64_t>("PRAGMA page_size");
-    pageCount_ = db->getPragma<int64_t>("PRAGMA page_count");
-    initialSize_ = pageSize_ * (pageCount_ - db->getPragma<int64_t>("PRAGMA freelist_count"));
-}
-
-uint64_t OfflineDatabase::DatabaseSizeChangeStats::pageSize() const {
-    return pageSize_;
-}
-
-int64_t OfflineDatabase::DatabaseSizeChangeStats::diff() const {
-    const int64_t currentSize = static_cast<int64_t>(pageSize_) * (db->getPragma<int64_t>("PRAGMA page_count") -
-                                                                   db->getPragma<int64_t>("PRAGMA freelist_count"));
-    return currentSize - static_cast<int64_t>(initialSize_);
-}
-
-uint64_t OfflineDatabase::DatabaseSizeChangeStats::bytesReleased() const {
-    uint64_t currentSize = pageSize_ * (pageCount_ - db->getPragma<int64_t>("PRAGMA freelist_count"));
-    return std::max<int64_t>(initialSize_ - currentSize, 0u);
-}
-
-void OfflineDatabase::updateAmbientCacheSize(DatabaseSizeChangeStats& stats) {
-    assert(currentAmbientCacheSize);
-    if (currentAmbientCacheSize) {
-        *currentAmbientCacheSize = std::max<int64_t>(static_cast<int64_t>(*currentAmbientCacheSize) + stats.diff(), 0u);
-    }
-}
-
 } // namespace mbgl
@@ -19,12 +19,16 @@
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tileset.hpp>
 
+#include <memory>
+#include <optional>
 #include <set>
+#include <vector>
 
 namespace {
 
-const size_t kResourcesBatchSize = 64;
+const size_t kResourcesBatchSize = 256;
 const size_t kMarkBatchSize = 200;
+const size_t kTilesBatchSize = 256;
 
 } // namespace
 
@@ -95,6 +99,57 @@ uint64_t tileCount(const OfflineRegionDefinition& definition,
     return result;
 }
 
+// Enumerates the tiles of a source one zoom level at a time, in the order of
+// their tile cover.
+class OfflineDownload::TilePlan {
+public:
+    TilePlan(const OfflineRegionDefinition& definition_, style::SourceType type, uint16_t tileSize, Tileset tileset_)
+        : definition(definition_),
+          tileset(std::move(tileset_)),
+          zoomRange(std::visit(
+              [&](auto& reg) { return coveringZoomRange(reg, type, tileSize, tileset.zoomRange); }, definition)),
+          z(zoomRange.min) {}
+
+    std::optional<Resource> next() {
+        while (z <= zoomRange.max) {
+            if (!cover) {
+                const auto zoom = static_cast<uint8_t>(z);
+                cover = std::visit(overloaded{[&](const OfflineTilePyramidRegionDefinition& reg) {
+                                                  return std::make_unique<util::TileCover>(reg.bounds, zoom);
+                                              },
+                                              [&](const OfflineGeometryRegionDefinition& reg) {
+                                                  return std::make_unique<util::TileCover>(reg.geometry, zoom);
+                                              }},
+                                   definition);
+            }
+
+            if (const auto tile = cover->next()) {
+                auto tileResource = Resource::tile(tileset.tiles[0],
+                                                   std::visit([](auto& def) { return def.pixelRatio; }, definition),
+                                                   tile->canonical.x,
+                                                   tile->canonical.y,
+                                                   tile->canonical.z,
+                                                   tileset.scheme);
+
+                tileResource.setPriority(Resource::Priority::Low);
+                tileResource.setUsage(Resource::Usage::Offline);
+                return tileResource;
+            }
+
+            cover.reset();
+            z++;
+        }
+        return std::nullopt;
+    }
+
+private:
+    const OfflineRegionDefinition& definition;
+    const Tileset tileset;
+    const Range<uint8_t> zoomRange;
+    uint32_t z;
+    std::unique_ptr<util::TileCover> cover;
+};
+
 // OfflineDownload
 
 OfflineDownload::OfflineDownload(int64_t id_,
@@ -393,7 +448,11 @@ void OfflineDownload::activateDownload() {
    fruitless anyway.
 */
 void OfflineDownload::continueDownload() {
-    if (resourcesRemaining.empty()) {
+    if (resourcesRemaining.empty() && tilesRemaining.empty()) {
+        planTiles();
+    }
+
+    if (!hasRemainingResources()) {
         // Flush pending buffers.
         if (!flushResourcesBuffer()) return;
         if (status.complete()) {
@@ -411,15 +470,44 @@ void OfflineDownload::continueDownload() {
         maxConcurrentRequests = static_cast<uint32_t>(*maxRequests);
     }
 
-    while (!resourcesRemaining.empty() && requests.size() < maxConcurrentRequests) {
-        ensureResource(std::move(resourcesRemaining.front()));
-        resourcesRemaining.pop_front();
+    while (requests.size() < maxConcurrentRequests) {
+        if (!resourcesRemaining.empty()) {
+            ensureResource(std::move(resourcesRemaining.front()));
+            resourcesRemaining.pop_front();
+        } else if (!tilesRemaining.empty()) {
+            // Taken off the queue first, the request deactivates the download
+            // when it exceeds the tile count limit.
+            Resource tileResource = std::move(tilesRemaining.front());
+            tilesRemaining.pop_front();
+            requestResource(std::move(tileResource));
+        } else if (!tilePlans.empty()) {
+            planTiles();
+            if (status.downloadState != OfflineRegionDownloadState::Active) {
+                // Deactivated by the observer.
+                return;
+            }
+            if (tilesRemaining.empty()) {
+                // The whole batch was already stored. Continue on a later run
+                // loop iteration, so that a region that is mostly downloaded
+                // doesn't block the thread while it's being checked.
+                auto workRequestsIt = requests.insert(requests.begin(), nullptr);
+                *workRequestsIt = util::RunLoop::Get()->invokeCancellable([this, workRequestsIt]() {
+                    requests.erase(workRequestsIt);
+                    continueDownload();
+                });
+                break;
+            }
+        } else {
+            break;
+        }
     }
 }
 
 void OfflineDownload::deactivateDownload() {
     requiredSourceURLs.clear();
     resourcesRemaining.clear();
+    tilePlans.clear();
+    tilesRemaining.clear();
     requests.clear();
     buffer.clear();
 }
@@ -437,6 +525,10 @@ bool OfflineDownload::flushResourcesBuffer() {
     }
 }
 
+bool OfflineDownload::hasRemainingResources() const {
+    return !resourcesRemaining.empty() || !tilesRemaining.empty() || !tilePlans.empty();
+}
+
 void OfflineDownload::queueResource(Resource&& resource) {
     resource.setPriority(Resource::Priority::Low);
     resource.setUsage(Resource::Usage::Offline);
@@ -448,22 +540,54 @@ void OfflineDownload::queueResource(Resource&& resource) {
 }
 
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
-    tileCover(definition, type, tileSize, tileset.zoomRange, [&](const auto& tile) {
-        status.requiredResourceCount++;
-        status.requiredTileCount++;
+    // Only counted here, the resources are created by `planTiles` as needed.
+    uint64_t count = 0;
+    tileCover(definition, type, tileSize, tileset.zoomRange, [&](const auto&) { count++; });
+    status.requiredResourceCount += count;
+    status.requiredTileCount += count;
+
+    tilePlans.push_back(std::make_unique<TilePlan>(definition, type, tileSize, tileset));
+}
+
+/*
+   Takes the next batch of tiles from the tile plans and looks them up in the
+   database together. Tiles that are already stored are completed right away
+   and marked as used with the next batch of marks, the others are queued in
+   `tilesRemaining` to be requested.
+*/
+void OfflineDownload::planTiles() {
+    std::vector<Resource> batch;
+    batch.reserve(kTilesBatchSize);
+    while (batch.size() < kTilesBatchSize && !tilePlans.empty()) {
+        if (auto tile = tilePlans.front()->next()) {
+            batch.push_back(std::move(*tile));
+        } else {
+            tilePlans.pop_front();
+        }
+    }
 
-        auto tileResource = Resource::tile(tileset.tiles[0],
-                                           std::visit([](auto& def) { return def.pixelRatio; }, definition),
-                                           tile.x,
-                                           tile.y,
-                                           tile.z,
-                                           tileset.scheme);
+    if (batch.empty()) return;
 
-        tileResource.setPriority(Resource::Priority::Low);
-        tileResource.setUsage(Resource::Usage::Offline);
+    const auto sizes = offlineDatabase.hasRegionResources(batch);
+    assert(sizes.size() == batch.size());
 
-        resourcesRemaining.push_back(std::move(tileResource));
-    });
+    bool completed = false;
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        if (sizes[i]) {
+            status.completedResourceCount++;
+            status.completedResourceSize += *sizes[i];
+            status.completedTileCount++;
+            status.completedTileSize += *sizes[i];
+            resourcesToBeMarkedAsUsed.push_back(std::move(batch[i]));
+            completed = true;
+        } else {
+            tilesRemaining.push_back(std::move(batch[i]));
+        }
+    }
+
+    if (completed) {
+        observer->statusChanged(status);
+    }
 }
 
 void OfflineDownload::markPendingUsedResources() {
@@ -510,47 +634,51 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
             return;
         }
 
-        if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
-            onMapboxTileCountLimitExceeded();
-            return;
-        }
+        requestResource(resource, callback);
+    });
+}
 
-        auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
-        *fileRequestsIt = onlineFileSource.request(resource, [=, this](const Response& onlineResponse) {
-            if (onlineResponse.error) {
-                observer->responseError(*onlineResponse.error);
-                if (onlineResponse.error->reason == Response::Error::Reason::NotFound) {
-                    // On error 404, we skip this request and go further.
-                    requests.erase(fileRequestsIt);
-                    assert(status.requiredResourceCount > 0);
-                    status.requiredResourceCount--;
-                    continueDownload();
-                }
-                return;
+void OfflineDownload::requestResource(Resource resource, std::function<void(Response)> callback) {
+    if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
+        onMapboxTileCountLimitExceeded();
+        return;
+    }
+
+    auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
+    *fileRequestsIt = onlineFileSource.request(resource, [=, this](const Response& onlineResponse) {
+        if (onlineResponse.error) {
+            observer->responseError(*onlineResponse.error);
+            if (onlineResponse.error->reason == Response::Error::Reason::NotFound) {
+                // On error 404, we skip this request and go further.
+                requests.erase(fileRequestsIt);
+                assert(status.requiredResourceCount > 0);
+                status.requiredResourceCount--;
+                continueDownload();
             }
+            return;
+        }
 
-            requests.erase(fileRequestsIt);
+        requests.erase(fileRequestsIt);
 
-            if (callback) {
-                callback(onlineResponse);
-            }
+        if (callback) {
+            callback(onlineResponse);
+        }
 
-            // Queue up for batched insertion
-            buffer.emplace_back(resource, onlineResponse);
+        // Queue up for batched insertion
+        buffer.emplace_back(resource, onlineResponse);
 
-            // Flush buffer periodically.
-            // Have to keep `resourcesRemaining.empty()` as the following
-            // condition would fail otherwise.
-            // TODO: Simplify the tile count limit check code path!
-            if ((buffer.size() == kResourcesBatchSize || resourcesRemaining.empty()) && !flushResourcesBuffer()) return;
+        // Flush buffer periodically.
+        // Have to keep `hasRemainingResources()` as the following
+        // condition would fail otherwise.
+        // TODO: Simplify the tile count limit check code path!
+        if ((buffer.size() == kResourcesBatchSize || !hasRemainingResources()) && !flushResourcesBuffer()) return;
 
-            if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
-                onMapboxTileCountLimitExceeded();
-                return;
-            }
+        if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
+            onMapboxTileCountLimitExceeded();
+            return;
+        }
 
-            continueDownload();
-        });
+        continueDownload();
     });
 }
 
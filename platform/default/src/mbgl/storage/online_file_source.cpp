@@ -3,6 +3,7 @@
 #include <mbgl/storage/http_file_source.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/storage/online_file_source.hpp>
+#include <mbgl/storage/request_concurrency_controller.hpp>
 #include <mbgl/storage/resource_options.hpp>
 #include <mbgl/storage/resource_transform.hpp>
 #include <mbgl/storage/response.hpp>
@@ -24,6 +25,7 @@
 #include <mbgl/util/timer.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <map>
@@ -34,6 +36,10 @@ namespace mbgl {
 // For testing only
 constexpr const char* ONLINE_STATUS_KEY = "online-status";
 
+// Active low priority requests younger than this may be preempted by regular
+// priority requests when adaptive concurrency is enabled.
+constexpr auto PREEMPTION_MAXIMUM_AGE = Milliseconds(250);
+
 class OnlineFileSourceThread;
 
 struct OnlineFileRequest {
@@ -71,6 +77,10 @@ struct OnlineFileRequest {
     uint32_t failedRequests = 0;
     Response::Error::Reason failedRequestReason = Response::Error::Reason::Success;
     std::optional<Timestamp> retryAfter;
+
+    // Scheme and authority of the resource URL, used for per-host concurrency limits.
+    std::string host;
+    TimePoint activatedAt;
 };
 
 class OnlineFileSourceThread {
@@ -117,6 +127,7 @@ public:
     void remove(OnlineFileRequest* req) {
         allRequests.erase(req);
         if (activeRequests.erase(req)) {
+            concurrencyController.onCancelled(req->host);
             activatePendingRequest();
         } else {
             pendingRequests.remove(req);
@@ -128,15 +139,49 @@ public:
         assert(activeRequests.find(req) == activeRequests.end());
         assert(!req->request);
 
-        if (activeRequests.size() >= getMaximumConcurrentRequests()) {
-            queueRequest(req);
-        } else {
+        req->host = RequestConcurrencyController::hostForURL(req->resource.url);
+
+        if (canActivate(req) || preemptLowPriorityRequest(req)) {
             activateRequest(req);
+        } else {
+            queueRequest(req);
         }
     }
 
     void queueRequest(OnlineFileRequest* req) { pendingRequests.insert(req); }
 
+    bool canActivate(const OnlineFileRequest* req) const {
+        if (activeRequests.size() >= getMaximumConcurrentRequests()) {
+            return false;
+        }
+        return !adaptiveConcurrency || concurrencyController.canActivate(req->host);
+    }
+
+    // Lets a regular priority request take over the slot of the most recently
+    // started low priority request, as long as that one is younger than
+    // PREEMPTION_MAXIMUM_AGE: it has made little progress and is cheap to
+    // restart. The preempted request goes back to the head of the low priority
+    // part of the queue.
+    bool preemptLowPriorityRequest(const OnlineFileRequest* req) {
+        if (!adaptiveConcurrency || req->resource.priority != Resource::Priority::Regular) {
+            return false;
+        }
+
+        const bool globalLimitReached = activeRequests.size() >= getMaximumConcurrentRequests();
+        OnlineFileRequest* victim = concurrencyController.preemptionCandidate(
+            activeRequests, req->host, Clock::now(), PREEMPTION_MAXIMUM_AGE);
+
+        if (!victim || (globalLimitReached && activeRequests.size() - 1 >= getMaximumConcurrentRequests())) {
+            return false;
+        }
+
+        victim->request.reset();
+        activeRequests.erase(victim);
+        concurrencyController.onCancelled(victim->host);
+        pendingRequests.requeue(victim);
+        return true;
+    }
+
     void activateRequest(OnlineFileRequest* req) {
         auto callback = [=, this](const Response& response) {
             activeRequests.erase(req);
@@ -146,9 +191,17 @@ public:
         };
 
         activeRequests.insert(req);
+        req->activatedAt = Clock::now();
 
         if (online) {
-            req->request = httpFileSource.request(req->resource, callback);
+            // The controller keeps learning even when adaptive concurrency is
+            // disabled, so enabling it later starts from measured limits.
+            concurrencyController.onStarted(req->host);
+            req->request = httpFileSource.request(req->resource, [=, this](const Response& response) {
+                concurrencyController.onCompleted(
+                    req->host, Clock::now() - req->activatedAt, !indicatesOverload(response));
+                callback(response);
+            });
         } else {
             Response response;
             response.error = std::make_unique<Response::Error>(Response::Error::Reason::Connection,
@@ -158,9 +211,25 @@ public:
     }
 
     void activatePendingRequest() {
-        auto req = pendingRequests.pop();
+        if (!adaptiveConcurrency) {
+            auto req = pendingRequests.pop();
+
+            if (req) {
+                activateRequest(*req);
+            }
+            return;
+        }
+
+        // With per-host limits the head of the queue may be blocked while
+        // requests to other hosts could proceed, and a grown limit may admit
+        // more than one request at once.
+        while (activeRequests.size() < getMaximumConcurrentRequests()) {
+            auto req = pendingRequests.pop(
+                [&](const OnlineFileRequest* pending) { return concurrencyController.canActivate(pending->host); });
 
-        if (req) {
+            if (!req) {
+                break;
+            }
             activateRequest(*req);
         }
     }
@@ -190,6 +259,12 @@ public:
 
     void setMaximumConcurrentRequests(uint32_t maximumConcurrentRequests_) {
         maximumConcurrentRequests = maximumConcurrentRequests_;
+        concurrencyController.setMaximumLimit(maximumConcurrentRequests);
+    }
+
+    void setAdaptiveConcurrency(bool enabled) {
+        adaptiveConcurrency = enabled;
+        activatePendingRequest();
     }
 
     void setAPIBaseURL(std::string t) {
@@ -204,6 +279,20 @@ public:
 private:
     friend struct OnlineFileRequest;
 
+    static bool indicatesOverload(const Response& response) {
+        if (!response.error) {
+            return false;
+        }
+        switch (response.error->reason) {
+            case Response::Error::Reason::Server:
+            case Response::Error::Reason::Connection:
+            case Response::Error::Reason::RateLimit:
+                return true;
+            default:
+                return false;
+        }
+    }
+
     void networkIsReachableAgain() {
         // Notify regular priority requests.
         for (auto& req : allRequests) {
@@ -261,6 +350,15 @@ private:
             }
         }
 
+        // Puts a preempted request back in front of the requests of the same priority.
+        void requeue(OnlineFileRequest* request) {
+            if (request->resource.priority == Resource::Priority::Regular) {
+                queue.push_front(request);
+            } else {
+                firstLowPriorityRequest = queue.insert(firstLowPriorityRequest, request);
+            }
+        }
+
         std::optional<OnlineFileRequest*> pop() {
             if (queue.empty()) {
                 return {};
@@ -275,6 +373,23 @@ private:
             return {next};
         }
 
+        // Pops the first request in queue order that satisfies `predicate`.
+        template <typename Predicate>
+        std::optional<OnlineFileRequest*> pop(Predicate&& predicate) {
+            for (auto it = queue.begin(); it != queue.end(); ++it) {
+                if (predicate(*it)) {
+                    if (it == firstLowPriorityRequest) {
+                        firstLowPriorityRequest++;
+                    }
+
+                    OnlineFileRequest* next = *it;
+                    queue.erase(it);
+                    return {next};
+                }
+            }
+            return {};
+        }
+
         bool contains(OnlineFileRequest* request) const {
             return (std::find(queue.begin(), queue.end(), request) != queue.end());
         }
@@ -304,6 +419,8 @@ private:
 
     bool online = true;
     uint32_t maximumConcurrentRequests;
+    bool adaptiveConcurrency = false;
+    RequestConcurrencyController concurrencyController;
     HTTPFileSource httpFileSource;
     util::AsyncTask reachability{std::bind(&OnlineFileSourceThread::networkIsReachableAgain, this)};
     std::map<AsyncRequest*, std::unique_ptr<OnlineFileRequest>> tasks;
@@ -383,6 +500,17 @@ public:
         return cachedMaximumConcurrentRequests;
     }
 
+    void setAdaptiveConcurrency(const mapbox::base::Value& value) {
+        if (auto* enabled = value.getBool()) {
+            thread->actor().invoke(&OnlineFileSourceThread::setAdaptiveConcurrency, *enabled);
+            adaptiveConcurrency = *enabled;
+        } else {
+            Log::Error(Event::General, "Invalid adaptive-concurrent-requests property value type.");
+        }
+    }
+
+    bool getAdaptiveConcurrency() const { return adaptiveConcurrency; }
+
     void setApiKey(const mapbox::base::Value& value) {
         if (auto* apiKey = value.getString()) {
             thread->actor().invoke(&OnlineFileSourceThread::setApiKey, *apiKey);
@@ -426,6 +554,7 @@ private:
 
     mutable std::mutex maximumConcurrentRequestsMutex;
     uint32_t cachedMaximumConcurrentRequests = util::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS;
+    std::atomic<bool> adaptiveConcurrency{false};
     const std::unique_ptr<util::Thread<OnlineFileSourceThread>> thread;
 };
 
@@ -674,6 +803,8 @@ void OnlineFileSource::setProperty(const std::string& key, const mapbox::base::V
         impl->setAPIBaseURL(value);
     } else if (key == MAX_CONCURRENT_REQUESTS_KEY) {
         impl->setMaximumConcurrentRequests(value);
+    } else if (key == ADAPTIVE_CONCURRENT_REQUESTS_KEY) {
+        impl->setAdaptiveConcurrency(value);
     } else if (key == ONLINE_STATUS_KEY) {
         // For testing only
         if (auto* boolValue = value.getBool()) {
@@ -692,6 +823,8 @@ mapbox::base::Value OnlineFileSource::getProperty(const std::string& key) const
         return impl->getAPIBaseURL();
     } else if (key == MAX_CONCURRENT_REQUESTS_KEY) {
         return impl->getMaximumConcurrentRequests();
+    } else if (key == ADAPTIVE_CONCURRENT_REQUESTS_KEY) {
+        return impl->getAdaptiveConcurrency();
     }
     std::string message = "Resource provider does not support property " + key;
     Log::Error(Event::General, message.c_str());
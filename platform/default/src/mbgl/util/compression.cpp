@@ -6,8 +6,15 @@
 #include <zlib.h>
 #endif
 
+#if MLN_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 
 // Check zlib library version.
@@ -89,40 +96,178 @@ std::string compress(const std::string &raw, int windowBits) {
     return result;
 }
 
-std::string decompress(const std::string &raw, int windowBits) {
-    z_stream inflate_stream;
-    memset(&inflate_stream, 0, sizeof(inflate_stream));
+namespace {
 
-    // TODO: reuse z_streams
-    if (inflateInit2(&inflate_stream, windowBits) != Z_OK) {
+// The inflate state and its window are set up once per thread and reset for
+// every call.
+struct InflateStream {
+    z_stream stream;
+    bool initialized = false;
+
+    ~InflateStream() {
+        if (initialized) {
+            inflateEnd(&stream);
+        }
+    }
+};
+
+z_stream &inflateStream(int windowBits) {
+    thread_local InflateStream state;
+    if (!state.initialized) {
+        memset(&state.stream, 0, sizeof(state.stream));
+        if (inflateInit2(&state.stream, windowBits) != Z_OK) {
+            throw std::runtime_error("failed to initialize inflate");
+        }
+        state.initialized = true;
+    } else if (inflateReset2(&state.stream, windowBits) != Z_OK) {
         throw std::runtime_error("failed to initialize inflate");
     }
+    return state.stream;
+}
+
+// Size to allocate up front for the decompressed data. The gzip trailer comes
+// with the data and may be wrong, so the hint stays within a small multiple of
+// the input and a fixed ceiling. Larger data grows the buffer as it inflates.
+size_t decompressedSizeHint(const std::string &raw) {
+    constexpr size_t maxRatio = 16;
+    constexpr size_t maxHint = 64 * 1024 * 1024;
+    const size_t limit = std::min(raw.size() * maxRatio + 64, maxHint);
+    if (raw.size() >= 18 && static_cast<uint8_t>(raw[0]) == 0x1f && static_cast<uint8_t>(raw[1]) == 0x8b) {
+        // gzip ends with the size of the decompressed data, modulo 2^32
+        const auto *trailer = reinterpret_cast<const uint8_t *>(raw.data() + raw.size() - 4);
+        const size_t size = size_t(trailer[0]) | size_t(trailer[1]) << 8 | size_t(trailer[2]) << 16 |
+                            size_t(trailer[3]) << 24;
+        if (size > 0) {
+            return std::min(size, limit);
+        }
+    }
+    return std::min(raw.size() * 4 + 64, limit);
+}
+
+} // namespace
+
+std::string decompress(const std::string &raw, int windowBits) {
+    z_stream &inflate_stream = inflateStream(windowBits);
 
     inflate_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(raw.data()));
     inflate_stream.avail_in = uInt(raw.size());
 
-    std::string result;
-    char out[16384];
+    // Inflate in place up to the size hint.
+    std::string result(std::max<size_t>(decompressedSizeHint(raw), 1), '\0');
 
-    int code;
-    do {
-        inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        inflate_stream.avail_out = sizeof(out);
-        code = inflate(&inflate_stream, 0);
-        if (result.size() < inflate_stream.total_out) {
-            result.append(out, inflate_stream.total_out - result.size());
-        }
-    } while (code == Z_OK);
+    int code = Z_OK;
+    while (code == Z_OK && inflate_stream.total_out < result.size()) {
+        inflate_stream.next_out = reinterpret_cast<Bytef *>(result.data() + inflate_stream.total_out);
+        inflate_stream.avail_out = uInt(std::min<size_t>(result.size() - inflate_stream.total_out,
+                                                         std::numeric_limits<uInt>::max()));
+        code = inflate(&inflate_stream, Z_NO_FLUSH);
+    }
 
-    inflateEnd(&inflate_stream);
+    // Append the rest, which grows the result without zero-filling it first.
+    if (code == Z_OK) {
+        char out[16384];
+        do {
+            inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
+            inflate_stream.avail_out = sizeof(out);
+            code = inflate(&inflate_stream, Z_NO_FLUSH);
+            result.append(out, sizeof(out) - inflate_stream.avail_out);
+        } while (code == Z_OK);
+    }
 
     if (code != Z_STREAM_END) {
         throw std::runtime_error(inflate_stream.msg ? inflate_stream.msg : "decompression error");
     }
 
+    result.resize(inflate_stream.total_out);
+    // The data may outlive the call by far, e.g. in a Response, so it doesn't
+    // keep an oversized hint or the growth of the last append.
+    if (result.capacity() > result.size() + result.size() / 2) {
+        result.shrink_to_fit();
+    }
+    return result;
+}
+
+#if MLN_WITH_ZSTD
+
+namespace {
+
+// Contexts hold the codec state and its buffers; reusing one per thread
+// avoids setting them up again for every tile.
+struct ZstdContextDeleter {
+    void operator()(ZSTD_CCtx *context) const { ZSTD_freeCCtx(context); }
+    void operator()(ZSTD_DCtx *context) const { ZSTD_freeDCtx(context); }
+};
+
+ZSTD_CCtx *zstdCompressionContext() {
+    thread_local std::unique_ptr<ZSTD_CCtx, ZstdContextDeleter> context(ZSTD_createCCtx());
+    return context.get();
+}
+
+ZSTD_DCtx *zstdDecompressionContext() {
+    thread_local std::unique_ptr<ZSTD_DCtx, ZstdContextDeleter> context(ZSTD_createDCtx());
+    return context.get();
+}
+
+} // namespace
+
+bool zstd_supported() noexcept {
+    return true;
+}
+
+std::string compress_zstd(const std::string &raw, int level) {
+    std::string result(ZSTD_compressBound(raw.size()), '\0');
+    const size_t size = ZSTD_compressCCtx(
+        zstdCompressionContext(), result.data(), result.size(), raw.data(), raw.size(), level);
+    if (ZSTD_isError(size)) {
+        throw std::runtime_error(ZSTD_getErrorName(size));
+    }
+    result.resize(size);
+    return result;
+}
+
+std::string decompress_zstd(const std::string &raw) {
+    // compress_zstd() records the content size in the frame header, which
+    // allows decoding in one call. The header isn't trusted: frames without
+    // the size are rejected, and so are sizes that a frame of this length
+    // can't hold, before anything is allocated.
+    const unsigned long long contentSize = ZSTD_getFrameContentSize(raw.data(), raw.size());
+    if (contentSize == ZSTD_CONTENTSIZE_ERROR || contentSize == ZSTD_CONTENTSIZE_UNKNOWN) {
+        throw std::runtime_error("decompression error");
+    }
+
+    // A block holds at most 128 KiB and takes at least 4 bytes, which is an
+    // RLE block.
+    constexpr unsigned long long maxBlockSize = 128 * 1024;
+    constexpr unsigned long long maxContentSize = 1 << 30;
+    if (contentSize > std::min(maxContentSize, (raw.size() / 4 + 1) * maxBlockSize)) {
+        throw std::runtime_error("decompression error");
+    }
+
+    std::string result(static_cast<size_t>(contentSize), '\0');
+    const size_t size = ZSTD_decompressDCtx(
+        zstdDecompressionContext(), result.data(), result.size(), raw.data(), raw.size());
+    if (ZSTD_isError(size) || size != result.size()) {
+        throw std::runtime_error("decompression error");
+    }
     return result;
 }
 
+#else
+
+bool zstd_supported() noexcept {
+    return false;
+}
+
+std::string compress_zstd(const std::string &, int) {
+    throw std::runtime_error("zstd support not enabled");
+}
+
+std::string decompress_zstd(const std::string &) {
+    throw std::runtime_error("zstd support not enabled");
+}
+
+#endif
+
 std::uint32_t crc32(const void *raw, size_t size) noexcept {
     auto hash = ::crc32(0L, Z_NULL, 0);
     if (raw) {
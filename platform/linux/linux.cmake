@@ -14,6 +14,9 @@ pkg_search_module(WEBP libwebp REQUIRED)
 pkg_search_module(LIBUV libuv REQUIRED)
 pkg_search_module(ICUUC icu-uc)
 pkg_search_module(ICUI18N icu-i18n)
+if(MLN_WITH_ZSTD)
+    pkg_search_module(ZSTD libzstd REQUIRED)
+endif()
 find_program(ARMERGE NAMES armerge)
 
 if(MLN_WITH_WAYLAND AND NOT MLN_WITH_VULKAN)
@@ -47,6 +50,7 @@ target_sources(
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/storage/mbtiles_file_source.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/storage/main_resource_loader.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/storage/offline.cpp
+        ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/storage/offline_archive.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/storage/offline_database.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/storage/offline_download.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/storage/online_file_source.cpp
@@ -145,8 +149,17 @@ target_include_directories(
         ${LIBUV_INCLUDE_DIRS}
         ${X11_INCLUDE_DIRS}
         ${WEBP_INCLUDE_DIRS}
+        ${ZSTD_INCLUDE_DIRS}
 )
 
+if(MLN_WITH_ZSTD)
+    target_compile_definitions(
+        mbgl-core
+        PRIVATE
+            MLN_WITH_ZSTD=1
+    )
+endif()
+
 include(${PROJECT_SOURCE_DIR}/vendor/nunicode.cmake)
 include(${PROJECT_SOURCE_DIR}/vendor/sqlite.cmake)
 
@@ -173,6 +186,7 @@ target_link_libraries(
         ${X11_LIBRARIES}
         ${CMAKE_THREAD_LIBS_INIT}
         ${WEBP_LIBRARIES}
+        ${ZSTD_LIBRARIES}
         $<$<NOT:$<BOOL:${MLN_USE_BUILTIN_ICU}>>:${ICUUC_LIBRARIES}>
         $<$<NOT:$<BOOL:${MLN_USE_BUILTIN_ICU}>>:${ICUI18N_LIBRARIES}>
         $<$<BOOL:${MLN_USE_BUILTIN_ICU}>:mbgl-vendor-icu>
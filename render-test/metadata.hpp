@@ -161,6 +161,7 @@ struct TestMetadata {
     mbgl::MapMode mapMode = mbgl::MapMode::Static;
     mbgl::MapDebugOptions debug = mbgl::MapDebugOptions::NoDebug;
     bool crossSourceCollisions = true;
+    bool parallelPlacement = false;
     bool axonometric = false;
     double xSkew = 0.0;
     double ySkew = 1.0;
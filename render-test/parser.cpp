@@ -545,6 +545,11 @@ TestMetadata parseTestMetadata(const TestPaths& paths) {
         metadata.crossSourceCollisions = testValue["crossSourceCollisions"].GetBool();
     }
 
+    if (testValue.HasMember("parallelPlacement")) {
+        assert(testValue["parallelPlacement"].IsBool());
+        metadata.parallelPlacement = testValue["parallelPlacement"].GetBool();
+    }
+
     if (testValue.HasMember("axonometric")) {
         assert(testValue["axonometric"].IsBool());
         metadata.axonometric = testValue["axonometric"].GetBool();
@@ -702,7 +702,8 @@ TestRunner::Impl::Impl(const TestMetadata& metadata,
               .withMapMode(metadata.mapMode)
               .withSize(metadata.size)
               .withPixelRatio(metadata.pixelRatio)
-              .withCrossSourceCollisions(metadata.crossSourceCollisions),
+              .withCrossSourceCollisions(metadata.crossSourceCollisions)
+              .withParallelPlacement(metadata.parallelPlacement),
           resourceOptions,
           clientOptions) {}
 
@@ -750,7 +751,8 @@ void TestRunner::run(TestMetadata& metadata) {
 
     std::string key = mbgl::util::toString(uint32_t(metadata.mapMode)) + "/" +
                       mbgl::util::toString(metadata.pixelRatio) + "/" +
-                      mbgl::util::toString(uint32_t(metadata.crossSourceCollisions));
+                      mbgl::util::toString(uint32_t(metadata.crossSourceCollisions)) + "/" +
+                      mbgl::util::toString(uint32_t(metadata.parallelPlacement));
 
     if (maps.find(key) == maps.end()) {
         maps[key] = std::make_unique<TestRunner::Impl>(
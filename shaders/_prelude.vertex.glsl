@@ -56,6 +56,18 @@ vec4 unpack_mix_color(const vec4 packedColors, const float t) {
     return mix(minColor, maxColor, t);
 }
 
+#ifdef HAS_FEATURE_STATE_TEXTURE
+// Paint values that depend on feature state, FEATURE_STATE_STRIDE texels per feature,
+// in the same packed form as the vertex attributes they replace.
+uniform highp sampler2D u_feature_state;
+
+highp vec4 feature_state_texel(const highp float ordinal, const int slot) {
+    int index = int(ordinal) * FEATURE_STATE_STRIDE + slot;
+    int width = textureSize(u_feature_state, 0).x;
+    return texelFetch(u_feature_state, ivec2(index - (index / width) * width, index / width), 0);
+}
+#endif
+
 // The offset depends on how many pixels are between the world origin and the edge of the tile:
 // vec2 offset = mod(pixel_coord, size)
 //
@@ -17,6 +17,9 @@ layout (std140) uniform FillEvaluatedPropsUBO {
 };
 
 layout (location = 0) in vec2 a_pos;
+#ifdef HAS_FEATURE_STATE_TEXTURE
+layout (location = 1) in highp float a_feature_ordinal;
+#endif
 
 #pragma mapbox: define highp vec4 color
 #pragma mapbox: define lowp float opacity
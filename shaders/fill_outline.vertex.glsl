@@ -29,6 +29,9 @@ layout (std140) uniform FillEvaluatedPropsUBO {
 };
 
 layout (location = 0) in vec2 a_pos;
+#ifdef HAS_FEATURE_STATE_TEXTURE
+layout (location = 1) in highp float a_feature_ordinal;
+#endif
 
 out vec2 v_pos;
 
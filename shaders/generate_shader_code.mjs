@@ -113,7 +113,8 @@ ${precision} ${type} ${name} = u_${name};
 };
 
 /// This variant does not emit any uniforms and instead controls access to UBOs
-const pragmaMapConvertOnlyVertexArrays = (source, pragmaMap, attribLocations, pipelineStage) => {
+/// With `featureState`, data driven properties can also be read from the feature state texture
+const pragmaMapConvertOnlyVertexArrays = (source, pragmaMap, attribLocations, pipelineStage, featureState) => {
     const re = /#pragma mapbox: ([\w]+) ([\w]+) ([\w]+) ([\w]+)/g;
 
     if (pipelineStage == "fragment") {
@@ -136,11 +137,26 @@ ${precision} ${type} ${name} = u_${name};
     return source.replace(re, (match, operation, precision, type, name) => {
         const attrType = type === 'float' ? 'vec2' : 'vec4';
         const unpackType = name.match(/color/) ? 'color' : attrType;
+        const usesFeatureState = featureState && unpackType !== 'vec4';
+        const attributeDefine = () => {
+            const attribute = `layout (location = ${locationForAttrib(attribLocations, name)}) in ${precision} ${attrType} a_${name};`;
+            return usesFeatureState
+                ? `#ifndef HAS_FEATURE_STATE_u_${name}
+${attribute}
+#endif`
+                : attribute;
+        };
+        // Feature state texels hold the same packed values as the attribute
+        const featureStateInitialize = (declaration) => usesFeatureState
+            ? `#if defined(HAS_FEATURE_STATE_u_${name})
+${declaration} = unpack_mix_${unpackType}(feature_state_texel(a_feature_ordinal, FEATURE_STATE_SLOT_u_${name})${attrType === 'vec2' ? '.xy' : ''}, u_${name}_t);
+#elif !defined(HAS_UNIFORM_u_${name})`
+            : `#ifndef HAS_UNIFORM_u_${name}`;
 
         if (pragmaMap[name]) {
             if (operation === 'define') {
                 return `#ifndef HAS_UNIFORM_u_${name}
-layout (location = ${locationForAttrib(attribLocations, name)}) in ${precision} ${attrType} a_${name};
+${attributeDefine()}
 out ${precision} ${type} ${name};
 #endif`;
             } else /* if (operation === 'initialize') */ {
@@ -152,7 +168,7 @@ ${name} = a_${name};
 ${precision} ${type} ${name} = u_${name};
 #endif`;
                 } else {
-                    return `#ifndef HAS_UNIFORM_u_${name}
+                    return `${featureStateInitialize(name)}
 ${name} = unpack_mix_${unpackType}(a_${name}, u_${name}_t);
 #else
 ${precision} ${type} ${name} = u_${name};
@@ -162,7 +178,7 @@ ${precision} ${type} ${name} = u_${name};
         } else {
             if (operation === 'define') {
                 return `#ifndef HAS_UNIFORM_u_${name}
-layout (location = ${locationForAttrib(attribLocations, name)}) in ${precision} ${attrType} a_${name};
+${attributeDefine()}
 #endif`;
             } else /* if (operation === 'initialize') */ {
                 if (unpackType === 'vec4') {
@@ -173,7 +189,7 @@ ${precision} ${type} ${name} = a_${name};
 ${precision} ${type} ${name} = u_${name};
 #endif`;
                 } else /* */{
-                    return `#ifndef HAS_UNIFORM_u_${name}
+                    return `${featureStateInitialize(`${precision} ${type} ${name}`)}
 ${precision} ${type} ${name} = unpack_mix_${unpackType}(a_${name}, u_${name}_t);
 #else
 ${precision} ${type} ${name} = u_${name};
@@ -240,7 +256,7 @@ JSON.parse(fs.readFileSync(path.join(shaderRoot, "manifest.json")))
             ? pragmaMapConvertOnlyVertexArrays(fragmentSource, pragmaMap, attribMap, "fragment")
             : pragmaMapConvert(fragmentSource, pragmaMap, attribMap, "fragment");
         const vert = elem.uses_ubos
-            ? pragmaMapConvertOnlyVertexArrays(vertexSource, pragmaMap, attribMap, "vertex")
+            ? pragmaMapConvertOnlyVertexArrays(vertexSource, pragmaMap, attribMap, "vertex", elem.uses_feature_state)
             : pragmaMapConvert(vertexSource, pragmaMap, attribMap, "vertex");
 
         const glRoot = path.join(outputRoot, "gl");
@@ -11,12 +11,17 @@
 #include <cstddef>
 #include <optional>
 
+// `featureStateName()` identifies the property when the shaders read it from a
+// feature state texture, see `gfx::ShaderGroup::featureStatePrefix`.
 #define MBGL_DEFINE_ATTRIBUTE(type_, n_, name_)             \
     struct name_ {                                          \
         using Type = ::mbgl::gfx::AttributeType<type_, n_>; \
         static constexpr auto name() {                      \
             return #name_;                                  \
         }                                                   \
+        static constexpr auto featureStateName() {          \
+            return "feature_state_" #name_;                 \
+        }                                                   \
     }
 
 #if defined(_MSC_VER) && !defined(__clang__)
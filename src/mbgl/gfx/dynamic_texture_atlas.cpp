@@ -150,8 +150,8 @@ ImageAtlas DynamicTextureAtlas::uploadIconsAndPatterns(const ImageMap& icons,
             const auto& icon = iconEntry.second;
 
             auto imageHash = util::hash(icon->id);
-            int32_t uniqueId = static_cast<int32_t>(sqrt(imageHash) / 2 + icon->image.size.area());
-            const auto size = Size(icon->image.size.width + 2 * padding, icon->image.size.height + 2 * padding);
+            int32_t uniqueId = static_cast<int32_t>(sqrt(imageHash) / 2 + icon->getSize().area());
+            const auto size = Size(icon->getSize().width + 2 * padding, icon->getSize().height + 2 * padding);
             const auto& texHandle = imageAtlas.dynamicTexture->reserveSize(size, uniqueId);
             if (!texHandle) {
                 hasSpace = false;
@@ -164,9 +164,9 @@ ImageAtlas DynamicTextureAtlas::uploadIconsAndPatterns(const ImageMap& icons,
                 const auto& pattern = patternEntry.second;
 
                 auto patternHash = util::hash(pattern->id);
-                int32_t uniqueId = static_cast<int32_t>(sqrt(patternHash) / 2 + pattern->image.size.area());
-                const auto size = Size(pattern->image.size.width + 2 * padding,
-                                       pattern->image.size.height + 2 * padding);
+                int32_t uniqueId = static_cast<int32_t>(sqrt(patternHash) / 2 + pattern->getSize().area());
+                const auto size = Size(pattern->getSize().width + 2 * padding,
+                                       pattern->getSize().height + 2 * padding);
                 const auto& texHandle = imageAtlas.dynamicTexture->reserveSize(size, uniqueId);
                 if (!texHandle) {
                     hasSpace = false;
@@ -199,7 +199,8 @@ ImageAtlas DynamicTextureAtlas::uploadIconsAndPatterns(const ImageMap& icons,
         if (texHandle.isUploadNeeded()) {
             PremultipliedImage paddedImage(Size{rect.w, rect.h});
             paddedImage.fill(0);
-            PremultipliedImage::copy(icon->image, paddedImage, {0, 0}, {padding, padding}, icon->image.size);
+            const PremultipliedImage& image = icon->getImage();
+            PremultipliedImage::copy(image, paddedImage, {0, 0}, {padding, padding}, image.size);
 
             imageAtlas.dynamicTexture->uploadImage(paddedImage.data.get(), texHandle);
         }
@@ -216,18 +217,19 @@ ImageAtlas DynamicTextureAtlas::uploadIconsAndPatterns(const ImageMap& icons,
         if (texHandle.isUploadNeeded()) {
             PremultipliedImage paddedImage(Size{rect.w, rect.h});
             paddedImage.fill(0);
-            PremultipliedImage::copy(pattern->image, paddedImage, {0, 0}, {padding, padding}, pattern->image.size);
+            const PremultipliedImage& image = pattern->getImage();
+            PremultipliedImage::copy(image, paddedImage, {0, 0}, {padding, padding}, image.size);
 
             const uint32_t x = padding;
             const uint32_t y = padding;
-            const uint32_t w = pattern->image.size.width;
-            const uint32_t h = pattern->image.size.height;
+            const uint32_t w = image.size.width;
+            const uint32_t h = image.size.height;
 
             // Add 1 pixel wrapped padding on each side of the image.
-            PremultipliedImage::copy(pattern->image, paddedImage, {0, h - 1}, {x, y - 1}, {w, 1}); // T
-            PremultipliedImage::copy(pattern->image, paddedImage, {0, 0}, {x, y + h}, {w, 1});     // B
-            PremultipliedImage::copy(pattern->image, paddedImage, {w - 1, 0}, {x - 1, y}, {1, h}); // L
-            PremultipliedImage::copy(pattern->image, paddedImage, {0, 0}, {x + w, y}, {1, h});     // R
+            PremultipliedImage::copy(image, paddedImage, {0, h - 1}, {x, y - 1}, {w, 1}); // T
+            PremultipliedImage::copy(image, paddedImage, {0, 0}, {x, y + h}, {w, 1});     // B
+            PremultipliedImage::copy(image, paddedImage, {w - 1, 0}, {x - 1, y}, {1, h}); // L
+            PremultipliedImage::copy(image, paddedImage, {0, 0}, {x + w, y}, {1, h});     // R
 
             imageAtlas.dynamicTexture->uploadImage(paddedImage.data.get(), texHandle);
         }
@@ -1,6 +1,8 @@
 #include <mbgl/gfx/shader_group.hpp>
 #include <mbgl/gfx/shader.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 namespace gfx {
 
@@ -47,5 +49,33 @@ bool ShaderGroup::registerShader(std::shared_ptr<Shader>&& shader, const std::st
     return true;
 }
 
+std::vector<std::pair<std::string, std::string>> ShaderGroup::featureStateDefines(
+    const StringIDSetsPair& propertiesAsUniforms) {
+    std::vector<std::string_view> names;
+    for (const auto name : propertiesAsUniforms.first) {
+        if (name.starts_with(featureStatePrefix)) {
+            names.push_back(name.substr(featureStatePrefix.size()));
+        }
+    }
+    if (names.empty()) {
+        return {};
+    }
+    std::sort(names.begin(), names.end());
+
+    std::vector<std::pair<std::string, std::string>> defines;
+    defines.reserve(2 * names.size() + 2);
+    defines.emplace_back("HAS_FEATURE_STATE_TEXTURE", std::string());
+    defines.emplace_back("FEATURE_STATE_STRIDE", std::to_string(names.size()));
+    for (std::size_t slot = 0; slot < names.size(); ++slot) {
+        // Properties that are currently constant keep their slot, but read the uniform
+        if (propertiesAsUniforms.first.contains(names[slot])) {
+            continue;
+        }
+        defines.emplace_back("HAS_FEATURE_STATE_u_" + std::string(names[slot]), std::string());
+        defines.emplace_back("FEATURE_STATE_SLOT_u_" + std::string(names[slot]), std::to_string(slot));
+    }
+    return defines;
+}
+
 } // namespace gfx
 } // namespace mbgl
@@ -127,5 +127,21 @@ void VertexAttributeArray::clear() {
     }
 }
 
+void VertexAttributeArray::setSharedAttributes(const VertexAttributeArray& other) {
+    for (std::size_t id = 0; id < other.attrs.size(); ++id) {
+        const auto& source = other.attrs[id];
+        if (!source || !source->sharedRawData) {
+            continue;
+        }
+        if (const auto& attr = set(id)) {
+            attr->setSharedRawData(source->sharedRawData,
+                                   source->sharedOffset,
+                                   source->sharedVertexOffset,
+                                   source->sharedStride,
+                                   source->sharedType);
+        }
+    }
+}
+
 } // namespace gfx
 } // namespace mbgl
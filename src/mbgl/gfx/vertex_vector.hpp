@@ -3,7 +3,11 @@
 #include <mbgl/util/ignore.hpp>
 #include <mbgl/util/monotonic_timer.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace mbgl {
@@ -20,7 +24,9 @@ public:
     VertexVectorBase(VertexVectorBase&& other)
         : buffer(std::move(other.buffer)),
           dirty(other.dirty),
-          released(other.released) {}
+          released(other.released),
+          modifiedBegin(other.modifiedBegin),
+          modifiedEnd(other.modifiedEnd) {}
     virtual ~VertexVectorBase() = default;
 
     virtual const void* getRawData() const = 0;
@@ -43,10 +49,45 @@ public:
     // Indicates that the owner/producer will not modify this again
     bool isReleased() const { return released; }
 
+    /// Elements overwritten in place since the buffer was last updated, as a
+    /// half-open range. Anything else, like adding elements, makes the range
+    /// cover the whole vector, and so does a vector that was never uploaded.
+    std::pair<std::size_t, std::size_t> getModifiedRange() const {
+        return {modifiedBegin, std::min(modifiedEnd, getRawCount())};
+    }
+    bool isPartiallyModified() const { return modifiedBegin != 0 || modifiedEnd != wholeVector; }
+
+    /// Called by the upload pass once the buffer matches the vector again.
+    void resetModifiedRange() {
+        modifiedBegin = 0;
+        modifiedEnd = 0;
+    }
+
 protected:
+    static constexpr std::size_t wholeVector = std::numeric_limits<std::size_t>::max();
+
+    void markModified() {
+        dirty = true;
+        modifiedBegin = 0;
+        modifiedEnd = wholeVector;
+    }
+
+    void markModified(std::size_t begin, std::size_t end) {
+        dirty = true;
+        if (modifiedBegin == modifiedEnd) {
+            modifiedBegin = begin;
+            modifiedEnd = end;
+        } else {
+            modifiedBegin = std::min(modifiedBegin, begin);
+            modifiedEnd = std::max(modifiedEnd, end);
+        }
+    }
+
     std::unique_ptr<VertexBufferBase> buffer;
     bool dirty = true;
     bool released = false;
+    std::size_t modifiedBegin = 0;
+    std::size_t modifiedEnd = wholeVector;
 
     std::chrono::duration<double> lastModified = util::MonotonicTimer::now();
 };
@@ -70,19 +111,19 @@ public:
     void emplace_back(Args&&... args) {
         assert(!released);
         util::ignore({(v.emplace_back(std::forward<Args>(args)), 0)...});
-        dirty = true;
+        markModified();
     }
 
     void extend(std::size_t n, const Vertex& val) {
         assert(!released);
         v.resize(v.size() + n, val);
-        dirty = true;
+        markModified();
     }
 
     Vertex& at(std::size_t n) {
         assert(n < v.size());
         assert(!released);
-        dirty = true;
+        markModified();
         return v.at(n);
     }
     const Vertex& at(std::size_t n) const {
@@ -96,8 +137,17 @@ public:
 
     bool empty() const { return v.empty(); }
 
+    /// Overwrites elements [begin, end), which is all the buffer needs to
+    /// update on the next upload.
+    void fill(std::size_t begin, std::size_t end, const Vertex& value) {
+        assert(begin <= end && end <= v.size());
+        assert(!released);
+        std::fill(v.begin() + begin, v.begin() + end, value);
+        markModified(begin, end);
+    }
+
     void clear() {
-        dirty = true;
+        markModified();
         v.clear();
     }
 
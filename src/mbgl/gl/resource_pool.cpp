@@ -46,6 +46,8 @@ size_t Texture2DDesc::channelStorageSize() const {
     switch (channelType) {
         case gfx::TextureChannelDataType::HalfFloat:
             return 2;
+        case gfx::TextureChannelDataType::Float:
+            return 4;
         case gfx::TextureChannelDataType::UnsignedByte:
             return 1;
         default:
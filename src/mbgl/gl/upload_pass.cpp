@@ -40,8 +40,15 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
 }
 
 void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
+    updateVertexBufferResource(resource, data, size, 0);
+}
+
+void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) {
     commandEncoder.context.vertexBuffer = static_cast<gl::VertexBufferResource&>(resource).getBuffer();
-    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
 
     commandEncoder.context.renderingStats().vertexUpdateBytes += size;
     commandEncoder.context.renderingStats().bufferUpdateBytes += size;
@@ -98,10 +105,23 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
 
             // If the already-allocated buffer is large enough, we can re-use it
             if (rawBufSize <= resource.getByteSize()) {
-                // If the source changed, update the buffer contents
+                // If the source changed, update the buffer contents, or only
+                // the elements that changed if they were overwritten in place
                 if (vec->isModifiedAfter(resource.getLastUpdated())) {
-                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    if (vec->isPartiallyModified()) {
+                        const auto [begin, end] = vec->getModifiedRange();
+                        const auto stride = vec->getRawSize();
+                        if (end > begin) {
+                            updateVertexBufferResource(resource,
+                                                       static_cast<const std::uint8_t*>(rawBufPtr) + begin * stride,
+                                                       (end - begin) * stride,
+                                                       begin * stride);
+                        }
+                    } else {
+                        updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    }
                     resource.setLastUpdated(vec->getLastModified());
+                    vec->resetModifiedRange();
                 }
                 return rawData->resource;
             }
@@ -111,6 +131,7 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             auto buffer = std::make_unique<VertexBufferGL>();
             buffer->resource = createVertexBufferResource(rawBufPtr, rawBufSize, usage, /*persistent=*/false);
             vec->setBuffer(std::move(buffer));
+            vec->resetModifiedRange();
             return static_cast<VertexBufferGL*>(vec->getBuffer())->resource;
         }
     }
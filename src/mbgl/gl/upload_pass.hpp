@@ -44,6 +44,7 @@ public:
     void updateIndexBufferResource(gfx::IndexBufferResource&, const void* data, std::size_t size) override;
 
     const gfx::UniqueVertexBufferResource& getBuffer(const gfx::VertexVectorBasePtr&, gfx::BufferUsageType);
+    void updateVertexBufferResource(gfx::VertexBufferResource&, const void* data, std::size_t size, std::size_t offset);
 
     gfx::AttributeBindingArray buildAttributeBindings(
         const std::size_t vertexCount,
@@ -102,6 +102,9 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
     : sharedData(std::move(sharedData_)),
       anchor(anchor_),
       symbolContent(iconType),
+      writingModes(WritingModeType::None),
+      singleLine(shapedTextOrientations.singleLine),
+      textBoxScale(textBoxScale_),
       // Create the collision features that will be used to check whether this
       // symbol instance can be placed As a collision approximation, we can use
       // either the vertical or any of the horizontal versions of the feature
@@ -116,15 +119,12 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                            textRotation),
       iconCollisionFeature(
           sharedData->line, anchor, shapedIcon, iconBoxScale, iconPadding, indexedFeature, iconRotation),
-      writingModes(WritingModeType::None),
-      layoutFeatureIndex(layoutFeatureIndex_),
-      dataFeatureIndex(dataFeatureIndex_),
+      layoutFeatureIndex(static_cast<uint32_t>(layoutFeatureIndex_)),
+      dataFeatureIndex(static_cast<uint32_t>(dataFeatureIndex_)),
       textOffset(textOffset_),
       iconOffset(iconOffset_),
-      key(std::move(key_)),
-      textBoxScale(textBoxScale_),
       textVariableAnchorOffset(textVariableAnchorOffset_),
-      singleLine(shapedTextOrientations.singleLine) {
+      key(std::move(key_)) {
     // 'hasText' depends on finding at least one glyph in the shaping that's also in the GlyphPositionMap
     if (!sharedData->empty()) symbolContent |= SymbolContent::Text;
     if (allowVerticalPlacement && shapedTextOrientations.vertical) {
@@ -149,11 +149,11 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
         }
     }
 
-    rightJustifiedGlyphQuadsSize = sharedData->rightJustifiedGlyphQuads.size();
-    centerJustifiedGlyphQuadsSize = sharedData->centerJustifiedGlyphQuads.size();
-    leftJustifiedGlyphQuadsSize = sharedData->leftJustifiedGlyphQuads.size();
-    verticalGlyphQuadsSize = sharedData->verticalGlyphQuads.size();
-    iconQuadsSize = sharedData->iconQuads ? sharedData->iconQuads->size() : 0;
+    rightJustifiedGlyphQuadsSize = static_cast<uint32_t>(sharedData->rightJustifiedGlyphQuads.size());
+    centerJustifiedGlyphQuadsSize = static_cast<uint32_t>(sharedData->centerJustifiedGlyphQuads.size());
+    leftJustifiedGlyphQuadsSize = static_cast<uint32_t>(sharedData->leftJustifiedGlyphQuads.size());
+    verticalGlyphQuadsSize = static_cast<uint32_t>(sharedData->verticalGlyphQuads.size());
+    iconQuadsSize = sharedData->iconQuads ? static_cast<uint32_t>(sharedData->iconQuads->size()) : 0;
 
     if (rightJustifiedGlyphQuadsSize || centerJustifiedGlyphQuadsSize || leftJustifiedGlyphQuadsSize) {
         writingModes |= WritingModeType::Horizontal;
@@ -228,9 +228,9 @@ void SymbolInstance::releaseSharedData() {
 }
 
 std::optional<size_t> SymbolInstance::getDefaultHorizontalPlacedTextIndex() const {
-    if (placedRightTextIndex) return placedRightTextIndex;
-    if (placedCenterTextIndex) return placedCenterTextIndex;
-    if (placedLeftTextIndex) return placedLeftTextIndex;
+    if (placedRightTextIndex != noPlacedIndex) return placedRightTextIndex;
+    if (placedCenterTextIndex != noPlacedIndex) return placedCenterTextIndex;
+    if (placedLeftTextIndex != noPlacedIndex) return placedLeftTextIndex;
     return std::nullopt;
 }
 
@@ -252,11 +252,12 @@ bool SymbolInstance::checkIndexes(std::size_t textCount,
                                   std::size_t iconSize,
                                   std::size_t sdfSize,
                                   const std::source_location& source) const {
-    return !isFailed && checkIndex(placedRightTextIndex, textCount, source) &&
-           checkIndex(placedCenterTextIndex, textCount, source) && checkIndex(placedLeftTextIndex, textCount, source) &&
-           checkIndex(placedVerticalTextIndex, textCount, source) &&
-           checkIndex(placedIconIndex, hasSdfIcon() ? sdfSize : iconSize, source) &&
-           checkIndex(placedVerticalIconIndex, hasSdfIcon() ? sdfSize : iconSize, source);
+    return !isFailed && checkIndex(getPlacedRightTextIndex(), textCount, source) &&
+           checkIndex(getPlacedCenterTextIndex(), textCount, source) &&
+           checkIndex(getPlacedLeftTextIndex(), textCount, source) &&
+           checkIndex(getPlacedVerticalTextIndex(), textCount, source) &&
+           checkIndex(getPlacedIconIndex(), hasSdfIcon() ? sdfSize : iconSize, source) &&
+           checkIndex(getPlacedVerticalIconIndex(), hasSdfIcon() ? sdfSize : iconSize, source);
 }
 
 namespace {
@@ -5,6 +5,8 @@
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/util/bitmask_operations.hpp>
 
+#include <cassert>
+#include <limits>
 #include <source_location>
 
 #if !defined(MLN_SYMBOL_GUARDS)
@@ -176,14 +178,14 @@ public:
     std::array<float, 2> getTextOffset() const { return textOffset; }
     std::array<float, 2> getIconOffset() const { return iconOffset; }
     const std::u16string& getKey() const { return key; }
-    std::optional<size_t> getPlacedRightTextIndex() const { return placedRightTextIndex; }
-    std::optional<size_t> getPlacedCenterTextIndex() const { return placedCenterTextIndex; }
-    std::optional<size_t> getPlacedLeftTextIndex() const { return placedLeftTextIndex; }
-    std::optional<size_t> getPlacedVerticalTextIndex() const { return placedVerticalTextIndex; }
-    std::optional<size_t> getPlacedIconIndex() const { return placedIconIndex; }
-    std::optional<size_t> getPlacedVerticalIconIndex() const { return placedVerticalIconIndex; }
+    std::optional<size_t> getPlacedRightTextIndex() const { return fromPlacedIndex(placedRightTextIndex); }
+    std::optional<size_t> getPlacedCenterTextIndex() const { return fromPlacedIndex(placedCenterTextIndex); }
+    std::optional<size_t> getPlacedLeftTextIndex() const { return fromPlacedIndex(placedLeftTextIndex); }
+    std::optional<size_t> getPlacedVerticalTextIndex() const { return fromPlacedIndex(placedVerticalTextIndex); }
+    std::optional<size_t> getPlacedIconIndex() const { return fromPlacedIndex(placedIconIndex); }
+    std::optional<size_t> getPlacedVerticalIconIndex() const { return fromPlacedIndex(placedVerticalIconIndex); }
     float getTextBoxScale() const { return textBoxScale; }
-    std::optional<VariableAnchorOffsetCollection> getTextVariableAnchorOffset() const {
+    const std::optional<VariableAnchorOffsetCollection>& getTextVariableAnchorOffset() const {
         return textVariableAnchorOffset;
     }
     bool getSingleLine() const { return singleLine; }
@@ -191,16 +193,12 @@ public:
     uint32_t getCrossTileID() const { return crossTileID; }
     void setCrossTileID(uint32_t x) { crossTileID = x; }
 
-    std::optional<size_t>& refPlacedRightTextIndex() { return placedRightTextIndex; }
-    std::optional<size_t>& refPlacedCenterTextIndex() { return placedCenterTextIndex; }
-    std::optional<size_t>& refPlacedLeftTextIndex() { return placedLeftTextIndex; }
-    std::optional<size_t>& refPlacedVerticalTextIndex() { return placedVerticalTextIndex; }
-    std::optional<size_t>& refPlacedIconIndex() { return placedIconIndex; }
-    std::optional<size_t>& refPlacedVerticalIconIndex() { return placedVerticalIconIndex; }
-
-    void setPlacedRightTextIndex(std::optional<size_t> x) { placedRightTextIndex = x; }
-    void setPlacedCenterTextIndex(std::optional<size_t> x) { placedCenterTextIndex = x; }
-    void setPlacedLeftTextIndex(std::optional<size_t> x) { placedLeftTextIndex = x; }
+    void setPlacedRightTextIndex(std::optional<size_t> x) { placedRightTextIndex = toPlacedIndex(x); }
+    void setPlacedCenterTextIndex(std::optional<size_t> x) { placedCenterTextIndex = toPlacedIndex(x); }
+    void setPlacedLeftTextIndex(std::optional<size_t> x) { placedLeftTextIndex = toPlacedIndex(x); }
+    void setPlacedVerticalTextIndex(std::optional<size_t> x) { placedVerticalTextIndex = toPlacedIndex(x); }
+    void setPlacedIconIndex(std::optional<size_t> x) { placedIconIndex = toPlacedIndex(x); }
+    void setPlacedVerticalIconIndex(std::optional<size_t> x) { placedVerticalIconIndex = toPlacedIndex(x); }
 
     static constexpr uint32_t invalidCrossTileID = std::numeric_limits<uint32_t>::max();
 
@@ -214,66 +212,77 @@ protected:
 #endif
 
 private:
+    // Indexes into the placed symbols of a bucket, and feature indexes, are stored in 32 bits.
+    static constexpr uint32_t noPlacedIndex = std::numeric_limits<uint32_t>::max();
+    static std::optional<size_t> fromPlacedIndex(uint32_t index) {
+        return index == noPlacedIndex ? std::nullopt : std::optional<size_t>(index);
+    }
+    static uint32_t toPlacedIndex(std::optional<size_t> index) {
+        assert(!index || *index < noPlacedIndex);
+        return index ? static_cast<uint32_t>(*index) : noPlacedIndex;
+    }
+
     std::shared_ptr<SymbolInstanceSharedData> sharedData;
 
     static constexpr std::uint64_t checkVal = 0x123456780ABCDEFFULL;
 
+    // Members read for every symbol during placement come first.
     SYM_GUARD_VALUE(01)
     Anchor anchor;
     SYM_GUARD_VALUE(02)
-    SymbolContent symbolContent;
+    uint32_t crossTileID = 0;
     SYM_GUARD_VALUE(03)
-
-    std::size_t rightJustifiedGlyphQuadsSize;
+    SymbolContent symbolContent;
     SYM_GUARD_VALUE(04)
-    std::size_t centerJustifiedGlyphQuadsSize;
+    WritingModeType writingModes;
     SYM_GUARD_VALUE(05)
-    std::size_t leftJustifiedGlyphQuadsSize;
+    bool singleLine;
     SYM_GUARD_VALUE(06)
-    std::size_t verticalGlyphQuadsSize;
+    float textBoxScale;
     SYM_GUARD_VALUE(07)
-    std::size_t iconQuadsSize;
+    uint32_t placedRightTextIndex = noPlacedIndex;
     SYM_GUARD_VALUE(08)
-
-    CollisionFeature textCollisionFeature;
+    uint32_t placedCenterTextIndex = noPlacedIndex;
     SYM_GUARD_VALUE(09)
-    CollisionFeature iconCollisionFeature;
+    uint32_t placedLeftTextIndex = noPlacedIndex;
     SYM_GUARD_VALUE(10)
-    std::optional<CollisionFeature> verticalTextCollisionFeature = std::nullopt;
+    uint32_t placedVerticalTextIndex = noPlacedIndex;
     SYM_GUARD_VALUE(11)
-    std::optional<CollisionFeature> verticalIconCollisionFeature = std::nullopt;
+    uint32_t placedIconIndex = noPlacedIndex;
     SYM_GUARD_VALUE(12)
-    WritingModeType writingModes;
+    uint32_t placedVerticalIconIndex = noPlacedIndex;
     SYM_GUARD_VALUE(13)
-    std::size_t layoutFeatureIndex; // Index into the set of features included at layout time
+    CollisionFeature textCollisionFeature;
     SYM_GUARD_VALUE(14)
-    std::size_t dataFeatureIndex; // Index into the underlying tile data feature set
+    CollisionFeature iconCollisionFeature;
     SYM_GUARD_VALUE(15)
-    std::array<float, 2> textOffset;
+    std::optional<CollisionFeature> verticalTextCollisionFeature = std::nullopt;
     SYM_GUARD_VALUE(16)
-    std::array<float, 2> iconOffset;
+    std::optional<CollisionFeature> verticalIconCollisionFeature = std::nullopt;
     SYM_GUARD_VALUE(17)
-    std::u16string key;
+
+    // Members used at layout, by the cross tile index, or for variable anchors only.
+    uint32_t rightJustifiedGlyphQuadsSize;
     SYM_GUARD_VALUE(18)
-    std::optional<size_t> placedRightTextIndex;
+    uint32_t centerJustifiedGlyphQuadsSize;
     SYM_GUARD_VALUE(19)
-    std::optional<size_t> placedCenterTextIndex;
+    uint32_t leftJustifiedGlyphQuadsSize;
     SYM_GUARD_VALUE(20)
-    std::optional<size_t> placedLeftTextIndex;
+    uint32_t verticalGlyphQuadsSize;
     SYM_GUARD_VALUE(21)
-    std::optional<size_t> placedVerticalTextIndex;
+    uint32_t iconQuadsSize;
     SYM_GUARD_VALUE(22)
-    std::optional<size_t> placedIconIndex;
+    uint32_t layoutFeatureIndex; // Index into the set of features included at layout time
     SYM_GUARD_VALUE(23)
-    std::optional<size_t> placedVerticalIconIndex;
+    uint32_t dataFeatureIndex; // Index into the underlying tile data feature set
     SYM_GUARD_VALUE(24)
-    float textBoxScale;
+    std::array<float, 2> textOffset;
     SYM_GUARD_VALUE(25)
-    std::optional<VariableAnchorOffsetCollection> textVariableAnchorOffset;
+    std::array<float, 2> iconOffset;
     SYM_GUARD_VALUE(26)
-    bool singleLine;
+    std::optional<VariableAnchorOffsetCollection> textVariableAnchorOffset;
     SYM_GUARD_VALUE(27)
-    uint32_t crossTileID = 0;
+    std::u16string key;
     SYM_GUARD_VALUE(28)
 #if MLN_SYMBOL_GUARDS
     mutable bool isFailed = false;
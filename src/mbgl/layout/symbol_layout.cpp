@@ -1046,7 +1046,7 @@ void SymbolLayout::createBucket(const ImagePositions&,
         if (hasIcon) {
             const Range<float> sizeData = bucket->iconSizeBinder->getVertexSizeData(feature);
             auto& iconBuffer = symbolInstance.hasSdfIcon() ? bucket->sdfIcon : bucket->icon;
-            const auto placeIcon = [&](const SymbolQuads& iconQuads, auto& index, const WritingModeType writingMode) {
+            const auto placeIcon = [&](const SymbolQuads& iconQuads, const WritingModeType writingMode) {
                 iconBuffer.placedSymbols.emplace_back(symbolInstance.getAnchor().point,
                                                       symbolInstance.getAnchor().segment.value_or(0u),
                                                       sizeData.min,
@@ -1055,21 +1055,21 @@ void SymbolLayout::createBucket(const ImagePositions&,
                                                       writingMode,
                                                       symbolInstance.line(),
                                                       std::vector<float>());
-                index = iconBuffer.placedSymbols.size() - 1;
+                const std::size_t index = iconBuffer.placedSymbols.size() - 1;
                 PlacedSymbol& iconSymbol = iconBuffer.placedSymbols.back();
                 iconSymbol.angle = (allowVerticalPlacement && writingMode == WritingModeType::Vertical)
                                        ? pi_v<float> / 2
                                        : 0.0f;
                 iconSymbol.vertexStartIndex = addSymbols(
                     iconBuffer, sizeData, iconQuads, symbolInstance.getAnchor(), iconSymbol, feature.sortKey);
+                return index;
             };
 
-            placeIcon(*symbolInstance.iconQuads(), symbolInstance.refPlacedIconIndex(), WritingModeType::None);
+            symbolInstance.setPlacedIconIndex(placeIcon(*symbolInstance.iconQuads(), WritingModeType::None));
 
             if (symbolInstance.verticalIconQuads()) {
-                placeIcon(*symbolInstance.verticalIconQuads(),
-                          symbolInstance.refPlacedVerticalIconIndex(),
-                          WritingModeType::Vertical);
+                symbolInstance.setPlacedVerticalIconIndex(
+                    placeIcon(*symbolInstance.verticalIconQuads(), WritingModeType::Vertical));
                 symbolInstance.check(SYM_GUARD_LOC);
             }
 
@@ -1096,46 +1096,54 @@ void SymbolLayout::createBucket(const ImagePositions&,
                 symbolInstance.setPlacedLeftTextIndex(placedTextIndex);
             } else {
                 if (symbolInstance.getRightJustifiedGlyphQuadsSize()) {
+                    std::optional<std::size_t> placedTextIndex;
                     lastAddedSection = addSymbolGlyphQuads(*bucket,
                                                            symbolInstance,
                                                            feature,
                                                            symbolInstance.getWritingModes(),
-                                                           symbolInstance.refPlacedRightTextIndex(),
+                                                           placedTextIndex,
                                                            symbolInstance.rightJustifiedGlyphQuads(),
                                                            canonical,
                                                            lastAddedSection);
+                    symbolInstance.setPlacedRightTextIndex(placedTextIndex);
                 }
                 if (symbolInstance.getCenterJustifiedGlyphQuadsSize()) {
+                    std::optional<std::size_t> placedTextIndex;
                     lastAddedSection = addSymbolGlyphQuads(*bucket,
                                                            symbolInstance,
                                                            feature,
                                                            symbolInstance.getWritingModes(),
-                                                           symbolInstance.refPlacedCenterTextIndex(),
+                                                           placedTextIndex,
                                                            symbolInstance.centerJustifiedGlyphQuads(),
                                                            canonical,
                                                            lastAddedSection);
+                    symbolInstance.setPlacedCenterTextIndex(placedTextIndex);
                 }
                 if (symbolInstance.getLeftJustifiedGlyphQuadsSize()) {
+                    std::optional<std::size_t> placedTextIndex;
                     lastAddedSection = addSymbolGlyphQuads(*bucket,
                                                            symbolInstance,
                                                            feature,
                                                            symbolInstance.getWritingModes(),
-                                                           symbolInstance.refPlacedLeftTextIndex(),
+                                                           placedTextIndex,
                                                            symbolInstance.leftJustifiedGlyphQuads(),
                                                            canonical,
                                                            lastAddedSection);
+                    symbolInstance.setPlacedLeftTextIndex(placedTextIndex);
                 }
             }
             if ((symbolInstance.getWritingModes() & WritingModeType::Vertical) &&
                 symbolInstance.getVerticalGlyphQuadsSize()) {
+                std::optional<std::size_t> placedTextIndex;
                 lastAddedSection = addSymbolGlyphQuads(*bucket,
                                                        symbolInstance,
                                                        feature,
                                                        WritingModeType::Vertical,
-                                                       symbolInstance.refPlacedVerticalTextIndex(),
+                                                       placedTextIndex,
                                                        symbolInstance.verticalGlyphQuads(),
                                                        canonical,
                                                        lastAddedSection);
+                symbolInstance.setPlacedVerticalTextIndex(placedTextIndex);
             }
             symbolInstance.check(SYM_GUARD_LOC);
             assert(lastAddedSection); // True, as hasText == true;
@@ -396,6 +396,8 @@ MapOptions Map::getMapOptions() const {
                          .withConstrainMode(impl->transform.getConstrainMode())
                          .withViewportMode(impl->transform.getViewportMode())
                          .withCrossSourceCollisions(impl->crossSourceCollisions)
+                         .withParallelPlacement(impl->parallelPlacement)
+                         .withAsyncPlacement(impl->asyncPlacement)
                          .withNorthOrientation(impl->transform.getNorthOrientation())
                          .withSize(impl->transform.getState().getSize())
                          .withPixelRatio(impl->pixelRatio));
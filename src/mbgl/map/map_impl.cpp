@@ -54,6 +54,8 @@ Map::Impl::Impl(RendererFrontend& frontend_,
       mode(mapOptions.mapMode()),
       pixelRatio(mapOptions.pixelRatio()),
       crossSourceCollisions(mapOptions.crossSourceCollisions()),
+      parallelPlacement(mapOptions.parallelPlacement()),
+      asyncPlacement(mapOptions.asyncPlacement()),
       fileSource(std::move(fileSource_)),
       style(std::make_unique<style::Style>(fileSource, pixelRatio, frontend_.getThreadPool())),
       annotationManager(*style) {
@@ -113,6 +115,18 @@ void Map::Impl::onUpdate() {
 
     transform.updateTransitions(timePoint);
 
+    if (mode == MapMode::Continuous && prefetchZoomDelta && transform.inTransition()) {
+        // The path is fixed for the lifetime of a transition; sample it once so
+        // tile pyramids can reuse the covering tiles they derived from it.
+        if (!transformPath || transformPathStart != transform.getTransitionStart()) {
+            transformPath = std::make_shared<const std::vector<TransformState>>(
+                transform.getTransitionPath(timePoint, util::TRANSITION_PATH_PREFETCH_SAMPLES));
+            transformPathStart = transform.getTransitionStart();
+        }
+    } else {
+        transformPath.reset();
+    }
+
     UpdateParameters params = {style->impl->isLoaded(),
                                mode,
                                pixelRatio,
@@ -132,10 +146,13 @@ void Map::Impl::onUpdate() {
                                prefetchZoomDelta,
                                bool(stillImageRequest),
                                crossSourceCollisions,
+                               parallelPlacement,
+                               asyncPlacement,
                                tileLodMinRadius,
                                tileLodScale,
                                tileLodPitchThreshold,
-                               tileLodZoomShift};
+                               tileLodZoomShift,
+                               transformPath};
 
     rendererFrontend.update(std::make_shared<UpdateParameters>(std::move(params)));
 }
@@ -90,6 +90,8 @@ public:
     const MapMode mode;
     const float pixelRatio;
     const bool crossSourceCollisions;
+    const bool parallelPlacement;
+    const bool asyncPlacement;
 
     MapDebugOptions debugOptions{MapDebugOptions::NoDebug};
     std::unique_ptr<gfx::RenderingStatsView> renderingStatsView;
@@ -103,6 +105,10 @@ public:
 
     uint8_t prefetchZoomDelta = util::DEFAULT_PREFETCH_ZOOM_DELTA;
 
+    // Camera states of the running transition, sampled when it started.
+    std::shared_ptr<const std::vector<TransformState>> transformPath;
+    TimePoint transformPathStart;
+
     bool loading = false;
     bool rendererFullyLoaded;
     std::unique_ptr<StillImageRequest> stillImageRequest;
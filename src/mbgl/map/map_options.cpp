@@ -9,6 +9,8 @@ public:
     ViewportMode viewportMode = ViewportMode::Default;
     NorthOrientation orientation = NorthOrientation::Upwards;
     bool crossSourceCollisions = true;
+    bool parallelPlacement = false;
+    bool asyncPlacement = false;
     Size size = {64, 64};
     float pixelRatio = 1.0;
 };
@@ -55,6 +57,24 @@ bool MapOptions::crossSourceCollisions() const {
     return impl_->crossSourceCollisions;
 }
 
+MapOptions& MapOptions::withParallelPlacement(bool enable) {
+    impl_->parallelPlacement = enable;
+    return *this;
+}
+
+bool MapOptions::parallelPlacement() const {
+    return impl_->parallelPlacement;
+}
+
+MapOptions& MapOptions::withAsyncPlacement(bool enable) {
+    impl_->asyncPlacement = enable;
+    return *this;
+}
+
+bool MapOptions::asyncPlacement() const {
+    return impl_->asyncPlacement;
+}
+
 MapOptions& MapOptions::withNorthOrientation(NorthOrientation orientation) {
     impl_->orientation = orientation;
     return *this;
@@ -170,25 +170,25 @@ void Transform::easeTo(const CameraOptions& inputCamera, const AnimationOptions&
     startTransition(
         camera,
         animation,
-        [=, this](double t) {
+        [=, this](TransformState& frameState, double t) {
             Point<double> framePoint = util::interpolate(startPoint, endPoint, t);
-            LatLng frameLatLng = Projection::unproject(framePoint, state.zoomScale(startZoom));
+            LatLng frameLatLng = Projection::unproject(framePoint, frameState.zoomScale(startZoom));
             double frameZoom = util::interpolate(startZoom, zoom, t);
-            state.setLatLngZoom(frameLatLng, frameZoom);
+            frameState.setLatLngZoom(frameLatLng, frameZoom);
             if (bearing != startBearing) {
-                state.setBearing(util::wrap(util::interpolate(startBearing, bearing, t), -pi, pi));
+                frameState.setBearing(util::wrap(util::interpolate(startBearing, bearing, t), -pi, pi));
             }
             if (padding != startEdgeInsets) {
                 // Interpolate edge insets
                 EdgeInsets edgeInsets;
-                state.setEdgeInsets({util::interpolate(startEdgeInsets.top(), padding.top(), t),
-                                     util::interpolate(startEdgeInsets.left(), padding.left(), t),
-                                     util::interpolate(startEdgeInsets.bottom(), padding.bottom(), t),
-                                     util::interpolate(startEdgeInsets.right(), padding.right(), t)});
+                frameState.setEdgeInsets({util::interpolate(startEdgeInsets.top(), padding.top(), t),
+                                          util::interpolate(startEdgeInsets.left(), padding.left(), t),
+                                          util::interpolate(startEdgeInsets.bottom(), padding.bottom(), t),
+                                          util::interpolate(startEdgeInsets.right(), padding.right(), t)});
             }
-            double maxPitch = getMaxPitchForEdgeInsets(state.getEdgeInsets());
+            double maxPitch = getMaxPitchForEdgeInsets(frameState.getEdgeInsets());
             if (pitch != startPitch || maxPitch < startPitch) {
-                state.setPitch(std::min(maxPitch, util::interpolate(startPitch, pitch, t)));
+                frameState.setPitch(std::min(maxPitch, util::interpolate(startPitch, pitch, t)));
             }
         },
         duration);
@@ -334,7 +334,7 @@ void Transform::flyTo(const CameraOptions& inputCamera,
     startTransition(
         camera,
         animation,
-        [=, this](double k) {
+        [=, this](TransformState& frameState, double k) {
             /// s: The distance traveled along the flight path, measured in
             /// ρ-screenfuls.
             double s = k * S;
@@ -343,7 +343,7 @@ void Transform::flyTo(const CameraOptions& inputCamera,
             // Calculate the current point and zoom level along the flight path.
             Point<double> framePoint = util::interpolate(startPoint, endPoint, us);
             double frameZoom = linearZoomInterpolation ? util::interpolate(startZoom, zoom, k)
-                                                       : startZoom + state.scaleZoom(1 / w(s));
+                                                       : startZoom + frameState.scaleZoom(1 / w(s));
 
             // Zoom can be NaN if size is empty.
             if (std::isnan(frameZoom)) {
@@ -352,22 +352,22 @@ void Transform::flyTo(const CameraOptions& inputCamera,
 
             // Convert to geographic coordinates and set the new viewpoint.
             LatLng frameLatLng = Projection::unproject(framePoint, startScale);
-            state.setLatLngZoom(frameLatLng, frameZoom);
+            frameState.setLatLngZoom(frameLatLng, frameZoom);
             if (bearing != startBearing) {
-                state.setBearing(util::wrap(util::interpolate(startBearing, bearing, k), -pi, pi));
+                frameState.setBearing(util::wrap(util::interpolate(startBearing, bearing, k), -pi, pi));
             }
 
             if (padding != startEdgeInsets) {
                 // Interpolate edge insets
-                state.setEdgeInsets({util::interpolate(startEdgeInsets.top(), padding.top(), k),
-                                     util::interpolate(startEdgeInsets.left(), padding.left(), k),
-                                     util::interpolate(startEdgeInsets.bottom(), padding.bottom(), k),
-                                     util::interpolate(startEdgeInsets.right(), padding.right(), k)});
+                frameState.setEdgeInsets({util::interpolate(startEdgeInsets.top(), padding.top(), k),
+                                          util::interpolate(startEdgeInsets.left(), padding.left(), k),
+                                          util::interpolate(startEdgeInsets.bottom(), padding.bottom(), k),
+                                          util::interpolate(startEdgeInsets.right(), padding.right(), k)});
             }
-            double maxPitch = getMaxPitchForEdgeInsets(state.getEdgeInsets());
+            double maxPitch = getMaxPitchForEdgeInsets(frameState.getEdgeInsets());
 
             if (pitch != startPitch || maxPitch < startPitch) {
-                state.setPitch(std::min(maxPitch, util::interpolate(startPitch, pitch, k)));
+                frameState.setPitch(std::min(maxPitch, util::interpolate(startPitch, pitch, k)));
             }
         },
         duration);
@@ -524,7 +524,7 @@ ProjectionMode Transform::getProjectionMode() const {
 
 void Transform::startTransition(const CameraOptions& camera,
                                 const AnimationOptions& animation,
-                                const std::function<void(double)>& frame,
+                                const std::function<void(TransformState&, double)>& frame,
                                 const Duration& duration) {
     if (transitionFinishFn) {
         transitionFinishFn();
@@ -547,16 +547,20 @@ void Transform::startTransition(const CameraOptions& camera,
     transitionStart = Clock::now();
     transitionDuration = duration;
 
-    transitionFrameFn = [isAnimated, animation, frame, anchor, anchorLatLng, this](const TimePoint now) {
-        float t = isAnimated ? (std::chrono::duration<float>(now - transitionStart) / transitionDuration) : 1.0f;
+    transitionPathFn = [animation, frame, anchor, anchorLatLng](TransformState& frameState, double t) {
         if (t >= 1.0) {
-            frame(1.0);
+            frame(frameState, 1.0);
         } else {
             util::UnitBezier ease = animation.easing ? *animation.easing : util::DEFAULT_TRANSITION_EASE;
-            frame(ease.solve(t, 0.001));
+            frame(frameState, ease.solve(t, 0.001));
         }
 
-        if (anchor) state.moveLatLng(anchorLatLng, *anchor);
+        if (anchor) frameState.moveLatLng(anchorLatLng, *anchor);
+    };
+
+    transitionFrameFn = [isAnimated, animation, path = transitionPathFn, this](const TimePoint now) {
+        float t = isAnimated ? (std::chrono::duration<float>(now - transitionStart) / transitionDuration) : 1.0f;
+        path(state, t);
 
         // At t = 1.0, a DidChangeAnimated notification should be sent from finish().
         if (t < 1.0) {
@@ -572,6 +576,7 @@ void Transform::startTransition(const CameraOptions& camera,
     };
 
     transitionFinishFn = [isAnimated, animation, this] {
+        transitionPathFn = nullptr;
         state.setProperties(
             TransformStateProperties().withPanningInProgress(false).withScalingInProgress(false).withRotatingInProgress(
                 false));
@@ -598,6 +603,26 @@ bool Transform::inTransition() const {
     return transitionFrameFn != nullptr;
 }
 
+std::vector<TransformState> Transform::getTransitionPath(const TimePoint& now, std::size_t samples) const {
+    std::vector<TransformState> path;
+    if (!transitionPathFn || samples == 0 || transitionDuration == Duration::zero()) {
+        return path;
+    }
+
+    const double start = std::chrono::duration<double>(now - transitionStart) / transitionDuration;
+    if (start >= 1.0) {
+        return path;
+    }
+
+    path.reserve(samples);
+    for (std::size_t i = 1; i <= samples; ++i) {
+        TransformState frameState = state;
+        transitionPathFn(frameState, start + (1.0 - start) * static_cast<double>(i) / static_cast<double>(samples));
+        path.push_back(std::move(frameState));
+    }
+    return path;
+}
+
 void Transform::updateTransitions(const TimePoint& now) {
     // Use a temporary function to ensure that the transitionFrameFn lambda is
     // called only once per update.
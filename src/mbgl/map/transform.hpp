@@ -13,6 +13,7 @@
 #include <cmath>
 #include <functional>
 #include <optional>
+#include <vector>
 
 namespace mbgl {
 
@@ -113,6 +114,11 @@ public:
     void updateTransitions(const TimePoint& now);
     TimePoint getTransitionStart() const { return transitionStart; }
     Duration getTransitionDuration() const { return transitionDuration; }
+    /** Returns the camera states the current transition will pass through,
+        sampled at `samples` evenly spaced points in time between `now` and the
+        end of the transition, in arrival order. The last state is the
+        destination. Empty when no animated transition is in progress. */
+    std::vector<TransformState> getTransitionPath(const TimePoint& now, std::size_t samples) const;
     void cancelTransitions();
 
     // Gesture
@@ -138,7 +144,7 @@ private:
 
     void startTransition(const CameraOptions&,
                          const AnimationOptions&,
-                         const std::function<void(double)>&,
+                         const std::function<void(TransformState&, double)>&,
                          const Duration&);
 
     // We don't want to show horizon: limit max pitch based on edge insets.
@@ -147,6 +153,7 @@ private:
     TimePoint transitionStart;
     Duration transitionDuration;
     std::function<bool(const TimePoint)> transitionFrameFn;
+    std::function<void(TransformState&, double)> transitionPathFn;
     std::function<void()> transitionFinishFn;
 };
 
@@ -103,10 +103,22 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
 
             // If the already-allocated buffer is large enough, we can re-use it
             if (rawBufSize <= resource.getSizeInBytes()) {
-                // If the source changed, update the buffer contents
+                // If the source changed, update the buffer contents, or only
+                // the elements that changed if they were overwritten in place
                 if (forceUpdate || vec->isModifiedAfter(resource.getLastUpdated())) {
-                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    if (!forceUpdate && vec->isPartiallyModified()) {
+                        const auto [begin, end] = vec->getModifiedRange();
+                        const auto stride = vec->getRawSize();
+                        if (end > begin) {
+                            resource.get().update(static_cast<const std::uint8_t*>(rawBufPtr) + begin * stride,
+                                                  (end - begin) * stride,
+                                                  begin * stride);
+                        }
+                    } else {
+                        updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    }
                     resource.setLastUpdated(vec->getLastModified());
+                    vec->resetModifiedRange();
                 }
                 return rawData->resource;
             }
@@ -116,6 +128,7 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             auto buffer_ = std::make_unique<VertexBuffer>();
             buffer_->resource = createVertexBufferResource(rawBufPtr, rawBufSize, usage, /*persistent=*/false);
             vec->setBuffer(std::move(buffer_));
+            vec->resetModifiedRange();
             return static_cast<VertexBuffer*>(vec->getBuffer())->resource;
         }
     }
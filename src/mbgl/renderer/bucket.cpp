@@ -0,0 +1,20 @@
+#include <mbgl/renderer/bucket.hpp>
+#include <mbgl/renderer/layer_drawable_data.hpp>
+
+namespace mbgl {
+
+void Bucket::prepareDrawables(const style::LayerProperties& properties) {
+    if (auto data = createDrawableData(properties)) {
+        drawableData.insert_or_assign(properties.baseImpl->id, std::move(data));
+    }
+}
+
+std::shared_ptr<const LayerDrawableData> Bucket::getDrawableData(const style::LayerProperties& properties) const {
+    const auto it = drawableData.find(properties.baseImpl->id);
+    if (it != drawableData.end() && it->second->constantsMask == properties.constantsMask()) {
+        return it->second;
+    }
+    return createDrawableData(properties);
+}
+
+} // namespace mbgl
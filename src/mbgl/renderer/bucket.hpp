@@ -2,12 +2,14 @@
 
 #include <mbgl/layout/symbol_instance.hpp>
 #include <mbgl/style/image_impl.hpp>
+#include <mbgl/style/layer_properties.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 
 #include <mbgl/util/identity.hpp>
 
 #include <atomic>
+#include <memory>
 
 namespace mbgl {
 
@@ -24,6 +26,7 @@ class Placement;
 class TransformState;
 class BucketPlacementData;
 class RenderTile;
+struct LayerDrawableData;
 
 class Bucket {
 public:
@@ -55,6 +58,19 @@ public:
 
     bool needsUpload() const { return hasData() && !uploaded; }
 
+    // Works out the drawable inputs of one of the layers using this bucket,
+    // null for buckets whose drawables aren't set up this way.
+    virtual std::shared_ptr<const LayerDrawableData> createDrawableData(const style::LayerProperties&) const {
+        return nullptr;
+    }
+
+    // Called by the worker once the bucket is complete, before it's handed to the render thread.
+    void prepareDrawables(const style::LayerProperties&);
+
+    // The drawable inputs prepared for the layer, or new ones if the properties
+    // changed which data driven properties are constant since.
+    std::shared_ptr<const LayerDrawableData> getDrawableData(const style::LayerProperties&) const;
+
     // The following methods are implemented by buckets that require cross-tile indexing and placement.
 
     // Returns a pair, the first element of which is a bucket cross-tile id
@@ -86,6 +102,9 @@ protected:
     util::SimpleIdentity bucketID;
 
     std::optional<std::thread::id> renderThreadID;
+
+    // Written on the worker thread only, before the bucket is shared
+    mbgl::unordered_map<std::string, std::shared_ptr<const LayerDrawableData>> drawableData;
 };
 
 } // namespace mbgl
@@ -1,7 +1,9 @@
 #include <mbgl/renderer/buckets/circle_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/layer_drawable_data.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_circle_layer.hpp>
+#include <mbgl/shaders/shader_defines.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/math.hpp>
 
@@ -54,6 +56,36 @@ float CircleBucket::getQueryRadius(const RenderLayer& layer) const {
     return radius + stroke + util::length(translate[0], translate[1]);
 }
 
+std::shared_ptr<const LayerDrawableData> CircleBucket::createDrawableData(
+    const style::LayerProperties& layerProperties) const {
+    using namespace shaders;
+    const auto it = paintPropertyBinders.find(layerProperties.baseImpl->id);
+    if (it == paintPropertyBinders.end()) {
+        return nullptr;
+    }
+
+    auto data = std::make_shared<LayerDrawableData>();
+    data->constantsMask = layerProperties.constantsMask();
+    const auto& evaluated = static_cast<const CircleLayerProperties&>(layerProperties).evaluated;
+    data->vertexAttributes.readDataDrivenPaintProperties<CircleColor,
+                                                         CircleRadius,
+                                                         CircleBlur,
+                                                         CircleOpacity,
+                                                         CircleStrokeColor,
+                                                         CircleStrokeWidth,
+                                                         CircleStrokeOpacity>(
+        it->second, evaluated, data->propertiesAsUniforms, idCircleColorVertexAttribute);
+
+    if (const auto& attr = data->vertexAttributes.set(idCirclePosVertexAttribute)) {
+        attr->setSharedRawData(sharedVertices,
+                               offsetof(CircleLayoutVertex, a1),
+                               0,
+                               sizeof(CircleLayoutVertex),
+                               gfx::AttributeDataType::Short2);
+    }
+    return data;
+}
+
 void CircleBucket::update(const FeatureStates& states,
                           const GeometryTileLayer& layer,
                           const std::string& layerID,
@@ -1,9 +1,11 @@
 #include <mbgl/renderer/buckets/fill_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/layer_drawable_data.hpp>
 #include <mbgl/style/layers/fill_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/gfx/fill_generator.hpp>
+#include <mbgl/shaders/shader_defines.hpp>
 
 namespace mbgl {
 
@@ -12,10 +14,19 @@ FillBucket::FillBucket(const FillBucket::PossiblyEvaluatedLayoutProperties&,
                        const float zoom,
                        const uint32_t) {
     using namespace style;
+#if MLN_FILL_FEATURE_STATE_TEXTURE
+    constexpr bool useFeatureStateTexture = true;
+#else
+    constexpr bool useFeatureStateTexture = false;
+#endif
     for (const auto& pair : layerPaintProperties) {
-        paintPropertyBinders.emplace(std::piecewise_construct,
-                                     std::forward_as_tuple(pair.first),
-                                     std::forward_as_tuple(getEvaluated<FillLayerProperties>(pair.second), zoom));
+        // The pattern shaders always read the properties from the vertex attributes.
+        const auto& properties = static_cast<const FillLayerProperties&>(*pair.second);
+        const bool hasPattern = !properties.layerImpl().paint.get<FillPattern>().value.isUndefined();
+        paintPropertyBinders.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(pair.first),
+            std::forward_as_tuple(properties.evaluated, zoom, useFeatureStateTexture && !hasPattern));
     }
 }
 
@@ -75,6 +86,13 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
 #endif // MLN_TRIANGULATE_FILL_OUTLINES
 
 void FillBucket::upload([[maybe_unused]] gfx::UploadPass& uploadPass) {
+#if MLN_FILL_FEATURE_STATE_TEXTURE
+    for (auto& pair : paintPropertyBinders) {
+        if (auto* texture = pair.second.getFeatureStateTexture()) {
+            texture->upload(uploadPass.getContext());
+        }
+    }
+#endif
     uploaded = true;
 }
 
@@ -89,6 +107,32 @@ float FillBucket::getQueryRadius(const RenderLayer& layer) const {
     return util::length(translate[0], translate[1]);
 }
 
+std::shared_ptr<const LayerDrawableData> FillBucket::createDrawableData(
+    const style::LayerProperties& layerProperties) const {
+    using namespace style;
+    using namespace shaders;
+    const auto it = paintPropertyBinders.find(layerProperties.baseImpl->id);
+    if (it == paintPropertyBinders.end()) {
+        return nullptr;
+    }
+
+    // `Fill*Program` all use `style::FillPaintProperties`
+    auto data = std::make_shared<LayerDrawableData>();
+    data->constantsMask = layerProperties.constantsMask();
+    const auto& evaluated = static_cast<const FillLayerProperties&>(layerProperties).evaluated;
+    data->vertexAttributes.readDataDrivenPaintProperties<FillColor, FillOpacity, FillOutlineColor, FillPattern>(
+        it->second, evaluated, data->propertiesAsUniforms, idFillColorVertexAttribute);
+
+    if (const auto& attr = data->vertexAttributes.set(idFillPosVertexAttribute)) {
+        attr->setSharedRawData(sharedVertices,
+                               offsetof(FillLayoutVertex, a1),
+                               /*vertexOffset=*/0,
+                               sizeof(FillLayoutVertex),
+                               gfx::AttributeDataType::Short2);
+    }
+    return data;
+}
+
 void FillBucket::update(const FeatureStates& states,
                         const GeometryTileLayer& layer,
                         const std::string& layerID,
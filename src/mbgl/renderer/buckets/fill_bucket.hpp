@@ -15,6 +15,14 @@
  */
 #define MLN_TRIANGULATE_FILL_OUTLINES (MLN_RENDER_BACKEND_METAL || MLN_RENDER_BACKEND_WEBGPU)
 
+/**
+    Control where the fill properties that depend on feature state are stored:
+    MLN_FILL_FEATURE_STATE_TEXTURE = 0 : In the vertex attributes, every vertex of a feature is rewritten on change.
+    MLN_FILL_FEATURE_STATE_TEXTURE = 1 : In a per-tile texture indexed by feature, one texel per property on change.
+ */
+#define MLN_FILL_FEATURE_STATE_TEXTURE \
+    (MLN_USE_FEATURE_STATE_TEXTURE && (MLN_RENDER_BACKEND_OPENGL || MLN_RENDER_BACKEND_VULKAN))
+
 #if MLN_TRIANGULATE_FILL_OUTLINES
 #include <mbgl/renderer/buckets/line_bucket.hpp>
 #endif
@@ -50,6 +58,8 @@ public:
 
     float getQueryRadius(const RenderLayer&) const override;
 
+    std::shared_ptr<const LayerDrawableData> createDrawableData(const style::LayerProperties&) const override;
+
     void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) override;
 
     static FillLayoutVertex layoutVertex(Point<int16_t> p) { return FillLayoutVertex{{{p.x, p.y}}}; }
@@ -1,9 +1,11 @@
 #include <mbgl/renderer/buckets/line_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/layer_drawable_data.hpp>
 #include <mbgl/style/layers/line_layer_impl.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/gfx/polyline_generator.hpp>
+#include <mbgl/shaders/shader_defines.hpp>
 
 #include <cassert>
 #include <utility>
@@ -160,6 +162,44 @@ float LineBucket::getQueryRadius(const RenderLayer& layer) const {
     return lineWidth / 2.0f + std::abs(offset) + util::length(translate[0], translate[1]);
 }
 
+std::shared_ptr<const LayerDrawableData> LineBucket::createDrawableData(
+    const style::LayerProperties& layerProperties) const {
+    using namespace shaders;
+    const auto it = paintPropertyBinders.find(layerProperties.baseImpl->id);
+    if (it == paintPropertyBinders.end()) {
+        return nullptr;
+    }
+
+    auto data = std::make_shared<LayerDrawableData>();
+    data->constantsMask = layerProperties.constantsMask();
+    const auto& evaluated = static_cast<const LineLayerProperties&>(layerProperties).evaluated;
+    data->vertexAttributes.readDataDrivenPaintProperties<LineColor,
+                                                         LineBlur,
+                                                         LineOpacity,
+                                                         LineGapWidth,
+                                                         LineOffset,
+                                                         LineWidth,
+                                                         LineFloorWidth,
+                                                         LinePattern>(
+        it->second, evaluated, data->propertiesAsUniforms, idLineColorVertexAttribute);
+
+    if (const auto& attr = data->vertexAttributes.set(idLinePosNormalVertexAttribute)) {
+        attr->setSharedRawData(sharedVertices,
+                               offsetof(LineLayoutVertex, a1),
+                               /*vertexOffset=*/0,
+                               sizeof(LineLayoutVertex),
+                               gfx::AttributeDataType::Short2);
+    }
+    if (const auto& attr = data->vertexAttributes.set(idLineDataVertexAttribute)) {
+        attr->setSharedRawData(sharedVertices,
+                               offsetof(LineLayoutVertex, a2),
+                               /*vertexOffset=*/0,
+                               sizeof(LineLayoutVertex),
+                               gfx::AttributeDataType::UByte4);
+    }
+    return data;
+}
+
 void LineBucket::update(const FeatureStates& states,
                         const GeometryTileLayer& layer,
                         const std::string& layerID,
@@ -39,6 +39,8 @@ public:
 
     float getQueryRadius(const RenderLayer&) const override;
 
+    std::shared_ptr<const LayerDrawableData> createDrawableData(const style::LayerProperties&) const override;
+
     void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) override;
 
     /*
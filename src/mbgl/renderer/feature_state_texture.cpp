@@ -0,0 +1,74 @@
+#include <mbgl/renderer/feature_state_texture.hpp>
+#include <mbgl/gfx/context.hpp>
+#include <mbgl/util/size.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+
+FeatureStateTexture::FeatureStateTexture(uint32_t stride_)
+    : stride(stride_) {
+    assert(stride > 0 && stride <= width);
+}
+
+FeatureStateTexture::~FeatureStateTexture() {
+    ordinals->release();
+}
+
+uint32_t FeatureStateTexture::addFeature(std::size_t vertexCount) {
+    const uint32_t ordinal = featureCount++;
+    ordinals->extend(vertexCount, OrdinalVertex{{{static_cast<float>(ordinal)}}});
+
+    const std::size_t required = static_cast<std::size_t>(featureCount) * stride;
+    if (required > texels.size()) {
+        // Grow by whole rows, the texture is re-created with the new height on the next upload.
+        const std::size_t rows = (required + width - 1) / width;
+        texels.resize(rows * width, Texel{{0.0f, 0.0f, 0.0f, 0.0f}});
+        texture.reset();
+    }
+    return ordinal;
+}
+
+void FeatureStateTexture::setTexel(uint32_t ordinal, uint32_t slot, const Texel& texel) {
+    assert(ordinal < featureCount && slot < stride);
+    const std::size_t index = static_cast<std::size_t>(ordinal) * stride + slot;
+    if (texels[index] != texel) {
+        texels[index] = texel;
+        markDirty(static_cast<uint32_t>(index / width));
+    }
+}
+
+void FeatureStateTexture::markDirty(uint32_t row) {
+    if (dirtyBegin < dirtyEnd) {
+        dirtyBegin = std::min(dirtyBegin, row);
+        dirtyEnd = std::max(dirtyEnd, row + 1);
+    } else {
+        dirtyBegin = row;
+        dirtyEnd = row + 1;
+    }
+}
+
+void FeatureStateTexture::upload(gfx::Context& context) {
+    if (texels.empty()) {
+        return;
+    }
+
+    const auto rows = static_cast<uint32_t>(texels.size() / width);
+    if (!texture) {
+        texture = context.createTexture2D();
+        texture->setSamplerConfiguration({.filter = gfx::TextureFilterType::Nearest,
+                                          .wrapU = gfx::TextureWrapType::Clamp,
+                                          .wrapV = gfx::TextureWrapType::Clamp});
+        texture->setFormat(gfx::TexturePixelType::RGBA, gfx::TextureChannelDataType::Float);
+        texture->upload(texels.data(), Size{width, rows});
+    } else if (needsUpload()) {
+        texture->uploadSubRegion(texels.data() + static_cast<std::size_t>(dirtyBegin) * width,
+                                 Size{width, dirtyEnd - dirtyBegin},
+                                 0,
+                                 static_cast<uint16_t>(dirtyBegin));
+    }
+    dirtyBegin = dirtyEnd = 0;
+}
+
+} // namespace mbgl
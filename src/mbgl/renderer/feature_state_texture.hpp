@@ -0,0 +1,78 @@
+#pragma once
+
+#include <mbgl/gfx/texture2d.hpp>
+#include <mbgl/gfx/vertex_vector.hpp>
+#include <mbgl/shaders/attributes.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+namespace gfx {
+class Context;
+using Texture2DPtr = std::shared_ptr<Texture2D>;
+} // namespace gfx
+
+/**
+ * Holds the paint values of the properties that depend on feature state, for
+ * all the features of a bucket, in a float texture.
+ *
+ * Each feature gets an ordinal, which is written to all of its vertices, and
+ * `stride` consecutive texels, one per property. The shaders fetch the texel
+ * for `ordinal * stride + slot`, so a state change rewrites a few texels
+ * instead of every vertex of the feature.
+ */
+class FeatureStateTexture {
+public:
+    using Texel = std::array<float, 4>;
+    using OrdinalVertex = gfx::Vertex<TypeList<attributes::feature_ordinal>>;
+    using OrdinalVector = gfx::VertexVector<OrdinalVertex>;
+
+    // Texels per row
+    static constexpr uint32_t width = 1024;
+
+    explicit FeatureStateTexture(uint32_t stride);
+    ~FeatureStateTexture();
+
+    /// Assigns the next ordinal to the vertices of a feature
+    /// @return The ordinal of the feature
+    uint32_t addFeature(std::size_t vertexCount);
+
+    void setTexel(uint32_t ordinal, uint32_t slot, const Texel&);
+    const Texel& getTexel(uint32_t ordinal, uint32_t slot) const { return texels[ordinal * stride + slot]; }
+
+    uint32_t getStride() const { return stride; }
+    uint32_t getFeatureCount() const { return featureCount; }
+
+    /// The ordinal of each vertex, shared with the drawables
+    const std::shared_ptr<OrdinalVector>& getOrdinals() const { return ordinals; }
+
+    /// Rows that changed since the last upload, as [first, last)
+    std::pair<uint32_t, uint32_t> getDirtyRows() const { return {dirtyBegin, dirtyEnd}; }
+    bool needsUpload() const { return dirtyBegin < dirtyEnd; }
+
+    /// Creates the texture on first use, then uploads only the modified rows
+    void upload(gfx::Context&);
+
+    const gfx::Texture2DPtr& getTexture() const { return texture; }
+
+private:
+    void markDirty(uint32_t row);
+
+    const uint32_t stride;
+    uint32_t featureCount = 0;
+
+    // Always a whole number of rows
+    std::vector<Texel> texels;
+    uint32_t dirtyBegin = 0;
+    uint32_t dirtyEnd = 0;
+
+    std::shared_ptr<OrdinalVector> ordinals = std::make_shared<OrdinalVector>();
+    gfx::Texture2DPtr texture;
+};
+
+} // namespace mbgl
@@ -0,0 +1,78 @@
+#include <mbgl/renderer/feature_vertex_index.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <cassert>
+#include <charconv>
+#include <optional>
+#include <string_view>
+
+namespace mbgl {
+
+namespace {
+
+// Parses IDs that featureIDtoString() produces for non-negative integers. A
+// leading zero (other than "0" itself) makes the string a different ID.
+std::optional<uint64_t> numericID(std::string_view id) {
+    if (id.empty() || (id.size() > 1 && id.front() == '0')) {
+        return std::nullopt;
+    }
+    uint64_t value = 0;
+    const auto* end = id.data() + id.size();
+    const auto result = std::from_chars(id.data(), end, value);
+    if (result.ec != std::errc() || result.ptr != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+} // namespace
+
+void FeatureVertexIndex::insert(const FeatureIdentifier& id,
+                                std::size_t featureIndex,
+                                std::size_t start,
+                                std::size_t end) {
+    assert(end <= npos && entries.size() < npos);
+
+    uint32_t* head = nullptr;
+    id.match(
+        [&](uint64_t value) { head = &numericIDs.try_emplace(value, npos).first->second; },
+        [&](int64_t value) {
+            if (value >= 0) {
+                head = &numericIDs.try_emplace(static_cast<uint64_t>(value), npos).first->second;
+            } else {
+                head = &stringIDs.try_emplace(util::toString(value), npos).first->second;
+            }
+        },
+        [&](const auto&) {
+            auto key = featureIDtoString(id);
+            if (!key) {
+                return;
+            }
+            if (auto value = numericID(*key)) {
+                head = &numericIDs.try_emplace(*value, npos).first->second;
+            } else {
+                head = &stringIDs.try_emplace(std::move(*key), npos).first->second;
+            }
+        });
+
+    if (!head) {
+        return;
+    }
+
+    entries.push_back(Entry{static_cast<uint32_t>(featureIndex),
+                            static_cast<uint32_t>(start),
+                            static_cast<uint32_t>(end),
+                            *head});
+    *head = static_cast<uint32_t>(entries.size() - 1);
+}
+
+uint32_t FeatureVertexIndex::find(const std::string& id) const {
+    if (const auto value = numericID(id)) {
+        const auto it = numericIDs.find(*value);
+        return it == numericIDs.end() ? npos : it->second;
+    }
+    const auto it = stringIDs.find(id);
+    return it == stringIDs.end() ? npos : it->second;
+}
+
+} // namespace mbgl
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <mbgl/util/containers.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// Maps vertex range to feature index
+struct FeatureVertexRange {
+    std::size_t featureIndex;
+    std::size_t start;
+    std::size_t end;
+};
+
+/**
+ * Finds the vertex ranges of the features in a bucket by the ID that is used
+ * with `setFeatureState`.
+ *
+ * Feature states are keyed by the string form of the ID. IDs that are
+ * non-negative integers -- by far the most common kind, and the only kind
+ * vector tiles store -- go into a numeric table, so they are neither formatted
+ * nor hashed as strings when the index is built. All ranges live in one flat
+ * vector, chained per feature.
+ */
+class FeatureVertexIndex {
+public:
+    void insert(const FeatureIdentifier&, std::size_t featureIndex, std::size_t start, std::size_t end);
+
+    template <typename Fn>
+    void forEachRange(const std::string& id, Fn&& fn) const {
+        for (auto entry = find(id); entry != npos; entry = entries[entry].next) {
+            const auto& e = entries[entry];
+            fn(FeatureVertexRange{e.featureIndex, e.start, e.end});
+        }
+    }
+
+    bool empty() const { return entries.empty(); }
+    std::size_t size() const { return entries.size(); }
+
+private:
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    struct Entry {
+        uint32_t featureIndex;
+        uint32_t start;
+        uint32_t end;
+        uint32_t next; // Next range of the same feature, or npos.
+    };
+
+    uint32_t find(const std::string& id) const;
+
+    mbgl::unordered_map<uint64_t, uint32_t> numericIDs;
+    mbgl::unordered_map<std::string, uint32_t> stringIDs;
+    std::vector<Entry> entries;
+};
+
+} // namespace mbgl
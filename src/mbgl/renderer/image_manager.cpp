@@ -50,10 +50,11 @@ void ImageManager::addImage(Immutable<style::Image::Impl> image_) {
 
     // Increase cache size if requested image was provided.
     if (requestedImages.find(image_->id) != requestedImages.end()) {
-        requestedImagesCacheSize += image_->image.bytes();
+        requestedImagesCacheSize += image_->bytes();
     }
 
     availableImages.emplace(image_->id);
+    availableImagesSnapshot.reset();
     images.emplace(image_->id, std::move(image_));
 }
 
@@ -64,12 +65,12 @@ bool ImageManager::updateImage(Immutable<style::Image::Impl> image_) {
     assert(oldImage != images.end());
     if (oldImage == images.end()) return false;
 
-    auto sizeChanged = oldImage->second->image.size != image_->image.size;
+    auto sizeChanged = oldImage->second->getSize() != image_->getSize();
 
     if (sizeChanged) {
         // Update cache size if requested image size has changed.
         if (requestedImages.find(image_->id) != requestedImages.end()) {
-            int64_t diff = image_->image.bytes() - oldImage->second->image.bytes();
+            int64_t diff = image_->bytes() - oldImage->second->bytes();
             assert(static_cast<int64_t>(requestedImagesCacheSize + diff) >= 0ll);
             requestedImagesCacheSize += diff;
         }
@@ -91,13 +92,14 @@ void ImageManager::removeImage(const std::string& id) {
     // Reduce cache size for requested images.
     auto requestedIt = requestedImages.find(it->second->id);
     if (requestedIt != requestedImages.end()) {
-        assert(requestedImagesCacheSize >= it->second->image.bytes());
-        requestedImagesCacheSize -= it->second->image.bytes();
+        assert(requestedImagesCacheSize >= it->second->bytes());
+        requestedImagesCacheSize -= it->second->bytes();
         requestedImages.erase(requestedIt);
     }
 
     images.erase(it);
     availableImages.erase(id);
+    availableImagesSnapshot.reset();
     updatedImageVersions.erase(id);
 }
 
@@ -197,14 +199,16 @@ void ImageManager::reduceMemoryUseIfCacheSizeExceedsLimit() {
     }
 }
 
-std::set<std::string> ImageManager::getAvailableImages() const {
+AvailableImages ImageManager::getAvailableImages() const {
     MLN_TRACE_FUNC();
     std::lock_guard<std::recursive_mutex> readWriteLock(rwLock);
 
-    {
+    // Tiles share the copy, it's only made again once the images change
+    if (!availableImagesSnapshot) {
         MLN_TRACE_ZONE(copy);
-        return availableImages;
+        availableImagesSnapshot = makeMutable<std::set<std::string>>(availableImages);
     }
+    return *availableImagesSnapshot;
 }
 
 void ImageManager::clear() {
@@ -215,6 +219,7 @@ void ImageManager::clear() {
 
     images.clear();
     availableImages.clear();
+    availableImagesSnapshot.reset();
     updatedImageVersions.clear();
     requestedImages.clear();
     loaded = false;
@@ -5,6 +5,7 @@
 
 #include <map>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -50,7 +51,8 @@ public:
     void notifyIfMissingImageAdded();
     void reduceMemoryUse();
     void reduceMemoryUseIfCacheSizeExceedsLimit();
-    std::set<std::string> getAvailableImages() const;
+    /// @return The image names, the same snapshot until an image is added or removed.
+    AvailableImages getAvailableImages() const;
 
     ImageVersionMap updatedImageVersions;
 
@@ -69,6 +71,8 @@ private:
     ImageMap images;
     // Mirror of 'ImageMap images;' keys.
     std::set<std::string> availableImages;
+    // Shared copy of `availableImages`, reset when it changes.
+    mutable std::optional<AvailableImages> availableImagesSnapshot;
 
     ImageManagerObserver* observer = nullptr;
 
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <mbgl/gfx/vertex_attribute.hpp>
+
+namespace mbgl {
+
+/// The inputs of a layer's drawables that don't depend on the rendering backend.
+/// Buckets prepare them on the worker thread, so that the render layer only
+/// creates the backend objects from them.
+struct LayerDrawableData {
+    /// `LayerProperties::constantsMask` of the properties these were made for
+    unsigned long constantsMask = 0;
+
+    /// Vertex attributes referring to the shared bucket and paint property data,
+    /// copied into a backend array with `VertexAttributeArray::setSharedAttributes`
+    gfx::VertexAttributeArray vertexAttributes;
+
+    /// The data driven properties that are constant, which select the shader
+    gfx::StringIDSetsPair propertiesAsUniforms;
+};
+
+} // namespace mbgl
@@ -9,6 +9,7 @@
 #include <mbgl/shaders/shader_program_base.hpp>
 #include <mbgl/style/layers/background_layer_properties.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/frame_arena.hpp>
 
 namespace mbgl {
 
@@ -75,7 +76,8 @@ void BackgroundLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintPara
 
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
-    std::vector<BackgroundDrawableUnionUBO> drawableUBOVector(layerGroup.getDrawableCount());
+    util::FrameVector<BackgroundDrawableUnionUBO> drawableUBOVector(layerGroup.getDrawableCount(),
+                                                                    parameters.frameArena);
 #endif
 
     visitLayerGroupDrawables(layerGroup, [&](gfx::Drawable& drawable) {
@@ -10,6 +10,7 @@
 #include <mbgl/shaders/shader_source.hpp>
 #include <mbgl/style/layers/circle_layer_properties.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/frame_arena.hpp>
 
 #if MLN_RENDER_BACKEND_METAL
 #include <mbgl/shaders/mtl/circle.hpp>
@@ -60,7 +61,7 @@ void CircleLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParamete
 
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
-    std::vector<CircleDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount());
+    util::FrameVector<CircleDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
 #endif
 
     visitLayerGroupDrawables(layerGroup, [&](gfx::Drawable& drawable) {
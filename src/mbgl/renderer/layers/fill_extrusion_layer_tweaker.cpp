@@ -13,6 +13,7 @@
 #include <mbgl/shaders/fill_extrusion_layer_ubo.hpp>
 #include <mbgl/shaders/shader_program_base.hpp>
 #include <mbgl/style/layers/fill_extrusion_layer_properties.hpp>
+#include <mbgl/util/frame_arena.hpp>
 
 #if MLN_RENDER_BACKEND_METAL
 #include <mbgl/shaders/mtl/fill_extrusion.hpp>
@@ -66,8 +67,9 @@ void FillExtrusionLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintP
 
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
-    std::vector<FillExtrusionDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount());
-    std::vector<FillExtrusionTilePropsUBO> tilePropsUBOVector(layerGroup.getDrawableCount());
+    util::FrameVector<FillExtrusionDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
+    util::FrameVector<FillExtrusionTilePropsUBO> tilePropsUBOVector(layerGroup.getDrawableCount(),
+                                                                    parameters.frameArena);
 #endif
 
     visitLayerGroupDrawables(layerGroup, [&](gfx::Drawable& drawable) {
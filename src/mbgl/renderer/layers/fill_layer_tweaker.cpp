@@ -15,6 +15,7 @@
 #include <mbgl/shaders/fill_layer_ubo.hpp>
 #include <mbgl/style/layers/fill_layer_properties.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/frame_arena.hpp>
 #include <mbgl/util/std.hpp>
 
 namespace mbgl {
@@ -59,8 +60,8 @@ void FillLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParameters
 
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
-    std::vector<FillDrawableUnionUBO> drawableUBOVector(layerGroup.getDrawableCount());
-    std::vector<FillTilePropsUnionUBO> tilePropsUBOVector(layerGroup.getDrawableCount());
+    util::FrameVector<FillDrawableUnionUBO> drawableUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
+    util::FrameVector<FillTilePropsUnionUBO> tilePropsUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
 #endif
 
     visitLayerGroupDrawables(layerGroup, [&](gfx::Drawable& drawable) {
@@ -9,6 +9,7 @@
 #include <mbgl/shaders/heatmap_layer_ubo.hpp>
 #include <mbgl/style/layers/heatmap_layer_properties.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/frame_arena.hpp>
 
 #if MLN_RENDER_BACKEND_METAL
 #include <mbgl/shaders/mtl/heatmap.hpp>
@@ -47,7 +48,7 @@ void HeatmapLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParamet
 
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
-    std::vector<HeatmapDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount());
+    util::FrameVector<HeatmapDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
 #endif
 
     visitLayerGroupDrawables(layerGroup, [&](gfx::Drawable& drawable) {
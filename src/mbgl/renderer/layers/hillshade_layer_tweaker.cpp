@@ -8,6 +8,7 @@
 #include <mbgl/shaders/hillshade_layer_ubo.hpp>
 #include <mbgl/style/layers/hillshade_layer_properties.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/frame_arena.hpp>
 
 namespace mbgl {
 
@@ -55,8 +56,8 @@ void HillshadeLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParam
 
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
-    std::vector<HillshadeDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount());
-    std::vector<HillshadeTilePropsUBO> tilePropsUBOVector(layerGroup.getDrawableCount());
+    util::FrameVector<HillshadeDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
+    util::FrameVector<HillshadeTilePropsUBO> tilePropsUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
 #endif
 
     visitLayerGroupDrawables(layerGroup, [&](gfx::Drawable& drawable) {
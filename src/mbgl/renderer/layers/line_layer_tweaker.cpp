@@ -11,6 +11,7 @@
 #include <mbgl/shaders/line_layer_ubo.hpp>
 #include <mbgl/shaders/shader_program_base.hpp>
 #include <mbgl/style/layers/line_layer_properties.hpp>
+#include <mbgl/util/frame_arena.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/math.hpp>
 
@@ -197,8 +198,8 @@ void LineLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParameters
 
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
-    std::vector<LineDrawableUnionUBO> drawableUBOVector(layerGroup.getDrawableCount());
-    std::vector<LineTilePropsUnionUBO> tilePropsUBOVector(layerGroup.getDrawableCount());
+    util::FrameVector<LineDrawableUnionUBO> drawableUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
+    util::FrameVector<LineTilePropsUnionUBO> tilePropsUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
 #endif
 
     visitLayerGroupDrawables(layerGroup, [&](gfx::Drawable& drawable) {
@@ -8,6 +8,7 @@
 #include <mbgl/shaders/raster_layer_ubo.hpp>
 #include <mbgl/style/layers/raster_layer_properties.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/frame_arena.hpp>
 #include <mbgl/gfx/image_drawable_data.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -71,7 +72,7 @@ void RasterLayerTweaker::execute([[maybe_unused]] LayerGroupBase& layerGroup,
 
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
-    std::vector<RasterDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount());
+    util::FrameVector<RasterDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
 #endif
 
     visitLayerGroupDrawables(layerGroup, [&](gfx::Drawable& drawable) {
@@ -5,6 +5,7 @@
 #include <mbgl/gfx/shader_group.hpp>
 #include <mbgl/gfx/shader_registry.hpp>
 #include <mbgl/renderer/buckets/circle_bucket.hpp>
+#include <mbgl/renderer/layer_drawable_data.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
@@ -204,9 +205,6 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
     stats.drawablesRemoved += tileLayerGroup->removeDrawablesIf(
         [&](gfx::Drawable& drawable) { return drawable.getTileID() && !hasRenderTile(*drawable.getTileID()); });
 
-    const auto& evaluated = static_cast<const CircleLayerProperties&>(*evaluatedProperties).evaluated;
-    StringIDSetsPair propertiesAsUniforms;
-
     for (const RenderTile& tile : *renderTiles) {
         const auto& tileID = tile.getOverscaledTileID();
 
@@ -239,31 +237,20 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
             continue;
         }
 
-        propertiesAsUniforms.first.clear();
-        propertiesAsUniforms.second.clear();
+        // The attributes and the properties selecting the shader are prepared by the tile worker
+        const auto drawableData = bucket.getDrawableData(*evaluatedProperties);
+        if (!drawableData) {
+            removeTile(renderPass, tileID);
+            continue;
+        }
 
-        auto circleVertexAttrs = context.createVertexAttributeArray();
-        circleVertexAttrs->readDataDrivenPaintProperties<CircleColor,
-                                                         CircleRadius,
-                                                         CircleBlur,
-                                                         CircleOpacity,
-                                                         CircleStrokeColor,
-                                                         CircleStrokeWidth,
-                                                         CircleStrokeOpacity>(
-            paintPropertyBinders, evaluated, propertiesAsUniforms, idCircleColorVertexAttribute);
-
-        const auto circleShader = circleShaderGroup->getOrCreateShader(context, propertiesAsUniforms);
+        const auto circleShader = circleShaderGroup->getOrCreateShader(context, drawableData->propertiesAsUniforms);
         if (!circleShader) {
             continue;
         }
 
-        if (const auto& attr = circleVertexAttrs->set(idCirclePosVertexAttribute)) {
-            attr->setSharedRawData(bucket.sharedVertices,
-                                   offsetof(CircleLayoutVertex, a1),
-                                   0,
-                                   sizeof(CircleLayoutVertex),
-                                   gfx::AttributeDataType::Short2);
-        }
+        auto circleVertexAttrs = context.createVertexAttributeArray();
+        circleVertexAttrs->setSharedAttributes(drawableData->vertexAttributes);
 
         circleBuilder = context.createDrawableBuilder("circle");
         circleBuilder->setShader(std::static_pointer_cast<gfx::ShaderProgramBase>(circleShader));
@@ -6,6 +6,7 @@
 #include <mbgl/gfx/shader_registry.hpp>
 #include <mbgl/renderer/buckets/fill_bucket.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/layer_drawable_data.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_source.hpp>
@@ -188,7 +189,6 @@ void RenderFillLayer::update(gfx::ShaderRegistry& shaders,
 
     fillTileLayerGroup->setStencilTiles(renderTiles);
 
-    StringIDSetsPair propertiesAsUniforms;
     for (const RenderTile& tile : *renderTiles) {
         const auto& tileID = tile.getOverscaledTileID();
 
@@ -228,24 +228,34 @@ void RenderFillLayer::update(gfx::ShaderRegistry& shaders,
             return atlasTweaker;
         };
 
-        propertiesAsUniforms.first.clear();
-        propertiesAsUniforms.second.clear();
+        // The attributes and the properties selecting the shaders are prepared by the tile worker
+        const auto drawableData = bucket.getDrawableData(*renderData->layerProperties);
+        if (!drawableData) {
+            removeTile(renderPass, tileID);
+            continue;
+        }
+        const StringIDSetsPair& propertiesAsUniforms = drawableData->propertiesAsUniforms;
 
-        // `Fill*Program` all use `style::FillPaintProperties`
-        // TODO: Only rebuild the vertex attributes when something has changed.
         // TODO: Can we update them in-place instead of replacing?
         auto vertexAttrs = context.createVertexAttributeArray();
-        vertexAttrs->readDataDrivenPaintProperties<FillColor, FillOpacity, FillOutlineColor, FillPattern>(
-            binders, evaluated, propertiesAsUniforms, idFillColorVertexAttribute);
+        vertexAttrs->setSharedAttributes(drawableData->vertexAttributes);
 
         const auto fillVertexCount = bucket.vertices.elements();
-        if (const auto& attr = vertexAttrs->set(idFillPosVertexAttribute)) {
-            attr->setSharedRawData(bucket.sharedVertices,
-                                   offsetof(FillLayoutVertex, a1),
-                                   /*vertexOffset=*/0,
-                                   sizeof(FillLayoutVertex),
-                                   gfx::AttributeDataType::Short2);
+
+#if MLN_FILL_FEATURE_STATE_TEXTURE
+        // Properties that depend on feature state are looked up by the ordinal of each feature.
+        const auto* featureStateTexture = binders.getFeatureStateTexture();
+        const gfx::Texture2DPtr featureStateSampler = featureStateTexture ? featureStateTexture->getTexture() : nullptr;
+        if (featureStateTexture) {
+            if (const auto& attr = vertexAttrs->set(idFillFeatureOrdinalVertexAttribute)) {
+                attr->setSharedRawData(featureStateTexture->getOrdinals(),
+                                       offsetof(FeatureStateTexture::OrdinalVertex, a1),
+                                       /*vertexOffset=*/0,
+                                       sizeof(FeatureStateTexture::OrdinalVertex),
+                                       gfx::AttributeDataType::Float);
+            }
         }
+#endif
 
 #if MLN_TRIANGULATE_FILL_OUTLINES
         const auto lineVertexCount = bucket.lineVertices.elements();
@@ -276,6 +286,13 @@ void RenderFillLayer::update(gfx::ShaderRegistry& shaders,
                 return false;
             }
 
+#if MLN_FILL_FEATURE_STATE_TEXTURE
+            // The texture is re-created when the bucket grows
+            if (drawable.getTexture(idFillFeatureStateTexture) != featureStateSampler) {
+                drawable.setTexture(featureStateSampler, idFillFeatureStateTexture);
+            }
+#endif
+
             switch (static_cast<FillVariant>(drawable.getType())) {
                 case FillVariant::Fill:
                 case FillVariant::FillPattern:
@@ -417,6 +434,9 @@ void RenderFillLayer::update(gfx::ShaderRegistry& shaders,
                 }
 #endif
                 fillBuilder->setVertexAttributes(std::move(vertexAttrs));
+#if MLN_FILL_FEATURE_STATE_TEXTURE
+                fillBuilder->setTexture(featureStateSampler, idFillFeatureStateTexture);
+#endif
 
                 fillBuilder->setRawVertices({}, fillVertexCount, gfx::AttributeDataType::Short2);
                 fillBuilder->setSegments(gfx::Triangles(),
@@ -446,6 +466,9 @@ void RenderFillLayer::update(gfx::ShaderRegistry& shaders,
 #else
             if (doOutline && outlineBuilder && bucket.sharedBasicLineIndexes->elements()) {
                 outlineBuilder->setShader(outlineShader);
+#if MLN_FILL_FEATURE_STATE_TEXTURE
+                outlineBuilder->setTexture(featureStateSampler, idFillFeatureStateTexture);
+#endif
                 outlineBuilder->setRawVertices({}, fillVertexCount, gfx::AttributeDataType::Short2);
                 outlineBuilder->setSegments(gfx::Lines(lineWidth),
                                             bucket.sharedBasicLineIndexes,
@@ -6,6 +6,7 @@
 #include <mbgl/gfx/shader_registry.hpp>
 #include <mbgl/renderer/buckets/line_bucket.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/layer_drawable_data.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
@@ -284,29 +285,11 @@ void RenderLineLayer::update(gfx::ShaderRegistry& shaders,
         [&](gfx::DrawableBuilder& builder, const LineBucket& bucket, gfx::VertexAttributeArrayPtr&& vertexAttrs) {
             const auto vertexCount = bucket.vertices.elements();
             builder.setRawVertices({}, vertexCount, gfx::AttributeDataType::Short4);
-
-            if (const auto& attr = vertexAttrs->set(idLinePosNormalVertexAttribute)) {
-                attr->setSharedRawData(bucket.sharedVertices,
-                                       offsetof(LineLayoutVertex, a1),
-                                       /*vertexOffset=*/0,
-                                       sizeof(LineLayoutVertex),
-                                       gfx::AttributeDataType::Short2);
-            }
-
-            if (const auto& attr = vertexAttrs->set(idLineDataVertexAttribute)) {
-                attr->setSharedRawData(bucket.sharedVertices,
-                                       offsetof(LineLayoutVertex, a2),
-                                       /*vertexOffset=*/0,
-                                       sizeof(LineLayoutVertex),
-                                       gfx::AttributeDataType::UByte4);
-            }
-
             builder.setVertexAttributes(std::move(vertexAttrs));
         };
 
     tileLayerGroup->setStencilTiles(renderTiles);
 
-    StringIDSetsPair propertiesAsUniforms;
     for (const RenderTile& tile : *renderTiles) {
         const auto& tileID = tile.getOverscaledTileID();
 
@@ -358,19 +341,16 @@ void RenderLineLayer::update(gfx::ShaderRegistry& shaders,
             ++stats.drawablesAdded;
         };
 
-        propertiesAsUniforms.first.clear();
-        propertiesAsUniforms.second.clear();
+        // The attributes and the properties selecting the shader are prepared by the tile worker
+        const auto drawableData = bucket.getDrawableData(*renderData->layerProperties);
+        if (!drawableData) {
+            removeTile(renderPass, tileID);
+            continue;
+        }
+        const StringIDSetsPair& propertiesAsUniforms = drawableData->propertiesAsUniforms;
 
         auto vertexAttrs = context.createVertexAttributeArray();
-        vertexAttrs->readDataDrivenPaintProperties<LineColor,
-                                                   LineBlur,
-                                                   LineOpacity,
-                                                   LineGapWidth,
-                                                   LineOffset,
-                                                   LineWidth,
-                                                   LineFloorWidth,
-                                                   LinePattern>(
-            paintPropertyBinders, evaluated, propertiesAsUniforms, idLineColorVertexAttribute);
+        vertexAttrs->setSharedAttributes(drawableData->vertexAttributes);
 
         if (!evaluated.get<LineDasharray>().from.empty()) {
             // dash array line (SDF)
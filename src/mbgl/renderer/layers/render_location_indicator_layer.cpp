@@ -319,7 +319,7 @@ public:
         */
         void assign(const Immutable<style::Image::Impl>* img) {
             imageDirty = true;
-            image = (img) ? &(img->get()->image) : nullptr;
+            image = (img) ? &(img->get()->getImage()) : nullptr;
             width = height = 0;
             pixelRatio = 1.0f;
             if (image) {
@@ -437,8 +437,8 @@ public:
             id = img->id;
             pixelRatio = img->pixelRatio;
 
-            width = img->image.size.width;
-            height = img->image.size.height;
+            width = img->getSize().width;
+            height = img->getSize().height;
         }
 
         void reset() {
@@ -834,7 +834,7 @@ protected:
             texture = tx;
         } else {
             const Immutable<style::Image::Impl>* sharedImage = params.imageManager->getSharedImage(imagePath);
-            const mbgl::PremultipliedImage* img = (sharedImage) ? &sharedImage->get()->image : nullptr;
+            const mbgl::PremultipliedImage* img = (sharedImage) ? &sharedImage->get()->getImage() : nullptr;
             std::shared_ptr<Texture>& tex = textures.at(imagePath);
             if (tex->image != img) { // image for the ID might have changed.
                 tex->assign(sharedImage);
@@ -1284,7 +1284,7 @@ void RenderLocationIndicatorLayer::update(gfx::ShaderRegistry& shaders,
                                                                        true});
                 }
 
-                info.textureInfo.texture->upload(info.textureInfo.image->get()->image);
+                info.textureInfo.texture->upload(info.textureInfo.image->get()->getImage());
                 info.textureInfo.image.reset();
             }
 
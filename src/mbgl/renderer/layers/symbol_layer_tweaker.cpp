@@ -15,6 +15,7 @@
 #include <mbgl/shaders/symbol_layer_ubo.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/frame_arena.hpp>
 #include <mbgl/util/std.hpp>
 
 #if MLN_RENDER_BACKEND_METAL
@@ -90,8 +91,8 @@ void SymbolLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParamete
 
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
-    std::vector<SymbolDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount());
-    std::vector<SymbolTilePropsUBO> tilePropsUBOVector(layerGroup.getDrawableCount());
+    util::FrameVector<SymbolDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
+    util::FrameVector<SymbolTilePropsUBO> tilePropsUBOVector(layerGroup.getDrawableCount(), parameters.frameArena);
 #endif
 
     const auto camDist = state.getCameraToCenterDistance();
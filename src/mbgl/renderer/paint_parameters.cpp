@@ -63,7 +63,8 @@ PaintParameters::PaintParameters(gfx::Context& context_,
                                  uint64_t frameCount_,
                                  double tileLodMinRadius_,
                                  double tileLodScale_,
-                                 double tileLodPitchThreshold_)
+                                 double tileLodPitchThreshold_,
+                                 util::FrameArena& frameArena_)
     : context(context_),
       backend(backend_),
       encoder(context.createCommandEncoder()),
@@ -78,6 +79,7 @@ PaintParameters::PaintParameters(gfx::Context& context_,
       timePoint(timePoint_),
       pixelRatio(pixelRatio_),
       shaders(*staticData_.shaders),
+      frameArena(frameArena_),
       frameCount(frameCount_),
       tileLodMinRadius(tileLodMinRadius_),
       tileLodScale(tileLodScale_),
@@ -27,6 +27,10 @@ class LineAtlas;
 class PatternAtlas;
 class UnwrappedTileID;
 
+namespace util {
+class FrameArena;
+} // namespace util
+
 namespace gfx {
 class Context;
 class RendererBackend;
@@ -60,7 +64,8 @@ public:
                     uint64_t frameCount,
                     double tileLodMinRadius,
                     double tileLodScale,
-                    double tileLodPitchThreshold);
+                    double tileLodPitchThreshold,
+                    util::FrameArena&);
     ~PaintParameters();
 
     gfx::Context& context;
@@ -86,6 +91,9 @@ public:
 
     gfx::ShaderRegistry& shaders;
 
+    /// Scratch memory for data that doesn't outlive the frame, e.g. UBO staging.
+    util::FrameArena& frameArena;
+
     gfx::DepthMode depthModeForSublayer(uint8_t n, gfx::DepthMaskType) const;
     gfx::DepthMode depthModeFor3D() const;
     gfx::ColorMode colorModeForRenderPass() const;
@@ -7,6 +7,8 @@
 #include <mbgl/layout/pattern_layout.hpp>
 #include <mbgl/shaders/attributes.hpp>
 #include <mbgl/renderer/cross_faded_property_evaluator.hpp>
+#include <mbgl/renderer/feature_state_texture.hpp>
+#include <mbgl/renderer/feature_vertex_index.hpp>
 #include <mbgl/renderer/paint_property_statistics.hpp>
 #include <mbgl/renderer/possibly_evaluated_property_value.hpp>
 #include <mbgl/util/indexed_tuple.hpp>
@@ -15,16 +17,11 @@
 #include <mbgl/util/variant.hpp>
 #include <mbgl/util/vectors.hpp>
 
-namespace mbgl {
-
-// Maps vertex range to feature index
-struct FeatureVertexRange {
-    std::size_t featureIndex;
-    std::size_t start;
-    std::size_t end;
-};
+#include <algorithm>
+#include <string_view>
+#include <vector>
 
-using FeatureVertexRangeMap = std::map<std::string, std::vector<FeatureVertexRange>>;
+namespace mbgl {
 
 /*
    ZoomInterpolatedAttribute<Attr> is a 'compound' attribute, representing two
@@ -76,6 +73,18 @@ std::array<float, N * 2> zoomInterpolatedAttributeValue(const std::array<float,
     return result;
 }
 
+/*
+    Pad an interpolated attribute value to a texel of the feature state texture,
+    the shaders only read as many components as the attribute has.
+*/
+template <size_t N>
+FeatureStateTexture::Texel toFeatureStateTexel(const std::array<float, N>& value) {
+    static_assert(N <= 4, "attribute does not fit a texel");
+    FeatureStateTexture::Texel texel{{0.0f, 0.0f, 0.0f, 0.0f}};
+    std::copy(value.begin(), value.end(), texel.begin());
+    return texel;
+}
+
 /*
    PaintPropertyBinder is an abstract class serving as the interface definition
    for the strategy used for constructing, uploading, and binding paint property
@@ -115,10 +124,19 @@ public:
                                       const CanonicalTileID& canonical,
                                       const style::expression::Value&) = 0;
 
-    virtual void updateVertexVectors(const FeatureStates&, const GeometryTileLayer&, const ImagePositions&) {}
+    /// Whether updateVertexVector() needs to run when the state of a feature changes.
+    virtual bool dependsOnFeatureState() const { return false; }
 
     virtual void updateVertexVector(std::size_t, std::size_t, const GeometryTileFeature&, const FeatureState&) = 0;
 
+    /// The value of a feature, as stored in the feature state texture instead of the vertex vector.
+    /// Only used for binders with a `featureStateSlot`.
+    virtual FeatureStateTexture::Texel featureStateTexel(const GeometryTileFeature&,
+                                                         const FeatureState&,
+                                                         const CanonicalTileID*) {
+        return {};
+    }
+
     virtual void setPatternParameters(const std::optional<ImagePosition>&,
                                       const std::optional<ImagePosition>&,
                                       const CrossfadeParameters&) = 0;
@@ -138,6 +156,9 @@ public:
     static std::unique_ptr<PaintPropertyBinder> create(const PossiblyEvaluatedType& value, float zoom, T defaultValue);
 
     PaintPropertyStatistics<T> statistics;
+
+    /// Where the value of each feature is in the feature state texture, if the property is read from there.
+    std::optional<uint32_t> featureStateSlot;
 };
 
 namespace detail {
@@ -249,7 +270,7 @@ public:
                               const CrossfadeParameters&) override {}
     void populateVertexVector(const GeometryTileFeature& feature,
                               std::size_t length,
-                              std::size_t index,
+                              std::size_t /* index */,
                               const ImagePositions&,
                               const std::optional<PatternDependency>&,
                               const CanonicalTileID& canonical,
@@ -264,29 +285,9 @@ public:
         for (std::size_t i = elements; i < length; ++i) {
             vertexVector.emplace_back(BaseVertex{value});
         }
-        std::optional<std::string> idStr = featureIDtoString(feature.getID());
-        if (idStr) {
-            featureMap[*idStr].emplace_back(FeatureVertexRange{index, elements, length});
-        }
     }
 
-    void updateVertexVectors(const FeatureStates& states,
-                             const GeometryTileLayer& layer,
-                             const ImagePositions&) override {
-        for (const auto& it : states) {
-            const auto positions = featureMap.find(it.first);
-            if (positions == featureMap.end()) {
-                continue;
-            }
-
-            for (const auto& pos : positions->second) {
-                std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(pos.featureIndex);
-                if (feature) {
-                    updateVertexVector(pos.start, pos.end, *feature, it.second);
-                }
-            }
-        }
-    }
+    bool dependsOnFeatureState() const override { return !expression.isFeatureStateConstant(); }
 
     void updateVertexVector(std::size_t start,
                             std::size_t end,
@@ -297,14 +298,23 @@ public:
         const auto evaluated = expression.evaluate(EvaluationContext(&feature).withFeatureState(&state), defaultValue);
         this->statistics.add(evaluated);
 
-        const auto value = BaseVertex{attributeValue(evaluated)};
-        for (std::size_t i = start; i < end; ++i) {
-            vertexVector.at(i) = value;
-        }
-
+        vertexVector.fill(start, end, BaseVertex{attributeValue(evaluated)});
         vertexVector.updateModified();
     }
 
+    FeatureStateTexture::Texel featureStateTexel(const GeometryTileFeature& feature,
+                                                 const FeatureState& state,
+                                                 const CanonicalTileID* canonical) override {
+        using style::expression::EvaluationContext;
+
+        const auto evaluated = expression.evaluate(
+            EvaluationContext(&feature).withFeatureState(&state).withCanonicalTileID(canonical), defaultValue);
+        this->statistics.add(evaluated);
+
+        const auto value = attributeValue(evaluated);
+        return toFeatureStateTexel(zoomInterpolatedAttributeValue(value, value));
+    }
+
     std::tuple<float> interpolationFactor(float) const override { return std::tuple<float>{0.0f}; }
 
     std::tuple<T> uniformValue(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
@@ -332,7 +342,6 @@ private:
     gfx::VertexVectorPtr<BaseVertex> sharedVertexVector = std::make_shared<gfx::VertexVector<BaseVertex>>();
     gfx::VertexVector<BaseVertex>& vertexVector = *sharedVertexVector;
 
-    FeatureVertexRangeMap featureMap;
 };
 
 template <class T, class A>
@@ -354,7 +363,7 @@ public:
                               const CrossfadeParameters&) override {}
     void populateVertexVector(const GeometryTileFeature& feature,
                               std::size_t length,
-                              std::size_t index,
+                              std::size_t /* index */,
                               const ImagePositions&,
                               const std::optional<PatternDependency>&,
                               const CanonicalTileID& canonical,
@@ -381,28 +390,9 @@ public:
         for (std::size_t i = elements; i < length; ++i) {
             vertexVector.emplace_back(Vertex{value});
         }
-        if (auto idStr = featureIDtoString(feature.getID())) {
-            featureMap[*idStr].emplace_back(FeatureVertexRange{index, elements, length});
-        }
     }
 
-    void updateVertexVectors(const FeatureStates& states,
-                             const GeometryTileLayer& layer,
-                             const ImagePositions&) override {
-        for (const auto& it : states) {
-            const auto positions = featureMap.find(it.first);
-            if (positions == featureMap.end()) {
-                continue;
-            }
-
-            for (const auto& pos : positions->second) {
-                std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(pos.featureIndex);
-                if (feature) {
-                    updateVertexVector(pos.start, pos.end, *feature, it.second);
-                }
-            }
-        }
-    }
+    bool dependsOnFeatureState() const override { return !expression.isFeatureStateConstant(); }
 
     void updateVertexVector(std::size_t start,
                             std::size_t end,
@@ -416,14 +406,26 @@ public:
         this->statistics.add(range.min);
         this->statistics.add(range.max);
 
-        const Vertex value = Vertex{
-            zoomInterpolatedAttributeValue(attributeValue(range.min), attributeValue(range.max))};
+        vertexVector.fill(
+            start, end, Vertex{zoomInterpolatedAttributeValue(attributeValue(range.min), attributeValue(range.max))});
+        vertexVector.updateModified();
+    }
 
-        for (std::size_t i = start; i < end; ++i) {
-            vertexVector.at(i) = value;
-        }
+    FeatureStateTexture::Texel featureStateTexel(const GeometryTileFeature& feature,
+                                                 const FeatureState& state,
+                                                 const CanonicalTileID* canonical) override {
+        using style::expression::EvaluationContext;
+        const Range<T> range = {
+            expression.evaluate(EvaluationContext(zoomRange.min, &feature, &state).withCanonicalTileID(canonical),
+                                defaultValue),
+            expression.evaluate(EvaluationContext(zoomRange.max, &feature, &state).withCanonicalTileID(canonical),
+                                defaultValue),
+        };
+        this->statistics.add(range.min);
+        this->statistics.add(range.max);
 
-        vertexVector.updateModified();
+        return toFeatureStateTexel(
+            zoomInterpolatedAttributeValue(attributeValue(range.min), attributeValue(range.max)));
     }
 
     std::tuple<float> interpolationFactor(float currentZoom) const override {
@@ -460,7 +462,6 @@ private:
     gfx::VertexVectorPtr<Vertex> sharedVertexVector = std::make_shared<gfx::VertexVector<Vertex>>();
     gfx::VertexVector<Vertex>& vertexVector = *sharedVertexVector;
 
-    FeatureVertexRangeMap featureMap;
 };
 
 template <class T, class A1, class A2>
@@ -651,10 +652,16 @@ public:
 
     using Binders = IndexedTuple<TypeList<Ps...>, TypeList<std::unique_ptr<Binder<Ps>>...>>;
 
+    /// @param useFeatureStateTexture Keep the properties that depend on feature state in a `FeatureStateTexture`
+    /// instead of the vertex vectors. The shaders must support it, see `gfx::ShaderGroup::featureStateDefines`.
     template <class EvaluatedProperties>
-    PaintPropertyBinders(const EvaluatedProperties& properties, float z)
-        : binders(Binder<Ps>::create(properties.template get<Ps>(), z, Ps::defaultValue())...) {
+    PaintPropertyBinders(const EvaluatedProperties& properties, float z, bool useFeatureStateTexture = false)
+        : binders(Binder<Ps>::create(properties.template get<Ps>(), z, Ps::defaultValue())...),
+          dependsOnFeatureState((false || ... || binders.template get<Ps>()->dependsOnFeatureState())) {
         (void)z; // Workaround for https://gcc.gnu.org/bugzilla/show_bug.cgi?id=56958
+        if (useFeatureStateTexture && dependsOnFeatureState) {
+            assignFeatureStateSlots();
+        }
     }
 
     PaintPropertyBinders(PaintPropertyBinders&&) noexcept = default;
@@ -667,15 +674,34 @@ public:
                                const std::optional<PatternDependency>& patternDependencies,
                                const CanonicalTileID& canonical,
                                const style::expression::Value& formattedSection = {}) {
-        util::ignore({(binders.template get<Ps>()->populateVertexVector(
+        if (featureStateTexture && length > populatedLength) {
+            const auto ordinal = featureStateTexture->addFeature(length - populatedLength);
+            util::ignore({(populateFeatureStateTexel<Ps>(ordinal, feature, canonical), 0)...});
+        }
+        util::ignore({(populateVertexVector<Ps>(
                            feature, length, index, patternPositions, patternDependencies, canonical, formattedSection),
                        0)...});
+
+        // Every data-driven binder pads its vertex vector to `length`, so the
+        // vertices of this feature start where the previous feature ended.
+        if (dependsOnFeatureState && length > populatedLength) {
+            featureIndex.insert(feature.getID(), index, populatedLength, length);
+        }
+        populatedLength = std::max(populatedLength, length);
     }
 
-    void updateVertexVectors(const FeatureStates& states,
-                             const GeometryTileLayer& layer,
-                             const ImagePositions& imagePositions) {
-        util::ignore({(binders.template get<Ps>()->updateVertexVectors(states, layer, imagePositions), 0)...});
+    void updateVertexVectors(const FeatureStates& states, const GeometryTileLayer& layer, const ImagePositions&) {
+        if (!dependsOnFeatureState) {
+            return;
+        }
+        for (const auto& [id, state] : states) {
+            featureIndex.forEachRange(id, [&](const FeatureVertexRange& range) {
+                // Fetch the feature once for all properties.
+                if (const auto feature = layer.getFeature(range.featureIndex)) {
+                    util::ignore({(updateVertexVector<Ps>(range, *feature, state), 0)...});
+                }
+            });
+        }
     }
 
     void setPatternParameters(const std::optional<ImagePosition>& posA,
@@ -721,8 +747,84 @@ public:
         return binders.template get<P>()->statistics;
     }
 
+    /// The feature state dependent values, if they're not in the vertex vectors.
+    FeatureStateTexture* getFeatureStateTexture() const { return featureStateTexture.get(); }
+
 private:
+    // Slots follow the order of the attribute names, which is how the shaders number them.
+    void assignFeatureStateSlots() {
+        std::vector<std::pair<std::string_view, std::optional<uint32_t>*>> slots;
+        util::ignore({(addFeatureStateSlot<Ps>(slots), 0)...});
+        if (slots.empty()) {
+            return;
+        }
+        std::sort(slots.begin(), slots.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (std::size_t slot = 0; slot < slots.size(); ++slot) {
+            *slots[slot].second = static_cast<uint32_t>(slot);
+        }
+        featureStateTexture = std::make_unique<FeatureStateTexture>(static_cast<uint32_t>(slots.size()));
+    }
+
+    template <class P>
+    void addFeatureStateSlot(std::vector<std::pair<std::string_view, std::optional<uint32_t>*>>& slots) {
+        // Cross-faded properties have more than one attribute and never read the feature state.
+        auto& binder = binders.template get<P>();
+        if (P::AttributeNames.size() == 1 && binder->dependsOnFeatureState()) {
+            slots.emplace_back(P::AttributeNames[0], &binder->featureStateSlot);
+        }
+    }
+
+    template <class P>
+    void populateVertexVector(const GeometryTileFeature& feature,
+                              std::size_t length,
+                              std::size_t index,
+                              const ImagePositions& patternPositions,
+                              const std::optional<PatternDependency>& patternDependencies,
+                              const CanonicalTileID& canonical,
+                              const style::expression::Value& formattedSection) {
+        auto& binder = binders.template get<P>();
+        if (!binder->featureStateSlot) {
+            binder->populateVertexVector(
+                feature, length, index, patternPositions, patternDependencies, canonical, formattedSection);
+        }
+    }
+
+    template <class P>
+    void populateFeatureStateTexel(uint32_t ordinal,
+                                   const GeometryTileFeature& feature,
+                                   const CanonicalTileID& canonical) {
+        auto& binder = binders.template get<P>();
+        if (binder->featureStateSlot) {
+            featureStateTexture->setTexel(
+                ordinal, *binder->featureStateSlot, binder->featureStateTexel(feature, {}, &canonical));
+        }
+    }
+
+    template <class P>
+    void updateVertexVector(const FeatureVertexRange& range,
+                            const GeometryTileFeature& feature,
+                            const FeatureState& state) {
+        auto& binder = binders.template get<P>();
+        if (!binder->dependsOnFeatureState()) {
+            return;
+        }
+        if (binder->featureStateSlot) {
+            const FeatureStateTexture::OrdinalVector& ordinals = *featureStateTexture->getOrdinals();
+            const auto ordinal = static_cast<uint32_t>(ordinals.at(range.start).a1[0]);
+            featureStateTexture->setTexel(
+                ordinal, *binder->featureStateSlot, binder->featureStateTexel(feature, state, nullptr));
+        } else {
+            binder->updateVertexVector(range.start, range.end, feature, state);
+        }
+    }
+
     Binders binders;
+
+    // Only maintained when a property reads the feature state.
+    bool dependsOnFeatureState;
+    FeatureVertexIndex featureIndex;
+    std::size_t populatedLength = 0;
+    std::unique_ptr<FeatureStateTexture> featureStateTexture;
 };
 
 } // namespace mbgl
@@ -38,8 +38,8 @@ std::optional<ImagePosition> PatternAtlas::addPattern(const style::Image::Impl&
     if (patterns.find(image.id) != patterns.end()) {
         return std::nullopt;
     }
-    const uint16_t width = image.image.size.width + padding * 2;
-    const uint16_t height = image.image.size.height + padding * 2;
+    const uint16_t width = image.getSize().width + padding * 2;
+    const uint16_t height = image.getSize().height + padding * 2;
 
     mapbox::Bin* bin = shelfPack.packOne(-1, width, height);
     if (!bin) {
@@ -48,7 +48,7 @@ std::optional<ImagePosition> PatternAtlas::addPattern(const style::Image::Impl&
 
     atlasImage.resize(getPixelSize());
 
-    const PremultipliedImage& src = image.image;
+    const PremultipliedImage& src = image.getImage();
 
     const uint32_t x = bin->x + padding;
     const uint32_t y = bin->y + padding;
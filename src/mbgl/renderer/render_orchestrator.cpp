@@ -23,7 +23,9 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/tile/raster_image_cache.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/string.hpp>
@@ -63,15 +65,16 @@ RendererObserver& nullObserver() {
 class RenderTreeImpl final : public RenderTree {
 public:
     RenderTreeImpl(std::unique_ptr<RenderTreeParameters> parameters_,
-                   std::set<LayerRenderItem> layerRenderItems_,
-                   std::vector<std::unique_ptr<RenderItem>> sourceRenderItems_,
+                   LayerRenderItems layerRenderItems_,
+                   util::FrameVector<std::unique_ptr<RenderItem>> sourceRenderItems_,
                    LineAtlas& lineAtlas_,
                    PatternAtlas& patternAtlas_,
                    RenderLayerReferences layersNeedPlacement_,
                    Immutable<Placement> placement_,
                    bool updateSymbolOpacities_,
+                   util::FrameArena& frameArena_,
                    double startTime_)
-        : RenderTree(std::move(parameters_), startTime_),
+        : RenderTree(std::move(parameters_), frameArena_, startTime_),
           layerRenderItems(std::move(layerRenderItems_)),
           sourceRenderItems(std::move(sourceRenderItems_)),
           lineAtlas(lineAtlas_),
@@ -88,10 +91,12 @@ public:
         }
     }
 
-    const std::set<LayerRenderItem>& getLayerRenderItemMap() const noexcept override { return layerRenderItems; }
-    RenderItems getLayerRenderItems() const override { return {layerRenderItems.begin(), layerRenderItems.end()}; }
+    const LayerRenderItems& getLayerRenderItemMap() const noexcept override { return layerRenderItems; }
+    RenderItems getLayerRenderItems() const override {
+        return {layerRenderItems.begin(), layerRenderItems.end(), frameArena};
+    }
     RenderItems getSourceRenderItems() const override {
-        RenderItems result;
+        RenderItems result(frameArena);
         result.reserve(sourceRenderItems.size());
         for (const auto& item : sourceRenderItems) result.emplace_back(*item);
         return result;
@@ -99,8 +104,8 @@ public:
     LineAtlas& getLineAtlas() const override { return lineAtlas; }
     PatternAtlas& getPatternAtlas() const override { return patternAtlas; }
 
-    std::set<LayerRenderItem> layerRenderItems;
-    std::vector<std::unique_ptr<RenderItem>> sourceRenderItems;
+    LayerRenderItems layerRenderItems;
+    util::FrameVector<std::unique_ptr<RenderItem>> sourceRenderItems;
     std::reference_wrapper<LineAtlas> lineAtlas;
     std::reference_wrapper<PatternAtlas> patternAtlas;
     RenderLayerReferences layersNeedPlacement;
@@ -118,6 +123,7 @@ RenderOrchestrator::RenderOrchestrator(bool backgroundLayerAsColor_,
       imageManager(std::make_unique<ImageManager>()),
       lineAtlas(std::make_unique<LineAtlas>()),
       patternAtlas(std::make_unique<PatternAtlas>()),
+      rasterImageCache(std::make_shared<RasterImageCache>(util::DEFAULT_RASTER_IMAGE_CACHE_SIZE)),
       imageImpls(makeMutable<std::vector<Immutable<style::Image::Impl>>>()),
       sourceImpls(makeMutable<std::vector<Immutable<style::Source::Impl>>>()),
       layerImpls(makeMutable<std::vector<Immutable<style::Layer::Impl>>>()),
@@ -142,6 +148,14 @@ RenderOrchestrator::~RenderOrchestrator() {
         }
     }
 
+    // The placement in flight reads layers and tiles owned here
+    if (pendingPlacement && pendingPlacement->done.valid()) {
+        pendingPlacement->done.wait();
+    }
+
+    // Raster tile workers still running may hold on to the cache, not to its images
+    rasterImageCache->clear();
+
     // Wait for any deferred cleanup tasks to complete before releasing and potentially
     // destroying the scheduler.  Those cleanup tasks must not hold the final reference
     // to the scheduler because it cannot be destroyed from one of its own pool threads.
@@ -158,6 +172,12 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
 
     const auto startTime = util::MonotonicTimer::now().count();
 
+    // The background placement reads the layers, tiles and buckets this frame updates.
+    const bool placementCommitted = commitPendingPlacement();
+
+    // The previous render tree is gone by now; recycle its memory.
+    frameArena.reset();
+
     const bool isMapModeContinuous = updateParameters->mode == MapMode::Continuous;
     if (!isMapModeContinuous) {
         // Reset zoom history state.
@@ -198,7 +218,10 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                         .tileLodScale = updateParameters->tileLodScale,
                                         .tileLodPitchThreshold = updateParameters->tileLodPitchThreshold,
                                         .tileLodZoomShift = updateParameters->tileLodZoomShift,
-                                        .dynamicTextureAtlas = dynamicTextureAtlas};
+                                        .dynamicTextureAtlas = dynamicTextureAtlas,
+                                        .transformPath = updateParameters->transformPath,
+                                        .tileCoverCache = &tileCoverCache,
+                                        .rasterImageCache = rasterImageCache};
 
     glyphManager->setURL(updateParameters->glyphURL);
     glyphManager->setFontFaces(updateParameters->fontFaces);
@@ -348,7 +371,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                                                        updateParameters->timePoint,
                                                                        renderLight.getEvaluated());
 
-    std::set<LayerRenderItem> layerRenderItems;
+    LayerRenderItems layerRenderItems(frameArena);
     layersNeedPlacement.clear();
     auto renderItemsEmplaceHint = layerRenderItems.begin();
 
@@ -358,7 +381,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
     }
 
     // Track which layers are flagged for rendering
-    std::vector<bool> updateList(orderedLayers.size());
+    util::FrameVector<bool> updateList(orderedLayers.size(), frameArena);
 
     // Update all sources and initialize renderItems.
     for (const auto& sourceImpl : *sourceImpls) {
@@ -494,12 +517,19 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
             placementUpdatePeriodOverride = std::optional<Duration>(Milliseconds(30));
         }
 
-        renderTreeParameters->placementChanged = !placementController.placementIsRecent(
+        bool placementDue = !placementController.placementIsRecent(
             updateParameters->timePoint,
             static_cast<float>(updateParameters->transformState.getZoom()),
             placementUpdatePeriodOverride);
+        if (placementDue && updateParameters->asyncPlacement) {
+            // This frame draws with the current placement. The new one runs
+            // after the frame is rendered and is committed by the next frame.
+            schedulePlacement(updateParameters, std::move(usedSymbolLayers));
+            placementDue = false;
+        }
+        renderTreeParameters->placementChanged = placementDue || placementCommitted;
         symbolBucketsChanged |= renderTreeParameters->placementChanged;
-        if (renderTreeParameters->placementChanged) {
+        if (placementDue) {
             Mutable<Placement> placement = Placement::create(updateParameters, placementController.getPlacement());
             placement->placeLayers(layersNeedPlacement);
             placementController.setPlacement(std::move(placement));
@@ -507,12 +537,13 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
             for (const auto& entry : renderSources) {
                 entry.second->updateFadingTiles();
             }
-        } else {
+        } else if (!placementCommitted) {
             placementController.setPlacementStale();
         }
         renderTreeParameters->symbolFadeChange = placementController.getPlacement()->symbolFadeChange(
             updateParameters->timePoint);
-        renderTreeParameters->needsRepaint = hasTransitions(updateParameters->timePoint);
+        renderTreeParameters->needsRepaint = hasTransitions(updateParameters->timePoint) ||
+                                             pendingPlacement.has_value();
     } else {
         MLN_TRACE_ZONE(placement);
 
@@ -535,7 +566,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         imageManager->reduceMemoryUseIfCacheSizeExceedsLimit();
     }
 
-    std::vector<std::unique_ptr<RenderItem>> sourceRenderItems;
+    util::FrameVector<std::unique_ptr<RenderItem>> sourceRenderItems(frameArena);
+    sourceRenderItems.reserve(renderSources.size());
     for (const auto& entry : renderSources) {
         if (entry.second->isEnabled()) {
             sourceRenderItems.emplace_back(entry.second->createRenderItem());
@@ -550,6 +582,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                             std::move(layersNeedPlacement),
                                             placementController.getPlacement(),
                                             symbolBucketsChanged,
+                                            frameArena,
                                             startTime);
 }
 
@@ -593,7 +626,7 @@ void RenderOrchestrator::queryRenderedSymbols(std::unordered_map<std::string, st
         return;
     }
     const Placement& placement = *placementController.getPlacement();
-    auto renderedSymbols = placement.getCollisionIndex().queryRenderedSymbols(geometry);
+    auto renderedSymbols = placement.queryRenderedSymbols(geometry);
     std::vector<std::reference_wrapper<const RetainedQueryData>> bucketQueryData;
     bucketQueryData.reserve(renderedSymbols.size());
     for (const auto& entry : renderedSymbols) {
@@ -770,11 +803,14 @@ bool RenderOrchestrator::getTileCacheEnabled() const {
 void RenderOrchestrator::reduceMemoryUse() {
     MLN_TRACE_FUNC();
 
+    commitPendingPlacement();
+
     filteredLayersForSource.shrink_to_fit();
     for (const auto& entry : renderSources) {
         entry.second->reduceMemoryUse();
     }
     imageManager->reduceMemoryUse();
+    rasterImageCache->clear();
     observer->onInvalidate();
 }
 
@@ -835,6 +871,72 @@ bool RenderOrchestrator::hasTransitions(TimePoint timePoint) const {
     return false;
 }
 
+void RenderOrchestrator::schedulePlacement(const std::shared_ptr<UpdateParameters>& updateParameters,
+                                           std::set<std::string> usedSymbolLayers) {
+    MLN_TRACE_FUNC();
+    assert(!pendingPlacement);
+
+    // The tiles' layout results own the buckets, and a tile drops its
+    // layout result when it's laid out again.
+    std::vector<std::shared_ptr<Bucket>> buckets;
+    for (const RenderLayer& layer : layersNeedPlacement) {
+        for (const BucketPlacementData& data : layer.getPlacementData()) {
+            if (const auto* renderData = data.tile.get().getLayerRenderData(*layer.baseImpl)) {
+                buckets.push_back(renderData->bucket);
+            }
+        }
+    }
+
+    pendingPlacement.emplace(
+        PendingPlacement{.placement = Placement::create(updateParameters, placementController.getPlacement()),
+                         .layers = layersNeedPlacement,
+                         .buckets = std::move(buckets),
+                         .usedSymbolLayers = std::move(usedSymbolLayers),
+                         .done = {}});
+}
+
+void RenderOrchestrator::startPendingPlacement() {
+    if (!pendingPlacement || pendingPlacement->done.valid()) {
+        return;
+    }
+    MLN_TRACE_FUNC();
+
+    auto task = std::make_shared<std::packaged_task<void()>>(
+        [&newPlacement = *pendingPlacement->placement, layers = pendingPlacement->layers] {
+            newPlacement.placeLayers(layers);
+        });
+    pendingPlacement->done = task->get_future();
+
+    if (!placementScheduler) {
+        placementScheduler = Scheduler::GetSequenced();
+    }
+    placementScheduler->schedule([task = std::move(task)] { (*task)(); });
+}
+
+bool RenderOrchestrator::commitPendingPlacement() {
+    if (!pendingPlacement) {
+        return false;
+    }
+    MLN_TRACE_FUNC();
+
+    auto pending = std::move(*pendingPlacement);
+    pendingPlacement.reset();
+
+    if (pending.done.valid()) {
+        // Rethrows anything placement threw
+        pending.done.get();
+    } else {
+        // The frame that scheduled it was never rendered
+        pending.placement->placeLayers(pending.layers);
+    }
+    placementController.setPlacement(std::move(pending.placement));
+    crossTileSymbolIndex.pruneUnusedLayers(pending.usedSymbolLayers);
+    for (const auto& entry : renderSources) {
+        entry.second->updateFadingTiles();
+    }
+    return true;
+}
+
 bool RenderOrchestrator::isLoaded() const {
     MLN_TRACE_FUNC();
 
@@ -855,6 +957,8 @@ bool RenderOrchestrator::isLoaded() const {
 void RenderOrchestrator::clearData() {
     MLN_TRACE_FUNC();
 
+    commitPendingPlacement();
+
     if (!sourceImpls->empty()) sourceImpls = makeMutable<std::vector<Immutable<style::Source::Impl>>>();
     if (!layerImpls->empty()) layerImpls = makeMutable<std::vector<Immutable<style::Layer::Impl>>>();
     if (!imageImpls->empty()) imageImpls = makeMutable<std::vector<Immutable<style::Image::Impl>>>();
@@ -15,14 +15,20 @@
 #include <mbgl/renderer/image_manager_observer.hpp>
 #include <mbgl/text/placement.hpp>
 #include <mbgl/renderer/render_tree.hpp>
+#include <mbgl/util/frame_arena.hpp>
+#include <mbgl/util/tile_cover.hpp>
 
+#include <future>
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace mbgl {
+class Bucket;
 class ChangeRequest;
 class RendererObserver;
 class RenderSource;
@@ -33,6 +39,7 @@ class SourceQueryOptions;
 class GlyphManager;
 class ImageManager;
 class LineAtlas;
+class RasterImageCache;
 class PatternAtlas;
 class CrossTileSymbolIndex;
 class RenderTree;
@@ -67,6 +74,9 @@ public:
     void setObserver(RendererObserver*);
 
     std::unique_ptr<RenderTree> createRenderTree(const std::shared_ptr<UpdateParameters>&, gfx::DynamicTextureAtlasPtr);
+    /// Starts the placement scheduled by the last render tree, if any, on a background thread.
+    /// Call once that render tree has been rendered and destroyed, the placement reads its buckets.
+    void startPendingPlacement();
 
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&) const;
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&) const;
@@ -161,6 +171,13 @@ private:
     bool isLoaded() const;
     bool hasTransitions(TimePoint) const;
 
+    /// Sets up a placement of the layers that need placement, started by startPendingPlacement()
+    void schedulePlacement(const std::shared_ptr<UpdateParameters>&, std::set<std::string> usedSymbolLayers);
+    /// Waits for the scheduled placement, if any, and makes it the current one.
+    /// Must be called before anything touches the layers, tiles or buckets it reads.
+    /// @return true if a placement was committed
+    bool commitPendingPlacement();
+
     RenderSource* getRenderSource(const std::string& id) const;
 
     RenderLayer* getRenderLayer(const std::string& id);
@@ -195,11 +212,14 @@ private:
 
     ZoomHistory zoomHistory;
     TransformState transformState;
+    util::TileCoverCache tileCoverCache;
+    util::FrameArena frameArena;
 
     std::shared_ptr<GlyphManager> glyphManager;
     std::shared_ptr<ImageManager> imageManager;
     std::unique_ptr<LineAtlas> lineAtlas;
     std::unique_ptr<PatternAtlas> patternAtlas;
+    std::shared_ptr<RasterImageCache> rasterImageCache;
 
     Immutable<std::vector<Immutable<style::Image::Impl>>> imageImpls;
     Immutable<std::vector<Immutable<style::Source::Impl>>> sourceImpls;
@@ -212,6 +232,21 @@ private:
     CrossTileSymbolIndex crossTileSymbolIndex;
     PlacementController placementController;
 
+    // A placement running in the background between two frames. It starts
+    // after a frame is rendered and is committed before the next one touches
+    // the layers, render tiles or buckets.
+    struct PendingPlacement {
+        Mutable<Placement> placement;
+        RenderLayerReferences layers;
+        // Placed buckets, kept alive if their tiles are laid out again meanwhile
+        std::vector<std::shared_ptr<Bucket>> buckets;
+        std::set<std::string> usedSymbolLayers;
+        // Valid once the placement is started
+        std::future<void> done;
+    };
+    std::optional<PendingPlacement> pendingPlacement;
+    std::shared_ptr<Scheduler> placementScheduler;
+
     const bool backgroundLayerAsColor;
     bool contextLost = false;
     bool placedSymbolDataCollected = false;
@@ -141,8 +141,10 @@ void RenderTile::prepare(const SourcePrepareParameters& parameters) {
     matrix::multiply(nearClippedMatrix, transform.nearClippedProjMatrix, nearClippedMatrix);
 }
 
-void RenderTile::setFeatureState(const LayerFeatureStates& states) {
-    tile.setFeatureState(states);
+void RenderTile::setFeatureState(const LayerFeatureStates& changes,
+                                 const LayerFeatureStates& states,
+                                 uint64_t version) {
+    tile.setFeatureState(changes, states, version);
 }
 
 } // namespace mbgl
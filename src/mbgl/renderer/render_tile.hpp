@@ -79,7 +79,7 @@ public:
                             const TransformState& state,
                             bool inViewportPixelUnits) const;
 
-    void setFeatureState(const LayerFeatureStates&);
+    void setFeatureState(const LayerFeatureStates& changes, const LayerFeatureStates& states, uint64_t version);
 
 private:
     Tile& tile;
@@ -1,6 +1,7 @@
 #pragma once
 #include <mbgl/gfx/drawable.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
+#include <mbgl/util/frame_arena.hpp>
 #include <mbgl/util/monotonic_timer.hpp>
 
 #include <cassert>
@@ -57,7 +58,8 @@ private:
     void updateDebugDrawables(DebugLayerGroupMap&, PaintParameters&) const override;
 };
 
-using RenderItems = std::vector<std::reference_wrapper<const RenderItem>>;
+using RenderItems = util::FrameVector<std::reference_wrapper<const RenderItem>>;
+using LayerRenderItems = util::FrameSet<LayerRenderItem>;
 
 class RenderTreeParameters {
 public:
@@ -90,7 +92,7 @@ public:
     virtual ~RenderTree() = default;
     virtual void prepare() {}
     // Render items
-    virtual const std::set<LayerRenderItem>& getLayerRenderItemMap() const noexcept = 0;
+    virtual const LayerRenderItems& getLayerRenderItemMap() const noexcept = 0;
     virtual RenderItems getLayerRenderItems() const = 0;
     virtual RenderItems getSourceRenderItems() const = 0;
     // Resources
@@ -98,16 +100,20 @@ public:
     virtual PatternAtlas& getPatternAtlas() const = 0;
     // Parameters
     const RenderTreeParameters& getParameters() const { return *parameters; }
+    // Scratch memory released when the next frame starts
+    util::FrameArena& getFrameArena() const { return frameArena; }
 
     double getElapsedTime() const { return util::MonotonicTimer::now().count() - startTime; }
 
 protected:
-    RenderTree(std::unique_ptr<RenderTreeParameters> parameters_, double startTime_)
+    RenderTree(std::unique_ptr<RenderTreeParameters> parameters_, util::FrameArena& frameArena_, double startTime_)
         : parameters(std::move(parameters_)),
+          frameArena(frameArena_),
           startTime(startTime_) {
         assert(parameters);
     }
     std::unique_ptr<RenderTreeParameters> parameters;
+    util::FrameArena& frameArena;
 
     double startTime;
 };
@@ -43,6 +43,8 @@ void Renderer::render(const std::shared_ptr<UpdateParameters>& updateParameters)
         renderTree->prepare();
         impl->render(*renderTree, updateParameters);
     }
+    // The frame is done with the buckets, a placement it scheduled can run until the next one
+    impl->orchestrator.startPendingPlacement();
 }
 
 std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenLineString& geometry,
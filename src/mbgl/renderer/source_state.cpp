@@ -97,14 +97,14 @@ void SourceFeatureState::coalesceChanges(std::vector<RenderTile>& tiles) {
     stateChanges.clear();
     deletedStates.clear();
 
-    changes.insert(currentStates.begin(), currentStates.end());
-
-    if (changes.empty()) {
-        return;
+    if (!changes.empty()) {
+        version++;
     }
 
+    // Tiles that are up to date return right away; only new or re-laid out
+    // tiles evaluate the full state.
     for (auto& tile : tiles) {
-        tile.setFeatureState(changes);
+        tile.setFeatureState(changes, currentStates, version);
     }
 }
 
@@ -28,6 +28,10 @@ private:
     LayerFeatureStates currentStates;
     LayerFeatureStates stateChanges;
     LayerFeatureStates deletedStates;
+
+    // Incremented whenever coalesceChanges() produces changes, so tiles can
+    // tell whether they saw the previous version.
+    uint64_t version = 0;
 };
 
 } // namespace mbgl
@@ -7,6 +7,7 @@
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/tile/vector_tile.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/frame_arena.hpp>
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/math.hpp>
 
@@ -102,7 +103,8 @@ public:
 
 #if MLN_UBO_CONSOLIDATION
         int i = 0;
-        std::vector<LineDrawableUnionUBO> drawableUBOVector(layerGroup.getDrawableCount());
+        util::FrameVector<LineDrawableUnionUBO> drawableUBOVector(layerGroup.getDrawableCount(),
+                                                                  parameters.frameArena);
 #endif
         visitLayerGroupDrawables(layerGroup, [&](gfx::Drawable& drawable) {
             if (!drawable.getTileID().has_value()) {
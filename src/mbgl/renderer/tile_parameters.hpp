@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <numbers>
+#include <vector>
 
 #include <mapbox/std/weak.hpp>
 
@@ -15,6 +16,11 @@ class FileSource;
 class AnnotationManager;
 class ImageManager;
 class GlyphManager;
+class RasterImageCache;
+
+namespace util {
+class TileCoverCache;
+} // namespace util
 
 namespace gfx {
 class DynamicTextureAtlas;
@@ -38,6 +44,9 @@ public:
     double tileLodPitchThreshold = (60.0 / 180.0) * std::numbers::pi;
     double tileLodZoomShift = 0;
     gfx::DynamicTextureAtlasPtr dynamicTextureAtlas;
+    std::shared_ptr<const std::vector<TransformState>> transformPath;
+    util::TileCoverCache* tileCoverCache = nullptr;
+    std::shared_ptr<RasterImageCache> rasterImageCache;
 };
 
 } // namespace mbgl
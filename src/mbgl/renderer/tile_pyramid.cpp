@@ -17,6 +17,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <span>
 
 namespace mbgl {
 
@@ -25,6 +26,10 @@ using namespace style;
 namespace {
 TileObserver nullObserver;
 const std::map<OverscaledTileID, std::unique_ptr<Tile>> emptyPrefetchedTiles;
+
+// Upper bound on the tiles requested ahead of a camera transition. Tiles of
+// the destination are always included.
+constexpr std::size_t maxPathTiles = 64;
 } // namespace
 
 TilePyramid::TilePyramid(const TaggedScheduler& threadPool_)
@@ -107,8 +112,10 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     const Duration minimumUpdateInterval = sourceImpl.getMinimumTileUpdateInterval();
     const bool isVolatile = sourceImpl.isVolatile();
 
-    std::vector<OverscaledTileID> idealTiles;
-    std::vector<OverscaledTileID> panTiles;
+    // Covers are shared with the other sources through the cache.
+    util::TileCoverCache& coverCache = parameters.tileCoverCache ? *parameters.tileCoverCache : tileCoverCache;
+    std::span<const OverscaledTileID> idealTiles;
+    std::span<const OverscaledTileID> panTiles;
 
     util::TileCoverParameters tileCoverParameters = {parameters.transformState,
                                                      parameters.tileLodMinRadius,
@@ -135,17 +142,18 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
             }
 
             if (panZoom < idealZoom) {
-                panTiles = util::tileCover(tileCoverParameters, panZoom);
+                panTiles = coverCache.get(tileCoverParameters, static_cast<uint8_t>(panZoom));
             }
         }
 
-        idealTiles = util::tileCover(tileCoverParameters, idealZoom, tileZoom);
+        idealTiles = coverCache.get(
+            tileCoverParameters, static_cast<uint8_t>(idealZoom), static_cast<uint8_t>(tileZoom));
         if (parameters.mode == MapMode::Tile && type != SourceType::Raster && type != SourceType::RasterDEM &&
             idealTiles.size() > 1) {
             mbgl::Log::Warning(mbgl::Event::General,
                                "Provided camera options returned " + std::to_string(idealTiles.size()) +
                                    " tiles, only " + util::toString(idealTiles[0]) + " is taken in Tile mode.");
-            idealTiles = {idealTiles[0]};
+            idealTiles = idealTiles.first(1);
         }
     }
 
@@ -179,10 +187,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
         tileRange = util::TileRange::fromLatLngBounds(
             *bounds, zoomRange.min, std::min(tileZoom, static_cast<int32_t>(zoomRange.max)));
     }
-    auto createTileFn = [&](const OverscaledTileID& tileID) -> Tile* {
-        if (tileRange && !tileRange->contains(tileID.canonical)) {
-            return nullptr;
-        }
+    auto addTileFn = [&](const OverscaledTileID& tileID) -> Tile* {
         std::unique_ptr<Tile> tile = cache.pop(tileID);
         if (!tile) {
             tile = createTile(tileID, observer);
@@ -192,6 +197,12 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
 
         return tiles.emplace(tileID, std::move(tile)).first->second.get();
     };
+    auto createTileFn = [&](const OverscaledTileID& tileID) -> Tile* {
+        if (tileRange && !tileRange->contains(tileID.canonical)) {
+            return nullptr;
+        }
+        return addTileFn(tileID);
+    };
 
     auto previouslyRenderedTiles = std::move(renderedTiles);
 
@@ -224,6 +235,41 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
                                  zoomRange,
                                  maxParentTileOverscaleFactor);
 
+    // Request the tiles along the path of a running camera transition with low
+    // priority, in the order the camera will reach them. They are not rendered;
+    // once they enter the viewport they are retained as ideal tiles above, which
+    // promotes their pending requests to regular priority.
+    if (parameters.mode == MapMode::Continuous && parameters.transformPath && type != SourceType::GeoJSON &&
+        type != SourceType::Annotations) {
+        if (parameters.transformPath != transformPath) {
+            transformPath = parameters.transformPath;
+            pathTiles = coverTransformPath(parameters, sourceImpl, tileSize, zoomRange, bounds);
+        }
+
+        for (const auto& tileID : pathTiles) {
+            if (retain.contains(tileID)) {
+                continue;
+            }
+            Tile* tile = getTileFn(tileID);
+            if (!tile) {
+                tile = addTileFn(tileID);
+            }
+            if (!tile) {
+                continue;
+            }
+
+            retain.emplace(tileID);
+            tile->setUpdateParameters({minimumUpdateInterval, isVolatile, Resource::Priority::Low});
+            tile->setNecessity(TileNecessity::Required);
+            if (needsRelayout) {
+                tile->setLayers(layers);
+            }
+        }
+    } else {
+        transformPath.reset();
+        pathTiles.clear();
+    }
+
     for (auto previouslyRenderedTile : previouslyRenderedTiles) {
         Tile& tile = previouslyRenderedTile.second;
         tile.markRenderedPreviously();
@@ -296,6 +342,66 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     cache.deferPendingReleases();
 }
 
+std::vector<OverscaledTileID> TilePyramid::coverTransformPath(const TileParameters& parameters,
+                                                             const style::Source::Impl& sourceImpl,
+                                                             const uint16_t tileSize,
+                                                             const Range<uint8_t> zoomRange,
+                                                             const std::optional<LatLngBounds>& bounds) const {
+    std::vector<std::vector<OverscaledTileID>> samples;
+
+    for (const TransformState& state : *parameters.transformPath) {
+        const double zoom = util::clamp<double>(
+            state.getZoom() + parameters.tileLodZoomShift, state.getMinZoom(), state.getMaxZoom());
+        const int32_t overscaledZoom = util::coveringZoomLevel(zoom, sourceImpl.type, tileSize);
+        if (overscaledZoom < zoomRange.min) {
+            continue;
+        }
+        const auto idealZoom = static_cast<uint8_t>(std::min<int32_t>(zoomRange.max, overscaledZoom));
+        const auto tileZoom = static_cast<uint8_t>(sourceImpl.type == SourceType::Raster ? idealZoom
+                                                                                          : overscaledZoom);
+
+        std::optional<util::TileRange> tileRange;
+        if (bounds) {
+            tileRange = util::TileRange::fromLatLngBounds(*bounds, zoomRange.min, idealZoom);
+        }
+
+        const util::TileCoverParameters tileCoverParameters = {
+            state, parameters.tileLodMinRadius, parameters.tileLodScale, parameters.tileLodPitchThreshold};
+
+        std::vector<OverscaledTileID> sampleTiles = util::tileCover(tileCoverParameters, idealZoom, tileZoom);
+        if (tileRange) {
+            std::erase_if(sampleTiles, [&](const OverscaledTileID& id) { return !tileRange->contains(id.canonical); });
+        }
+        samples.push_back(std::move(sampleTiles));
+    }
+
+    if (samples.empty()) {
+        return {};
+    }
+
+    // Fill the budget in arrival order, but always keep the destination.
+    std::set<OverscaledTileID> seen(samples.back().begin(), samples.back().end());
+    std::size_t budget = maxPathTiles > seen.size() ? maxPathTiles - seen.size() : 0;
+
+    std::vector<OverscaledTileID> result;
+    for (std::size_t i = 0; i + 1 < samples.size() && budget > 0; ++i) {
+        for (const auto& tileID : samples[i]) {
+            if (budget > 0 && seen.insert(tileID).second) {
+                result.push_back(tileID);
+                budget--;
+            }
+        }
+    }
+
+    std::set<OverscaledTileID> destination;
+    for (const auto& tileID : samples.back()) {
+        if (destination.insert(tileID).second) {
+            result.push_back(tileID);
+        }
+    }
+    return result;
+}
+
 void TilePyramid::handleWrapJump(float lng) {
     // On top of the regular z/x/y values, TileIDs have a `wrap` value that specify
     // which cppy of the world the tile belongs to. For example, at `lng: 10` you
@@ -319,6 +425,9 @@ void TilePyramid::handleWrapJump(float lng) {
     prevLng = lng;
 
     if (wrapDelta) {
+        // Prefetched path tiles use the previous wrap; recompute them.
+        transformPath.reset();
+
         std::map<OverscaledTileID, std::unique_ptr<Tile>> newTiles;
         std::map<UnwrappedTileID, std::reference_wrapper<Tile>> newRenderTiles;
         for (auto& tile : tiles) {
@@ -11,6 +11,7 @@
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/range.hpp>
+#include <mbgl/util/tile_cover.hpp>
 
 #include <memory>
 #include <unordered_map>
@@ -75,12 +76,27 @@ public:
 private:
     void addRenderTile(const UnwrappedTileID& tileID, Tile& tile);
 
+    // Returns the tiles covering the camera states of an animated transition,
+    // in the order the camera reaches them.
+    std::vector<OverscaledTileID> coverTransformPath(const TileParameters&,
+                                                     const style::Source::Impl&,
+                                                     uint16_t tileSize,
+                                                     Range<uint8_t> zoomRange,
+                                                     const std::optional<LatLngBounds>& bounds) const;
+
     std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
     TileCache cache;
 
     std::map<UnwrappedTileID, std::reference_wrapper<Tile>> renderedTiles; // Sorted by tile id.
     TileObserver* observer = nullptr;
 
+    // Tiles prefetched along the path of the current camera transition.
+    std::shared_ptr<const std::vector<TransformState>> transformPath;
+    std::vector<OverscaledTileID> pathTiles;
+
+    // Used when the parameters don't provide a cache shared between sources.
+    util::TileCoverCache tileCoverCache;
+
     float prevLng = 0;
 
     bool fadingTiles = false;
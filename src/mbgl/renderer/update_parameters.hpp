@@ -47,11 +47,17 @@ public:
     const bool stillImageRequest;
 
     const bool crossSourceCollisions;
+    const bool parallelPlacement;
+    const bool asyncPlacement;
 
     double tileLodMinRadius = 3;
     double tileLodScale = 1;
     double tileLodPitchThreshold = (60.0 / 180.0) * std::numbers::pi;
     double tileLodZoomShift = 0;
+
+    // Camera states an animated transition will pass through, in arrival
+    // order. Null when the camera is not animating.
+    std::shared_ptr<const std::vector<TransformState>> transformPath;
 };
 
 } // namespace mbgl
@@ -22,6 +22,7 @@ MBGL_DEFINE_ATTRIBUTE(uint16_t, 2, placed);
 MBGL_DEFINE_ATTRIBUTE(uint16_t, 3, size);
 MBGL_DEFINE_ATTRIBUTE(float, 1, offset);
 MBGL_DEFINE_ATTRIBUTE(float, 2, shift);
+MBGL_DEFINE_ATTRIBUTE(float, 1, feature_ordinal);
 
 template <typename T, std::size_t N>
 struct data {
@@ -145,10 +145,13 @@ const std::vector<UniformBlockInfo> FillShaderInfo::uniformBlocks = {
 };
 const std::vector<AttributeInfo> FillShaderInfo::attributes = {
     AttributeInfo{"a_pos", idFillPosVertexAttribute},
+    AttributeInfo{"a_feature_ordinal", idFillFeatureOrdinalVertexAttribute},
     AttributeInfo{"a_color", idFillColorVertexAttribute},
     AttributeInfo{"a_opacity", idFillOpacityVertexAttribute},
 };
-const std::vector<TextureInfo> FillShaderInfo::textures = {};
+const std::vector<TextureInfo> FillShaderInfo::textures = {
+    TextureInfo{"u_feature_state", idFillFeatureStateTexture},
+};
 
 // Fill Outline
 using FillOutlineShaderInfo = ShaderInfo<BuiltIn::FillOutlineShader, gfx::Backend::Type::OpenGL>;
@@ -160,10 +163,13 @@ const std::vector<UniformBlockInfo> FillOutlineShaderInfo::uniformBlocks = {
 };
 const std::vector<AttributeInfo> FillOutlineShaderInfo::attributes = {
     AttributeInfo{"a_pos", idFillPosVertexAttribute},
+    AttributeInfo{"a_feature_ordinal", idFillFeatureOrdinalVertexAttribute},
     AttributeInfo{"a_outline_color", idFillOutlineColorVertexAttribute},
     AttributeInfo{"a_opacity", idFillOpacityVertexAttribute},
 };
-const std::vector<TextureInfo> FillOutlineShaderInfo::textures = {};
+const std::vector<TextureInfo> FillOutlineShaderInfo::textures = {
+    TextureInfo{"u_feature_state", idFillFeatureStateTexture},
+};
 
 // Fill Pattern
 using FillPatternShaderInfo = ShaderInfo<BuiltIn::FillPatternShader, gfx::Backend::Type::OpenGL>;
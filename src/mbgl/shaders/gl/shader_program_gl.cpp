@@ -151,8 +151,8 @@ std::shared_ptr<ShaderProgramGL> ShaderProgramGL::create(
 
         SamplerLocationArray samplerLocations;
         for (const auto& textureInfo : texturesInfo) {
+            // Samplers may be compiled out by the defines of a variant, e.g. the feature state texture
             GLint location = MBGL_CHECK_ERROR(glGetUniformLocation(program, textureInfo.name.data()));
-            assert(location != -1);
             if (location != -1) {
                 samplerLocations[textureInfo.id] = location;
             }
@@ -10,24 +10,30 @@ namespace shaders {
 
 using FillShaderSource = ShaderSource<BuiltIn::FillShader, gfx::Backend::Type::Vulkan>;
 
-const std::array<AttributeInfo, 3> FillShaderSource::attributes = {
+const std::array<AttributeInfo, 4> FillShaderSource::attributes = {
     AttributeInfo{0, gfx::AttributeDataType::Short2, idFillPosVertexAttribute},
     AttributeInfo{1, gfx::AttributeDataType::Float4, idFillColorVertexAttribute},
     AttributeInfo{2, gfx::AttributeDataType::Float2, idFillOpacityVertexAttribute},
+    AttributeInfo{3, gfx::AttributeDataType::Float, idFillFeatureOrdinalVertexAttribute},
+};
+const std::array<TextureInfo, 1> FillShaderSource::textures = {
+    TextureInfo{1, idFillFeatureStateTexture},
 };
-const std::array<TextureInfo, 0> FillShaderSource::textures = {};
 
 //
 // Fill outline
 
 using FillOutlineShaderSource = ShaderSource<BuiltIn::FillOutlineShader, gfx::Backend::Type::Vulkan>;
 
-const std::array<AttributeInfo, 3> FillOutlineShaderSource::attributes = {
+const std::array<AttributeInfo, 4> FillOutlineShaderSource::attributes = {
     AttributeInfo{0, gfx::AttributeDataType::Short2, idFillPosVertexAttribute},
     AttributeInfo{1, gfx::AttributeDataType::Float4, idFillOutlineColorVertexAttribute},
     AttributeInfo{2, gfx::AttributeDataType::Float2, idFillOpacityVertexAttribute},
+    AttributeInfo{3, gfx::AttributeDataType::Float, idFillFeatureOrdinalVertexAttribute},
+};
+const std::array<TextureInfo, 1> FillOutlineShaderSource::textures = {
+    TextureInfo{1, idFillFeatureStateTexture},
 };
-const std::array<TextureInfo, 0> FillOutlineShaderSource::textures = {};
 
 //
 // Fill pattern
@@ -16,6 +16,30 @@
 
 namespace mbgl {
 
+namespace {
+
+// Disallow invalid parameter configurations.
+bool validateMetrics(const Size& sheet,
+                     const int32_t srcX,
+                     const int32_t srcY,
+                     const int32_t width,
+                     const int32_t height,
+                     const double ratio) {
+    if (width <= 0 || height <= 0 || width > 1024 || height > 1024 || ratio <= 0 || ratio > 10 || srcX < 0 ||
+        srcY < 0 || srcX >= static_cast<int32_t>(sheet.width) || srcY >= static_cast<int32_t>(sheet.height) ||
+        srcX + width > static_cast<int32_t>(sheet.width) || srcY + height > static_cast<int32_t>(sheet.height)) {
+        std::ostringstream ss;
+        ss << "Can't create image with invalid metrics: " << width << "x" << height << "@" << srcX << "," << srcY
+           << " in " << sheet.width << "x" << sheet.height << "@" << util::toString(ratio) << "x"
+           << " sprite";
+        Log::Error(Event::Sprite, ss.str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 std::unique_ptr<style::Image> createStyleImage(const std::string& id,
                                                const PremultipliedImage& image,
                                                const int32_t srcX,
@@ -29,16 +53,7 @@ std::unique_ptr<style::Image> createStyleImage(const std::string& id,
                                                const std::optional<style::ImageContent>& content,
                                                const std::optional<style::TextFit>& textFitWidth,
                                                const std::optional<style::TextFit>& textFitHeight) {
-    // Disallow invalid parameter configurations.
-    if (width <= 0 || height <= 0 || width > 1024 || height > 1024 || ratio <= 0 || ratio > 10 || srcX < 0 ||
-        srcY < 0 || srcX >= static_cast<int32_t>(image.size.width) || srcY >= static_cast<int32_t>(image.size.height) ||
-        srcX + width > static_cast<int32_t>(image.size.width) ||
-        srcY + height > static_cast<int32_t>(image.size.height)) {
-        std::ostringstream ss;
-        ss << "Can't create image with invalid metrics: " << width << "x" << height << "@" << srcX << "," << srcY
-           << " in " << image.size.width << "x" << image.size.height << "@" << util::toString(ratio) << "x"
-           << " sprite";
-        Log::Error(Event::Sprite, ss.str());
+    if (!validateMetrics(image.size, srcX, srcY, width, height, ratio)) {
         return nullptr;
     }
 
@@ -198,7 +213,8 @@ std::optional<style::TextFit> getTextFit(const JSValue& value, const char* prope
 std::vector<Immutable<style::Image::Impl>> parseSprite(const std::string& id,
                                                        const std::string& encodedImage,
                                                        const std::string& json) {
-    const PremultipliedImage raster = decodeImage(encodedImage);
+    // The images keep the decoded sheet and copy their pixels out of it when they're used
+    const auto raster = std::make_shared<const PremultipliedImage>(decodeImage(encodedImage));
 
     JSDocument doc;
     doc.Parse<0>(json.c_str());
@@ -235,21 +251,23 @@ std::vector<Immutable<style::Image::Impl>> parseSprite(const std::string& id,
             std::optional<style::TextFit> textFitWidth = getTextFit(value, "textFitWidth", name.c_str());
             std::optional<style::TextFit> textFitHeight = getTextFit(value, "textFitHeight", name.c_str());
 
-            auto image = createStyleImage(completeName,
-                                          raster,
-                                          x,
-                                          y,
-                                          width,
-                                          height,
-                                          pixelRatio,
-                                          sdf,
-                                          std::move(stretchX),
-                                          std::move(stretchY),
-                                          content,
-                                          textFitWidth,
-                                          textFitHeight);
-            if (image) {
-                images.push_back(std::move(image->baseImpl));
+            if (!validateMetrics(raster->size, x, y, width, height, pixelRatio)) {
+                continue;
+            }
+
+            try {
+                images.push_back(makeMutable<style::Image::Impl>(std::move(completeName),
+                                                                 raster,
+                                                                 Rect<uint32_t>(x, y, width, height),
+                                                                 static_cast<float>(pixelRatio),
+                                                                 sdf,
+                                                                 std::move(stretchX),
+                                                                 std::move(stretchY),
+                                                                 std::move(content),
+                                                                 textFitWidth,
+                                                                 textFitHeight));
+            } catch (const util::StyleImageException& ex) {
+                Log::Error(Event::Sprite, std::string("Can't create image with invalid metadata: ") + ex.what());
             }
         }
     }
@@ -5,6 +5,9 @@
 #include <mbgl/util/client_options.hpp>
 #include <mbgl/util/thread.hpp>
 
+#include <atomic>
+#include <vector>
+
 namespace mbgl {
 // File source for supporting .mbtiles maps.
 // can only load resource URLS that are absolute paths to local files
@@ -25,6 +28,11 @@ public:
 private:
     class Impl;
     std::unique_ptr<util::Thread<Impl>> thread; // impl
+
+    // Tiles are read in parallel, each reader with its own connections
+    class TileReader;
+    std::vector<std::unique_ptr<util::Thread<TileReader>>> tileReaders;
+    std::atomic<std::size_t> nextTileReader{0};
 };
 
 } // namespace mbgl
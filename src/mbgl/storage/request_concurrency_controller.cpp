@@ -0,0 +1,134 @@
+#include <mbgl/storage/request_concurrency_controller.hpp>
+#include <mbgl/util/url.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+
+namespace {
+
+double toMilliseconds(Duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+RequestConcurrencyController::RequestConcurrencyController()
+    : RequestConcurrencyController(Options()) {}
+
+RequestConcurrencyController::RequestConcurrencyController(Options options_)
+    : options(std::move(options_)) {
+    assert(options.minimumLimit > 0);
+    assert(options.minimumLimit <= options.maximumLimit);
+}
+
+bool RequestConcurrencyController::canActivate(const std::string& host) const {
+    return getActive(host) < getLimit(host);
+}
+
+void RequestConcurrencyController::onStarted(const std::string& host) {
+    state(host).active++;
+}
+
+void RequestConcurrencyController::onCancelled(const std::string& host) {
+    auto& hostState = state(host);
+    if (hostState.active) {
+        hostState.active--;
+    }
+}
+
+void RequestConcurrencyController::onCompleted(const std::string& host, Duration rtt, bool success) {
+    auto& hostState = state(host);
+    if (hostState.active) {
+        hostState.active--;
+    }
+
+    if (!success) {
+        hostState.limit = clamp(hostState.limit * options.backoffRatio);
+        return;
+    }
+
+    if (hostState.probeSamples) {
+        // Requests that were started before the probe still carry queuing
+        // delay; only the fastest sample of the probe counts.
+        hostState.probeRTT = std::min(hostState.probeRTT, rtt);
+        if (--hostState.probeSamples == 0) {
+            hostState.minimumRTT = hostState.probeRTT;
+        }
+        return;
+    }
+
+    if (++hostState.samples % options.minimumRTTProbeInterval == 0) {
+        // Under sustained load every sample includes queuing delay, so the
+        // unloaded RTT can only be re-learned by briefly draining the host.
+        hostState.probeSamples = static_cast<uint32_t>(hostState.limit) + 2 * minimumLimit();
+        hostState.probeRTT = Duration::max();
+    }
+    hostState.minimumRTT = std::min(hostState.minimumRTT, rtt);
+
+    const double sample = toMilliseconds(rtt);
+    if (hostState.samples == 1) {
+        hostState.smoothedRTT = sample;
+    } else {
+        hostState.smoothedRTT += options.smoothing * (sample - hostState.smoothedRTT);
+    }
+
+    const double threshold = toMilliseconds(hostState.minimumRTT) * options.latencyTolerance;
+    if (hostState.smoothedRTT <= threshold) {
+        // Latency is not inflating. Grow by roughly one request per round
+        // trip, but only when the current limit is actually being used: an
+        // underutilized host tells us nothing about its capacity.
+        if (hostState.active + 1 >= hostState.limit / 2) {
+            hostState.limit = clamp(hostState.limit + 1.0 / hostState.limit);
+        }
+    } else {
+        // Requests are queuing somewhere. Shrink proportionally to how much
+        // the latency exceeds the tolerated RTT.
+        const double gradient = std::max(0.5, threshold / hostState.smoothedRTT);
+        hostState.limit = clamp(hostState.limit * (1.0 - options.smoothing * (1.0 - gradient)));
+    }
+}
+
+uint32_t RequestConcurrencyController::getLimit(const std::string& host) const {
+    auto it = hosts.find(host);
+    if (it == hosts.end()) {
+        return static_cast<uint32_t>(clamp(options.initialLimit));
+    }
+    return it->second.probeSamples ? minimumLimit() : static_cast<uint32_t>(it->second.limit);
+}
+
+uint32_t RequestConcurrencyController::getActive(const std::string& host) const {
+    auto it = hosts.find(host);
+    return it == hosts.end() ? 0 : it->second.active;
+}
+
+void RequestConcurrencyController::setMaximumLimit(uint32_t maximumLimit) {
+    options.maximumLimit = std::max(1u, maximumLimit);
+    for (auto& entry : hosts) {
+        entry.second.limit = clamp(entry.second.limit);
+    }
+}
+
+std::string RequestConcurrencyController::hostForURL(const std::string& url) {
+    const util::URL parsed(url);
+    return url.substr(0, parsed.domain.first + parsed.domain.second);
+}
+
+RequestConcurrencyController::HostState& RequestConcurrencyController::state(const std::string& host) {
+    auto it = hosts.find(host);
+    if (it == hosts.end()) {
+        it = hosts.emplace(host, HostState{clamp(options.initialLimit)}).first;
+    }
+    return it->second;
+}
+
+uint32_t RequestConcurrencyController::minimumLimit() const {
+    return std::min(options.minimumLimit, options.maximumLimit);
+}
+
+double RequestConcurrencyController::clamp(double limit) const {
+    return std::clamp(limit, static_cast<double>(minimumLimit()), static_cast<double>(options.maximumLimit));
+}
+
+} // namespace mbgl
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace mbgl {
+
+/**
+ * Tunes the number of concurrent network requests per host from observed
+ * round-trip times.
+ *
+ * The limit follows a latency gradient: as long as the smoothed RTT stays
+ * close to the best RTT seen for a host, the limit grows additively (the link
+ * has spare throughput); once queuing inflates the RTT, the limit is scaled
+ * down by the ratio of the two. Failed requests back off multiplicatively.
+ * The result is an AIMD controller that settles near the knee of the
+ * throughput/latency curve of each host. The minimum RTT is periodically
+ * re-measured by dropping to the minimum limit for about one round trip.
+ */
+class RequestConcurrencyController {
+public:
+    struct Options {
+        uint32_t minimumLimit = 4;
+        uint32_t maximumLimit = 40;
+        uint32_t initialLimit = 8;
+
+        // How much the smoothed RTT may exceed the minimum RTT before the
+        // limit starts shrinking.
+        double latencyTolerance = 1.5;
+
+        // Multiplicative decrease applied when a request fails.
+        double backoffRatio = 0.75;
+
+        // Weight of a new sample in the exponentially smoothed RTT.
+        double smoothing = 0.2;
+
+        // The minimum RTT is re-learned after this many samples by briefly
+        // dropping to `minimumLimit`, so the controller can follow route or
+        // server load changes.
+        uint32_t minimumRTTProbeInterval = 500;
+    };
+
+    RequestConcurrencyController();
+    explicit RequestConcurrencyController(Options);
+
+    /// Returns whether another request to `host` may be started.
+    bool canActivate(const std::string& host) const;
+
+    void onStarted(const std::string& host);
+    void onCompleted(const std::string& host, Duration rtt, bool success);
+    void onCancelled(const std::string& host);
+
+    uint32_t getLimit(const std::string& host) const;
+    uint32_t getActive(const std::string& host) const;
+
+    /// Caps every per-host limit, e.g. to the global maximum number of
+    /// concurrent requests. A maximum below `Options::minimumLimit` lowers
+    /// the minimum only until the maximum is raised again.
+    void setMaximumLimit(uint32_t);
+    uint32_t getMaximumLimit() const { return options.maximumLimit; }
+
+    /// Returns the active request whose slot a regular priority request to
+    /// `host` may take, or null: the most recently started low priority
+    /// request that is at most `maximumAge` old. While `host` is at its
+    /// limit, only requests to `host` qualify. `Request` needs `resource`,
+    /// `host` and `activatedAt` members.
+    template <typename Requests>
+    auto preemptionCandidate(const Requests& active,
+                             const std::string& host,
+                             TimePoint now,
+                             Duration maximumAge) const {
+        const bool hostLimitReached = !canActivate(host);
+        std::remove_cvref_t<decltype(*std::begin(active))> candidate = nullptr;
+        for (const auto& request : active) {
+            using Priority = std::remove_cvref_t<decltype(request->resource.priority)>;
+            if (request->resource.priority != Priority::Low || now - request->activatedAt > maximumAge) {
+                continue;
+            }
+            // Preempting a request to another host only frees a global slot.
+            if (hostLimitReached && request->host != host) {
+                continue;
+            }
+            if (!candidate || request->activatedAt > candidate->activatedAt) {
+                candidate = request;
+            }
+        }
+        return candidate;
+    }
+
+    /// Extracts the key used to group requests, i.e. the scheme and authority
+    /// of the URL.
+    static std::string hostForURL(const std::string& url);
+
+private:
+    struct HostState {
+        double limit;
+        uint32_t active = 0;
+        uint32_t samples = 0;
+        Duration minimumRTT = Duration::max();
+        double smoothedRTT = 0;
+
+        // Remaining samples of a minimum RTT probe, zero when not probing.
+        uint32_t probeSamples = 0;
+        Duration probeRTT = Duration::max();
+    };
+
+    HostState& state(const std::string& host);
+    // The configured minimum, unless the maximum is set below it.
+    uint32_t minimumLimit() const;
+    double clamp(double limit) const;
+
+    Options options;
+    std::unordered_map<std::string, HostState> hosts;
+};
+
+} // namespace mbgl
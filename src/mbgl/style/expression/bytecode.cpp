@@ -0,0 +1,1196 @@
+#include <mbgl/style/expression/bytecode.hpp>
+
+#include <mbgl/math/log2.hpp>
+#include <mbgl/style/expression/assertion.hpp>
+#include <mbgl/style/expression/boolean_operator.hpp>
+#include <mbgl/style/expression/case.hpp>
+#include <mbgl/style/expression/coalesce.hpp>
+#include <mbgl/style/expression/coercion.hpp>
+#include <mbgl/style/expression/comparison.hpp>
+#include <mbgl/style/expression/compound_expression.hpp>
+#include <mbgl/style/expression/interpolate.hpp>
+#include <mbgl/style/expression/is_constant.hpp>
+#include <mbgl/style/expression/literal.hpp>
+#include <mbgl/style/expression/match.hpp>
+#include <mbgl/style/expression/step.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/bitmask_operations.hpp>
+#include <mbgl/util/interpolate.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string_view>
+
+namespace mbgl {
+namespace style {
+namespace expression {
+
+enum class Bytecode::OpCode : uint8_t {
+    LoadConstant,           // dst = constants[operand]
+    LoadZoom,               // dst = zoom
+    LoadColorRampParameter, // dst = heatmap-density / line-progress
+    GetProperty,            // dst = the value of property slot a
+    HasProperty,            // dst = property slot a is set on the feature
+    GetGeometryType,        // dst = feature geometry type
+    Fold,                   // dst = foldOperators[operand] over registers [a, a + b)
+    Binary,                 // dst = binaryOperators[operand](a, b)
+    Unary,                  // dst = unaryOperators[operand](a)
+    Not,                    // dst = !a
+    ToBoolean,              // dst = a coerced to a boolean
+    ToNumber,               // dst = a coerced to a number and jump to operand, if it can be
+    Equal,                  // dst = a == b
+    NotEqual,               // dst = a != b
+    Less,                   // dst = a < b
+    LessEqual,              // dst = a <= b
+    Greater,                // dst = a > b
+    GreaterEqual,           // dst = a >= b
+    EqualConstant,          // dst = a == constants[operand], false for arrays and objects
+    CompareConstant,        // dst = a compared as b (<, <=, >, >=) with constants[operand], false for other types
+    In,                     // dst = a is one of valueSets[operand]
+    Jump,                   // jump to operand
+    JumpIfTrue,             // jump to operand if a is true
+    JumpIfFalse,            // jump to operand if a is false
+    JumpIfNotNull,          // jump to operand if a isn't null
+    JumpIfType,             // jump to operand if the type of a is in the mask b
+    MatchString,            // jump to the branch of matchTables[operand] for a
+    MatchNumber,            // jump to the branch of matchTables[operand] for a
+    Step,                   // jump to the stop of stepTables[operand] for a
+    Interpolate,            // dst = interpolateTables[operand] at a
+    Fail,                   // give up, the expression evaluates to an error
+    Return,                 // the result is a
+};
+
+class Bytecode::Frame {
+public:
+    std::array<Register, maxRegisters> registers;
+    // Values read from the feature, registers point into the strings
+    std::array<std::optional<mbgl::Value>, maxPropertySlots> properties;
+    // Slots read so far
+    uint16_t loaded = 0;
+};
+
+static_assert(Bytecode::maxPropertySlots <= 16, "Property slots are tracked in a 16 bit mask");
+
+namespace {
+
+using Register = Bytecode::Register;
+using RegisterType = Bytecode::RegisterType;
+
+struct FoldOperator {
+    std::string_view name;
+    double initial;
+    double (*apply)(double value, double accumulated);
+};
+
+// Same initial values and argument order as the compound expressions
+const std::array<FoldOperator, 4> foldOperators{{
+    {"+", 0.0, [](double value, double sum) { return sum + value; }},
+    {"*", 1.0, [](double value, double product) { return product * value; }},
+    {"min", std::numeric_limits<double>::infinity(), [](double value, double result) { return fmin(value, result); }},
+    {"max", -std::numeric_limits<double>::infinity(), [](double value, double result) { return fmax(value, result); }},
+}};
+
+struct BinaryOperator {
+    std::string_view name;
+    double (*apply)(double, double);
+};
+
+const std::array<BinaryOperator, 4> binaryOperators{{
+    {"-", [](double a, double b) { return a - b; }},
+    {"/",
+     [](double a, double b) {
+         if (b == 0) {
+             if (a == 0) return std::numeric_limits<double>::quiet_NaN();
+             const double inf = std::numeric_limits<double>::infinity();
+             if (a > 0) return inf;
+             if (a < 0) return -inf;
+         }
+         return a / b;
+     }},
+    {"%", [](double a, double b) { return fmod(a, b); }},
+    {"^", [](double a, double b) { return pow(a, b); }},
+}};
+
+struct UnaryOperator {
+    std::string_view name;
+    double (*apply)(double);
+};
+
+const std::array<UnaryOperator, 15> unaryOperators{{
+    {"-", [](double x) { return -x; }},
+    {"sqrt", [](double x) { return sqrt(x); }},
+    {"log10", [](double x) { return log10(x); }},
+    {"ln", [](double x) { return log(x); }},
+    {"log2", [](double x) { return util::log2(x); }},
+    {"sin", [](double x) { return sin(x); }},
+    {"cos", [](double x) { return cos(x); }},
+    {"tan", [](double x) { return tan(x); }},
+    {"asin", [](double x) { return asin(x); }},
+    {"acos", [](double x) { return acos(x); }},
+    {"atan", [](double x) { return atan(x); }},
+    {"round", [](double x) { return ::round(x); }},
+    {"floor", [](double x) { return std::floor(x); }},
+    {"ceil", [](double x) { return std::ceil(x); }},
+    {"abs", [](double x) { return std::abs(x); }},
+}};
+
+template <typename Operators>
+std::optional<uint32_t> findOperator(const Operators& operators, const std::string& name) {
+    const auto it = std::find_if(
+        operators.begin(), operators.end(), [&](const auto& op) { return op.name == name; });
+    if (it == operators.end()) {
+        return std::nullopt;
+    }
+    return static_cast<uint32_t>(it - operators.begin());
+}
+
+const std::array<std::string, 4> geometryTypes{{"Unknown", "Point", "LineString", "Polygon"}};
+
+const std::string& geometryTypeName(FeatureType type) {
+    switch (type) {
+        case FeatureType::Point:
+            return geometryTypes[1];
+        case FeatureType::LineString:
+            return geometryTypes[2];
+        case FeatureType::Polygon:
+            return geometryTypes[3];
+        default:
+            return geometryTypes[0];
+    }
+}
+
+void setNull(Register& reg) {
+    reg.type = RegisterType::Null;
+}
+
+void setBoolean(Register& reg, bool value) {
+    reg.type = RegisterType::Boolean;
+    reg.boolean = value;
+}
+
+void setNumber(Register& reg, double value) {
+    reg.type = RegisterType::Number;
+    reg.number = value;
+}
+
+void setString(Register& reg, const std::string* value) {
+    reg.type = RegisterType::String;
+    reg.string = value;
+}
+
+void setColor(Register& reg, const Color& color) {
+    reg.type = RegisterType::Color;
+    reg.color[0] = color.r;
+    reg.color[1] = color.g;
+    reg.color[2] = color.b;
+    reg.color[3] = color.a;
+}
+
+Color getColor(const Register& reg) {
+    return {reg.color[0], reg.color[1], reg.color[2], reg.color[3]};
+}
+
+/// Loads a feature value the way `toExpressionValue` converts it, the register points into the value.
+void load(Register& reg, const std::optional<mbgl::Value>& value) {
+    if (!value) {
+        setNull(reg);
+        return;
+    }
+    value->match([&](const mbgl::NullValue&) { setNull(reg); },
+                 [&](const bool b) { setBoolean(reg, b); },
+                 [&](const uint64_t n) { setNumber(reg, static_cast<double>(n)); },
+                 [&](const int64_t n) { setNumber(reg, static_cast<double>(n)); },
+                 [&](const double n) { setNumber(reg, n); },
+                 [&](const std::string& s) { setString(reg, &s); },
+                 [&](const auto&) { reg.type = RegisterType::Other; });
+}
+
+/// Reads a property, or the id for a null key, the first time a slot is used in an evaluation.
+const std::optional<mbgl::Value>& fetch(const GeometryTileFeature& feature,
+                                        Bytecode::Frame& frame,
+                                        const std::string* key,
+                                        uint8_t slot) {
+    auto& property = frame.properties[slot];
+    const auto bit = static_cast<uint16_t>(1u << slot);
+    if (!(frame.loaded & bit)) {
+        if (key) {
+            property = feature.getValue(*key);
+        } else {
+            property = feature.getID().match([](const auto& id) { return mbgl::Value(id); });
+        }
+        frame.loaded |= bit;
+    }
+    return property;
+}
+
+/// @return The equality of two registers like `Value::operator==`, or nothing if it can't be decided on registers.
+std::optional<bool> equals(const Register& a, const Register& b) {
+    if (a.type != b.type) {
+        return false;
+    }
+    switch (a.type) {
+        case RegisterType::Null:
+            return true;
+        case RegisterType::Boolean:
+            return a.boolean == b.boolean;
+        case RegisterType::Number:
+            return a.number == b.number;
+        case RegisterType::String:
+            return *a.string == *b.string;
+        case RegisterType::Color:
+            return getColor(a) == getColor(b);
+        case RegisterType::Other:
+            break;
+    }
+    return std::nullopt;
+}
+
+/// @return The result of `<`, `>`, ... or nothing if the operands aren't both numbers or both strings.
+template <typename Compare>
+std::optional<bool> compare(const Register& a, const Register& b, Compare op) {
+    if (a.type == RegisterType::Number && b.type == RegisterType::Number) {
+        return op(a.number, b.number);
+    }
+    if (a.type == RegisterType::String && b.type == RegisterType::String) {
+        return op(*a.string, *b.string);
+    }
+    return std::nullopt;
+}
+
+bool toBoolean(const Register& reg) {
+    switch (reg.type) {
+        case RegisterType::Null:
+            return false;
+        case RegisterType::Boolean:
+            return reg.boolean;
+        case RegisterType::Number:
+            return static_cast<bool>(reg.number);
+        case RegisterType::String:
+            return !reg.string->empty();
+        default:
+            return true;
+    }
+}
+
+std::optional<double> toNumber(const Register& reg) {
+    switch (reg.type) {
+        case RegisterType::Null:
+            return 0.0;
+        case RegisterType::Number:
+            return reg.number;
+        case RegisterType::String:
+            try {
+                return util::stof(*reg.string);
+            } catch (...) {
+                return std::nullopt;
+            }
+        default:
+            return std::nullopt;
+    }
+}
+
+uint8_t typeMask(const type::Type& type) {
+    if (type == type::Number) return 1 << static_cast<uint8_t>(RegisterType::Number);
+    if (type == type::String) return 1 << static_cast<uint8_t>(RegisterType::String);
+    if (type == type::Boolean) return 1 << static_cast<uint8_t>(RegisterType::Boolean);
+    return 0;
+}
+
+/// Whether a subexpression can be evaluated once at compile time. The parser
+/// already folds most of them, but expressions built from legacy functions
+/// and type annotations added after parsing aren't.
+bool isFoldable(const Expression& expression) {
+    if (expression.has(Dependency::Feature | Dependency::Zoom | Dependency::Image | Dependency::Var |
+                       Dependency::Override) ||
+        expression.getType() == type::Image) {
+        return false;
+    }
+    if (expression.getKind() == Kind::CompoundExpression) {
+        const auto& compound = static_cast<const CompoundExpression&>(expression);
+        const auto op = compound.getOperator();
+        if (op == "error" || op == "accumulated" || op == "heatmap-density" || op == "line-progress") {
+            return false;
+        }
+    }
+    bool foldable = true;
+    expression.eachChild([&](const Expression& child) { foldable = foldable && isFoldable(child); });
+    return foldable;
+}
+
+} // namespace
+
+class BytecodeCompiler {
+public:
+    explicit BytecodeCompiler(Bytecode& program_)
+        : program(program_) {}
+
+    /// Emits the code that leaves the result of the expression in register `dst`,
+    /// registers above it are free to use.
+    bool compile(const Expression& expression, uint8_t dst) {
+        if (dst >= Bytecode::maxRegisters) {
+            return false;
+        }
+
+        if (expression.getKind() != Kind::Literal && isFoldable(expression)) {
+            const EvaluationResult result = expression.evaluate(EvaluationContext(nullptr));
+            if (!result) {
+                emit(OpCode::Fail);
+                return true;
+            }
+            return compileConstant(*result, dst);
+        }
+
+        switch (expression.getKind()) {
+            case Kind::Literal:
+                return compileConstant(static_cast<const Literal&>(expression).getValue(), dst);
+            case Kind::CompoundExpression:
+                return compileCompound(static_cast<const CompoundExpression&>(expression), dst);
+            case Kind::Comparison:
+                return compileComparison(expression, dst);
+            case Kind::Any:
+                return compileLogical(expression, OpCode::JumpIfTrue, false, dst);
+            case Kind::All:
+                return compileLogical(expression, OpCode::JumpIfFalse, true, dst);
+            case Kind::Case:
+                return compileCase(expression, dst);
+            case Kind::Coalesce:
+                return compileCoalesce(static_cast<const Coalesce&>(expression), dst);
+            case Kind::Assertion:
+                return compileAssertion(expression, dst);
+            case Kind::Coercion:
+                return compileCoercion(expression, dst);
+            case Kind::Match:
+                if (static_cast<const MatchBase&>(expression).hasStringLabels()) {
+                    return compileMatch(static_cast<const Match<std::string>&>(expression), OpCode::MatchString, dst);
+                }
+                return compileMatch(static_cast<const Match<int64_t>&>(expression), OpCode::MatchNumber, dst);
+            case Kind::Step:
+                return compileStep(static_cast<const Step&>(expression), dst);
+            case Kind::Interpolate:
+                return compileInterpolate(static_cast<const Interpolate&>(expression), dst);
+            default:
+                return false;
+        }
+    }
+
+private:
+    using OpCode = Bytecode::OpCode;
+
+    std::size_t emit(OpCode op, uint8_t dst = 0, uint8_t a = 0, uint8_t b = 0, uint32_t operand = 0) {
+        program.code.push_back({op, dst, a, b, operand});
+        return program.code.size() - 1;
+    }
+
+    uint32_t here() const { return static_cast<uint32_t>(program.code.size()); }
+
+    void patch(std::size_t instruction) { program.code[instruction].operand = here(); }
+
+    void patch(const std::vector<std::size_t>& instructions) {
+        for (const auto instruction : instructions) {
+            patch(instruction);
+        }
+    }
+
+    static std::vector<const Expression*> childrenOf(const Expression& expression) {
+        std::vector<const Expression*> children;
+        expression.eachChild([&](const Expression& child) { children.push_back(&child); });
+        return children;
+    }
+
+    uint32_t addString(std::string value) {
+        program.strings.push_back(std::move(value));
+        return static_cast<uint32_t>(program.strings.size() - 1);
+    }
+
+    std::optional<uint8_t> allocatePropertySlot(const std::string* key) {
+        if (program.propertyKeys.size() >= Bytecode::maxPropertySlots) {
+            return std::nullopt;
+        }
+        program.propertyKeys.push_back(key);
+        return static_cast<uint8_t>(program.propertyKeys.size() - 1);
+    }
+
+    /// @return The slot of a property, shared by all the reads of the same key.
+    std::optional<uint8_t> propertySlot(const std::string& key) {
+        if (const auto it = propertySlots.find(key); it != propertySlots.end()) {
+            return it->second;
+        }
+        const auto slot = allocatePropertySlot(&program.strings[addString(key)]);
+        if (slot) {
+            propertySlots.emplace(key, *slot);
+        }
+        return slot;
+    }
+
+    std::optional<uint8_t> idPropertySlot() {
+        if (!idSlot) {
+            idSlot = allocatePropertySlot(nullptr);
+        }
+        return idSlot;
+    }
+
+    std::optional<Register> toRegister(const Value& value) {
+        Register reg;
+        const bool supported = value.match(
+            [&](const NullValue&) {
+                setNull(reg);
+                return true;
+            },
+            [&](const bool b) {
+                setBoolean(reg, b);
+                return true;
+            },
+            [&](const double n) {
+                setNumber(reg, n);
+                return true;
+            },
+            [&](const std::string& s) {
+                setString(reg, &program.strings[addString(s)]);
+                return true;
+            },
+            [&](const Color& color) {
+                setColor(reg, color);
+                return true;
+            },
+            [&](const auto&) { return false; });
+        return supported ? std::optional<Register>(reg) : std::nullopt;
+    }
+
+    bool compileConstant(const Value& value, uint8_t dst) {
+        const auto reg = toRegister(value);
+        if (!reg) {
+            return false;
+        }
+        program.constants.push_back(*reg);
+        emit(OpCode::LoadConstant, dst, 0, 0, static_cast<uint32_t>(program.constants.size() - 1));
+        return true;
+    }
+
+    /// Compiles the expressions into consecutive registers starting at `first`.
+    bool compileOperands(const std::vector<const Expression*>& operands, uint8_t first) {
+        if (first + operands.size() > Bytecode::maxRegisters) {
+            return false;
+        }
+        for (std::size_t i = 0; i < operands.size(); ++i) {
+            if (!compile(*operands[i], static_cast<uint8_t>(first + i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @return The key of a `get` or `has` on the feature, if it's constant.
+    static std::optional<std::string> constantKey(const std::vector<const Expression*>& args) {
+        if (args.size() != 1 || args[0]->getKind() != Kind::Literal) {
+            return std::nullopt;
+        }
+        const auto& key = static_cast<const Literal*>(args[0])->getValue();
+        return key.is<std::string>() ? key.get<std::string>() : std::optional<std::string>();
+    }
+
+    bool compileCompound(const CompoundExpression& expression, uint8_t dst) {
+        const std::string op = expression.getOperator();
+        const std::optional<std::size_t> parameterCount = expression.getParameterCount();
+        const auto args = childrenOf(expression);
+
+        if (op == "zoom") {
+            emit(OpCode::LoadZoom, dst);
+            return true;
+        }
+        if (op == "heatmap-density" || op == "line-progress") {
+            emit(OpCode::LoadColorRampParameter, dst);
+            return true;
+        }
+        if (op == "geometry-type") {
+            emit(OpCode::GetGeometryType, dst);
+            return true;
+        }
+        if (op == "id") {
+            const auto slot = idPropertySlot();
+            if (!slot) return false;
+            emit(OpCode::GetProperty, dst, *slot);
+            return true;
+        }
+        if ((op == "get" || op == "has") && parameterCount == 1u) {
+            // Only the forms reading the feature, with a constant key
+            const auto key = constantKey(args);
+            if (!key) return false;
+            const auto slot = propertySlot(*key);
+            if (!slot) return false;
+            emit(op == "has" ? OpCode::HasProperty : OpCode::GetProperty, dst, *slot);
+            return true;
+        }
+        if (op.starts_with("filter-")) {
+            return compileLegacyFilter(op, args, dst);
+        }
+        if (op == "!" && args.size() == 1) {
+            if (!compile(*args[0], dst)) return false;
+            emit(OpCode::Not, dst, dst);
+            return true;
+        }
+        if (!parameterCount) {
+            const auto index = findOperator(foldOperators, op);
+            if (!index || args.size() > std::numeric_limits<uint8_t>::max() || !compileOperands(args, dst)) {
+                return false;
+            }
+            emit(OpCode::Fold, dst, dst, static_cast<uint8_t>(args.size()), *index);
+            return true;
+        }
+        if (*parameterCount == 2 && args.size() == 2) {
+            const auto index = findOperator(binaryOperators, op);
+            if (!index || !compileOperands(args, dst)) return false;
+            emit(OpCode::Binary, dst, dst, static_cast<uint8_t>(dst + 1), *index);
+            return true;
+        }
+        if (*parameterCount == 1 && args.size() == 1) {
+            const auto index = findOperator(unaryOperators, op);
+            if (!index || !compile(*args[0], dst)) return false;
+            emit(OpCode::Unary, dst, dst, 0, *index);
+            return true;
+        }
+        return false;
+    }
+
+    /// The `filter-*` operators that legacy filters are converted to, all with
+    /// literal arguments. A property that is missing or of another type than
+    /// the value matches nothing.
+    bool compileLegacyFilter(const std::string& op, const std::vector<const Expression*>& args, uint8_t dst) {
+        std::vector<Value> values;
+        for (const auto* arg : args) {
+            if (arg->getKind() != Kind::Literal) return false;
+            values.push_back(static_cast<const Literal*>(arg)->getValue());
+        }
+
+        if (op == "filter-has") {
+            if (values.size() != 1 || !values[0].is<std::string>()) return false;
+            const auto slot = propertySlot(values[0].get<std::string>());
+            if (!slot) return false;
+            emit(OpCode::HasProperty, dst, *slot);
+            return true;
+        }
+        if (op == "filter-has-id") {
+            // The id slot is always set, to null for features without an id
+            const auto slot = idPropertySlot();
+            if (!slot) return false;
+            program.constants.push_back(*toRegister(Null));
+            emit(OpCode::GetProperty, dst, *slot);
+            emit(OpCode::EqualConstant, dst, dst, 0, static_cast<uint32_t>(program.constants.size() - 1));
+            emit(OpCode::Not, dst, dst);
+            return true;
+        }
+
+        // The subject of the filter, then the comparison
+        std::string_view comparison = std::string_view(op).substr(std::string_view("filter-").size());
+        std::optional<uint8_t> slot;
+        bool missingProperty = false;
+        if (comparison.starts_with("type-")) {
+            comparison.remove_prefix(std::string_view("type-").size());
+        } else if (comparison.starts_with("id-")) {
+            comparison.remove_prefix(std::string_view("id-").size());
+            slot = idPropertySlot();
+            if (!slot) return false;
+        } else {
+            if (values.empty() || !values[0].is<std::string>()) return false;
+            slot = propertySlot(values[0].get<std::string>());
+            if (!slot) return false;
+            values.erase(values.begin());
+            missingProperty = true;
+        }
+
+        std::optional<std::size_t> missing;
+        auto loadSubject = [&](bool matchesNull) {
+            // A missing property loads as null, only checked when null could match
+            if (missingProperty && matchesNull) {
+                emit(OpCode::HasProperty, dst, *slot);
+                missing = emit(OpCode::JumpIfFalse, dst, dst);
+            }
+            if (slot) {
+                emit(OpCode::GetProperty, dst, *slot);
+            } else {
+                emit(OpCode::GetGeometryType, dst);
+            }
+        };
+
+        if (comparison == "in") {
+            Bytecode::ValueSet set;
+            for (const auto& value : values) {
+                if (value.is<NullValue>()) {
+                    set.null = true;
+                } else if (value.is<bool>()) {
+                    (value.get<bool>() ? set.trueValue : set.falseValue) = true;
+                } else if (value.is<double>()) {
+                    set.numbers.insert(value.get<double>());
+                } else if (value.is<std::string>()) {
+                    set.strings.insert(value.get<std::string>());
+                } else {
+                    return false;
+                }
+            }
+            loadSubject(set.null);
+            program.valueSets.push_back(std::move(set));
+            emit(OpCode::In, dst, dst, 0, static_cast<uint32_t>(program.valueSets.size() - 1));
+        } else {
+            static const std::array<std::string_view, 4> comparisons{{"<", "<=", ">", ">="}};
+            const auto it = std::find(comparisons.begin(), comparisons.end(), comparison);
+            if (values.size() != 1 || (comparison != "==" && it == comparisons.end())) return false;
+
+            const auto constant = toRegister(values[0]);
+            if (!constant || constant->type == RegisterType::Color) return false;
+            program.constants.push_back(*constant);
+            const auto constantIndex = static_cast<uint32_t>(program.constants.size() - 1);
+
+            if (comparison == "==") {
+                loadSubject(constant->type == RegisterType::Null);
+                emit(OpCode::EqualConstant, dst, dst, 0, constantIndex);
+            } else {
+                loadSubject(false);
+                emit(OpCode::CompareConstant,
+                     dst,
+                     dst,
+                     static_cast<uint8_t>(it - comparisons.begin()),
+                     constantIndex);
+            }
+        }
+        if (missing) {
+            patch(*missing);
+        }
+        return true;
+    }
+
+    bool compileComparison(const Expression& expression, uint8_t dst) {
+        const auto args = childrenOf(expression);
+        // Three operands are a collator comparison
+        if (args.size() != 2) {
+            return false;
+        }
+
+        static const std::array<std::pair<std::string_view, OpCode>, 6> comparisons{{
+            {"==", OpCode::Equal},
+            {"!=", OpCode::NotEqual},
+            {"<", OpCode::Less},
+            {"<=", OpCode::LessEqual},
+            {">", OpCode::Greater},
+            {">=", OpCode::GreaterEqual},
+        }};
+        const std::string op = expression.getOperator();
+        const auto it = std::find_if(
+            comparisons.begin(), comparisons.end(), [&](const auto& comparison) { return comparison.first == op; });
+        if (it == comparisons.end() || !compileOperands(args, dst)) {
+            return false;
+        }
+        emit(it->second, dst, dst, static_cast<uint8_t>(dst + 1));
+        return true;
+    }
+
+    /// `any` and `all`, stopping at the first operand that decides the result.
+    bool compileLogical(const Expression& expression, OpCode jump, bool empty, uint8_t dst) {
+        const auto args = childrenOf(expression);
+        if (args.empty()) {
+            return compileConstant(empty, dst);
+        }
+        std::vector<std::size_t> exits;
+        for (const auto* arg : args) {
+            if (!compile(*arg, dst)) return false;
+            exits.push_back(emit(jump, dst, dst));
+        }
+        patch(exits);
+        return true;
+    }
+
+    bool compileCase(const Expression& expression, uint8_t dst) {
+        // Conditions and results in turn, then the fallback
+        const auto args = childrenOf(expression);
+        std::vector<std::size_t> exits;
+        for (std::size_t i = 0; i + 1 < args.size(); i += 2) {
+            if (!compile(*args[i], dst)) return false;
+            const auto next = emit(OpCode::JumpIfFalse, dst, dst);
+            if (!compile(*args[i + 1], dst)) return false;
+            exits.push_back(emit(OpCode::Jump));
+            patch(next);
+        }
+        if (!compile(*args.back(), dst)) return false;
+        patch(exits);
+        return true;
+    }
+
+    bool compileCoalesce(const Coalesce& expression, uint8_t dst) {
+        if (expression.getType() == type::Image || expression.getLength() == 0) {
+            return false;
+        }
+        std::vector<std::size_t> exits;
+        for (std::size_t i = 0; i < expression.getLength(); ++i) {
+            if (!compile(*expression.getChild(i), dst)) return false;
+            if (i + 1 < expression.getLength()) {
+                exits.push_back(emit(OpCode::JumpIfNotNull, dst, dst));
+            }
+        }
+        patch(exits);
+        return true;
+    }
+
+    bool compileAssertion(const Expression& expression, uint8_t dst) {
+        const uint8_t mask = typeMask(expression.getType());
+        if (!mask) {
+            return false;
+        }
+        std::vector<std::size_t> exits;
+        for (const auto* input : childrenOf(expression)) {
+            if (!compile(*input, dst)) return false;
+            exits.push_back(emit(OpCode::JumpIfType, dst, dst, mask));
+        }
+        emit(OpCode::Fail);
+        patch(exits);
+        return true;
+    }
+
+    bool compileCoercion(const Expression& expression, uint8_t dst) {
+        const auto inputs = childrenOf(expression);
+        if (inputs.empty()) {
+            return false;
+        }
+        if (expression.getType() == type::Boolean) {
+            // Coercing to a boolean never fails, so only the first input matters
+            if (!compile(*inputs[0], dst)) return false;
+            emit(OpCode::ToBoolean, dst, dst);
+            return true;
+        }
+        if (expression.getType() == type::Number) {
+            std::vector<std::size_t> exits;
+            for (const auto* input : inputs) {
+                if (!compile(*input, dst)) return false;
+                exits.push_back(emit(OpCode::ToNumber, dst, dst));
+            }
+            emit(OpCode::Fail);
+            patch(exits);
+            return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    bool compileMatch(const Match<T>& expression, OpCode op, uint8_t dst) {
+        if (!compile(*expression.getInput(), dst)) return false;
+
+        const auto tableIndex = static_cast<uint32_t>(program.matchTables.size());
+        program.matchTables.emplace_back();
+        emit(op, dst, dst, 0, tableIndex);
+
+        // Labels sharing an output share its code
+        mbgl::unordered_map<const Expression*, uint32_t> targets;
+        std::vector<std::size_t> exits;
+        for (const auto& [label, output] : expression.getBranches()) {
+            auto it = targets.find(output.get());
+            if (it == targets.end()) {
+                it = targets.emplace(output.get(), here()).first;
+                if (!compile(*output, dst)) return false;
+                exits.push_back(emit(OpCode::Jump));
+            }
+            if constexpr (std::is_same_v<T, std::string>) {
+                program.matchTables[tableIndex].strings.emplace(label, it->second);
+            } else {
+                program.matchTables[tableIndex].numbers.emplace(label, it->second);
+            }
+        }
+
+        program.matchTables[tableIndex].otherwise = here();
+        if (!compile(*expression.getOtherwise(), dst)) return false;
+        patch(exits);
+        return true;
+    }
+
+    bool compileStep(const Step& expression, uint8_t dst) {
+        if (expression.getStopCount() == 0 || !compile(*expression.getInput(), dst)) {
+            return false;
+        }
+
+        const auto tableIndex = static_cast<uint32_t>(program.stepTables.size());
+        program.stepTables.emplace_back();
+        emit(OpCode::Step, dst, dst, 0, tableIndex);
+
+        bool compiled = true;
+        std::vector<std::size_t> exits;
+        expression.eachStop([&](double input, const Expression& output) {
+            if (!compiled) return;
+            program.stepTables[tableIndex].inputs.push_back(input);
+            program.stepTables[tableIndex].targets.push_back(here());
+            compiled = compile(output, dst);
+            exits.push_back(emit(OpCode::Jump));
+        });
+        patch(exits);
+        return compiled;
+    }
+
+    /// Only curves with constant numbers or colors at the stops, the common case
+    /// for zoom and data driven properties.
+    bool compileInterpolate(const Interpolate& expression, uint8_t dst) {
+        const auto& resultType = expression.getType();
+        const auto outputType = resultType == type::Number  ? RegisterType::Number
+                                : resultType == type::Color ? RegisterType::Color
+                                                            : RegisterType::Other;
+        if (outputType == RegisterType::Other || expression.getStopCount() == 0) {
+            return false;
+        }
+
+        Bytecode::InterpolateTable table{expression.getInterpolator(), {}, {}};
+        bool constant = true;
+        expression.eachStop([&](double input, const Expression& output) {
+            if (!constant) return;
+            std::optional<Register> reg;
+            if (output.getKind() == Kind::Literal) {
+                reg = toRegister(static_cast<const Literal&>(output).getValue());
+            } else if (isFoldable(output)) {
+                if (const auto result = output.evaluate(EvaluationContext(nullptr))) {
+                    reg = toRegister(*result);
+                }
+            }
+            constant = reg && reg->type == outputType;
+            if (constant) {
+                table.inputs.push_back(input);
+                table.outputs.push_back(*reg);
+            }
+        });
+        if (!constant || !compile(*expression.getInput(), dst)) {
+            return false;
+        }
+
+        program.interpolateTables.push_back(std::move(table));
+        emit(OpCode::Interpolate, dst, dst, 0, static_cast<uint32_t>(program.interpolateTables.size() - 1));
+        return true;
+    }
+
+    Bytecode& program;
+    mbgl::unordered_map<std::string, uint8_t> propertySlots;
+    std::optional<uint8_t> idSlot;
+};
+
+std::shared_ptr<const Bytecode> Bytecode::compile(const Expression& expression) {
+    auto program = std::make_shared<Bytecode>();
+    BytecodeCompiler compiler(*program);
+    if (!compiler.compile(expression, 0)) {
+        return nullptr;
+    }
+    program->code.push_back({OpCode::Return, 0, 0, 0, 0});
+    return program;
+}
+
+const Bytecode::Register* Bytecode::run(const EvaluationContext& context, Frame& frame) const {
+    auto& r = frame.registers;
+    const Instruction* pc = code.data();
+
+    while (true) {
+        const Instruction& in = *pc++;
+        Register& dst = r[in.dst];
+        const Register& a = r[in.a];
+
+        switch (in.op) {
+            case OpCode::LoadConstant:
+                dst = constants[in.operand];
+                break;
+
+            case OpCode::LoadZoom:
+                if (!context.zoom) return nullptr;
+                setNumber(dst, *context.zoom);
+                break;
+
+            case OpCode::LoadColorRampParameter:
+                if (!context.colorRampParameter) return nullptr;
+                setNumber(dst, *context.colorRampParameter);
+                break;
+
+            case OpCode::GetProperty:
+                if (!context.feature) return nullptr;
+                load(dst, fetch(*context.feature, frame, propertyKeys[in.a], in.a));
+                break;
+
+            case OpCode::HasProperty:
+                if (!context.feature) return nullptr;
+                setBoolean(dst, fetch(*context.feature, frame, propertyKeys[in.a], in.a).has_value());
+                break;
+
+            case OpCode::GetGeometryType:
+                if (!context.feature) return nullptr;
+                setString(dst, &geometryTypeName(context.feature->getType()));
+                break;
+
+            case OpCode::Fold: {
+                const auto& op = foldOperators[in.operand];
+                double result = op.initial;
+                for (uint8_t i = 0; i < in.b; ++i) {
+                    const Register& arg = r[in.a + i];
+                    if (arg.type != RegisterType::Number) return nullptr;
+                    result = op.apply(arg.number, result);
+                }
+                setNumber(dst, result);
+                break;
+            }
+
+            case OpCode::Binary: {
+                const Register& b = r[in.b];
+                if (a.type != RegisterType::Number || b.type != RegisterType::Number) return nullptr;
+                setNumber(dst, binaryOperators[in.operand].apply(a.number, b.number));
+                break;
+            }
+
+            case OpCode::Unary:
+                if (a.type != RegisterType::Number) return nullptr;
+                setNumber(dst, unaryOperators[in.operand].apply(a.number));
+                break;
+
+            case OpCode::Not:
+                if (a.type != RegisterType::Boolean) return nullptr;
+                setBoolean(dst, !a.boolean);
+                break;
+
+            case OpCode::ToBoolean:
+                setBoolean(dst, toBoolean(a));
+                break;
+
+            case OpCode::ToNumber:
+                if (const auto number = toNumber(a)) {
+                    setNumber(dst, *number);
+                    pc = code.data() + in.operand;
+                }
+                break;
+
+            case OpCode::Equal:
+            case OpCode::NotEqual: {
+                const std::optional<bool> equal = equals(a, r[in.b]);
+                // Arrays and objects from the feature would need to be compared as values
+                if (!equal) return nullptr;
+                setBoolean(dst, in.op == OpCode::Equal ? *equal : !*equal);
+                break;
+            }
+
+            case OpCode::Less:
+            case OpCode::LessEqual:
+            case OpCode::Greater:
+            case OpCode::GreaterEqual: {
+                const Register& b = r[in.b];
+                std::optional<bool> result;
+                switch (in.op) {
+                    case OpCode::Less:
+                        result = compare(a, b, std::less<>());
+                        break;
+                    case OpCode::LessEqual:
+                        result = compare(a, b, std::less_equal<>());
+                        break;
+                    case OpCode::Greater:
+                        result = compare(a, b, std::greater<>());
+                        break;
+                    default:
+                        result = compare(a, b, std::greater_equal<>());
+                        break;
+                }
+                if (!result) return nullptr;
+                setBoolean(dst, *result);
+                break;
+            }
+
+            case OpCode::EqualConstant:
+                // The constants are never arrays or objects, so the registers decide
+                setBoolean(dst, equals(a, constants[in.operand]).value_or(false));
+                break;
+
+            case OpCode::CompareConstant: {
+                const Register& b = constants[in.operand];
+                std::optional<bool> result;
+                switch (in.b) {
+                    case 0:
+                        result = compare(a, b, std::less<>());
+                        break;
+                    case 1:
+                        result = compare(a, b, std::less_equal<>());
+                        break;
+                    case 2:
+                        result = compare(a, b, std::greater<>());
+                        break;
+                    default:
+                        result = compare(a, b, std::greater_equal<>());
+                        break;
+                }
+                setBoolean(dst, result.value_or(false));
+                break;
+            }
+
+            case OpCode::In: {
+                const auto& set = valueSets[in.operand];
+                bool found = false;
+                switch (a.type) {
+                    case RegisterType::Null:
+                        found = set.null;
+                        break;
+                    case RegisterType::Boolean:
+                        found = a.boolean ? set.trueValue : set.falseValue;
+                        break;
+                    case RegisterType::Number:
+                        found = set.numbers.find(a.number) != set.numbers.end();
+                        break;
+                    case RegisterType::String:
+                        found = set.strings.find(*a.string) != set.strings.end();
+                        break;
+                    default:
+                        break;
+                }
+                setBoolean(dst, found);
+                break;
+            }
+
+            case OpCode::Jump:
+                pc = code.data() + in.operand;
+                break;
+
+            case OpCode::JumpIfTrue:
+            case OpCode::JumpIfFalse:
+                if (a.type != RegisterType::Boolean) return nullptr;
+                if (a.boolean == (in.op == OpCode::JumpIfTrue)) {
+                    pc = code.data() + in.operand;
+                }
+                break;
+
+            case OpCode::JumpIfNotNull:
+                if (a.type != RegisterType::Null) {
+                    pc = code.data() + in.operand;
+                }
+                break;
+
+            case OpCode::JumpIfType:
+                if (in.b & (1 << static_cast<uint8_t>(a.type))) {
+                    pc = code.data() + in.operand;
+                }
+                break;
+
+            case OpCode::MatchString: {
+                const auto& table = matchTables[in.operand];
+                uint32_t target = table.otherwise;
+                if (a.type == RegisterType::String) {
+                    if (const auto it = table.strings.find(*a.string); it != table.strings.end()) {
+                        target = it->second;
+                    }
+                }
+                pc = code.data() + target;
+                break;
+            }
+
+            case OpCode::MatchNumber: {
+                const auto& table = matchTables[in.operand];
+                uint32_t target = table.otherwise;
+                if (a.type == RegisterType::Number) {
+                    const auto rounded = static_cast<int64_t>(std::floor(a.number));
+                    if (a.number == rounded) {
+                        if (const auto it = table.numbers.find(rounded); it != table.numbers.end()) {
+                            target = it->second;
+                        }
+                    }
+                }
+                pc = code.data() + target;
+                break;
+            }
+
+            case OpCode::Step: {
+                if (a.type != RegisterType::Number) return nullptr;
+                const auto x = static_cast<float>(a.number);
+                if (std::isnan(x)) return nullptr;
+                const auto& table = stepTables[in.operand];
+                const auto it = std::upper_bound(table.inputs.begin(), table.inputs.end(), x);
+                const auto index = static_cast<std::size_t>(it - table.inputs.begin());
+                pc = code.data() + table.targets[index == 0 ? 0 : index - 1];
+                break;
+            }
+
+            case OpCode::Interpolate: {
+                if (a.type != RegisterType::Number) return nullptr;
+                const auto x = static_cast<float>(a.number);
+                if (std::isnan(x)) return nullptr;
+                const auto& table = interpolateTables[in.operand];
+                const auto it = std::upper_bound(table.inputs.begin(), table.inputs.end(), x);
+                if (it == table.inputs.end()) {
+                    dst = table.outputs.back();
+                } else if (it == table.inputs.begin()) {
+                    dst = table.outputs.front();
+                } else {
+                    const auto upper = static_cast<std::size_t>(it - table.inputs.begin());
+                    const double t = table.interpolator.match([&](const auto& interpolator) {
+                        return interpolator.interpolationFactor({table.inputs[upper - 1], table.inputs[upper]}, x);
+                    });
+                    const Register& lowerOutput = table.outputs[upper - 1];
+                    const Register& upperOutput = table.outputs[upper];
+                    if (t == 0.0) {
+                        dst = lowerOutput;
+                    } else if (t == 1.0) {
+                        dst = upperOutput;
+                    } else if (lowerOutput.type == RegisterType::Number) {
+                        setNumber(dst, util::interpolate(lowerOutput.number, upperOutput.number, t));
+                    } else {
+                        setColor(dst, util::interpolate(getColor(lowerOutput), getColor(upperOutput), t));
+                    }
+                }
+                break;
+            }
+
+            case OpCode::Fail:
+                return nullptr;
+
+            case OpCode::Return:
+                return &a;
+        }
+    }
+}
+
+template <typename T>
+std::optional<T> Bytecode::evaluate(const EvaluationContext& context) const {
+    static_assert(isEvaluatedType<T>);
+    Frame frame;
+    const Register* result = run(context, frame);
+    if (!result) {
+        return std::nullopt;
+    }
+
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        if (result->type == RegisterType::Number) return static_cast<T>(result->number);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        if (result->type == RegisterType::Boolean) return result->boolean;
+    } else if constexpr (std::is_same_v<T, Color>) {
+        if (result->type == RegisterType::Color) return getColor(*result);
+    } else {
+        if (result->type == RegisterType::String) return *result->string;
+    }
+    return std::nullopt;
+}
+
+template std::optional<float> Bytecode::evaluate<float>(const EvaluationContext&) const;
+template std::optional<double> Bytecode::evaluate<double>(const EvaluationContext&) const;
+template std::optional<bool> Bytecode::evaluate<bool>(const EvaluationContext&) const;
+template std::optional<Color> Bytecode::evaluate<Color>(const EvaluationContext&) const;
+template std::optional<std::string> Bytecode::evaluate<std::string>(const EvaluationContext&) const;
+
+std::optional<Value> Bytecode::evaluate(const EvaluationContext& context) const {
+    Frame frame;
+    const Register* result = run(context, frame);
+    if (!result) {
+        return std::nullopt;
+    }
+
+    switch (result->type) {
+        case RegisterType::Null:
+            return Value(Null);
+        case RegisterType::Boolean:
+            return Value(result->boolean);
+        case RegisterType::Number:
+            return Value(result->number);
+        case RegisterType::String:
+            return Value(*result->string);
+        case RegisterType::Color:
+            return Value(getColor(*result));
+        case RegisterType::Other:
+            break;
+    }
+    return std::nullopt;
+}
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
@@ -7,6 +7,12 @@ namespace style {
 bool Filter::operator()(const expression::EvaluationContext &context) const {
     if (!this->expression) return true;
 
+    if (bytecode) {
+        if (const std::optional<bool> result = bytecode->evaluate<bool>(context)) {
+            return *result;
+        }
+    }
+
     const expression::EvaluationResult result = (*this->expression)->evaluate(context);
     if (result) {
         const std::optional<bool> typed = expression::fromExpressionValue<bool>(*result);
@@ -31,7 +31,7 @@ std::string Image::getID() const {
 Image::Image(const Image&) = default;
 
 const PremultipliedImage& Image::getImage() const {
-    return baseImpl->image;
+    return baseImpl->getImage();
 }
 
 bool Image::isSdf() const {
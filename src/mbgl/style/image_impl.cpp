@@ -1,6 +1,8 @@
 #include <mbgl/style/image_impl.hpp>
 #include <mbgl/util/exception.hpp>
 
+#include <cassert>
+
 namespace mbgl {
 namespace style {
 
@@ -42,23 +44,65 @@ Image::Impl::Impl(std::string id_,
                   std::optional<TextFit> textFitWidth_,
                   std::optional<TextFit> textFitHeight_)
     : id(std::move(id_)),
-      image(std::move(image_)),
       pixelRatio(pixelRatio_),
       sdf(sdf_),
       stretchX(std::move(stretchX_)),
       stretchY(std::move(stretchY_)),
       content(std::move(content_)),
       textFitWidth(std::move(textFitWidth_)),
-      textFitHeight(std::move(textFitHeight_)) {
-    if (!image.valid()) {
+      textFitHeight(std::move(textFitHeight_)),
+      size(image_.valid() ? image_.size : Size()),
+      image(std::move(image_)) {
+    validate();
+}
+
+Image::Impl::Impl(std::string id_,
+                  std::shared_ptr<const PremultipliedImage> sheet_,
+                  const Rect<uint32_t>& rect,
+                  const float pixelRatio_,
+                  bool sdf_,
+                  ImageStretches stretchX_,
+                  ImageStretches stretchY_,
+                  std::optional<ImageContent> content_,
+                  std::optional<TextFit> textFitWidth_,
+                  std::optional<TextFit> textFitHeight_)
+    : id(std::move(id_)),
+      pixelRatio(pixelRatio_),
+      sdf(sdf_),
+      stretchX(std::move(stretchX_)),
+      stretchY(std::move(stretchY_)),
+      content(std::move(content_)),
+      textFitWidth(std::move(textFitWidth_)),
+      textFitHeight(std::move(textFitHeight_)),
+      size(rect.w, rect.h),
+      sheet(std::move(sheet_)),
+      sheetRect(rect) {
+    assert(sheet && rect.x + rect.w <= sheet->size.width && rect.y + rect.h <= sheet->size.height);
+    validate();
+}
+
+const PremultipliedImage& Image::Impl::getImage() const {
+    std::call_once(extracted, [this] {
+        if (sheet) {
+            image = PremultipliedImage(size);
+            PremultipliedImage::copy(*sheet, image, {sheetRect.x, sheetRect.y}, {0, 0}, size);
+            // The sheet is released with its last unextracted image
+            sheet.reset();
+        }
+    });
+    return image;
+}
+
+void Image::Impl::validate() const {
+    if (size.isEmpty()) {
         throw util::StyleImageException("dimensions may not be zero");
     } else if (pixelRatio <= 0) {
         throw util::StyleImageException("pixelRatio may not be <= 0");
-    } else if (!validateStretch(stretchX, static_cast<float>(image.size.width))) {
+    } else if (!validateStretch(stretchX, static_cast<float>(size.width))) {
         throw util::StyleImageException("stretchX is out of bounds or overlapping");
-    } else if (!validateStretch(stretchY, static_cast<float>(image.size.height))) {
+    } else if (!validateStretch(stretchY, static_cast<float>(size.height))) {
         throw util::StyleImageException("stretchY is out of bounds or overlapping");
-    } else if (content && !validateContent(*content, image.size)) {
+    } else if (content && !validateContent(*content, size)) {
         throw util::StyleImageException("content area is invalid");
     }
 }
@@ -4,6 +4,9 @@
 #include <mbgl/util/containers.hpp>
 #include <mbgl/util/rect.hpp>
 
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <optional>
 #include <array>
@@ -23,9 +26,27 @@ public:
          std::optional<TextFit> textFitWidth = std::nullopt,
          std::optional<TextFit> textFitHeight = std::nullopt);
 
-    const std::string id;
+    // An image in a sprite sheet, the pixels are copied out of the sheet the
+    // first time they're needed.
+    Impl(std::string id,
+         std::shared_ptr<const PremultipliedImage> sheet,
+         const Rect<uint32_t>& rect,
+         float pixelRatio,
+         bool sdf = false,
+         ImageStretches stretchX = {},
+         ImageStretches stretchY = {},
+         std::optional<ImageContent> content = std::nullopt,
+         std::optional<TextFit> textFitWidth = std::nullopt,
+         std::optional<TextFit> textFitHeight = std::nullopt);
 
-    PremultipliedImage image;
+    Impl(const Impl&) = delete;
+    Impl& operator=(const Impl&) = delete;
+
+    const PremultipliedImage& getImage() const;
+    Size getSize() const { return size; }
+    std::size_t bytes() const { return size.area() * PremultipliedImage::channels; }
+
+    const std::string id;
 
     // Pixel ratio of the sprite image.
     const float pixelRatio;
@@ -46,6 +67,16 @@ public:
     // If `icon-text-fit` is used in a layer with this image, this option defines constraints on the vertical scaling of
     // the image.
     const std::optional<TextFit> textFitHeight;
+
+private:
+    void validate() const;
+
+    const Size size;
+    mutable PremultipliedImage image;
+    // The sheet and the location of the image, until it's extracted
+    mutable std::shared_ptr<const PremultipliedImage> sheet;
+    const Rect<uint32_t> sheetRect;
+    mutable std::once_flag extracted;
 };
 
 } // namespace style
@@ -59,6 +90,8 @@ using ImageMap = mbgl::unordered_map<std::string, Immutable<style::Image::Impl>>
 using ImageDependencies = mbgl::unordered_map<std::string, ImageType>;
 using ImageRequestPair = std::pair<ImageDependencies, uint64_t>;
 using ImageVersionMap = mbgl::unordered_map<std::string, uint32_t>;
+// Names of the images of a style, a snapshot shared by all the tiles
+using AvailableImages = Immutable<std::set<std::string>>;
 inline bool operator<(const Immutable<mbgl::style::Image::Impl>& a, const Immutable<mbgl::style::Image::Impl>& b) {
     return a->id < b->id;
 }
@@ -19,10 +19,12 @@ bool checkGPUCapable(const Expression& expression, const ZoomCurvePtr& zoomCurve
 
 PropertyExpressionBase::PropertyExpressionBase(std::unique_ptr<expression::Expression> expression_)
     : expression(std::move(expression_)),
+      bytecode(expression->has(Dependency::Feature) ? expression::Bytecode::compile(*expression) : nullptr),
       zoomCurve(expression->has(Dependency::Zoom) ? expression::findZoomCurveChecked(*expression) : nullptr),
       useIntegerZoom_(false),
       isZoomConstant_(!expression->has(Dependency::Zoom)),
       isFeatureConstant_(!expression->has(Dependency::Feature)),
+      isFeatureStateConstant_(isFeatureConstant_ || expression::isFeatureStateConstant(*expression)),
       isRuntimeConstant_(!expression->has(Dependency::Image)),
       isGPUCapable_(checkGPUCapable(*expression, zoomCurve)) {
     assert(isZoomConstant_ == expression::isZoomConstant(*expression));
@@ -32,28 +34,34 @@ PropertyExpressionBase::PropertyExpressionBase(std::unique_ptr<expression::Expre
 
 PropertyExpressionBase::PropertyExpressionBase(PropertyExpressionBase&& other)
     : expression(std::move(other.expression)),
+      bytecode(std::move(other.bytecode)),
       zoomCurve(std::move(other.zoomCurve)),
       useIntegerZoom_(other.useIntegerZoom_),
       isZoomConstant_(other.isZoomConstant_),
       isFeatureConstant_(other.isFeatureConstant_),
+      isFeatureStateConstant_(other.isFeatureStateConstant_),
       isRuntimeConstant_(other.isRuntimeConstant_),
       isGPUCapable_(other.isGPUCapable_) {}
 
 PropertyExpressionBase::PropertyExpressionBase(const PropertyExpressionBase& other)
     : expression(other.expression),
+      bytecode(other.bytecode),
       zoomCurve(other.zoomCurve),
       useIntegerZoom_(other.useIntegerZoom_),
       isZoomConstant_(other.isZoomConstant_),
       isFeatureConstant_(other.isFeatureConstant_),
+      isFeatureStateConstant_(other.isFeatureStateConstant_),
       isRuntimeConstant_(other.isRuntimeConstant_),
       isGPUCapable_(other.isGPUCapable_) {}
 
 PropertyExpressionBase& PropertyExpressionBase::operator=(PropertyExpressionBase&& other) {
     expression = std::move(other.expression);
+    bytecode = std::move(other.bytecode);
     zoomCurve = other.zoomCurve;
     useIntegerZoom_ = other.useIntegerZoom_;
     isZoomConstant_ = other.isZoomConstant_;
     isFeatureConstant_ = other.isFeatureConstant_;
+    isFeatureStateConstant_ = other.isFeatureStateConstant_;
     isRuntimeConstant_ = other.isRuntimeConstant_;
     isGPUCapable_ = other.isGPUCapable_;
     return *this;
@@ -61,10 +69,12 @@ PropertyExpressionBase& PropertyExpressionBase::operator=(PropertyExpressionBase
 
 PropertyExpressionBase& PropertyExpressionBase::operator=(const PropertyExpressionBase& other) {
     expression = other.expression;
+    bytecode = other.bytecode;
     zoomCurve = other.zoomCurve;
     useIntegerZoom_ = other.useIntegerZoom_;
     isZoomConstant_ = other.isZoomConstant_;
     isFeatureConstant_ = other.isFeatureConstant_;
+    isFeatureStateConstant_ = other.isFeatureStateConstant_;
     isRuntimeConstant_ = other.isRuntimeConstant_;
     isGPUCapable_ = other.isGPUCapable_;
     return *this;
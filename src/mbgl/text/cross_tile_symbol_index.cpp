@@ -6,23 +6,85 @@
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/util/instrumentation.hpp>
 
+#include <algorithm>
+#include <cassert>
+
 namespace mbgl {
 
+namespace {
+
+int64_t cellOf(int64_t value) {
+    return (value >= 0 ? value : value - TileLayerIndex::cellSize + 1) / TileLayerIndex::cellSize;
+}
+
+uint64_t cellKey(int64_t x, int64_t y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+} // namespace
+
 TileLayerIndex::TileLayerIndex(OverscaledTileID coord_,
                                std::vector<SymbolInstance>& symbolInstances,
+                               const std::vector<std::size_t>& keyHashes,
                                uint32_t bucketInstanceId_,
                                std::string bucketLeaderId_)
     : coord(coord_),
       bucketInstanceId(bucketInstanceId_),
       bucketLeaderId(std::move(bucketLeaderId_)) {
-    for (const SymbolInstance& symbolInstance : symbolInstances) {
+    assert(keyHashes.size() == symbolInstances.size());
+    for (std::size_t i = 0; i < symbolInstances.size(); ++i) {
+        const SymbolInstance& symbolInstance = symbolInstances[i];
         if (!symbolInstance.check(SYM_GUARD_LOC) ||
             symbolInstance.getCrossTileID() == SymbolInstance::invalidCrossTileID) {
             continue;
         }
-        indexedSymbolInstances[symbolInstance.getKey()].emplace_back(symbolInstance.getCrossTileID(),
-                                                                     getScaledCoordinates(symbolInstance, coord));
+        getOrAddKey(keyHashes[i], symbolInstance.getKey())
+            .instances.emplace_back(symbolInstance.getCrossTileID(), getScaledCoordinates(symbolInstance, coord));
+    }
+
+    // Labels repeated along lines can have hundreds of symbols with the same key in a tile
+    for (KeyedSymbols& keyed : keyedSymbols) {
+        if (keyed.instances.size() <= gridThreshold) {
+            continue;
+        }
+        for (std::size_t i = 0; i < keyed.instances.size(); ++i) {
+            const auto& symbolCoord = keyed.instances[i].coord;
+            keyed.cells[cellKey(cellOf(symbolCoord.x), cellOf(symbolCoord.y))].push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+TileLayerIndex::KeyedSymbols& TileLayerIndex::getOrAddKey(std::size_t hash, const std::u16string& key) {
+    const auto newIndex = static_cast<uint32_t>(keyedSymbols.size());
+    const auto result = keysByHash.emplace(hash, newIndex);
+    if (!result.second) {
+        uint32_t index = result.first->second;
+        while (true) {
+            if (keyedSymbols[index].key == key) {
+                return keyedSymbols[index];
+            }
+            if (keyedSymbols[index].nextWithSameHash == noKey) {
+                break;
+            }
+            index = keyedSymbols[index].nextWithSameHash;
+        }
+        keyedSymbols[index].nextWithSameHash = newIndex;
+    }
+    keyedSymbols.emplace_back().key = key;
+    return keyedSymbols.back();
+}
+
+auto TileLayerIndex::findKey(std::size_t hash, const std::u16string& key) const -> const KeyedSymbols* {
+    const auto it = keysByHash.find(hash);
+    if (it == keysByHash.end()) {
+        return nullptr;
+    }
+    for (uint32_t index = it->second; index != noKey; index = keyedSymbols[index].nextWithSameHash) {
+        if (keyedSymbols[index].key == key) {
+            return &keyedSymbols[index];
+        }
     }
+    return nullptr;
 }
 
 Point<int64_t> TileLayerIndex::getScaledCoordinates(const SymbolInstance& symbolInstance,
@@ -37,8 +99,9 @@ Point<int64_t> TileLayerIndex::getScaledCoordinates(const SymbolInstance& symbol
 }
 
 void TileLayerIndex::findMatches(SymbolBucket& bucket,
+                                 const std::vector<std::size_t>& keyHashes,
                                  const OverscaledTileID& newCoord,
-                                 std::set<uint32_t>& zoomCrossTileIDs) const {
+                                 mbgl::unordered_set<uint32_t>& zoomCrossTileIDs) const {
     auto& symbolInstances = bucket.symbolInstances;
     float tolerance = coord.canonical.z < newCoord.canonical.z
                           ? 1.0f
@@ -46,34 +109,73 @@ void TileLayerIndex::findMatches(SymbolBucket& bucket,
 
     if (bucket.bucketLeaderID != bucketLeaderId) return;
 
-    for (auto& symbolInstance : symbolInstances) {
+    // The grid only helps when the search area spans a few cells
+    const bool useGrid = tolerance <= static_cast<float>(cellSize);
+    const auto gridTolerance = static_cast<int64_t>(tolerance);
+    std::vector<uint32_t> candidates;
+
+    for (std::size_t i = 0; i < symbolInstances.size(); ++i) {
+        auto& symbolInstance = symbolInstances[i];
         if (symbolInstance.getCrossTileID() || !symbolInstance.check(SYM_GUARD_LOC)) {
             // already has a match, skip
             continue;
         }
 
-        auto it = indexedSymbolInstances.find(symbolInstance.getKey());
-        if (it == indexedSymbolInstances.end()) {
+        const KeyedSymbols* keyed = findKey(keyHashes[i], symbolInstance.getKey());
+        if (!keyed) {
             // No symbol with this key in this bucket
             continue;
         }
 
         auto scaledSymbolCoord = getScaledCoordinates(symbolInstance, newCoord);
 
-        for (const IndexedSymbolInstance& thisTileSymbol : it->second) {
-            // Return any symbol with the same keys whose coordinates are within
-            // 1 grid unit. (with a 4px grid, this covers a 12px by 12px area)
-            if (std::abs(thisTileSymbol.coord.x - scaledSymbolCoord.x) <= tolerance &&
-                std::abs(thisTileSymbol.coord.y - scaledSymbolCoord.y) <= tolerance &&
-                zoomCrossTileIDs.find(thisTileSymbol.crossTileID) == zoomCrossTileIDs.end()) {
-                // Once we've marked ourselves duplicate against this parent
-                // symbol, don't let any other symbols at the same zoom level
-                // duplicate against the same parent (see issue #10844)
-                zoomCrossTileIDs.insert(thisTileSymbol.crossTileID);
-                symbolInstance.setCrossTileID(thisTileSymbol.crossTileID);
-                break;
+        // Return any symbol with the same keys whose coordinates are within
+        // 1 grid unit. (with a 4px grid, this covers a 12px by 12px area)
+        const auto matches = [&](const IndexedSymbolInstance& thisTileSymbol) {
+            return std::abs(thisTileSymbol.coord.x - scaledSymbolCoord.x) <= tolerance &&
+                   std::abs(thisTileSymbol.coord.y - scaledSymbolCoord.y) <= tolerance &&
+                   !zoomCrossTileIDs.contains(thisTileSymbol.crossTileID);
+        };
+
+        const IndexedSymbolInstance* match = nullptr;
+        if (keyed->cells.empty() || !useGrid) {
+            for (const IndexedSymbolInstance& thisTileSymbol : keyed->instances) {
+                if (matches(thisTileSymbol)) {
+                    match = &thisTileSymbol;
+                    break;
+                }
+            }
+        } else {
+            candidates.clear();
+            for (int64_t x = cellOf(scaledSymbolCoord.x - gridTolerance);
+                 x <= cellOf(scaledSymbolCoord.x + gridTolerance);
+                 ++x) {
+                for (int64_t y = cellOf(scaledSymbolCoord.y - gridTolerance);
+                     y <= cellOf(scaledSymbolCoord.y + gridTolerance);
+                     ++y) {
+                    const auto cell = keyed->cells.find(cellKey(x, y));
+                    if (cell != keyed->cells.end()) {
+                        candidates.insert(candidates.end(), cell->second.begin(), cell->second.end());
+                    }
+                }
+            }
+            // Keep bucket order, so that the same symbol wins as with a linear search
+            std::sort(candidates.begin(), candidates.end());
+            for (const uint32_t candidate : candidates) {
+                if (matches(keyed->instances[candidate])) {
+                    match = &keyed->instances[candidate];
+                    break;
+                }
             }
         }
+
+        if (match) {
+            // Once we've marked ourselves duplicate against this parent
+            // symbol, don't let any other symbols at the same zoom level
+            // duplicate against the same parent (see issue #10844)
+            zoomCrossTileIDs.insert(match->crossTileID);
+            symbolInstance.setCrossTileID(match->crossTileID);
+        }
     }
 }
 
@@ -160,20 +262,27 @@ bool CrossTileSymbolLayerIndex::addBucket(const OverscaledTileID& tileID,
 
     auto& thisZoomUsedCrossTileIDs = usedCrossTileIDs[tileID.overscaledZ];
 
+    // Hash every key once, instead of once for each index that's searched
+    keyHashes.clear();
+    keyHashes.reserve(bucket.symbolInstances.size());
+    for (const auto& symbolInstance : bucket.symbolInstances) {
+        keyHashes.push_back(TileLayerIndex::hashKey(symbolInstance.getKey()));
+    }
+
     for (auto& it : indexes) {
         auto zoom = it.first;
         const auto& zoomIndexes = it.second;
         if (zoom > tileID.overscaledZ) {
             for (auto& childIndex : zoomIndexes) {
                 if (childIndex.second.coord.isChildOf(tileID)) {
-                    childIndex.second.findMatches(bucket, tileID, thisZoomUsedCrossTileIDs);
+                    childIndex.second.findMatches(bucket, keyHashes, tileID, thisZoomUsedCrossTileIDs);
                 }
             }
         } else {
             auto parentTileID = tileID.scaledTo(zoom);
             auto parentIndex = zoomIndexes.find(parentTileID);
             if (parentIndex != zoomIndexes.end()) {
-                parentIndex->second.findMatches(bucket, tileID, thisZoomUsedCrossTileIDs);
+                parentIndex->second.findMatches(bucket, keyHashes, tileID, thisZoomUsedCrossTileIDs);
             }
         }
     }
@@ -190,14 +299,16 @@ bool CrossTileSymbolLayerIndex::addBucket(const OverscaledTileID& tileID,
     thisZoomIndexes.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(tileID),
-        std::forward_as_tuple(tileID, bucket.symbolInstances, bucket.bucketInstanceId, bucket.bucketLeaderID));
+        std::forward_as_tuple(
+            tileID, bucket.symbolInstances, keyHashes, bucket.bucketInstanceId, bucket.bucketLeaderID));
     return true;
 }
 
 void CrossTileSymbolLayerIndex::removeBucketCrossTileIDs(uint8_t zoom, const TileLayerIndex& removedBucket) {
-    for (const auto& key : removedBucket.indexedSymbolInstances) {
-        for (auto indexedSymbolInstance : key.second) {
-            usedCrossTileIDs[zoom].erase(indexedSymbolInstance.crossTileID);
+    auto& zoomCrossTileIDs = usedCrossTileIDs[zoom];
+    for (const auto& keyed : removedBucket.keyedSymbols) {
+        for (const auto& indexedSymbolInstance : keyed.instances) {
+            zoomCrossTileIDs.erase(indexedSymbolInstance.crossTileID);
         }
     }
 }
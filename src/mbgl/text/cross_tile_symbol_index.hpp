@@ -3,9 +3,11 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/bitmask_operations.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/containers.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/util/mat4.hpp>
 
+#include <limits>
 #include <map>
 #include <set>
 #include <vector>
@@ -32,18 +34,49 @@ public:
 
 class TileLayerIndex {
 public:
+    static constexpr uint32_t noKey = std::numeric_limits<uint32_t>::max();
+
+    // Keys with more symbols than this get a spatial grid
+    static constexpr std::size_t gridThreshold = 16;
+    // Size of a grid cell, in scaled coordinates
+    static constexpr int64_t cellSize = 16;
+
+    /// The symbols of the bucket that share a key, in bucket order
+    struct KeyedSymbols {
+        std::u16string key;
+        std::vector<IndexedSymbolInstance> instances;
+        /// Positions in `instances` by grid cell, only for keys with more than `gridThreshold` symbols
+        mbgl::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+        /// The next entry whose key has the same hash
+        uint32_t nextWithSameHash = noKey;
+    };
+
+    /// @param keyHashes The hash of the key of each symbol instance, see `hashKey()`
     TileLayerIndex(OverscaledTileID coord,
                    std::vector<SymbolInstance>&,
+                   const std::vector<std::size_t>& keyHashes,
                    uint32_t bucketInstanceId,
                    std::string bucketLeaderId);
 
+    static std::size_t hashKey(const std::u16string& key) { return std::hash<std::u16string>()(key); }
+
     Point<int64_t> getScaledCoordinates(const SymbolInstance&, const OverscaledTileID&) const;
-    void findMatches(SymbolBucket&, const OverscaledTileID&, std::set<uint32_t>&) const;
+    void findMatches(SymbolBucket&,
+                     const std::vector<std::size_t>& keyHashes,
+                     const OverscaledTileID&,
+                     mbgl::unordered_set<uint32_t>&) const;
+
+    const KeyedSymbols* findKey(std::size_t hash, const std::u16string& key) const;
 
     OverscaledTileID coord;
     uint32_t bucketInstanceId;
     std::string bucketLeaderId;
-    std::map<std::u16string, std::vector<IndexedSymbolInstance>> indexedSymbolInstances;
+    std::vector<KeyedSymbols> keyedSymbols;
+    // Hash of the key to the first entry of `keyedSymbols` with that hash
+    mbgl::unordered_map<std::size_t, uint32_t> keysByHash;
+
+private:
+    KeyedSymbols& getOrAddKey(std::size_t hash, const std::u16string& key);
 };
 
 class CrossTileSymbolLayerIndex {
@@ -56,8 +89,12 @@ public:
 private:
     void removeBucketCrossTileIDs(uint8_t zoom, const TileLayerIndex& removedBucket);
 
+    // Ordered by tile: child tiles are matched in this order, and the first
+    // match claims a cross tile ID.
     std::map<uint8_t, std::map<OverscaledTileID, TileLayerIndex>> indexes;
-    std::map<uint8_t, std::set<uint32_t>> usedCrossTileIDs;
+    std::map<uint8_t, mbgl::unordered_set<uint32_t>> usedCrossTileIDs;
+    // Reused across calls to `addBucket`
+    std::vector<std::size_t> keyHashes;
     float lng = 0;
     uint32_t& maxCrossTileID;
 };
@@ -1,5 +1,6 @@
 #include <mbgl/text/placement.hpp>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
@@ -10,7 +11,11 @@
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/math.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <list>
+#include <memory>
 #include <utility>
 
 namespace mbgl {
@@ -199,13 +204,102 @@ Placement::Placement()
 Placement::~Placement() = default;
 
 void Placement::placeLayers(const RenderLayerReferences& layers) {
-    for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
-        std::set<uint32_t> seenCrossTileIDs;
-        placeLayer(*it, seenCrossTileIDs);
+    if (updateParameters && updateParameters->parallelPlacement && !updateParameters->crossSourceCollisions) {
+        placeLayersInParallel(layers);
+    } else {
+        for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
+            std::set<uint32_t> seenCrossTileIDs;
+            placeLayer(*it, seenCrossTileIDs);
+        }
     }
     commit();
 }
 
+void Placement::placeLayersInParallel(const RenderLayerReferences& layers) {
+    MLN_TRACE_FUNC();
+
+    // Symbols of different collision groups never collide, so each group is
+    // placed on its own collision index. The layers of a group keep their
+    // order, and cross tile IDs are unique across layers, so merging the
+    // results gives the same placement as placing all the layers in turn.
+    std::vector<std::string> groupSources;
+    std::vector<RenderLayerReferences> groupLayers;
+    for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
+        const auto& placementData = it->get().getPlacementData();
+        if (placementData.empty()) continue;
+        const std::string& sourceID = placementData.front().sourceId;
+        // Assign the group IDs in the same order as serial placement
+        collisionGroups.get(sourceID);
+        const auto found = std::find(groupSources.begin(), groupSources.end(), sourceID);
+        if (found == groupSources.end()) {
+            groupSources.push_back(sourceID);
+            groupLayers.emplace_back().push_back(*it);
+        } else {
+            groupLayers[static_cast<std::size_t>(found - groupSources.begin())].push_back(*it);
+        }
+    }
+
+    // The groups are claimed through a shared counter, by the render thread
+    // and by the jobs handed to the background pool. The render thread never
+    // waits for a group that nobody has started: whatever the pool hasn't
+    // picked up yet, it places itself. A pool job that starts after all the
+    // groups are claimed finds nothing left and only touches this state.
+    struct Claims {
+        std::atomic<std::size_t> next{0};
+        std::vector<std::packaged_task<void()>> tasks;
+
+        void runPending() {
+            for (std::size_t i = next++; i < tasks.size(); i = next++) {
+                tasks[i]();
+            }
+        }
+    };
+    const auto claims = std::make_shared<Claims>();
+
+    std::vector<std::unique_ptr<Placement>> groups;
+    std::vector<std::future<void>> results;
+    groups.reserve(groupLayers.size());
+    claims->tasks.reserve(groupLayers.size());
+    results.reserve(groupLayers.size());
+    for (std::size_t i = 0; i < groupLayers.size(); ++i) {
+        auto& group = groups.emplace_back(std::make_unique<Placement>(updateParameters, prevPlacement));
+        group->collisionGroups = collisionGroups;
+        claims->tasks.emplace_back([&groupPlacement = *group, &groupLayerRefs = groupLayers[i]] {
+            for (const RenderLayer& layer : groupLayerRefs) {
+                std::set<uint32_t> seenCrossTileIDs;
+                groupPlacement.placeLayer(layer, seenCrossTileIDs);
+            }
+        });
+        results.push_back(claims->tasks.back().get_future());
+    }
+
+    if (claims->tasks.size() > 1) {
+        auto scheduler = Scheduler::GetBackground();
+        for (std::size_t i = 1; i < claims->tasks.size(); ++i) {
+            scheduler->schedule([claims] { claims->runPending(); });
+        }
+    }
+    claims->runPending();
+
+    // Only groups that a pool thread is placing right now are left. Wait for
+    // all of them before rethrowing, they use the groups above.
+    for (auto& result : results) {
+        result.wait();
+    }
+    for (auto& result : results) {
+        result.get();
+    }
+
+    for (auto& group : groups) {
+        placements.merge(group->placements);
+        variableOffsets.merge(group->variableOffsets);
+        placedOrientations.merge(group->placedOrientations);
+        retainedQueryData.merge(group->retainedQueryData);
+        collisionCircles.merge(group->collisionCircles);
+        groupCollisionIndexes.push_back(std::make_unique<CollisionIndex>(std::move(group->collisionIndex)));
+    }
+}
+
 void Placement::placeLayer(const RenderLayer& layer, std::set<uint32_t>& seenCrossTileIDs) {
     for (const BucketPlacementData& data : layer.getPlacementData()) {
         Bucket& bucket = data.bucket;
@@ -1322,6 +1416,20 @@ const CollisionIndex& Placement::getCollisionIndex() const {
     return collisionIndex;
 }
 
+std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> Placement::queryRenderedSymbols(
+    const ScreenLineString& queryGeometry) const {
+    auto result = collisionIndex.queryRenderedSymbols(queryGeometry);
+    for (const auto& groupCollisionIndex : groupCollisionIndexes) {
+        // A bucket belongs to a single collision group
+        for (auto& entry : groupCollisionIndex->queryRenderedSymbols(queryGeometry)) {
+            auto& features = result[entry.first];
+            features.insert(
+                features.end(), std::make_move_iterator(entry.second.begin()), std::make_move_iterator(entry.second.end()));
+        }
+    }
+    return result;
+}
+
 const RetainedQueryData& Placement::getQueryData(uint32_t bucketInstanceId) const {
     auto it = retainedQueryData.find(bucketInstanceId);
     if (it == retainedQueryData.end()) {
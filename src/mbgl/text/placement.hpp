@@ -130,6 +130,8 @@ public:
     virtual const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
 
     const CollisionIndex& getCollisionIndex() const;
+    /// Queries the collision index, and the indexes of the collision groups placed in parallel
+    std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> queryRenderedSymbols(const ScreenLineString&) const;
     TimePoint getCommitTime() const { return commitTime; }
     Duration getUpdatePeriod(float zoom) const;
 
@@ -147,6 +149,7 @@ protected:
     virtual void placeSymbolBucket(const BucketPlacementData&, std::set<uint32_t>& seenCrossTileIDs);
     JointPlacement placeSymbol(const SymbolInstance& symbolInstance, const PlacementContext&);
     void placeLayer(const RenderLayer&, std::set<uint32_t>&);
+    void placeLayersInParallel(const RenderLayerReferences&);
     virtual void commit();
     virtual void newSymbolPlaced(const SymbolInstance&,
                                  const PlacementContext&,
@@ -183,6 +186,8 @@ protected:
 
     std::shared_ptr<const UpdateParameters> updateParameters;
     CollisionIndex collisionIndex;
+    // The symbols of each collision group, when they were placed in parallel
+    std::vector<std::unique_ptr<CollisionIndex>> groupCollisionIndexes;
 
     style::TransitionOptions transitionOptions;
 
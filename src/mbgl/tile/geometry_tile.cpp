@@ -136,7 +136,7 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
 
     if (!imagePatches.empty()) {
         for (const auto& imagePatch : imagePatches) { // patch updated images.
-            atlasTextures->icon->uploadSubRegion(imagePatch.image->image,
+            atlasTextures->icon->uploadSubRegion(imagePatch.image->getImage(),
                                                  imagePatch.paddedRect.x + ImagePosition::padding,
                                                  imagePatch.paddedRect.y + ImagePosition::padding);
         }
@@ -342,6 +342,7 @@ void GeometryTile::onLayout(std::shared_ptr<LayoutResult> result, const uint64_t
     }
 
     layoutResult = std::move(result);
+    featureStateVersion = std::nullopt;
     if (!atlasTextures) {
         atlasTextures = std::make_shared<TileAtlasTextures>();
     }
@@ -578,11 +579,20 @@ void GeometryTile::performedFadePlacement() {
     }
 }
 
-void GeometryTile::setFeatureState(const LayerFeatureStates& states) {
+void GeometryTile::setFeatureState(const LayerFeatureStates& changes,
+                                   const LayerFeatureStates& allStates,
+                                   uint64_t version) {
     MLN_TRACE_FUNC();
 
     const auto layers = getData();
-    if ((layers == nullptr) || states.empty() || !layoutResult) {
+    if ((layers == nullptr) || !layoutResult || featureStateVersion == version) {
+        return;
+    }
+
+    const bool incremental = featureStateVersion && *featureStateVersion + 1 == version;
+    const auto& states = incremental ? changes : allStates;
+    featureStateVersion = version;
+    if (states.empty()) {
         return;
     }
 
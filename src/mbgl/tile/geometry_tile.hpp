@@ -99,7 +99,7 @@ public:
     void performedFadePlacement() override;
     std::shared_ptr<FeatureIndex> getFeatureIndex() const;
 
-    void setFeatureState(const LayerFeatureStates&) override;
+    void setFeatureState(const LayerFeatureStates& changes, const LayerFeatureStates& states, uint64_t version) override;
 
 protected:
     const GeometryTileData* getData() const;
@@ -125,6 +125,9 @@ private:
     std::shared_ptr<LayoutResult> layoutResult;
     std::shared_ptr<TileAtlasTextures> atlasTextures;
 
+    // Feature state version applied to the buckets of `layoutResult`.
+    std::optional<uint64_t> featureStateVersion;
+
     const MapMode mode;
 
     bool showCollisionBoxes;
@@ -130,7 +130,7 @@ GeometryTileWorker::~GeometryTileWorker() {
 */
 
 void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
-                                 std::set<std::string> availableImages_,
+                                 AvailableImages availableImages_,
                                  uint64_t correlationID_) {
     MLN_TRACE_FUNC();
 
@@ -157,7 +157,7 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
 }
 
 void GeometryTileWorker::setLayers(std::vector<Immutable<LayerProperties>> layers_,
-                                   std::set<std::string> availableImages_,
+                                   AvailableImages availableImages_,
                                    uint64_t correlationID_) {
     MLN_TRACE_FUNC();
 
@@ -472,7 +472,7 @@ void GeometryTileWorker::parse() {
         // images/glyphs are available to add the features to the buckets.
         if (leaderImpl.getTypeInfo()->layout == LayerTypeInfo::Layout::Required) {
             std::unique_ptr<Layout> layout = LayerManager::get()->createLayout(
-                {parameters, fontFaces, glyphDependencies, imageDependencies, availableImages},
+                {parameters, fontFaces, glyphDependencies, imageDependencies, *availableImages},
                 std::move(geometryLayer),
                 group);
             if (layout->hasDependencies()) {
@@ -570,6 +570,13 @@ void GeometryTileWorker::finalizeLayout() {
 
     layouts.clear();
 
+    // Set up what the drawables need from the complete buckets here, rather than on the render thread
+    for (const auto& [layerID, layerData] : renderData) {
+        if (layerData.bucket) {
+            layerData.bucket->prepareDrawables(*layerData.layerProperties);
+        }
+    }
+
     firstLoad = false;
 
     MBGL_TIMING_FINISH(watch,
@@ -0,0 +1,71 @@
+#include <mbgl/tile/raster_image_cache.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <string_view>
+
+namespace mbgl {
+
+RasterImageCache::RasterImageCache(std::size_t maxBytes_)
+    : maxBytes(maxBytes_) {}
+
+std::shared_ptr<PremultipliedImage> RasterImageCache::decode(const std::shared_ptr<const std::string>& data) {
+    const std::size_t key = std::hash<std::string_view>()(*data);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = entries.find(key);
+        if (it != entries.end() && (it->second.data == data || *it->second.data == *data)) {
+            lru.touch(key);
+            ++hits;
+            return it->second.image;
+        }
+    }
+
+    // Decode without the lock, another worker may be decoding the same data
+    Entry entry{data, std::make_shared<PremultipliedImage>(decodeImage(*data))};
+    auto image = entry.image;
+    const std::size_t entryBytes = entry.bytes();
+    if (entryBytes > maxBytes) {
+        return image;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (const auto it = entries.find(key); it != entries.end()) {
+        bytes -= it->second.bytes();
+        it->second = std::move(entry);
+    } else {
+        entries.emplace(key, std::move(entry));
+    }
+    bytes += entryBytes;
+    lru.touch(key);
+    evict();
+    return image;
+}
+
+void RasterImageCache::evict() {
+    while (bytes > maxBytes && !lru.empty()) {
+        const auto it = entries.find(lru.evict());
+        bytes -= it->second.bytes();
+        entries.erase(it);
+    }
+}
+
+void RasterImageCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!lru.empty()) {
+        lru.evict();
+    }
+    entries.clear();
+    bytes = 0;
+}
+
+std::size_t RasterImageCache::getBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes;
+}
+
+std::size_t RasterImageCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+} // namespace mbgl
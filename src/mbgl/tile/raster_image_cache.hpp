@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mbgl/util/containers.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/lru_cache.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace mbgl {
+
+/**
+ * @brief Decoded raster tile images, shared by the tiles that load the same
+ * encoded data, like the overscaled tiles of a source past its maximum zoom
+ * or a tile that is loaded again after it left the tile cache.
+ *
+ * Each renderer owns one, shared with its raster tile workers. The least
+ * recently used images are dropped once the size of the decoded images and
+ * of the encoded data kept to compare them exceeds the limit. The cache is
+ * thread safe, the images it returns must not be modified.
+ */
+class RasterImageCache {
+public:
+    explicit RasterImageCache(std::size_t maxBytes);
+
+    /// @return The decoded image, from the cache or decoded with `decodeImage`, which may throw.
+    std::shared_ptr<PremultipliedImage> decode(const std::shared_ptr<const std::string>& data);
+
+    void clear();
+
+    /// @return The size of the cached images and of their encoded data
+    std::size_t getBytes() const;
+    std::size_t getHits() const;
+
+private:
+    void evict();
+
+    struct Entry {
+        std::shared_ptr<const std::string> data;
+        std::shared_ptr<PremultipliedImage> image;
+
+        std::size_t bytes() const { return data->size() + image->bytes(); }
+    };
+
+    const std::size_t maxBytes;
+    mutable std::mutex mutex;
+    // Keyed by the hash of the encoded data
+    mbgl::unordered_map<std::size_t, Entry> entries;
+    LRU<std::size_t> lru;
+    std::size_t bytes = 0;
+    std::size_t hits = 0;
+};
+
+} // namespace mbgl
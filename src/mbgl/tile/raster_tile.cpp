@@ -23,7 +23,7 @@ RasterTile::RasterTile(const OverscaledTileID& id_,
       loader(*this, id_, parameters, tileset),
       threadPool(parameters.threadPool),
       mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
-      worker(parameters.threadPool, ActorRef<RasterTile>(*this, mailbox)) {}
+      worker(parameters.threadPool, ActorRef<RasterTile>(*this, mailbox), parameters.rasterImageCache) {}
 
 RasterTile::~RasterTile() {
     markObsolete();
@@ -1,13 +1,16 @@
 #include <mbgl/tile/raster_tile_worker.hpp>
 #include <mbgl/tile/raster_tile.hpp>
+#include <mbgl/tile/raster_image_cache.hpp>
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/actor/actor.hpp>
-#include <mbgl/util/premultiply.hpp>
 
 namespace mbgl {
 
-RasterTileWorker::RasterTileWorker(const ActorRef<RasterTileWorker>&, ActorRef<RasterTile> parent_)
-    : parent(std::move(parent_)) {}
+RasterTileWorker::RasterTileWorker(const ActorRef<RasterTileWorker>&,
+                                   ActorRef<RasterTile> parent_,
+                                   std::shared_ptr<RasterImageCache> imageCache_)
+    : parent(std::move(parent_)),
+      imageCache(std::move(imageCache_)) {}
 
 void RasterTileWorker::parse(const std::shared_ptr<const std::string>& data, uint64_t correlationID) {
     if (!data) {
@@ -17,7 +20,8 @@ void RasterTileWorker::parse(const std::shared_ptr<const std::string>& data, uin
     }
 
     try {
-        auto bucket = std::make_unique<RasterBucket>(decodeImage(*data));
+        auto bucket = imageCache ? std::make_unique<RasterBucket>(imageCache->decode(data))
+                                 : std::make_unique<RasterBucket>(decodeImage(*data));
         parent.invoke(&RasterTile::onParsed, std::move(bucket), correlationID);
     } catch (...) {
         parent.invoke(&RasterTile::onError, std::current_exception(), correlationID);
@@ -7,16 +7,19 @@
 
 namespace mbgl {
 
+class RasterImageCache;
 class RasterTile;
 
 class RasterTileWorker {
 public:
-    RasterTileWorker(const ActorRef<RasterTileWorker>&, ActorRef<RasterTile>);
+    RasterTileWorker(const ActorRef<RasterTileWorker>&, ActorRef<RasterTile>, std::shared_ptr<RasterImageCache>);
 
     void parse(const std::shared_ptr<const std::string>& data, uint64_t correlationID);
 
 private:
     ActorRef<RasterTile> parent;
+    // The renderer's decoded images, if any
+    std::shared_ptr<RasterImageCache> imageCache;
 };
 
 } // namespace mbgl
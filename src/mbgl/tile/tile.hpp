@@ -38,10 +38,12 @@ class UploadPass;
 struct TileUpdateParameters {
     Duration minimumUpdateInterval;
     bool isVolatile;
+    Resource::Priority priority = Resource::Priority::Regular;
 };
 
 inline bool operator==(const TileUpdateParameters& a, const TileUpdateParameters& b) {
-    return a.minimumUpdateInterval == b.minimumUpdateInterval && a.isVolatile == b.isVolatile;
+    return a.minimumUpdateInterval == b.minimumUpdateInterval && a.isVolatile == b.isVolatile &&
+           a.priority == b.priority;
 }
 
 inline bool operator!=(const TileUpdateParameters& a, const TileUpdateParameters& b) {
@@ -132,7 +134,12 @@ public:
     // placement and will have time to finish by the second placement.
     virtual void performedFadePlacement() {}
 
-    virtual void setFeatureState(const LayerFeatureStates&) {}
+    // Brings the buckets up to `version` of the source's feature state.
+    // `changes` leads there from the previous version; tiles that missed it,
+    // e.g. because they were laid out again, apply the full `states` instead.
+    virtual void setFeatureState(const LayerFeatureStates& /* changes */,
+                                 const LayerFeatureStates& /* states */,
+                                 uint64_t /* version */) {}
 
     void dumpDebugLogs() const;
 
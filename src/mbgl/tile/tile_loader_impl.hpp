@@ -198,6 +198,7 @@ void TileLoader<T>::loadFromNetwork() {
     // CacheOnly, and then a NetworkOnly request.
     resource.loadingMethod = Resource::LoadingMethod::NetworkOnly;
     resource.minimumUpdateInterval = updateParameters.minimumUpdateInterval;
+    resource.priority = updateParameters.priority;
     resource.storagePolicy = updateParameters.isVolatile ? Resource::StoragePolicy::Volatile
                                                          : Resource::StoragePolicy::Permanent;
 
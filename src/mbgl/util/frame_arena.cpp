@@ -0,0 +1,85 @@
+#include <mbgl/util/frame_arena.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+
+namespace mbgl {
+namespace util {
+
+FrameArena::FrameArena(std::size_t initialBlockSize_)
+    : initialBlockSize(initialBlockSize_) {
+    addBlock(initialBlockSize);
+}
+
+FrameArena::~FrameArena() = default;
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment) {
+    assert(alignment && (alignment & (alignment - 1)) == 0);
+    size = std::max<std::size_t>(size, 1);
+
+    while (true) {
+        Block& block = blocks[current];
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const std::uintptr_t aligned = (base + offset + alignment - 1) & ~(alignment - 1);
+        const std::size_t end = static_cast<std::size_t>(aligned - base) + size;
+        if (end <= block.size) {
+            used += end - offset;
+            offset = end;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        // Move on to the next block; padding at the end of this one is lost.
+        if (++current == blocks.size()) {
+            addBlock(size + alignment);
+        }
+        offset = 0;
+    }
+}
+
+void FrameArena::reset() {
+    if (blocks.size() > 1) {
+        // The last frame did not fit; replace the chain with one block that
+        // holds all of it.
+        const std::size_t total = std::accumulate(
+            blocks.begin(), blocks.end(), std::size_t{0}, [](std::size_t sum, const Block& block) {
+                return sum + block.size;
+            });
+        blocks.clear();
+        addBlock(total);
+        quietFrames = 0;
+        quietPeak = 0;
+    } else {
+        quietPeak = std::max(quietPeak, used);
+        if (++quietFrames == shrinkInterval) {
+            // Give back what a past busy frame left, keeping room to grow.
+            const std::size_t size = std::max(initialBlockSize, quietPeak * 2);
+            if (size < blocks.front().size) {
+                blocks.clear();
+                addBlock(size);
+            }
+            quietFrames = 0;
+            quietPeak = 0;
+        }
+    }
+    current = 0;
+    offset = 0;
+    used = 0;
+}
+
+std::size_t FrameArena::getCapacity() const {
+    return std::accumulate(blocks.begin(), blocks.end(), std::size_t{0}, [](std::size_t sum, const Block& block) {
+        return sum + block.size;
+    });
+}
+
+void FrameArena::addBlock(std::size_t minimumSize) {
+    // Grow geometrically so a large frame needs few blocks before the merge.
+    const std::size_t size = blocks.empty() ? minimumSize : std::max(minimumSize, blocks.back().size * 2);
+    blocks.push_back({std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+    blockAllocations++;
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+/**
+ * Monotonic allocator for memory that lives no longer than a frame.
+ *
+ * Allocations bump a pointer through a list of blocks and are never freed
+ * individually; `reset()` releases everything at once at the start of the
+ * next frame. When a frame overflows the first block, the blocks are merged
+ * on reset into a single one large enough for that frame, so frames of a
+ * stable size stop touching the heap after a few iterations. Once no frame
+ * of the last `shrinkInterval` used more than half of that block, it is
+ * replaced by one twice their peak, but no smaller than the initial block,
+ * so a single busy frame doesn't pin its memory.
+ *
+ * Not thread-safe; the arena belongs to the render thread.
+ */
+class FrameArena {
+public:
+    static constexpr std::size_t defaultBlockSize = 64 * 1024;
+    static constexpr std::size_t shrinkInterval = 120;
+
+    explicit FrameArena(std::size_t initialBlockSize = defaultBlockSize);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    /// Invalidates every allocation made since the last reset.
+    void reset();
+
+    /// Bytes handed out since the last reset, including alignment padding.
+    std::size_t getUsed() const { return used; }
+    std::size_t getCapacity() const;
+
+    /// Number of blocks requested from the heap over the lifetime of the arena.
+    std::size_t getBlockAllocations() const { return blockAllocations; }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    void addBlock(std::size_t minimumSize);
+
+    const std::size_t initialBlockSize;
+    std::vector<Block> blocks;
+    std::size_t current = 0;
+    std::size_t offset = 0;
+    std::size_t used = 0;
+    std::size_t blockAllocations = 0;
+
+    // Frames since the block last changed, and their highest usage
+    std::size_t quietFrames = 0;
+    std::size_t quietPeak = 0;
+};
+
+/// Standard allocator adaptor over a `FrameArena`. Deallocation is a no-op;
+/// containers using it must not outlive the frame.
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator(FrameArena& arena_) noexcept // NOLINT(google-explicit-constructor)
+        : arena(&arena_) {}
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept // NOLINT(google-explicit-constructor)
+        : arena(other.arena) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, std::size_t) noexcept {}
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept {
+        return arena == other.arena;
+    }
+
+private:
+    template <typename U>
+    friend class FrameAllocator;
+
+    FrameArena* arena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+template <typename T, typename Compare = std::less<T>>
+using FrameSet = std::set<T, Compare, FrameAllocator<T>>;
+
+} // namespace util
+} // namespace mbgl
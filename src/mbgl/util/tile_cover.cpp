@@ -155,9 +155,12 @@ int32_t coveringZoomLevel(double zoom, style::SourceType type, uint16_t size) no
     }
 }
 
-std::vector<OverscaledTileID> tileCover(const TileCoverParameters& state,
-                                        uint8_t z,
-                                        const std::optional<uint8_t>& overscaledZ) {
+namespace {
+
+void coverFrustum(const TileCoverParameters& state,
+                  uint8_t z,
+                  const std::optional<uint8_t>& overscaledZ,
+                  std::vector<OverscaledTileID>& ids) {
     struct Node {
         AABB aabb;
         uint8_t zoom;
@@ -276,16 +279,67 @@ std::vector<OverscaledTileID> tileCover(const TileCoverParameters& state,
     std::sort(
         result.begin(), result.end(), [](const ResultTile& a, const ResultTile& b) { return a.sqrDist < b.sqrDist; });
 
-    std::vector<OverscaledTileID> ids;
+    ids.clear();
     ids.reserve(result.size());
 
     for (const auto& tile : result) {
         ids.push_back(tile.id);
     }
+}
 
+} // namespace
+
+std::vector<OverscaledTileID> tileCover(const TileCoverParameters& state,
+                                        uint8_t z,
+                                        const std::optional<uint8_t>& overscaledZ) {
+    std::vector<OverscaledTileID> ids;
+    coverFrustum(state, z, overscaledZ, ids);
     return ids;
 }
 
+const std::vector<OverscaledTileID>& TileCoverCache::get(const TileCoverParameters& state,
+                                                         uint8_t z,
+                                                         const std::optional<uint8_t>& overscaledZ) {
+    const auto& transform = state.transformState;
+    const Camera camera{transform.getInvProjectionMatrix(),
+                        transform.getSize(),
+                        transform.getScale(),
+                        transform.getPitch(),
+                        transform.getViewportMode(),
+                        state.tileLodMinRadius,
+                        state.tileLodScale,
+                        state.tileLodPitchThreshold};
+
+    if (!lastCamera || !(*lastCamera == camera)) {
+        // Keep the entries, and with them their storage, for the next camera.
+        lastCamera = camera;
+        used = 0;
+    }
+
+    const uint8_t overscaledZoom = std::max(overscaledZ.value_or(z), z);
+    for (std::size_t i = 0; i < used; ++i) {
+        if (entries[i].z == z && entries[i].overscaledZ == overscaledZoom) {
+            hits++;
+            return entries[i].tiles;
+        }
+    }
+
+    if (used == entries.size()) {
+        entries.emplace_back();
+    }
+    Entry& entry = entries[used++];
+    entry.z = z;
+    entry.overscaledZ = overscaledZoom;
+    coverFrustum(state, z, overscaledZoom, entry.tiles);
+    misses++;
+    return entry.tiles;
+}
+
+void TileCoverCache::clear() {
+    lastCamera.reset();
+    used = 0;
+}
+
 std::vector<UnwrappedTileID> tileCover(const LatLngBounds& bounds_, uint8_t z) {
     if (bounds_.isEmpty() || bounds_.south() > util::LATITUDE_MAX || bounds_.north() < -util::LATITUDE_MAX) {
         return {};
@@ -6,6 +6,7 @@
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/util/range.hpp>
 
+#include <deque>
 #include <vector>
 #include <memory>
 #include <numbers>
@@ -52,5 +53,45 @@ std::vector<UnwrappedTileID> tileCover(const Geometry<double>&, uint8_t z);
 uint64_t tileCount(const LatLngBounds&, uint8_t z) noexcept;
 uint64_t tileCount(const Geometry<double>&, uint8_t z);
 
+// Memoizes frustum tile covers for the most recent camera
+class TileCoverCache {
+public:
+    // Valid until the next call with a different camera, or `clear()`
+    const std::vector<OverscaledTileID>& get(const TileCoverParameters&,
+                                             uint8_t z,
+                                             const std::optional<uint8_t>& overscaledZ = std::nullopt);
+    void clear();
+
+    std::size_t getHits() const { return hits; }
+    std::size_t getMisses() const { return misses; }
+
+private:
+    // Everything the frustum cover depends on
+    struct Camera {
+        mat4 invProjMatrix;
+        Size size;
+        double scale;
+        double pitch;
+        ViewportMode viewportMode;
+        double tileLodMinRadius;
+        double tileLodScale;
+        double tileLodPitchThreshold;
+
+        bool operator==(const Camera&) const = default;
+    };
+
+    struct Entry {
+        uint8_t z = 0;
+        uint8_t overscaledZ = 0;
+        std::vector<OverscaledTileID> tiles;
+    };
+
+    std::optional<Camera> lastCamera;
+    std::deque<Entry> entries;
+    std::size_t used = 0;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+};
+
 } // namespace util
 } // namespace mbgl
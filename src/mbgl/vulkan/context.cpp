@@ -659,7 +659,8 @@ void Context::buildImageDescriptorSetLayout() {
     for (size_t i = 0; i < shaders::maxTextureCountPerShader; ++i) {
         bindings.push_back(vk::DescriptorSetLayoutBinding()
                                .setBinding(static_cast<uint32_t>(i))
-                               .setStageFlags(vk::ShaderStageFlagBits::eFragment)
+                               .setStageFlags(vk::ShaderStageFlags() | vk::ShaderStageFlagBits::eVertex |
+                                              vk::ShaderStageFlagBits::eFragment)
                                .setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
                                .setDescriptorCount(1));
     }
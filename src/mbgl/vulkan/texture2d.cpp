@@ -454,8 +454,9 @@ void Texture2D::transitionToShaderReadLayout(const vk::UniqueCommandBuffer& buff
                              .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
                              .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1});
 
+    // Vertex shaders sample some textures too, e.g. the feature state texture
     buffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
-                            vk::PipelineStageFlagBits::eFragmentShader,
+                            vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader,
                             {},
                             nullptr,
                             nullptr,
@@ -10,6 +10,11 @@
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/layer_drawable_data.hpp>
+#include <mbgl/shaders/shader_defines.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
+#include <mbgl/style/layers/fill_layer_properties.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/headless_backend.hpp>
@@ -100,6 +105,38 @@ TEST(Buckets, FillBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 }
 
+TEST(Buckets, FillBucketDrawableData) {
+    using namespace style;
+    FillLayer layer("fill", "source");
+    Immutable<LayerProperties> layerProperties = makeMutable<FillLayerProperties>(
+        staticImmutableCast<FillLayer::Impl>(layer.baseImpl));
+
+    FillBucket bucket{{}, {{"fill", layerProperties}}, 5.0f, 1};
+    GeometryCollection polygon{{{0, 0}, {0, 1}, {1, 1}}};
+    bucket.addFeature(StubGeometryTileFeature{{}, FeatureType::Polygon, polygon, properties},
+                      polygon,
+                      {},
+                      PatternLayerMap(),
+                      0,
+                      CanonicalTileID(0, 0, 0));
+
+    // Not prepared yet, created on request
+    const auto created = bucket.getDrawableData(*layerProperties);
+    ASSERT_TRUE(created);
+    EXPECT_NE(created, bucket.getDrawableData(*layerProperties));
+
+    bucket.prepareDrawables(*layerProperties);
+    const auto prepared = bucket.getDrawableData(*layerProperties);
+    ASSERT_TRUE(prepared);
+    EXPECT_EQ(prepared, bucket.getDrawableData(*layerProperties));
+    EXPECT_EQ(layerProperties->constantsMask(), prepared->constantsMask);
+
+    // The layout attribute reads the bucket's vertices
+    const auto& pos = prepared->vertexAttributes.get(shaders::idFillPosVertexAttribute);
+    ASSERT_TRUE(pos);
+    EXPECT_EQ(bucket.sharedVertices, pos->getSharedRawData());
+}
+
 TEST(Buckets, LineBucket) {
     gl::HeadlessBackend backend({512, 256});
     gfx::BackendScope scope{backend};
@@ -43,6 +43,7 @@
 #include <mbgl/util/run_loop.hpp>
 
 #include <atomic>
+#include <map>
 
 using namespace mbgl;
 using namespace mbgl::style;
@@ -479,6 +480,8 @@ TEST(Map, DefaultMapOptions) {
     EXPECT_EQ(options.constrainMode(), ConstrainMode::HeightOnly);
     EXPECT_EQ(options.northOrientation(), NorthOrientation::Upwards);
     EXPECT_TRUE(options.crossSourceCollisions());
+    EXPECT_FALSE(options.parallelPlacement());
+    EXPECT_FALSE(options.asyncPlacement());
     EXPECT_EQ(options.size().width, 256);
     EXPECT_EQ(options.size().height, 256);
     EXPECT_EQ(options.pixelRatio(), 1);
@@ -1765,6 +1768,155 @@ TEST(Map, InvalidUTF8InTile) {
     test.runLoop.run();
 }
 
+TEST(Map, AsyncPlacement) {
+    MapTest<> test{MapOptions().withMapMode(MapMode::Continuous).withAsyncPlacement(true)};
+
+    test.fileSource->glyphsResponse = [&](const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "point": {
+          "type": "geojson",
+          "data": { "type": "Point", "coordinates": [0, 0] }
+        }
+      },
+      "layers": [{
+        "id": "label",
+        "type": "symbol",
+        "source": "point",
+        "layout": {
+          "text-field": "A",
+          "text-font": ["Open Sans Regular"]
+        }
+      }]
+    })STYLE");
+
+    // Placement results show up on a later frame, the map keeps repainting until then.
+    bool placementChanged = false;
+    test.observer.didFinishRenderingFrameCallback = [&](MapObserver::RenderFrameStatus status) {
+        placementChanged |= status.placementChanged;
+    };
+    test.observer.didBecomeIdleCallback = [&]() {
+        test.runLoop.stop();
+    };
+
+    test.runLoop.run();
+
+    EXPECT_TRUE(placementChanged);
+    const auto center = test.map.pixelForLatLng({0, 0});
+    EXPECT_EQ(1u, test.frontend.getRenderer()->queryRenderedFeatures(center).size());
+}
+
+namespace {
+
+constexpr int labelsPerSource = 8;
+
+// Three sources with two symbol layers each. The labels of every source
+// overlap each other, and those of the other sources.
+std::string placementGroupsStyle() {
+    std::string sources;
+    std::string layers;
+    for (const std::string id : {"a", "b", "c"}) {
+        std::string features;
+        for (int i = 0; i < labelsPerSource; ++i) {
+            if (!features.empty()) features += ",";
+            features += R"({ "type": "Feature", "properties": { "name": "Label )" + util::toString(i) +
+                        R"(" }, "geometry": { "type": "Point", "coordinates": [)" + util::toString(i * 3 - 10) +
+                        ", " + util::toString((i % 3) * 2) + "] } }";
+        }
+        if (!sources.empty()) sources += ",";
+        sources += "\"" + id + R"(": { "type": "geojson", "data": { "type": "FeatureCollection", "features": [)" +
+                   features + "] } }";
+        for (const std::string level : {"low", "high"}) {
+            if (!layers.empty()) layers += ",";
+            layers += R"({ "id": ")" + id + "-" + level + R"(", "type": "symbol", "source": ")" + id +
+                      R"(", "layout": { "text-field": ["get", "name"], "text-font": ["Open Sans Regular"], )" +
+                      R"("text-size": 20 } })";
+        }
+    }
+    return R"({ "version": 8, "sources": {)" + sources + R"(}, "layers": [)" + layers + "] }";
+}
+
+struct PlacementResult {
+    PremultipliedImage image;
+    std::map<std::string, std::size_t> featureCounts;
+};
+
+PlacementResult renderPlacement(const std::string& style, bool parallel) {
+    MapTest<> test{MapOptions().withCrossSourceCollisions(false).withParallelPlacement(parallel)};
+
+    test.fileSource->glyphsResponse = [&](const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.map.getStyle().loadJSON(style);
+
+    PlacementResult result;
+    result.image = test.frontend.render(test.map).image;
+    const auto size = test.frontend.getSize();
+    const ScreenBox box{{0, 0}, {static_cast<double>(size.width), static_cast<double>(size.height)}};
+    for (const auto* layer : test.map.getStyle().getLayers()) {
+        result.featureCounts[layer->getID()] =
+            test.frontend.getRenderer()
+                ->queryRenderedFeatures(box, RenderedQueryOptions{std::vector<std::string>{layer->getID()}})
+                .size();
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(Map, ParallelPlacementCollidesWithinGroup) {
+    // Both layers of "a" collide with each other, but not with "b".
+    const std::string style = R"STYLE({
+      "version": 8,
+      "sources": {
+        "a": { "type": "geojson", "data": { "type": "Point", "coordinates": [0, 0] } },
+        "b": { "type": "geojson", "data": { "type": "Point", "coordinates": [0, 0] } }
+      },
+      "layers": [
+        { "id": "a-low", "type": "symbol", "source": "a", "layout": { "text-field": "A", "text-font": ["Open Sans Regular"] } },
+        { "id": "b-label", "type": "symbol", "source": "b", "layout": { "text-field": "A", "text-font": ["Open Sans Regular"] } },
+        { "id": "a-high", "type": "symbol", "source": "a", "layout": { "text-field": "A", "text-font": ["Open Sans Regular"] } }
+      ]
+    })STYLE";
+
+    const auto result = renderPlacement(style, true);
+
+    EXPECT_EQ(0u, result.featureCounts.at("a-low"));
+    EXPECT_EQ(1u, result.featureCounts.at("a-high"));
+    EXPECT_EQ(1u, result.featureCounts.at("b-label"));
+}
+
+TEST(Map, ParallelPlacementMatchesSerial) {
+    const std::string style = placementGroupsStyle();
+    const auto serial = renderPlacement(style, false);
+
+    std::size_t placed = 0;
+    std::size_t hidden = 0;
+    for (const auto& [layer, count] : serial.featureCounts) {
+        placed += count;
+        hidden += static_cast<std::size_t>(labelsPerSource) - count;
+    }
+    // Make sure the style exercises collisions at all.
+    ASSERT_LT(0u, placed);
+    ASSERT_LT(0u, hidden);
+
+    // The pool can pick up the groups in a different order on every run.
+    for (int run = 0; run < 5; ++run) {
+        const auto parallel = renderPlacement(style, true);
+        EXPECT_EQ(serial.featureCounts, parallel.featureCounts);
+        EXPECT_TRUE(serial.image == parallel.image);
+    }
+}
+
 TEST(Map, ObserveTileLifecycle) {
     util::RunLoop runLoop;
 
@@ -513,6 +513,41 @@ TEST(Transform, Camera) {
     ASSERT_DOUBLE_EQ(transform.getLatLng().longitude(), 0);
 }
 
+TEST(Transform, TransitionPath) {
+    Transform transform;
+    transform.resize({1000, 1000});
+    transform.jumpTo(CameraOptions().withCenter(LatLng{40.7, -74.0}).withZoom(15.0));
+
+    // No path without an animated transition.
+    EXPECT_TRUE(transform.getTransitionPath(Clock::now(), 8).empty());
+
+    const LatLng destination{41.38, 2.18};
+    transform.flyTo(CameraOptions().withCenter(destination).withZoom(14.0), AnimationOptions(Seconds(2)));
+    ASSERT_TRUE(transform.inTransition());
+
+    const auto path = transform.getTransitionPath(transform.getTransitionStart(), 8);
+    ASSERT_EQ(8u, path.size());
+
+    // Sampling must not move the camera.
+    EXPECT_NEAR(40.7, transform.getLatLng().latitude(), 1e-6);
+    EXPECT_NEAR(15.0, transform.getZoom(), 1e-6);
+
+    // flyTo zooms out first; the last sample is the destination.
+    EXPECT_LT(path[3].getZoom(), 14.0);
+    EXPECT_NEAR(destination.latitude(), path.back().getLatLng().latitude(), 1e-6);
+    EXPECT_NEAR(destination.longitude(), path.back().getLatLng().longitude(), 1e-6);
+    EXPECT_NEAR(14.0, path.back().getZoom(), 1e-6);
+
+    // Samples only cover the remainder of the transition.
+    const auto remaining = transform.getTransitionPath(transform.getTransitionStart() + Milliseconds(1500), 2);
+    ASSERT_EQ(2u, remaining.size());
+    EXPECT_GT(remaining.front().getZoom(), path[3].getZoom());
+
+    transform.updateTransitions(transform.getTransitionStart() + transform.getTransitionDuration());
+    EXPECT_FALSE(transform.inTransition());
+    EXPECT_TRUE(transform.getTransitionPath(Clock::now(), 8).empty());
+}
+
 TEST(Transform, ProjectionMode) {
     Transform transform;
 
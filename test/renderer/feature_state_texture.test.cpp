@@ -0,0 +1,90 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/shader_group.hpp>
+#include <mbgl/renderer/feature_state_texture.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(FeatureStateTexture, Ordinals) {
+    FeatureStateTexture texture(2);
+    EXPECT_EQ(0u, texture.addFeature(3));
+    EXPECT_EQ(1u, texture.addFeature(2));
+    EXPECT_EQ(2u, texture.getFeatureCount());
+
+    const FeatureStateTexture::OrdinalVector& ordinals = *texture.getOrdinals();
+    ASSERT_EQ(5u, ordinals.elements());
+    const std::vector<float> expected{0, 0, 0, 1, 1};
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], ordinals.at(i).a1[0]);
+    }
+}
+
+TEST(FeatureStateTexture, DirtyRows) {
+    // Two texels per feature, so a row holds half as many features as texels.
+    FeatureStateTexture texture(2);
+    constexpr auto featuresPerRow = FeatureStateTexture::width / 2;
+    for (uint32_t i = 0; i < 3 * featuresPerRow; ++i) {
+        texture.addFeature(1);
+    }
+
+    EXPECT_FALSE(texture.needsUpload());
+    texture.setTexel(featuresPerRow + 1, 1, {{1, 2, 3, 4}});
+    EXPECT_TRUE(texture.needsUpload());
+    EXPECT_EQ(std::make_pair(1u, 2u), texture.getDirtyRows());
+
+    texture.setTexel(2 * featuresPerRow, 0, {{5, 6, 7, 8}});
+    EXPECT_EQ(std::make_pair(1u, 3u), texture.getDirtyRows());
+
+    const FeatureStateTexture::Texel texel{{1, 2, 3, 4}};
+    EXPECT_EQ(texel, texture.getTexel(featuresPerRow + 1, 1));
+    EXPECT_EQ((FeatureStateTexture::Texel{{0, 0, 0, 0}}), texture.getTexel(featuresPerRow + 1, 0));
+}
+
+TEST(FeatureStateTexture, UnchangedTexel) {
+    FeatureStateTexture texture(1);
+    texture.addFeature(4);
+    texture.setTexel(0, 0, {{0, 0, 0, 0}});
+    EXPECT_FALSE(texture.needsUpload());
+}
+
+TEST(FeatureStateTexture, ShaderDefines) {
+    StringIDSetsPair properties;
+    properties.first.emplace("feature_state_opacity");
+    properties.first.emplace("feature_state_color");
+    properties.first.emplace("outline_color");
+    properties.second.emplace(1);
+    properties.second.emplace(2);
+    properties.second.emplace(3);
+
+    const std::vector<std::pair<std::string, std::string>> expected{
+        {"HAS_FEATURE_STATE_TEXTURE", ""},
+        {"FEATURE_STATE_STRIDE", "2"},
+        {"HAS_FEATURE_STATE_u_color", ""},
+        {"FEATURE_STATE_SLOT_u_color", "0"},
+        {"HAS_FEATURE_STATE_u_opacity", ""},
+        {"FEATURE_STATE_SLOT_u_opacity", "1"},
+    };
+    EXPECT_EQ(expected, gfx::ShaderGroup::featureStateDefines(properties));
+
+    // A property that's currently constant keeps its slot
+    properties.first.emplace("color");
+    const std::vector<std::pair<std::string, std::string>> expectedConstant{
+        {"HAS_FEATURE_STATE_TEXTURE", ""},
+        {"FEATURE_STATE_STRIDE", "2"},
+        {"HAS_FEATURE_STATE_u_opacity", ""},
+        {"FEATURE_STATE_SLOT_u_opacity", "1"},
+    };
+    EXPECT_EQ(expectedConstant, gfx::ShaderGroup::featureStateDefines(properties));
+
+    // Uniforms don't need any of them
+    StringIDSetsPair uniforms;
+    uniforms.first.emplace("opacity");
+    uniforms.first.emplace("color");
+    uniforms.first.emplace("outline_color");
+    uniforms.second = properties.second;
+    EXPECT_TRUE(gfx::ShaderGroup::featureStateDefines(uniforms).empty());
+}
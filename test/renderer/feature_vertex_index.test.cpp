@@ -0,0 +1,71 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/vertex_vector.hpp>
+#include <mbgl/renderer/feature_vertex_index.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+std::vector<std::size_t> featureIndices(const FeatureVertexIndex& index, const std::string& id) {
+    std::vector<std::size_t> result;
+    index.forEachRange(id, [&](const FeatureVertexRange& range) { result.push_back(range.featureIndex); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST(FeatureVertexIndex, MatchesStringifiedIDs) {
+    FeatureVertexIndex index;
+    index.insert(FeatureIdentifier{uint64_t{42}}, 0, 0, 4);
+    index.insert(FeatureIdentifier{int64_t{7}}, 1, 4, 8);
+    index.insert(FeatureIdentifier{int64_t{-7}}, 2, 8, 12);
+    index.insert(FeatureIdentifier{std::string{"12"}}, 3, 12, 16);
+    index.insert(FeatureIdentifier{std::string{"012"}}, 4, 16, 20);
+    index.insert(FeatureIdentifier{std::string{"building"}}, 5, 20, 24);
+    index.insert(FeatureIdentifier{NullValue{}}, 6, 24, 28);
+
+    EXPECT_EQ(std::vector<std::size_t>{0}, featureIndices(index, "42"));
+    EXPECT_EQ(std::vector<std::size_t>{1}, featureIndices(index, "7"));
+    EXPECT_EQ(std::vector<std::size_t>{2}, featureIndices(index, "-7"));
+    EXPECT_EQ(std::vector<std::size_t>{3}, featureIndices(index, "12"));
+    EXPECT_EQ(std::vector<std::size_t>{4}, featureIndices(index, "012"));
+    EXPECT_EQ(std::vector<std::size_t>{5}, featureIndices(index, "building"));
+    EXPECT_TRUE(featureIndices(index, "43").empty());
+    EXPECT_TRUE(featureIndices(index, "").empty());
+    EXPECT_EQ(6u, index.size());
+}
+
+TEST(FeatureVertexIndex, MultipleRangesPerFeature) {
+    FeatureVertexIndex index;
+    index.insert(FeatureIdentifier{uint64_t{1}}, 0, 0, 4);
+    index.insert(FeatureIdentifier{uint64_t{2}}, 1, 4, 8);
+    index.insert(FeatureIdentifier{uint64_t{1}}, 2, 8, 10);
+
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    index.forEachRange("1", [&](const FeatureVertexRange& range) { ranges.emplace_back(range.start, range.end); });
+    std::sort(ranges.begin(), ranges.end());
+    EXPECT_EQ((std::vector<std::pair<std::size_t, std::size_t>>{{0, 4}, {8, 10}}), ranges);
+}
+
+TEST(VertexVector, ModifiedRange) {
+    gfx::VertexVector<int> vector;
+    vector.extend(10, 0);
+
+    // Never uploaded, so everything needs to go.
+    EXPECT_FALSE(vector.isPartiallyModified());
+
+    vector.resetModifiedRange();
+    vector.fill(2, 4, 1);
+    vector.fill(6, 7, 1);
+    EXPECT_TRUE(vector.isPartiallyModified());
+    EXPECT_EQ(std::make_pair(std::size_t{2}, std::size_t{7}), vector.getModifiedRange());
+
+    vector.emplace_back(1);
+    EXPECT_FALSE(vector.isPartiallyModified());
+    EXPECT_EQ(std::make_pair(std::size_t{0}, std::size_t{11}), vector.getModifiedRange());
+}
@@ -31,7 +31,7 @@ TEST(ImageManager, Basic) {
         imageManager.addImage(image);
         auto* stored = imageManager.getImage(image->id);
         ASSERT_TRUE(stored);
-        EXPECT_EQ(image->image.size, stored->image.size);
+        EXPECT_EQ(image->getSize(), stored->getSize());
     }
 
     imageManager.dumpDebugLogs();
@@ -53,6 +53,26 @@ TEST(ImageManager, AddRemove) {
     EXPECT_EQ(nullptr, imageManager.getImage("four"));
 }
 
+TEST(ImageManager, AvailableImages) {
+    ImageManager imageManager;
+    imageManager.addImage(makeMutable<style::Image::Impl>("one", PremultipliedImage({16, 16}), 2.0f));
+    imageManager.addImage(makeMutable<style::Image::Impl>("two", PremultipliedImage({16, 16}), 2.0f));
+
+    // Shared until the images change
+    const AvailableImages first = imageManager.getAvailableImages();
+    EXPECT_EQ(first, imageManager.getAvailableImages());
+    EXPECT_EQ(std::set<std::string>({"one", "two"}), *first);
+
+    imageManager.removeImage("one");
+    const AvailableImages second = imageManager.getAvailableImages();
+    EXPECT_FALSE(first == second);
+    EXPECT_EQ(std::set<std::string>({"two"}), *second);
+    EXPECT_EQ(std::set<std::string>({"one", "two"}), *first);
+
+    imageManager.addImage(makeMutable<style::Image::Impl>("three", PremultipliedImage({16, 16}), 2.0f));
+    EXPECT_EQ(std::set<std::string>({"three", "two"}), *imageManager.getAvailableImages());
+}
+
 TEST(ImageManager, Update) {
     FixtureLog log;
     ImageManager imageManager;
@@ -1,9 +1,12 @@
 #include <mbgl/storage/mbtiles_file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/resource_options.hpp>
+#include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <algorithm>
 #include <filesystem>
 
 #include <climits>
@@ -124,3 +127,53 @@ TEST(MBTilesFileSource, NonExistentTile) {
 
     loop.run();
 }
+
+// Tiles of deduplicated files are read from the `map` and `images` tables
+TEST(MBTilesFileSource, DeduplicatedTile) {
+    util::RunLoop loop;
+
+    const auto path = std::filesystem::current_path() / "test/fixtures/storage/mbtiles/deduplicated.mbtiles";
+    std::filesystem::remove(path);
+    {
+        auto db = mapbox::sqlite::Database::open(path.string(), mapbox::sqlite::ReadWriteCreate);
+        db.exec(
+            "CREATE TABLE map (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_id TEXT);"
+            "CREATE TABLE images (tile_data BLOB, tile_id TEXT);"
+            "CREATE VIEW tiles AS SELECT map.zoom_level AS zoom_level, map.tile_column AS tile_column, "
+            "map.tile_row AS tile_row, images.tile_data AS tile_data FROM map JOIN images ON images.tile_id = "
+            "map.tile_id;"
+            "INSERT INTO map VALUES (1, 0, 0, 'a'), (1, 1, 0, 'a'), (1, 0, 1, 'b');");
+        mapbox::sqlite::Statement insert(db, "INSERT INTO images VALUES (?1, ?2)");
+        for (const auto& [data, id] : {std::pair<std::string, std::string>{util::compress("sea", util::GZIP), "a"},
+                                       {"land", "b"}}) {
+            mapbox::sqlite::Query query{insert};
+            query.bindBlob(1, data.data(), data.size());
+            query.bind(2, id);
+            query.run();
+        }
+    }
+
+    MBTilesFileSource mbtiles(ResourceOptions::Default(), ClientOptions());
+    const std::string url = "mbtiles://" + path.string() + "?file={z}/{x}/{y}.pbf";
+
+    // The rows are stored in the TMS scheme
+    std::vector<std::string> results;
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    for (const auto& [x, y] : {std::pair<int32_t, int32_t>{0, 1}, {1, 1}, {0, 0}, {1, 0}}) {
+        requests.push_back(
+            mbtiles.request(Resource::tile(url, 1.0, x, y, 1, Tileset::Scheme::XYZ), [&, x, y](Response res) {
+                EXPECT_EQ(nullptr, res.error);
+                results.push_back(std::to_string(x) + "/" + std::to_string(y) + ":" +
+                                  (res.data ? *res.data : std::string("none")));
+                if (results.size() == 4) {
+                    loop.stop();
+                }
+            }));
+    }
+
+    loop.run();
+
+    std::sort(results.begin(), results.end());
+    EXPECT_EQ((std::vector<std::string>{"0/0:land", "0/1:sea", "1/0:none", "1/1:sea"}), results);
+    std::filesystem::remove(path);
+}
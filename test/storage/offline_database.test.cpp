@@ -5,6 +5,7 @@
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 
@@ -20,6 +21,7 @@ using mapbox::sqlite::ResultCode;
 
 static constexpr const char* filename = "test/fixtures/offline_database/offline.db";
 static constexpr const char* filename_sideload = "test/fixtures/offline_database/offline_sideload.db";
+static constexpr const char* filename_archive = "test/fixtures/offline_database/offline.archive";
 #ifndef __QT__ // Qt doesn't expose the ability to register virtual file system handlers.
 static constexpr const char* filename_test_fs = "file:test/fixtures/offline_database/offline.db?vfs=test_fs";
 #endif
@@ -94,6 +96,14 @@ static std::vector<std::string> databaseTableColumns(const std::string& path, co
     return columns;
 }
 
+static int databaseBlobCount(const std::string& path) {
+    mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Statement stmt{db, "SELECT COUNT(*) FROM blobs"};
+    mapbox::sqlite::Query query{stmt};
+    query.run();
+    return query.get<int>(0);
+}
+
 static int databaseAutoVacuum(const std::string& path) {
     mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
     mapbox::sqlite::Statement stmt{db, "pragma auto_vacuum"};
@@ -236,7 +246,7 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(SchemaVersion)) {
         OfflineDatabase db(filename, fixture::tileServerOptions);
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     OfflineDatabase db(filename, fixture::tileServerOptions);
     // Now try inserting and reading back to make sure we have a valid database.
@@ -366,6 +376,60 @@ TEST(OfflineDatabase, PutAndGetResource) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, PutAndGetWithEachDataCodec) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    Response response;
+    response.data = std::make_shared<std::string>(4096, 'a');
+
+    for (auto codec : {OfflineDataCodec::None, OfflineDataCodec::Zlib, OfflineDataCodec::Zstd}) {
+        db.setDataCodec(codec);
+        const auto url = "maptiler://example.com/style/"s + util::toString(static_cast<int>(codec));
+        const auto size = db.put(Resource::style(url), response).second;
+
+        if (db.getDataCodec() == OfflineDataCodec::None) {
+            EXPECT_EQ(response.data->size(), size);
+        } else {
+            EXPECT_GT(response.data->size(), size);
+        }
+
+        // Entries keep their codec when the database switches to another one.
+        db.setDataCodec(OfflineDataCodec::None);
+        auto result = db.get(Resource::style(url));
+        ASSERT_TRUE(result && result->data);
+        EXPECT_EQ(*response.data, *result->data);
+    }
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(UnknownDataCodecIsAMiss)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    Response response;
+    response.data = std::make_shared<std::string>(4096, 'a');
+    const Resource resource = Resource::style("maptiler://example.com/style");
+
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        db.put(resource, response);
+    }
+
+    {
+        // Stands in for an entry written by a newer version with a codec this
+        // one doesn't know about.
+        mapbox::sqlite::Database db = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadWriteCreate);
+        db.exec("UPDATE ambient_resources SET compressed = 99");
+    }
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    EXPECT_FALSE(bool(db.get(resource)));
+    EXPECT_EQ(1u, log.count({EventSeverity::Error, Event::Database, -1, "Can't read resource: Unknown data codec 99"}));
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, PutTile) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -766,13 +830,12 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(DeleteRegion)) {
         // should get back to the original size.
         db.clearAmbientCache();
 
-        // The size of the database has shrunk right away after deleted region
-        // is evicted from an ambient cache.
+        // The size of the database has shrunk right away after the region
+        // is deleted.
         const size_t sizeWithoutRegions = util::read_file(filename).size();
 
-        // The tiles from the offline region will migrate to the
-        // ambient cache and shrink the database to the maximum
-        // size defined by default.
+        // The tiles from the offline region are deleted with it
+        // instead of lingering in the ambient cache.
 #ifndef __QT__ // Qt doesn't decrease the size of the database file.
         EXPECT_LE(sizeWithoutRegions, util::DEFAULT_MAX_CACHE_SIZE);
 #endif
@@ -1207,6 +1270,224 @@ TEST(OfflineDatabase, PutRegionResourceDoesNotEvict) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, PutRegionResourceMovesAmbientEntryToRegion) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+
+    for (const auto& res : {fixture::resource, fixture::tile}) {
+        db.put(res, fixture::response);
+        db.putRegionResource(region->getID(), res, fixture::response);
+    }
+
+    // Clearing the ambient cache does not touch region data...
+    db.clearAmbientCache();
+    for (const auto& res : {fixture::resource, fixture::tile}) {
+        auto result = db.get(res);
+        ASSERT_TRUE(result && result->data);
+        EXPECT_EQ("first", *result->data);
+    }
+
+    // ...and ambient loads of a region resource refresh the region copy.
+    Response second;
+    second.data = std::make_shared<std::string>("second");
+    for (const auto& res : {fixture::resource, fixture::tile}) {
+        EXPECT_FALSE(db.put(res, second).first);
+    }
+    db.clearAmbientCache();
+    for (const auto& res : {fixture::resource, fixture::tile}) {
+        auto result = db.get(res);
+        ASSERT_TRUE(result && result->data);
+        EXPECT_EQ("second", *result->data);
+    }
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, MarkUsedMovesAmbientEntryToRegion) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+
+    db.put(fixture::resource, fixture::response);
+    db.put(fixture::tile, fixture::response);
+    EXPECT_EQ(5, *db.hasRegionResource(fixture::tile));
+
+    db.markUsedResources(region->getID(), {fixture::resource, fixture::tile});
+    db.clearAmbientCache();
+
+    auto status = db.getRegionCompletedStatus(region->getID());
+    ASSERT_TRUE(status);
+    EXPECT_EQ(2u, status->completedResourceCount);
+    EXPECT_EQ(1u, status->completedTileCount);
+    EXPECT_TRUE(bool(db.get(fixture::resource)));
+    EXPECT_TRUE(bool(db.get(fixture::tile)));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, DeleteRegionRemovesUnsharedEntries) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region1 = db.createRegion(definition, OfflineRegionMetadata());
+    auto region2 = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region1 && region2);
+
+    const Resource shared = Resource::style("http://example.com/shared");
+    const Resource own = Resource::style("http://example.com/own");
+    db.putRegionResource(region1->getID(), shared, fixture::response);
+    db.putRegionResource(region2->getID(), shared, fixture::response);
+    db.putRegionResource(region1->getID(), own, fixture::response);
+    db.putRegionResource(region1->getID(), fixture::tile, fixture::response);
+
+    EXPECT_TRUE(db.deleteRegion(std::move(*region1)) == nullptr);
+
+    EXPECT_TRUE(bool(db.get(shared)));
+    EXPECT_FALSE(bool(db.get(own)));
+    EXPECT_FALSE(bool(db.get(fixture::tile)));
+
+    auto status = db.getRegionCompletedStatus(region2->getID());
+    ASSERT_TRUE(status);
+    EXPECT_EQ(1u, status->completedResourceCount);
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(RegionEntriesShareBlobs)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region1 = db.createRegion(definition, OfflineRegionMetadata());
+    auto region2 = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region1 && region2);
+
+    Response ocean;
+    ocean.data = std::make_shared<std::string>("ocean");
+    Response land;
+    land.data = std::make_shared<std::string>("land");
+
+    const Resource style = Resource::style("http://example.com/style");
+    const Resource landTile = Resource::tile("maptiler://test", 1, 3, 0, 2, Tileset::Scheme::XYZ);
+    for (int32_t x = 0; x < 3; x++) {
+        db.putRegionResource(
+            region1->getID(), Resource::tile("maptiler://test", 1, x, 0, 2, Tileset::Scheme::XYZ), ocean);
+    }
+    db.putRegionResource(region1->getID(), landTile, land);
+    db.putRegionResource(region2->getID(), style, ocean);
+    EXPECT_EQ(2, databaseBlobCount(filename));
+
+    // Every entry reads and counts its own copy.
+    auto result = db.get(Resource::tile("maptiler://test", 1, 1, 0, 2, Tileset::Scheme::XYZ));
+    ASSERT_TRUE(result && result->data);
+    EXPECT_EQ("ocean", *result->data);
+    result = db.get(style);
+    ASSERT_TRUE(result && result->data);
+    EXPECT_EQ("ocean", *result->data);
+    auto status = db.getRegionCompletedStatus(region1->getID());
+    ASSERT_TRUE(status);
+    EXPECT_EQ(4u, status->completedTileCount);
+    EXPECT_EQ(19u, status->completedTileSize);
+
+    // The last entry of a blob releases it.
+    db.putRegionResource(region1->getID(), landTile, ocean);
+    EXPECT_EQ(1, databaseBlobCount(filename));
+    EXPECT_TRUE(db.deleteRegion(std::move(*region1)) == nullptr);
+    EXPECT_EQ(1, databaseBlobCount(filename));
+    EXPECT_TRUE(db.deleteRegion(std::move(*region2)) == nullptr);
+    EXPECT_EQ(0, databaseBlobCount(filename));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(AmbientCacheSizeIsPersisted)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    Response response;
+    response.data = randomString(1024);
+
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        db.setMaximumAmbientCacheSize(1024 * 100);
+        for (uint32_t i = 1; i <= 50; ++i) {
+            db.put(Resource::style("http://example.com/"s + util::toString(i)), response);
+        }
+    }
+
+    // A new session picks up the size from the previous one, so its first
+    // writes evict the oldest entries of the previous session.
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    db.setMaximumAmbientCacheSize(1024 * 100);
+    for (uint32_t i = 51; i <= 101; ++i) {
+        db.put(Resource::style("http://example.com/"s + util::toString(i)), response);
+    }
+
+    EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/1"))));
+    EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/101"))));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(AmbientCacheSizeIgnoresReads)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    const Resource resource = Resource::style("http://example.com/");
+    Response response;
+    response.data = randomString(1024);
+
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        db.put(resource, response);
+    }
+
+    // Count every write to the size row.
+    {
+        mapbox::sqlite::Database raw = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadWriteCreate);
+        raw.exec(
+            "CREATE TABLE size_writes (n INTEGER NOT NULL);"
+            "INSERT INTO size_writes (n) VALUES (0);"
+            "CREATE TRIGGER count_size_writes AFTER UPDATE ON ambient_cache_size "
+            "BEGIN UPDATE size_writes SET n = n + 1; END;");
+    }
+
+    const auto query = [](const char* sql) {
+        mapbox::sqlite::Database raw = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadOnly);
+        mapbox::sqlite::Statement stmt{raw, sql};
+        mapbox::sqlite::Query q{stmt};
+        q.run();
+        return q.get<int64_t>(0);
+    };
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    const int64_t size = query("SELECT size FROM ambient_cache_size");
+
+    // Reads refresh `accessed`, which isn't part of the size.
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(bool(db.get(resource)));
+    }
+    EXPECT_EQ(0, query("SELECT n FROM size_writes"));
+    EXPECT_EQ(size, query("SELECT size FROM ambient_cache_size"));
+
+    // New data still updates it.
+    response.data = randomString(2048);
+    db.put(resource, response);
+    EXPECT_LT(0, query("SELECT n FROM size_writes"));
+    EXPECT_EQ(size + 1024, query("SELECT size FROM ambient_cache_size"));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, PutFailsWhenEvictionInsuffices) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1322,6 +1603,38 @@ TEST(OfflineDatabase, HasRegionResourceTile) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, HasRegionResources) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+
+    const Resource stored = Resource::tile("http://example.com/", 1.0, 0, 0, 1, Tileset::Scheme::XYZ);
+    const Resource ambient = Resource::tile("http://example.com/", 1.0, 1, 0, 1, Tileset::Scheme::XYZ);
+    const Resource missing = Resource::tile("http://example.com/", 1.0, 1, 1, 1, Tileset::Scheme::XYZ);
+    const Resource style = Resource::style("http://example.com/style");
+
+    Response response;
+    response.data = std::make_shared<std::string>("first");
+    db.putRegionResource(region->getID(), stored, response);
+    db.putRegionResource(region->getID(), style, response);
+    response.data = std::make_shared<std::string>("second");
+    db.put(ambient, response);
+
+    const auto sizes = db.hasRegionResources({stored, ambient, missing, style});
+    ASSERT_EQ(4u, sizes.size());
+    EXPECT_EQ(5, sizes[0]);
+    EXPECT_EQ(6, sizes[1]);
+    EXPECT_FALSE(bool(sizes[2]));
+    EXPECT_EQ(5, sizes[3]);
+
+    EXPECT_TRUE(db.hasRegionResources({}).empty());
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, OfflineMapboxTileCount) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1462,7 +1775,7 @@ TEST(OfflineDatabase, MigrateFromV2Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
     EXPECT_LT(databasePageCount(filename), databasePageCount("test/fixtures/offline_database/v2.db"));
 
     EXPECT_EQ(0u, log.uncheckedCount());
@@ -1484,7 +1797,7 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1506,7 +1819,7 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     // Journal mode should be DELETE after migration to v5.
     EXPECT_EQ("delete", databaseJournalMode(filename));
@@ -1533,7 +1846,7 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{"id",
                                         "url_template",
@@ -1547,12 +1860,40 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
                                         "data",
                                         "compressed",
                                         "accessed",
-                                        "must_revalidate"}),
+                                        "must_revalidate",
+                                        "blob_id"}),
               databaseTableColumns(filename, "tiles"));
+    EXPECT_EQ((std::vector<std::string>{"id",
+                                        "url",
+                                        "kind",
+                                        "expires",
+                                        "modified",
+                                        "etag",
+                                        "data",
+                                        "compressed",
+                                        "accessed",
+                                        "must_revalidate",
+                                        "blob_id"}),
+              databaseTableColumns(filename, "resources"));
+    // The ambient cache keeps its data inline.
+    EXPECT_EQ((std::vector<std::string>{"id",
+                                        "url_template",
+                                        "pixel_ratio",
+                                        "z",
+                                        "x",
+                                        "y",
+                                        "expires",
+                                        "modified",
+                                        "etag",
+                                        "data",
+                                        "compressed",
+                                        "accessed",
+                                        "must_revalidate"}),
+              databaseTableColumns(filename, "ambient_tiles"));
     EXPECT_EQ(
         (std::vector<std::string>{
             "id", "url", "kind", "expires", "modified", "etag", "data", "compressed", "accessed", "must_revalidate"}),
-        databaseTableColumns(filename, "resources"));
+        databaseTableColumns(filename, "ambient_resources"));
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1590,7 +1931,7 @@ TEST(OfflineDatabase, DowngradeSchema) {
         db.setMaximumAmbientCacheSize(0);
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{"id",
                                         "url_template",
@@ -1604,12 +1945,21 @@ TEST(OfflineDatabase, DowngradeSchema) {
                                         "data",
                                         "compressed",
                                         "accessed",
-                                        "must_revalidate"}),
+                                        "must_revalidate",
+                                        "blob_id"}),
               databaseTableColumns(filename, "tiles"));
-    EXPECT_EQ(
-        (std::vector<std::string>{
-            "id", "url", "kind", "expires", "modified", "etag", "data", "compressed", "accessed", "must_revalidate"}),
-        databaseTableColumns(filename, "resources"));
+    EXPECT_EQ((std::vector<std::string>{"id",
+                                        "url",
+                                        "kind",
+                                        "expires",
+                                        "modified",
+                                        "etag",
+                                        "data",
+                                        "compressed",
+                                        "accessed",
+                                        "must_revalidate",
+                                        "blob_id"}),
+              databaseTableColumns(filename, "resources"));
 
     EXPECT_EQ(
         1u,
@@ -1975,6 +2325,46 @@ TEST(OfflineDatabase, MergeDatabaseWithInvalidDb) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(MergeDatabaseWithUndecodableCodec)) {
+    FixtureLog log;
+
+    // Unknown to every build, and zstd when this build can't decode it
+    std::vector<int64_t> codecs{99};
+    if (!util::zstd_supported()) {
+        codecs.push_back(static_cast<int64_t>(OfflineDataCodec::Zstd));
+    }
+
+    for (const auto codec : codecs) {
+        util::deleteFile(filename_sideload);
+        {
+            OfflineDatabase side(filename_sideload, fixture::tileServerOptions);
+            OfflineTilePyramidRegionDefinition definition{
+                "http://example.com/style", LatLngBounds::world(), 0, 0, 1.0, false};
+            auto region = side.createRegion(definition, {});
+            ASSERT_TRUE(region);
+            Response response;
+            response.data = std::make_shared<std::string>("style");
+            side.putRegionResource(region->getID(), Resource::style("http://example.com/style"), response);
+        }
+        {
+            mapbox::sqlite::Database side = mapbox::sqlite::Database::open(filename_sideload,
+                                                                           mapbox::sqlite::ReadWriteCreate);
+            side.exec("UPDATE resources SET compressed = " + util::toString(codec));
+        }
+
+        OfflineDatabase db(":memory:", fixture::tileServerOptions);
+        EXPECT_FALSE(db.mergeDatabase(filename_sideload));
+        EXPECT_EQ(1u,
+                  log.count({EventSeverity::Error,
+                             Event::Database,
+                             -1,
+                             "Merge database has entries in a data codec this build can't decode"}));
+        EXPECT_EQ(0u, db.listRegions()->size());
+    }
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 #ifndef __QT__ // Qt doesn't expose the ability to register virtual file system handlers.
 TEST(OfflineDatabase, TEST_REQUIRES_WRITE(MergeDatabaseWithDiskFull)) {
     FixtureLog log;
@@ -1997,6 +2387,172 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(MergeDatabaseWithDiskFull)) {
 }
 #endif // __QT__
 
+TEST(OfflineDatabase, ExportImportRegion) {
+    FixtureLog log;
+    util::deleteFile(filename_archive);
+
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+    OfflineTilePyramidRegionDefinition definition{"http://example.com/style", LatLngBounds::world(), 0, 1, 1.0, false};
+    const OfflineRegionMetadata metadata{1, 2, 3};
+    auto region = db.createRegion(definition, metadata);
+    ASSERT_TRUE(region);
+
+    const auto ocean = randomString(4096);
+    const Resource style = Resource::style("http://example.com/style");
+    const Resource land = Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+    const Resource empty = Resource::tile("http://example.com/", 1.0, 1, 1, 1, Tileset::Scheme::XYZ);
+    const Resource ocean2 = Resource::tile("http://example.com/", 1.0, 0, 1, 1, Tileset::Scheme::XYZ);
+    const Resource ambient = Resource::tile("http://example.com/", 1.0, 1, 0, 1, Tileset::Scheme::XYZ);
+
+    Response response;
+    response.data = std::make_shared<std::string>("style");
+    response.etag = "etag"s;
+    db.putRegionResource(region->getID(), style, response);
+    response.etag = std::nullopt;
+    response.data = std::make_shared<std::string>("land");
+    db.putRegionResource(region->getID(), land, response);
+    // Identical tiles are stored once in the archive.
+    response.data = ocean;
+    db.putRegionResource(
+        region->getID(), Resource::tile("http://example.com/", 1.0, 0, 0, 1, Tileset::Scheme::XYZ), response);
+    db.putRegionResource(region->getID(), ocean2, response);
+    response.data = nullptr;
+    response.noContent = true;
+    db.putRegionResource(region->getID(), empty, response);
+    // Not part of the region
+    response.data = std::make_shared<std::string>("ambient");
+    response.noContent = false;
+    db.put(ambient, response);
+
+    ASSERT_FALSE(db.exportRegion(region->getID(), filename_archive));
+
+    const auto archive = util::read_file(filename_archive);
+    EXPECT_NE(std::string::npos, archive.find(*ocean));
+    EXPECT_EQ(archive.find(*ocean), archive.rfind(*ocean));
+    EXPECT_EQ(std::string::npos, archive.find("ambient"));
+
+    OfflineDatabase other(":memory:", fixture::tileServerOptions);
+    auto imported = other.importRegion(filename_archive);
+    ASSERT_TRUE(imported);
+    EXPECT_EQ(encodeOfflineRegionDefinition(region->getDefinition()),
+              encodeOfflineRegionDefinition(imported->getDefinition()));
+    EXPECT_EQ(metadata, imported->getMetadata());
+
+    const auto status = db.getRegionCompletedStatus(region->getID());
+    const auto importedStatus = other.getRegionCompletedStatus(imported->getID());
+    ASSERT_TRUE(status && importedStatus);
+    EXPECT_EQ(status->completedResourceCount, importedStatus->completedResourceCount);
+    EXPECT_EQ(status->completedTileCount, importedStatus->completedTileCount);
+    EXPECT_EQ(4u, importedStatus->completedTileCount);
+
+    auto styleResponse = other.get(style);
+    ASSERT_TRUE(styleResponse && styleResponse->data);
+    EXPECT_EQ("style", *styleResponse->data);
+    EXPECT_EQ("etag"s, styleResponse->etag);
+    EXPECT_EQ("land", *other.get(land)->data);
+    EXPECT_EQ(*ocean, *other.get(ocean2)->data);
+    EXPECT_TRUE(other.get(empty)->noContent);
+    EXPECT_FALSE(other.get(ambient));
+
+    // Importing the same region again reuses it.
+    auto again = other.importRegion(filename_archive);
+    ASSERT_TRUE(again);
+    EXPECT_EQ(imported->getID(), again->getID());
+    EXPECT_EQ(1u, other.listRegions()->size());
+    EXPECT_EQ(4u, other.getRegionCompletedStatus(again->getID())->completedTileCount);
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, ImportCorruptArchive) {
+    FixtureLog log;
+    util::deleteFile(filename_archive);
+
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+    OfflineTilePyramidRegionDefinition definition{"http://example.com/style", LatLngBounds::world(), 0, 0, 1.0, false};
+    auto region = db.createRegion(definition, {});
+    ASSERT_TRUE(region);
+
+    Response response;
+    response.data = std::make_shared<std::string>("tile data");
+    db.putRegionResource(
+        region->getID(), Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), response);
+    ASSERT_FALSE(db.exportRegion(region->getID(), filename_archive));
+    const auto archive = util::read_file(filename_archive);
+
+    OfflineDatabase other(":memory:", fixture::tileServerOptions);
+
+    auto damaged = archive;
+    damaged[damaged.find("tile data")] = 'T';
+    util::write_file(filename_archive, damaged);
+    EXPECT_FALSE(other.importRegion(filename_archive));
+    EXPECT_EQ(1u,
+              log.count({EventSeverity::Error, Event::Database, -1, "Can't import region: Offline archive is corrupt"}));
+
+    util::write_file(filename_archive, archive.substr(0, archive.size() - 1));
+    EXPECT_FALSE(other.importRegion(filename_archive));
+    EXPECT_EQ(
+        1u, log.count({EventSeverity::Error, Event::Database, -1, "Can't import region: Offline archive is truncated"}));
+
+    util::write_file(filename_archive, "not an archive");
+    EXPECT_FALSE(other.importRegion(filename_archive));
+    EXPECT_EQ(1u, log.count({EventSeverity::Error, Event::Database, -1, "Can't import region: Not an offline archive"}));
+
+    // Nothing is kept from the failed imports.
+    EXPECT_EQ(0u, other.listRegions()->size());
+    EXPECT_FALSE(other.get(Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ)));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(ImportArchiveWithUndecodableCodec)) {
+    FixtureLog log;
+
+    // Unknown to every build, and zstd when this build can't decode it
+    std::vector<int64_t> codecs{99};
+    if (!util::zstd_supported()) {
+        codecs.push_back(static_cast<int64_t>(OfflineDataCodec::Zstd));
+    }
+
+    for (const auto codec : codecs) {
+        deleteDatabaseFiles();
+        util::deleteFile(filename_archive);
+        {
+            OfflineDatabase db(filename, fixture::tileServerOptions);
+            OfflineTilePyramidRegionDefinition definition{
+                "http://example.com/style", LatLngBounds::world(), 0, 0, 1.0, false};
+            auto region = db.createRegion(definition, {});
+            ASSERT_TRUE(region);
+            Response response;
+            response.data = std::make_shared<std::string>("tile data");
+            db.putRegionResource(
+                region->getID(), Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), response);
+        }
+        {
+            // Stands in for an entry written by a build with another codec,
+            // the archive keeps the codec the entry is stored with.
+            mapbox::sqlite::Database db = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadWriteCreate);
+            db.exec("UPDATE tiles SET compressed = " + util::toString(codec));
+        }
+        {
+            OfflineDatabase db(filename, fixture::tileServerOptions);
+            ASSERT_FALSE(db.exportRegion(db.listRegions()->front().getID(), filename_archive));
+        }
+
+        OfflineDatabase other(":memory:", fixture::tileServerOptions);
+        EXPECT_FALSE(other.importRegion(filename_archive));
+        EXPECT_EQ(1u,
+                  log.count({EventSeverity::Error,
+                             Event::Database,
+                             -1,
+                             "Can't import region: Offline archive uses data codec " + util::toString(codec) +
+                                 ", which this build can't decode"}));
+        EXPECT_EQ(0u, other.listRegions()->size());
+    }
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, ChangePath) {
     std::string newPath("test/fixtures/offline_database/test.db");
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
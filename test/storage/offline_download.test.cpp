@@ -673,6 +673,59 @@ TEST(OfflineDownload, WithPreviouslyExistingTile) {
     test.loop.run();
 }
 
+TEST(OfflineDownload, SkipsStoredTiles) {
+    OfflineTest test;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    OfflineDownload download(region->getID(),
+                             OfflineTilePyramidRegionDefinition(
+                                 "http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 2.0, 1.0, false),
+                             test.db,
+                             test.fileSource);
+
+    test.fileSource.styleResponse = [&](const Resource&) {
+        return test.response("inline_source.style.json");
+    };
+
+    // All of zoom level 1 is already stored.
+    for (uint32_t x = 0; x < 2; x++) {
+        for (uint32_t y = 0; y < 2; y++) {
+            test.db.put(
+                Resource::tile("http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf", 1, x, y, 1, Tileset::Scheme::XYZ),
+                test.response("0-0-0.vector.pbf"));
+        }
+    }
+
+    std::size_t tileRequests = 0;
+    test.fileSource.tileResponse = [&](const Resource& resource) {
+        EXPECT_NE(1, resource.tileData->z);
+        tileRequests++;
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    auto observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        if (status.complete()) {
+            EXPECT_EQ(21u, status.requiredTileCount);
+            EXPECT_EQ(21u, status.completedTileCount);
+            EXPECT_EQ(22u, status.completedResourceCount);
+            EXPECT_TRUE(status.requiredResourceCountIsPrecise);
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+
+    EXPECT_EQ(17u, tileRequests);
+
+    auto status = test.db.getRegionCompletedStatus(region->getID());
+    ASSERT_TRUE(status);
+    EXPECT_EQ(21u, status->completedTileCount);
+}
+
 TEST(OfflineDownload, ReactivatePreviouslyCompletedDownload) {
     OfflineTest test;
     auto region = test.createRegion();
@@ -11,6 +11,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 using namespace mbgl;
 
 #ifdef WIN32
@@ -613,6 +617,53 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(MaximumConcurrentRequests)) {
     ASSERT_EQ(*fs->getProperty(MAX_CONCURRENT_REQUESTS_KEY).getUint(), 10u);
 }
 
+TEST(OnlineFileSource, AdaptiveConcurrentRequests) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+
+    ASSERT_FALSE(*fs->getProperty(ADAPTIVE_CONCURRENT_REQUESTS_KEY).getBool());
+
+    fs->setProperty(ADAPTIVE_CONCURRENT_REQUESTS_KEY, true);
+    ASSERT_TRUE(*fs->getProperty(ADAPTIVE_CONCURRENT_REQUESTS_KEY).getBool());
+}
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(AdaptiveConcurrentRequestsLoad)) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+
+    fs->setProperty(ADAPTIVE_CONCURRENT_REQUESTS_KEY, true);
+    fs->setProperty(MAX_CONCURRENT_REQUESTS_KEY, 16u);
+
+    // Requests in flight on the server when each request arrived, in the
+    // order of the responses.
+    std::vector<int> inFlight;
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+
+    for (int i = 0; i < 200; ++i) {
+        Resource resource{Resource::Unknown, "http://127.0.0.1:3000/concurrency/" + util::toString(i)};
+        if (i % 2) {
+            resource.setPriority(Resource::Priority::Low);
+        }
+        requests.emplace_back(fs->request(resource, [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            EXPECT_TRUE(res.data);
+            inFlight.push_back(res.data ? std::stoi(*res.data) : 0);
+            if (inFlight.size() == 200) {
+                loop.stop();
+            }
+        }));
+    }
+
+    loop.run();
+
+    // The host starts at the initial limit of the controller, and never goes
+    // past the global limit. How the limit follows latency depends on the
+    // timing of the server, so it is tested with simulated latencies in
+    // request_concurrency_controller.test.cpp.
+    EXPECT_LE(*std::max_element(inFlight.begin(), inFlight.begin() + 8), 8);
+    EXPECT_LE(*std::max_element(inFlight.begin(), inFlight.end()), 16);
+}
+
 TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RequestSameUrlMultipleTimes)) {
     util::RunLoop loop;
     std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
@@ -0,0 +1,274 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/storage/request_concurrency_controller.hpp>
+#include <mbgl/storage/resource.hpp>
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Stand-in for a remote file source with simulated latency. The host serves
+// up to `capacity` requests in parallel at `baseLatency`; beyond that,
+// requests queue up and latency grows proportionally to the load.
+class SimulatedHost {
+public:
+    SimulatedHost(std::string host_, uint32_t capacity_, Duration baseLatency_)
+        : host(std::move(host_)),
+          capacity(capacity_),
+          baseLatency(baseLatency_) {}
+
+    void setCapacity(uint32_t capacity_) { capacity = capacity_; }
+
+    // Keeps as many requests in flight as the controller allows and completes
+    // `count` of them in simulated time.
+    void run(RequestConcurrencyController& controller, std::size_t count, bool failing = false) {
+        for (std::size_t completed = 0; completed < count;) {
+            while (controller.canActivate(host)) {
+                controller.onStarted(host);
+                const auto load = std::max<double>(1.0, double(controller.getActive(host)) / capacity);
+                inFlight.push({now + std::chrono::duration_cast<Duration>(baseLatency * load), now});
+            }
+
+            const Request request = inFlight.top();
+            inFlight.pop();
+            now = request.completesAt;
+            controller.onCompleted(host, request.completesAt - request.startedAt, !failing);
+            completed++;
+        }
+    }
+
+private:
+    struct Request {
+        TimePoint completesAt;
+        TimePoint startedAt;
+
+        bool operator>(const Request& other) const { return completesAt > other.completesAt; }
+    };
+
+    const std::string host;
+    uint32_t capacity;
+    const Duration baseLatency;
+    TimePoint now;
+    std::priority_queue<Request, std::vector<Request>, std::greater<>> inFlight;
+};
+
+// Keeps `host` at its limit and completes one request after `rtt`.
+void complete(RequestConcurrencyController& controller, const std::string& host, Duration rtt) {
+    while (controller.canActivate(host)) {
+        controller.onStarted(host);
+    }
+    controller.onCompleted(host, rtt, true);
+}
+
+// The members of an active online file source request that preemption reads.
+struct ActiveRequest {
+    ActiveRequest(std::string host_, Resource::Priority priority, TimePoint activatedAt_)
+        : resource(Resource::Unknown, host_ + "/resource"),
+          host(std::move(host_)),
+          activatedAt(activatedAt_) {
+        resource.setPriority(priority);
+    }
+
+    Resource resource;
+    std::string host;
+    TimePoint activatedAt;
+};
+
+} // namespace
+
+TEST(RequestConcurrencyController, HostForURL) {
+    EXPECT_EQ("http://127.0.0.1:3000", RequestConcurrencyController::hostForURL("http://127.0.0.1:3000/load/1"));
+    EXPECT_EQ("https://example.com", RequestConcurrencyController::hostForURL("https://example.com/a/b.pbf?key=1"));
+    EXPECT_EQ("https://example.com", RequestConcurrencyController::hostForURL("https://example.com"));
+}
+
+TEST(RequestConcurrencyController, InitialLimit) {
+    RequestConcurrencyController controller;
+    const std::string host = "https://example.com";
+
+    EXPECT_EQ(8u, controller.getLimit(host));
+    for (uint32_t i = 0; i < 8; ++i) {
+        EXPECT_TRUE(controller.canActivate(host));
+        controller.onStarted(host);
+    }
+    EXPECT_FALSE(controller.canActivate(host));
+
+    controller.onCancelled(host);
+    EXPECT_TRUE(controller.canActivate(host));
+    EXPECT_EQ(7u, controller.getActive(host));
+}
+
+TEST(RequestConcurrencyController, GrowsOnFastLink) {
+    RequestConcurrencyController controller;
+    SimulatedHost host("https://fast.example.com", 32, Milliseconds(100));
+
+    host.run(controller, 5000);
+
+    // Settles around the capacity of the host, within the latency tolerance.
+    EXPECT_GE(controller.getLimit("https://fast.example.com"), 24u);
+    EXPECT_LE(controller.getLimit("https://fast.example.com"), 40u);
+}
+
+TEST(RequestConcurrencyController, ShrinksOnCongestedLink) {
+    RequestConcurrencyController controller;
+    SimulatedHost host("https://mobile.example.com", 32, Milliseconds(100));
+
+    host.run(controller, 5000);
+    EXPECT_GE(controller.getLimit("https://mobile.example.com"), 24u);
+
+    // The link degrades; latency inflates and the limit follows.
+    host.setCapacity(4);
+    host.run(controller, 2000);
+
+    EXPECT_LE(controller.getLimit("https://mobile.example.com"), 8u);
+    EXPECT_GE(controller.getLimit("https://mobile.example.com"), 4u);
+}
+
+TEST(RequestConcurrencyController, BacksOffOnFailure) {
+    RequestConcurrencyController::Options options;
+    options.initialLimit = 32;
+    RequestConcurrencyController controller(options);
+    SimulatedHost host("https://failing.example.com", 64, Milliseconds(50));
+
+    host.run(controller, 1, true);
+    EXPECT_EQ(24u, controller.getLimit("https://failing.example.com"));
+
+    host.run(controller, 100, true);
+    EXPECT_EQ(options.minimumLimit, controller.getLimit("https://failing.example.com"));
+}
+
+TEST(RequestConcurrencyController, HostsAreIndependent) {
+    RequestConcurrencyController controller;
+    SimulatedHost fast("https://fast.example.com", 32, Milliseconds(50));
+    SimulatedHost slow("https://slow.example.com", 4, Milliseconds(400));
+
+    fast.run(controller, 5000);
+    slow.run(controller, 2000);
+
+    EXPECT_GT(controller.getLimit("https://fast.example.com"), controller.getLimit("https://slow.example.com"));
+}
+
+TEST(RequestConcurrencyController, MaximumLimit) {
+    RequestConcurrencyController controller;
+    SimulatedHost host("https://fast.example.com", 64, Milliseconds(100));
+
+    controller.setMaximumLimit(12);
+    host.run(controller, 5000);
+    EXPECT_EQ(12u, controller.getLimit("https://fast.example.com"));
+
+    controller.setMaximumLimit(2);
+    EXPECT_EQ(2u, controller.getLimit("https://fast.example.com"));
+}
+
+TEST(RequestConcurrencyController, MaximumLimitKeepsMinimum) {
+    RequestConcurrencyController controller;
+    SimulatedHost host("https://failing.example.com", 64, Milliseconds(50));
+
+    // A maximum below the minimum lowers it while it lasts.
+    controller.setMaximumLimit(2);
+    host.run(controller, 100, true);
+    EXPECT_EQ(2u, controller.getLimit("https://failing.example.com"));
+
+    // Raising the maximum again restores the configured minimum.
+    controller.setMaximumLimit(40);
+    EXPECT_EQ(4u, controller.getLimit("https://failing.example.com"));
+    host.run(controller, 100, true);
+    EXPECT_EQ(4u, controller.getLimit("https://failing.example.com"));
+}
+
+TEST(RequestConcurrencyController, AdditiveIncrease) {
+    RequestConcurrencyController controller;
+    const std::string host = "https://example.com";
+
+    // A flat latency grows the limit by about one per round trip, i.e. per
+    // `limit` completed requests.
+    for (uint32_t round = 0; round < 8; ++round) {
+        const uint32_t limit = controller.getLimit(host);
+        for (uint32_t i = 0; i <= limit; ++i) {
+            complete(controller, host, Milliseconds(100));
+        }
+        EXPECT_EQ(limit + 1, controller.getLimit(host));
+    }
+    EXPECT_EQ(16u, controller.getLimit(host));
+}
+
+TEST(RequestConcurrencyController, DecreaseFollowsLatency) {
+    RequestConcurrencyController controller;
+    const std::string host = "https://example.com";
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        complete(controller, host, Milliseconds(100));
+    }
+    const uint32_t grown = controller.getLimit(host);
+    EXPECT_LT(8u, grown);
+
+    // Latency within the tolerance doesn't shrink the limit.
+    for (uint32_t i = 0; i < 10; ++i) {
+        complete(controller, host, Milliseconds(140));
+    }
+    EXPECT_LE(grown, controller.getLimit(host));
+
+    // Beyond it, the limit shrinks with every sample until the minimum.
+    uint32_t limit = controller.getLimit(host);
+    for (uint32_t i = 0; i < 100; ++i) {
+        complete(controller, host, Milliseconds(400));
+        EXPECT_GE(limit, controller.getLimit(host));
+        limit = controller.getLimit(host);
+    }
+    EXPECT_EQ(4u, limit);
+}
+
+TEST(RequestConcurrencyController, PreemptsLowPriorityRequest) {
+    RequestConcurrencyController controller;
+    const std::string host = "https://example.com";
+    const TimePoint start;
+
+    // Fill the limit of the host with low priority requests.
+    std::vector<std::unique_ptr<ActiveRequest>> requests;
+    std::vector<ActiveRequest*> active;
+    for (uint32_t i = 0; i < 8; ++i) {
+        requests.push_back(
+            std::make_unique<ActiveRequest>(host, Resource::Priority::Low, start + Milliseconds(10 * i)));
+        active.push_back(requests.back().get());
+        controller.onStarted(host);
+    }
+    ASSERT_FALSE(controller.canActivate(host));
+
+    // The most recently started one gives up its slot.
+    ActiveRequest* victim = controller.preemptionCandidate(active, host, start + Milliseconds(100), Milliseconds(250));
+    EXPECT_EQ(requests.back().get(), victim);
+    controller.onCancelled(host);
+    EXPECT_TRUE(controller.canActivate(host));
+}
+
+TEST(RequestConcurrencyController, PreemptionCandidates) {
+    RequestConcurrencyController controller;
+    const std::string host = "https://example.com";
+    const std::string otherHost = "https://other.example.com";
+    const TimePoint start;
+    const TimePoint now = start + Milliseconds(500);
+
+    ActiveRequest regular(host, Resource::Priority::Regular, now);
+    ActiveRequest old(host, Resource::Priority::Low, start);
+    ActiveRequest other(otherHost, Resource::Priority::Low, now);
+
+    // Regular priority requests, and those older than the maximum age, keep
+    // their slot.
+    std::vector<ActiveRequest*> active{&regular, &old};
+    EXPECT_EQ(nullptr, controller.preemptionCandidate(active, host, now, Milliseconds(250)));
+    EXPECT_EQ(&old, controller.preemptionCandidate(active, host, now, Milliseconds(500)));
+
+    // A request to another host frees a global slot only, which doesn't help
+    // while the host of the new request is at its limit.
+    active.push_back(&other);
+    EXPECT_EQ(&other, controller.preemptionCandidate(active, host, now, Milliseconds(250)));
+    for (uint32_t i = 0; i < 8; ++i) {
+        controller.onStarted(host);
+    }
+    EXPECT_EQ(nullptr, controller.preemptionCandidate(active, host, now, Milliseconds(250)));
+}
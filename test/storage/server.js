@@ -173,6 +173,25 @@ app.get('/load/:number(\\d+)', function(req, res) {
     res.send('Request ' + req.params.number);
 });
 
+// Answers with the number of /concurrency requests in flight when this one
+// arrived, itself included.
+var concurrentRequests = 0;
+app.get('/concurrency/:number(\\d+)', function(req, res) {
+    var inFlight = ++concurrentRequests;
+    var done = false;
+    function finish() {
+        if (!done) {
+            done = true;
+            concurrentRequests--;
+        }
+    }
+    res.on('close', finish);
+    setTimeout(function() {
+        finish();
+        res.send(String(inFlight));
+    }, 10);
+});
+
 app.get('/online/:style(*)', function(req, res) {
     const file = path.join(import.meta.dirname, "../fixtures/map/online", req.params.style);
     res.sendFile(file); // Set disposition and send it.
@@ -0,0 +1,201 @@
+#include <mbgl/style/conversion/filter.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/expression/bytecode.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+#include <mbgl/style/filter.hpp>
+#include <mbgl/style/property_expression.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+#include <mbgl/test/util.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::style;
+using namespace mbgl::style::expression;
+using namespace mbgl::style::expression::dsl;
+
+using namespace std::string_literals;
+
+namespace {
+
+const std::vector<StubGeometryTileFeature> features{
+    {PropertyMap{}},
+    {PropertyMap{{"class", "primary"s}, {"rank", uint64_t(3)}, {"height", 12.5}, {"oneway", true}}},
+    {PropertyMap{{"class", "minor"s}, {"rank", int64_t(-2)}, {"height", 0.0}, {"name", ""s}}},
+    {PropertyMap{{"class", "path"s}, {"rank", 1.5}, {"height", "40"s}, {"name", "Main Street"s}}},
+    {FeatureIdentifier(uint64_t(7)), FeatureType::Polygon, {}, PropertyMap{{"rank", uint64_t(10)}}},
+    {FeatureIdentifier("way/1"s), FeatureType::LineString, {}, PropertyMap{{"class", NullValue()}, {"oneway", false}}},
+};
+
+// Counts the property reads
+class CountingFeature : public StubGeometryTileFeature {
+public:
+    using StubGeometryTileFeature::StubGeometryTileFeature;
+
+    std::optional<mbgl::Value> getValue(const std::string& key) const override {
+        ++reads;
+        return StubGeometryTileFeature::getValue(key);
+    }
+
+    mutable std::size_t reads = 0;
+};
+
+void expectParity(const Expression& expression, const Bytecode& bytecode, const std::string& json);
+
+// The compiled form gives the same results as the tree, or none where the tree fails.
+void expectParity(const std::string& json) {
+    const auto expression = createExpression(json.c_str());
+    ASSERT_TRUE(expression) << json;
+    const auto bytecode = Bytecode::compile(*expression);
+    ASSERT_TRUE(bytecode) << json;
+
+    expectParity(*expression, *bytecode, json);
+}
+
+void expectParity(const Expression& expression, const Bytecode& bytecode, const std::string& json) {
+    for (const float zoom : {0.0f, 7.5f, 14.0f, 22.0f}) {
+        for (const auto& feature : features) {
+            const EvaluationContext context(zoom, &feature);
+            const EvaluationResult expected = expression.evaluate(context);
+            const std::optional<Value> actual = bytecode.evaluate(context);
+            if (expected) {
+                ASSERT_TRUE(actual) << json;
+                EXPECT_EQ(*expected, *actual) << json;
+            } else {
+                EXPECT_FALSE(actual) << json;
+            }
+        }
+    }
+}
+
+void expectFilterParity(const std::string& json) {
+    conversion::Error error;
+    const std::optional<Filter> filter = conversion::convertJSON<Filter>(json, error);
+    ASSERT_TRUE(filter && filter->expression) << json << ": " << error.message;
+    const auto bytecode = Bytecode::compile(**filter->expression);
+    ASSERT_TRUE(bytecode) << json;
+    expectParity(**filter->expression, *bytecode, json);
+}
+
+} // namespace
+
+TEST(Bytecode, Parity) {
+    expectParity(R"(["get", "class"])");
+    expectParity(R"(["has", "name"])");
+    expectParity(R"(["id"])");
+    expectParity(R"(["geometry-type"])");
+    expectParity(R"(["+", ["number", ["get", "rank"], 0], ["*", ["zoom"], 2], 1])");
+    expectParity(R"(["-", ["/", ["number", ["get", "rank"], 0], ["-", ["zoom"], 7]]])");
+    expectParity(R"(["max", ["%", ["zoom"], 4], ["^", 2, ["number", ["get", "rank"], 1]], ["sqrt", ["zoom"]]])");
+    expectParity(R"(["round", ["log2", ["abs", ["number", ["get", "rank"], 1]]]])");
+    expectParity(R"(["to-number", ["get", "height"]])");
+    expectParity(R"(["to-boolean", ["get", "name"]])");
+    expectParity(R"(["==", ["get", "class"], "primary"])");
+    expectParity(R"(["!=", ["get", "rank"], 3])");
+    expectParity(R"(["<", ["get", "height"], 20])");
+    expectParity(R"([">=", ["string", ["get", "class"], ""], "minor"])");
+    expectParity(R"(["all", ["has", "rank"], ["!", ["get", "oneway"]]])");
+    expectParity(R"(["any", ["==", ["get", "oneway"], true], [">", ["zoom"], 10]])");
+    expectParity(R"(["case", ["has", "name"], ["get", "name"], ["has", "class"], ["get", "class"], "none"])");
+    expectParity(R"(["coalesce", ["get", "name"], ["get", "class"], "unnamed"])");
+    expectParity(R"(["match", ["get", "class"], "primary", 10, ["minor", "path"], 5, 0])");
+    expectParity(R"(["match", ["get", "rank"], 3, "three", [-2, 10], "other", "none"])");
+    expectParity(R"(["step", ["zoom"], "low", 8, "mid", 14, "high"])");
+    expectParity(R"(["interpolate", ["linear"], ["zoom"], 5, 1, 10, 4, 15, 16])");
+    expectParity(R"(["interpolate", ["exponential", 1.5], ["number", ["get", "rank"], 0], 0, ["to-color", "red"], 10, ["to-color", "blue"]])");
+    expectParity(R"(["interpolate", ["cubic-bezier", 0.4, 0, 0.6, 1], ["zoom"], 0, 0, 20, 1])");
+}
+
+TEST(Bytecode, Unsupported) {
+    EXPECT_FALSE(Bytecode::compile(*createExpression(R"(["feature-state", "hover"])")));
+    EXPECT_FALSE(Bytecode::compile(*createExpression(R"(["let", "a", ["get", "rank"], ["var", "a"]])")));
+    EXPECT_FALSE(Bytecode::compile(*createExpression(R"(["get", ["get", "key"]])")));
+    EXPECT_FALSE(Bytecode::compile(*createExpression(R"(["upcase", ["string", ["get", "class"]]])")));
+    // Stops that aren't constant
+    EXPECT_FALSE(Bytecode::compile(
+        *createExpression(R"(["interpolate", ["linear"], ["zoom"], 0, 0, 10, ["number", ["get", "rank"]]])")));
+}
+
+TEST(Bytecode, Errors) {
+    const auto expression = createExpression(R"(["number", ["get", "height"]])");
+    const auto bytecode = Bytecode::compile(*expression);
+    ASSERT_TRUE(bytecode);
+
+    EXPECT_EQ(std::optional<float>(12.5f), bytecode->evaluate<float>(EvaluationContext(&features[1])));
+    EXPECT_FALSE(bytecode->evaluate<float>(EvaluationContext(&features[3])));
+    EXPECT_FALSE(bytecode->evaluate<std::string>(EvaluationContext(&features[1])));
+    // Feature data is unavailable
+    EXPECT_FALSE(bytecode->evaluate<float>(EvaluationContext(7.0f)));
+
+    // The tree reports the error, so the default value applies
+    const PropertyExpression<float> property(createExpression(R"(["number", ["get", "height"]])"), 3.0f);
+    ASSERT_TRUE(property.getBytecode());
+    EXPECT_EQ(12.5f, property.evaluate(features[1], 0.0f));
+    EXPECT_EQ(3.0f, property.evaluate(features[3], 0.0f));
+}
+
+TEST(Bytecode, ConstantFolding) {
+    // Built without the parser, which folds the constant operand itself
+    const auto expression = lt(number(get("rank")), number(literal(3.0)));
+    const auto bytecode = Bytecode::compile(*expression);
+    ASSERT_TRUE(bytecode);
+
+    // get, type check, fail, constant, compare, return
+    EXPECT_EQ(6u, bytecode->getInstructionCount());
+    EXPECT_EQ(std::optional<bool>(false), bytecode->evaluate<bool>(EvaluationContext(&features[1])));
+    EXPECT_EQ(std::optional<bool>(true), bytecode->evaluate<bool>(EvaluationContext(&features[3])));
+}
+
+TEST(Bytecode, LegacyFilters) {
+    expectFilterParity(R"(["==", "class", "primary"])");
+    expectFilterParity(R"(["==", "class", null])");
+    expectFilterParity(R"(["!=", "rank", 3])");
+    expectFilterParity(R"(["==", "oneway", false])");
+    expectFilterParity(R"(["<", "rank", 3])");
+    expectFilterParity(R"([">=", "height", 12.5])");
+    expectFilterParity(R"(["<=", "class", "path"])");
+    expectFilterParity(R"([">", "height", "35"])");
+    expectFilterParity(R"(["in", "class", "primary", "path", null])");
+    expectFilterParity(R"(["!in", "rank", 3, 10, -2, true])");
+    expectFilterParity(R"(["in", "oneway", false])");
+    expectFilterParity(R"(["has", "name"])");
+    expectFilterParity(R"(["!has", "class"])");
+    expectFilterParity(R"(["==", "$type", "Polygon"])");
+    expectFilterParity(R"(["in", "$type", "LineString", "Polygon"])");
+    expectFilterParity(R"(["==", "$id", 7])");
+    expectFilterParity(R"(["in", "$id", "way/1", null])");
+    expectFilterParity(R"(["<", "$id", 10])");
+    expectFilterParity(R"(["has", "$id"])");
+    expectFilterParity(R"(["!has", "$id"])");
+    expectFilterParity(R"(["all", ["==", "class", "primary"], ["<", "rank", 5], ["!has", "name"]])");
+    expectFilterParity(R"(["any", ["in", "class", "minor", "path"], ["none", ["has", "rank"]]])");
+}
+
+TEST(Bytecode, PropertyKeys) {
+    // Every key is read once per evaluation, however many times the filter uses it
+    conversion::Error error;
+    const std::optional<Filter> filter = conversion::convertJSON<Filter>(
+        R"(["all", ["has", "class"], ["!=", "class", "minor"], ["in", "class", "primary", "path"], [">", "rank", 1]])",
+        error);
+    ASSERT_TRUE(filter);
+
+    const CountingFeature feature(PropertyMap{{"class", "primary"s}, {"rank", uint64_t(3)}});
+    EXPECT_TRUE((*filter)(EvaluationContext(&feature)));
+    EXPECT_EQ(2u, feature.reads);
+}
+
+TEST(Bytecode, PropertyExpression) {
+    // Only data driven expressions are compiled
+    EXPECT_FALSE(PropertyExpression<float>(createExpression(R"(["interpolate", ["linear"], ["zoom"], 0, 0, 10, 1])"))
+                     .getBytecode());
+    EXPECT_TRUE(PropertyExpression<float>(createExpression(R"(["number", ["get", "rank"], 0])")).getBytecode());
+
+    const PropertyExpression<Color> color(createExpression(
+        R"(["interpolate", ["linear"], ["number", ["get", "rank"], 0], 0, ["to-color", "red"], 10, ["to-color", "blue"]])"));
+    ASSERT_TRUE(color.getBytecode());
+    EXPECT_EQ(Color::red(), color.evaluate(features[0], Color()));
+    EXPECT_EQ(Color::blue(), color.evaluate(features[4], Color()));
+    EXPECT_EQ(color.getExpression().evaluate(EvaluationContext(&features[1]))->get<Color>(),
+              color.evaluate(features[1], Color()));
+}
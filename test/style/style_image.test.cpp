@@ -1,6 +1,7 @@
 #include <mbgl/test/util.hpp>
 
 #include <mbgl/style/image.hpp>
+#include <mbgl/style/image_impl.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/exception.hpp>
 
@@ -123,3 +124,28 @@ TEST(StyleImage, StretchContent) {
     EXPECT_EQ((style::ImageStretches{{0.0f, 4.0f}, {12.0f, 16.0f}}), image.getStretchY());
     EXPECT_EQ((style::ImageContent{2, 2, 14, 14}), image.getContent());
 }
+
+TEST(StyleImage, SpriteSheet) {
+    auto sheet = std::make_shared<PremultipliedImage>(Size{4, 2});
+    for (uint8_t i = 0; i < sheet->bytes(); ++i) {
+        sheet->data[i] = i;
+    }
+
+    const style::Image::Impl impl("test", sheet, Rect<uint32_t>(2, 0, 2, 2), 1.0f);
+    EXPECT_EQ(Size(2, 2), impl.getSize());
+    EXPECT_EQ(16u, impl.bytes());
+    // Not copied out of the sheet yet
+    EXPECT_EQ(2, sheet.use_count());
+
+    const PremultipliedImage& image = impl.getImage();
+    EXPECT_EQ(1, sheet.use_count());
+    ASSERT_EQ(Size(2, 2), image.size);
+    for (uint32_t y = 0; y < 2; ++y) {
+        for (uint32_t x = 0; x < 2; ++x) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                EXPECT_EQ(sheet->data[(y * 4 + x + 2) * 4 + c], image.data[(y * 2 + x) * 4 + c]);
+            }
+        }
+    }
+    EXPECT_EQ(&image, &impl.getImage());
+}
@@ -441,3 +441,142 @@ TEST(CrossTileSymbolLayerIndex, offscreenSymbols) {
     EXPECT_EQ(symbolBucket.symbolInstances.at(0).getCrossTileID(), 1u);
     EXPECT_EQ(symbolBucket.symbolInstances.at(1).getCrossTileID(), 2u);
 }
+
+TEST(CrossTileSymbolLayerIndex, repeatedKeys) {
+    uint32_t maxCrossTileID = 0;
+    CrossTileSymbolLayerIndex index(maxCrossTileID);
+
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    bool iconsNeedLinear = false;
+    bool sortFeaturesByY = false;
+    std::string bucketLeaderID = "test";
+
+    // Enough symbols with the same key for the index to put them in a grid
+    constexpr std::size_t count = 64;
+    static_assert(count > TileLayerIndex::gridThreshold);
+
+    OverscaledTileID mainID(6, 0, 6, 8, 8);
+    std::vector<SymbolInstance> mainInstances;
+    std::vector<SortKeyRange> mainRanges;
+    for (std::size_t i = 0; i < count; ++i) {
+        mainInstances.push_back(makeSymbolInstance(100.0f * i + 50.0f, 1000, u"Main Street"));
+    }
+    SymbolBucket mainBucket{layout,
+                            {},
+                            16.0f,
+                            1.0f,
+                            0,
+                            iconsNeedLinear,
+                            sortFeaturesByY,
+                            bucketLeaderID,
+                            std::move(mainInstances),
+                            std::move(mainRanges),
+                            1.0f,
+                            false,
+                            {},
+                            false /*iconsInText*/};
+    mainBucket.bucketInstanceId = 1;
+    index.addBucket(mainID, mat4{}, mainBucket);
+    ASSERT_EQ(maxCrossTileID, count);
+
+    // The child tile covers the first 41 symbols of the parent, in reverse order
+    OverscaledTileID childID(7, 0, 7, 16, 16);
+    std::vector<SymbolInstance> childInstances;
+    std::vector<SortKeyRange> childRanges;
+    constexpr std::size_t childCount = 41;
+    for (std::size_t i = childCount; i-- > 0;) {
+        childInstances.push_back(makeSymbolInstance(200.0f * i + 101.0f, 2001, u"Main Street"));
+    }
+    childInstances.push_back(makeSymbolInstance(8000, 8000, u"Main Street"));
+    SymbolBucket childBucket{layout,
+                             {},
+                             16.0f,
+                             1.0f,
+                             0,
+                             iconsNeedLinear,
+                             sortFeaturesByY,
+                             bucketLeaderID,
+                             std::move(childInstances),
+                             std::move(childRanges),
+                             1.0f,
+                             false,
+                             {},
+                             false /*iconsInText*/};
+    childBucket.bucketInstanceId = 2;
+    index.addBucket(childID, mat4{}, childBucket);
+
+    for (std::size_t i = 0; i < childCount; ++i) {
+        EXPECT_EQ(childBucket.symbolInstances.at(i).getCrossTileID(), childCount - i);
+    }
+    // No parent symbol at this location
+    EXPECT_EQ(childBucket.symbolInstances.at(childCount).getCrossTileID(), count + 1);
+}
+
+TEST(CrossTileSymbolLayerIndex, childTileOrder) {
+    uint32_t maxCrossTileID = 0;
+    CrossTileSymbolLayerIndex index(maxCrossTileID);
+
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    bool iconsNeedLinear = false;
+    bool sortFeaturesByY = false;
+    std::string bucketLeaderID = "test";
+
+    // Four child tiles each hold a symbol at the shared corner in the middle of the parent tile.
+    // They are added out of tile order and get cross tile IDs 1-4.
+    const std::vector<std::pair<OverscaledTileID, Point<float>>> children = {
+        {OverscaledTileID(7, 0, 7, 17, 17), {0, 0}},
+        {OverscaledTileID(7, 0, 7, 16, 17), {8191, 0}},
+        {OverscaledTileID(7, 0, 7, 17, 16), {0, 8191}},
+        {OverscaledTileID(7, 0, 7, 16, 16), {8191, 8191}},
+    };
+    std::vector<std::unique_ptr<SymbolBucket>> childBuckets;
+    for (const auto& [childID, anchor] : children) {
+        std::vector<SymbolInstance> childInstances;
+        childInstances.push_back(makeSymbolInstance(anchor.x, anchor.y, u"Corner"));
+        std::vector<SortKeyRange> childRanges;
+        childBuckets.push_back(
+            std::make_unique<SymbolBucket>(layout,
+                                           std::map<std::string, Immutable<style::LayerProperties>>{},
+                                           16.0f,
+                                           1.0f,
+                                           0,
+                                           iconsNeedLinear,
+                                           sortFeaturesByY,
+                                           bucketLeaderID,
+                                           std::move(childInstances),
+                                           std::move(childRanges),
+                                           1.0f,
+                                           false,
+                                           std::vector<style::TextWritingModeType>{},
+                                           false /*iconsInText*/));
+        childBuckets.back()->bucketInstanceId = static_cast<uint32_t>(childBuckets.size());
+        index.addBucket(childID, mat4{}, *childBuckets.back());
+        ASSERT_EQ(childBuckets.back()->symbolInstances.at(0).getCrossTileID(), childBuckets.size());
+    }
+
+    // The parent symbol matches all four children; the first child in tile order claims it.
+    OverscaledTileID parentID(6, 0, 6, 8, 8);
+    std::vector<SymbolInstance> parentInstances;
+    parentInstances.push_back(makeSymbolInstance(4096, 4096, u"Corner"));
+    std::vector<SortKeyRange> parentRanges;
+    SymbolBucket parentBucket{layout,
+                              {},
+                              16.0f,
+                              1.0f,
+                              0,
+                              iconsNeedLinear,
+                              sortFeaturesByY,
+                              bucketLeaderID,
+                              std::move(parentInstances),
+                              std::move(parentRanges),
+                              1.0f,
+                              false,
+                              {},
+                              false /*iconsInText*/};
+    parentBucket.bucketInstanceId = 5;
+    index.addBucket(parentID, mat4{}, parentBucket);
+
+    EXPECT_EQ(parentBucket.symbolInstances.at(0).getCrossTileID(), 4u);
+}
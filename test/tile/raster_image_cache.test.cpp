@@ -0,0 +1,51 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/raster_image_cache.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace mbgl;
+
+TEST(RasterImageCache, Decode) {
+    RasterImageCache cache(1024 * 1024);
+    const auto png = std::make_shared<const std::string>(util::read_file("test/fixtures/image/tile.png"));
+
+    const auto image = cache.decode(png);
+    ASSERT_TRUE(image && image->valid());
+    // The encoded data is kept to tell apart data with the same hash
+    EXPECT_EQ(image->bytes() + png->size(), cache.getBytes());
+    EXPECT_EQ(0u, cache.getHits());
+
+    // The same data, loaded again
+    const auto copy = std::make_shared<const std::string>(*png);
+    EXPECT_EQ(image, cache.decode(copy));
+    EXPECT_EQ(1u, cache.getHits());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getBytes());
+    EXPECT_NE(image, cache.decode(png));
+}
+
+TEST(RasterImageCache, Evict) {
+    const auto png = std::make_shared<const std::string>(util::read_file("test/fixtures/image/tile.png"));
+    const auto jpeg = std::make_shared<const std::string>(util::read_file("test/fixtures/image/tile.jpeg"));
+
+    // Room for one of the images, with its encoded data
+    const std::size_t pngBytes = RasterImageCache(0).decode(png)->bytes() + png->size();
+    const std::size_t jpegBytes = RasterImageCache(0).decode(jpeg)->bytes() + jpeg->size();
+    RasterImageCache cache(pngBytes + jpegBytes - 1);
+
+    const auto first = cache.decode(png);
+    cache.decode(jpeg);
+    EXPECT_EQ(jpegBytes, cache.getBytes());
+    EXPECT_NE(first, cache.decode(png));
+    EXPECT_EQ(0u, cache.getHits());
+}
+
+TEST(RasterImageCache, Invalid) {
+    RasterImageCache cache(1024 * 1024);
+    EXPECT_ANY_THROW(cache.decode(std::make_shared<const std::string>("invalid")));
+    EXPECT_EQ(0u, cache.getBytes());
+}
@@ -0,0 +1,114 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <stdexcept>
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+std::string makeData(std::size_t size) {
+    std::string data;
+    data.reserve(size);
+    for (std::size_t i = 0; data.size() < size; ++i) {
+        data += std::to_string(i * 7919 % 104729);
+    }
+    data.resize(size);
+    return data;
+}
+
+} // namespace
+
+TEST(Compression, RoundTrip) {
+    for (const std::size_t size : {std::size_t(0), std::size_t(1), std::size_t(1000), std::size_t(1 << 20)}) {
+        const std::string data = makeData(size);
+        for (const int format : {util::ZLIB, util::GZIP, util::DEFLATE}) {
+            const std::string compressed = util::compress(data, format);
+            EXPECT_EQ(data, util::decompress(compressed, format)) << size << " " << format;
+            if (format != util::DEFLATE) {
+                EXPECT_EQ(data, util::decompress(compressed)) << size << " " << format;
+            }
+        }
+    }
+}
+
+TEST(Compression, SizeHint) {
+    // A wrong gzip size trailer fails the length check
+    const std::string data = makeData(100000);
+    std::string compressed = util::compress(data, util::GZIP);
+    compressed[compressed.size() - 4] = 1;
+    compressed[compressed.size() - 3] = 0;
+    compressed[compressed.size() - 2] = 0;
+    compressed[compressed.size() - 1] = 0;
+    EXPECT_ANY_THROW(util::decompress(compressed));
+
+    // The buffer grows past the hint, and doesn't keep the spare capacity
+    const std::string zlib = util::compress(std::string(1 << 20, 'a'));
+    const std::string result = util::decompress(zlib);
+    EXPECT_EQ(std::string(1 << 20, 'a'), result);
+    EXPECT_LE(result.capacity(), result.size() + result.size() / 2);
+}
+
+TEST(Compression, LyingSizeTrailer) {
+    // The trailer claims 4 GiB. Only a small multiple of the input is
+    // allocated for it, then the length check fails.
+    std::string compressed = util::compress(makeData(1 << 20), util::GZIP);
+    for (std::size_t i = compressed.size() - 4; i < compressed.size(); ++i) {
+        compressed[i] = '\xFF';
+    }
+    try {
+        util::decompress(compressed);
+        FAIL() << "the length check should fail";
+    } catch (const std::runtime_error& error) {
+        EXPECT_STREQ("incorrect length check", error.what());
+    }
+}
+
+TEST(Compression, Invalid) {
+    EXPECT_ANY_THROW(util::decompress("invalid"));
+
+    const std::string compressed = util::compress(makeData(10000));
+    EXPECT_ANY_THROW(util::decompress(compressed.substr(0, compressed.size() / 2)));
+
+    // The stream state doesn't carry over to the next call
+    EXPECT_EQ(makeData(10000), util::decompress(compressed));
+}
+
+TEST(Compression, VectorTile) {
+    const std::string tile = util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf");
+    EXPECT_EQ(tile, util::decompress(util::compress(tile, util::GZIP)));
+}
+
+TEST(Compression, Zstd) {
+    if (!util::zstd_supported()) {
+        EXPECT_ANY_THROW(util::compress_zstd("data"));
+        return;
+    }
+
+    for (const std::size_t size : {std::size_t(0), std::size_t(1000), std::size_t(1 << 20)}) {
+        const std::string data = makeData(size);
+        EXPECT_EQ(data, util::decompress_zstd(util::compress_zstd(data))) << size;
+    }
+
+    EXPECT_ANY_THROW(util::decompress_zstd("invalid"));
+
+    // A single RLE block holding one byte
+    const std::string magic("\x28\xB5\x2F\xFD", 4);
+    const std::string block("\x0B\x00\x00" "a", 4);
+
+    // A header claiming 1 TiB, which a frame this small can't hold, is
+    // rejected before the output is allocated.
+    const std::string huge = magic + std::string("\xE0\x00\x00\x00\x00\x00\x01\x00\x00", 9) + block;
+    EXPECT_ANY_THROW(util::decompress_zstd(huge));
+
+    // Frames without a content size are rejected.
+    const std::string unknown = magic + std::string("\x00\x00", 2) + block;
+    EXPECT_ANY_THROW(util::decompress_zstd(unknown));
+
+    // The same block with the right size
+    const std::string one = magic + std::string("\x20\x01", 2) + block;
+    EXPECT_EQ("a", util::decompress_zstd(one));
+}
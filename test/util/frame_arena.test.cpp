@@ -0,0 +1,115 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/frame_arena.hpp>
+
+#include <cstdint>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+TEST(FrameArena, Alignment) {
+    FrameArena arena(256);
+
+    arena.allocate(1, 1);
+    for (std::size_t alignment : {2, 4, 8, 16, 64, 256}) {
+        void* ptr = arena.allocate(3, alignment);
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(ptr) % alignment);
+    }
+}
+
+TEST(FrameArena, Containers) {
+    FrameArena arena(128);
+
+    FrameVector<int> vector(arena);
+    for (int i = 0; i < 1000; ++i) {
+        vector.push_back(i);
+    }
+    EXPECT_EQ(999, vector.back());
+
+    FrameSet<int> set(arena);
+    for (int i = 100; i > 0; --i) {
+        set.insert(i);
+    }
+    EXPECT_EQ(100u, set.size());
+    EXPECT_EQ(1, *set.begin());
+}
+
+TEST(FrameArena, ResetMergesBlocks) {
+    FrameArena arena(1024);
+    EXPECT_EQ(1u, arena.getBlockAllocations());
+
+    const auto frame = [&] {
+        for (int i = 0; i < 100; ++i) {
+            arena.allocate(100, 8);
+        }
+    };
+
+    frame();
+    EXPECT_GT(arena.getBlockAllocations(), 1u);
+    EXPECT_GE(arena.getUsed(), 100u * 100u);
+
+    // The next frame of the same size fits into a single block.
+    arena.reset();
+    EXPECT_EQ(0u, arena.getUsed());
+    const std::size_t blockAllocations = arena.getBlockAllocations();
+    const std::size_t capacity = arena.getCapacity();
+
+    frame();
+    arena.reset();
+    frame();
+    EXPECT_EQ(blockAllocations, arena.getBlockAllocations());
+    EXPECT_EQ(capacity, arena.getCapacity());
+}
+
+TEST(FrameArena, ResetShrinksAfterQuietFrames) {
+    FrameArena arena(1024);
+
+    // A single busy frame grows the block.
+    for (int i = 0; i < 1000; ++i) {
+        arena.allocate(100, 8);
+    }
+    arena.reset();
+    const std::size_t grown = arena.getCapacity();
+    EXPECT_GE(grown, 100u * 1000u);
+
+    const auto quietFrame = [&] {
+        for (int i = 0; i < 10; ++i) {
+            arena.allocate(100, 8);
+        }
+        arena.reset();
+    };
+
+    // It is kept for a while, in case the load comes back.
+    for (std::size_t i = 1; i < FrameArena::shrinkInterval; ++i) {
+        quietFrame();
+    }
+    EXPECT_EQ(grown, arena.getCapacity());
+
+    // Then sized for the recent frames, but never below the initial block.
+    quietFrame();
+    EXPECT_LT(arena.getCapacity(), grown);
+    EXPECT_GE(arena.getCapacity(), 2u * 10u * 100u);
+
+    for (std::size_t i = 0; i < FrameArena::shrinkInterval; ++i) {
+        arena.reset();
+    }
+    EXPECT_EQ(1024u, arena.getCapacity());
+}
+
+TEST(FrameArena, ResetKeepsBlockUnderSteadyLoad) {
+    FrameArena arena(1024);
+
+    const auto frame = [&] {
+        for (int i = 0; i < 100; ++i) {
+            arena.allocate(100, 8);
+        }
+        arena.reset();
+    };
+
+    frame();
+    const std::size_t blockAllocations = arena.getBlockAllocations();
+    for (std::size_t i = 0; i < 3 * FrameArena::shrinkInterval; ++i) {
+        frame();
+    }
+    EXPECT_EQ(blockAllocations, arena.getBlockAllocations());
+}
@@ -251,6 +251,37 @@ TEST(TileCover, FlippedYHelsinki) {
               util::tileCover({transform.getState()}, 11));
 }
 
+TEST(TileCover, Cache) {
+    Transform transform;
+    transform.resize({512, 512});
+    transform.jumpTo(CameraOptions().withCenter(LatLng{0.1, -0.1}).withZoom(8.0).withBearing(5.0).withPitch(40.0));
+
+    util::TileCoverCache cache;
+    const auto& tiles = cache.get({transform.getState()}, 8);
+    EXPECT_EQ(util::tileCover({transform.getState()}, 8), tiles);
+    EXPECT_EQ(1u, cache.getMisses());
+
+    // Same camera, same zoom: served from the cache.
+    EXPECT_EQ(&tiles, &cache.get({transform.getState()}, 8));
+    EXPECT_EQ(1u, cache.getHits());
+
+    // Other zoom levels are cached alongside; other LOD parameters are a
+    // different camera.
+    EXPECT_EQ(util::tileCover({transform.getState()}, 8, 10), cache.get({transform.getState()}, 8, 10));
+    EXPECT_EQ(util::tileCover({transform.getState(), 5}, 8), cache.get({transform.getState(), 5}, 8));
+    EXPECT_EQ(3u, cache.getMisses());
+
+    // Moving the camera invalidates the cover.
+    transform.jumpTo(CameraOptions().withCenter(LatLng{10.1, -0.1}));
+    EXPECT_EQ(util::tileCover({transform.getState()}, 8), cache.get({transform.getState()}, 8));
+    EXPECT_EQ(4u, cache.getMisses());
+    EXPECT_EQ(1u, cache.getHits());
+
+    cache.clear();
+    cache.get({transform.getState()}, 8);
+    EXPECT_EQ(5u, cache.getMisses());
+}
+
 TEST(TileCoverStream, Arctic) {
     auto bounds = LatLngBounds::hull({84, -180}, {70, 180});
     auto zoom = 3;